@@ -15,12 +15,12 @@
  */
 #include "backend/kernel_compiler/cpu/adam_weight_decay_cpu_kernel.h"
 
+#include <algorithm>
 #include <cmath>
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "nnacl/fp32/adam_fp32.h"
 #include "utils/ms_utils.h"
-#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -30,23 +30,12 @@ constexpr size_t kAdamWeightDecayInputSize = 9;
 constexpr size_t kAdamWeightDecayOutputSize = 3;
 
 void AdamWeightDecayCPUKernel::ParallelForAdam(const CTask &task, size_t count) {
-  auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  const float block_size = 128.0;
-  const float align_size = 16.0;
-  size_t thread_num = count < block_size * max_thread_num ? std::ceil(count / block_size) : max_thread_num;
-  std::vector<common::Task> tasks;
-  size_t start = 0;
-  size_t once_compute_size = align_size * std::ceil(count / (align_size * thread_num));
-  while (start < count) {
-    size_t end = (start + once_compute_size) > count ? count : (start + once_compute_size);
-    auto block = [&, start, end]() {
-      task(start, end);
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(block);
-    start += once_compute_size;
-  }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
+  // The blocks are aligned to the vector length of the fused adam.
+  const size_t align_size = 16;
+  auto aligned_task = [&task, count, align_size](size_t start, size_t end) {
+    task(start * align_size, std::min(end * align_size, count));
+  };
+  CPUKernelUtils::ParallelFor(aligned_task, (count + align_size - 1) / align_size, static_cast<float>(align_size));
 }
 
 template <typename T, typename S>
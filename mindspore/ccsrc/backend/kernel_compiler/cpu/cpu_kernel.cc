@@ -15,6 +15,7 @@
  */
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include <algorithm>
+#include <cmath>
 #include <utility>
 #include "common/thread_pool.h"
 
@@ -85,23 +86,12 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   std::reverse(element_num->begin(), element_num->end());
 }
 
-void CPUKernelUtils::ParallelFor(const CTask &task, size_t count) {
-  auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  const float block_size = 128.0;
-  size_t thread_num = count < block_size * max_thread_num ? std::ceil(count / block_size) : max_thread_num;
-  std::vector<common::Task> tasks;
-  size_t start = 0;
-  size_t once_compute_size = (count + thread_num - 1) / thread_num;
-  while (start < count) {
-    size_t end = (start + once_compute_size) > count ? count : (start + once_compute_size);
-    auto block = [&, start, end]() {
-      task(start, end);
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(block);
-    start += once_compute_size;
+void CPUKernelUtils::ParallelFor(const CTask &task, size_t count, float cost) {
+  size_t grain_size = 1;
+  if (cost > 0 && cost < kParallelForMinBlockCost) {
+    grain_size = static_cast<size_t>(std::ceil(kParallelForMinBlockCost / cost));
   }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
+  common::ThreadPool::GetInstance().ParallelFor(task, count, grain_size);
 }
 
 std::vector<size_t> CPUKernelUtils::FlatShapeByAxis(const std::vector<size_t> &shape, int axis) {
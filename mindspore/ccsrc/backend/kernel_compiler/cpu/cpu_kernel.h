@@ -31,6 +31,7 @@ using mindspore::kernel::AddressPtr;
 using CTask = std::function<void(size_t, size_t)>;
 namespace mindspore {
 namespace kernel {
+constexpr float kParallelForMinBlockCost = 128.0;
 const char KERNEL_SIZE[] = "kernel_size";
 const char STRIDE[] = "stride";
 const char STRIDES[] = "strides";
@@ -151,7 +152,9 @@ class CPUKernelUtils {
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
-  static void ParallelFor(const CTask &task, size_t count);
+  // The cost is the estimated number of arithmetic operations to compute one of the 'count' elements, the elements
+  // are split into blocks of at least kParallelForMinBlockCost operations to amortize the dispatch.
+  static void ParallelFor(const CTask &task, size_t count, float cost = 1.0);
   static std::vector<size_t> FlatShapeByAxis(const std::vector<size_t> &shape, int axis);
   static std::vector<size_t> GetBroadcastShape(const std::vector<size_t> &x, const std::vector<size_t> &y);
 };
@@ -37,7 +37,7 @@ void GatherV2CPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
 }
 
 template <typename T>
-void GatherV2CPUKernel<T>::ParallelRun(int8_t *input_addr, int8_t *output_addr, int thread_num) {
+void GatherV2CPUKernel<T>::ParallelRun(int8_t *input_addr, int8_t *output_addr) {
   int outer_size = 1, inner_size = 1;
   for (int64_t i = 0; i < axis_; ++i) {
     outer_size *= input_shape_.at(i);
@@ -50,29 +50,16 @@ void GatherV2CPUKernel<T>::ParallelRun(int8_t *input_addr, int8_t *output_addr,
     indices_element_size *= indices_shape_.at(i);
   }
   const int limit = input_shape_.at(axis_);
-  int stride = UP_DIV(outer_size, thread_num);
-  std::vector<common::Task> tasks;
-  int thread_index = 0;
-  while (thread_index < thread_num) {
-    int count = MSMIN(stride, outer_size - stride * thread_index);
-    if (count <= 0) break;
-    auto thread_stride = stride * thread_index;
-    int8_t *in = input_addr + thread_stride * limit * inner_size * sizeof(T);
-    int8_t *out = output_addr + thread_stride * indices_element_size * inner_size * sizeof(T);
-    auto block = [&, in, count, out]() {
-      int ret = Gather(in, count, inner_size, limit, indices_data_, indices_element_size, out, sizeof(T));
-      if (ret != 0) {
-        MS_LOG(ERROR) << "GatherRun error task_id[" << thread_index << "] error_code[" << ret << "]";
-        return common::FAIL;
-      }
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(block);
-    thread_index++;
-  }
-  if (!common::ThreadPool::GetInstance().SyncRun(tasks)) {
-    MS_LOG(EXCEPTION) << "SyncRun error!";
-  }
+  auto task = [&](size_t start, size_t end) {
+    int8_t *in = input_addr + start * limit * inner_size * sizeof(T);
+    int8_t *out = output_addr + start * indices_element_size * inner_size * sizeof(T);
+    int count = SizeToInt(end - start);
+    int ret = Gather(in, count, inner_size, limit, indices_data_, indices_element_size, out, sizeof(T));
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "GatherRun error, start[" << start << "] end[" << end << "] error_code[" << ret << "]";
+    }
+  };
+  common::ThreadPool::GetInstance().ParallelFor(task, IntToSize(outer_size));
 }
 
 template <typename T>
@@ -82,8 +69,7 @@ bool GatherV2CPUKernel<T>::Launch(const std::vector<kernel::AddressPtr> &inputs,
   int8_t *input_tensor = reinterpret_cast<int8_t *>(inputs[0]->addr);
   indices_data_ = reinterpret_cast<int32_t *>(inputs[1]->addr);
   int8_t *output_addr = reinterpret_cast<int8_t *>(outputs[0]->addr);
-  int max_thread_num = static_cast<int>(common::ThreadPool::GetInstance().GetSyncRunThreadNum());
-  ParallelRun(input_tensor, output_addr, max_thread_num);
+  ParallelRun(input_tensor, output_addr);
   return true;
 }
 
@@ -36,7 +36,7 @@ class GatherV2CPUKernel : public CPUKernel {
 
  private:
   void CheckParam(const CNodePtr &kernel_node);
-  void ParallelRun(int8_t *input_addr, int8_t *output_addr, int thread_num);
+  void ParallelRun(int8_t *input_addr, int8_t *output_addr);
   std::vector<size_t> input_shape_;
   std::vector<size_t> indices_shape_;
   std::vector<size_t> output_shape_;
@@ -17,7 +17,6 @@
 #include "backend/kernel_compiler/cpu/layer_norm_grad_cpu_kernel.h"
 #include "backend/kernel_compiler/common_utils.h"
 #include "runtime/device/cpu/cpu_device_address.h"
-#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -74,19 +73,8 @@ void LayerNormGradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
   auto dx = reinterpret_cast<T *>(outputs[0]->addr);
   auto dg = reinterpret_cast<T *>(outputs[1]->addr);
   auto db = reinterpret_cast<T *>(outputs[2]->addr);
-  size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  auto thread_num1 = param_num_ < thread_num ? param_num_ : thread_num;
-  std::vector<common::Task> tasks1;
-  tasks1.reserve(thread_num1);
-  auto thread_num2 = block_num_ < thread_num ? block_num_ : thread_num;
-  std::vector<common::Task> tasks2;
-  tasks2.reserve(thread_num2);
   auto task1 = [&](size_t start, size_t end) {
-    for (size_t c = 0; c < ceil(static_cast<double>(param_num_) / thread_num1); ++c) {
-      if (c * thread_num1 + start >= param_num_) {
-        continue;
-      }
-      size_t param_index = c * thread_num1 + start;
+    for (size_t param_index = start; param_index < end; ++param_index) {
       T dgamma = (T)0.0;
       T dbeta = (T)0.0;
       for (size_t j = param_index; j < param_size_ * param_num_; j += param_num_) {
@@ -99,11 +87,7 @@ void LayerNormGradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
     }
   };
   auto task2 = [&](size_t start, size_t end) {
-    for (size_t c = 0; c < ceil(static_cast<double>(block_num_) / thread_num2); ++c) {
-      if (c * thread_num2 + start >= block_num_) {
-        continue;
-      }
-      size_t block_index = c * thread_num2 + start;
+    for (size_t block_index = start; block_index < end; ++block_index) {
       T sum1 = (T)0.0;
       T sum2 = (T)0.0;
       T sum3 = (T)0.0;
@@ -127,22 +111,10 @@ void LayerNormGradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
       }
     }
   };
-  for (size_t i = 0; i < thread_num1; ++i) {
-    auto block = [&, i]() {
-      task1(i, i + 1);
-      return common::SUCCESS;
-    };
-    tasks1.emplace_back(block);
-  }
-  common::ThreadPool::GetInstance().SyncRun(tasks1);
-  for (size_t i = 0; i < thread_num2; ++i) {
-    auto block = [&, i]() {
-      task2(i, i + 1);
-      return common::SUCCESS;
-    };
-    tasks2.emplace_back(block);
-  }
-  common::ThreadPool::GetInstance().SyncRun(tasks2);
+  // The elements of each param and each block are computed with a power function.
+  const float element_cost = 16.0;
+  CPUKernelUtils::ParallelFor(task1, param_num_, element_cost * param_size_);
+  CPUKernelUtils::ParallelFor(task2, block_num_, element_cost * block_size_);
 }
 
 void LayerNormGradCPUKernel::CheckParam(const CNodePtr &kernel_node) {
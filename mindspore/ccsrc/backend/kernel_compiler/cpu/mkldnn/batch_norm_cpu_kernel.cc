@@ -22,7 +22,7 @@
 namespace mindspore {
 namespace kernel {
 void BatchNormCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
-  CPUKernel::InitInputOutputSize(kernel_node);
+  MKLCPUKernel::InitInputOutputSize(kernel_node);
   MS_EXCEPTION_IF_NULL(kernel_node);
   size_t type_size = sizeof(float);
   std::vector<size_t> shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
@@ -44,7 +44,7 @@ void BatchNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   channel = x_shape[1];
   hw_size = x_shape[2] * x_shape[3];
   nhw_size = x_shape[0] * hw_size;
-  dnnl::memory::desc x_desc = GetDefaultMemDesc(x_shape);
+  dnnl::memory::desc x_desc = GetInputMemDesc(kernel_node, 0, x_shape);
   dnnl::memory::desc scale_bias_desc = GetDefaultMemDesc({2, channel});
   auto epsilon = AnfAlgo::GetNodeAttr<float>(kernel_node, "epsilon");
   auto prop_kind = dnnl::prop_kind::forward_inference;
@@ -62,7 +62,13 @@ void BatchNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   AddArgument(DNNL_ARG_VARIANCE, prim_desc.variance_desc());
   AddArgument(DNNL_ARG_SCALE_SHIFT, scale_bias_desc);
   AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc());
-  AddArgument(DNNL_ARG_DST, x_desc);
+  // The output keeps the layout of the input, it is reordered if the consumers need the default layout.
+  if (IsOutputBlocked(kernel_node, 0)) {
+    SetBlockedOutputDesc(0, x_desc);
+    AddArgument(DNNL_ARG_DST, x_desc);
+  } else {
+    AddReorderArgument(DNNL_ARG_DST, GetDefaultMemDesc(x_shape), x_desc, true);
+  }
 }
 
 bool BatchNormCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -70,22 +70,31 @@ void Conv2dGradFilterCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
-  dnnl::convolution_forward::desc forward_desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
-
-  auto forward_prim_desc = dnnl::convolution_forward::primitive_desc(forward_desc, MKLKernelEngine::Get().engine());
-
-  dnnl::convolution_backward_weights::desc backward_desc = dnnl::convolution_backward_weights::desc(
-    dnnl::algorithm::convolution_auto, src_desc, weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
-
-  auto backward_prim_desc = dnnl::convolution_backward_weights::primitive_desc(
-    backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
+  // In bfloat16 the src and the dst grad are reordered to the layouts chosen by the primitive, and the weights grad
+  // is computed in float32.
+  auto backward_prim_desc = CreateComputePrimDesc<dnnl::convolution_backward_weights::primitive_desc>(
+    [&](dnnl::memory::data_type data_type) {
+      bool is_f32 = data_type == dnnl::memory::data_type::f32;
+      auto compute_src_desc = is_f32 ? src_desc : AnyFormatMemDesc(src_desc, data_type);
+      auto compute_weights_desc = is_f32 ? weights_desc : AnyFormatMemDesc(weights_desc, data_type);
+      auto compute_diff_weights_desc = is_f32 ? weights_desc : AnyFormatMemDesc(weights_desc);
+      auto compute_dst_desc = is_f32 ? dst_desc : AnyFormatMemDesc(dst_desc, data_type);
+      dnnl::convolution_forward::desc forward_desc = dnnl::convolution_forward::desc(
+        dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, compute_src_desc, compute_weights_desc,
+        compute_dst_desc, strides, dilates, padding_l, padding_r);
+      auto forward_prim_desc =
+        dnnl::convolution_forward::primitive_desc(forward_desc, MKLKernelEngine::Get().engine());
+      dnnl::convolution_backward_weights::desc backward_desc = dnnl::convolution_backward_weights::desc(
+        dnnl::algorithm::convolution_auto, compute_src_desc, compute_diff_weights_desc, compute_dst_desc, strides,
+        dilates, padding_l, padding_r);
+      return dnnl::convolution_backward_weights::primitive_desc(backward_desc, MKLKernelEngine::Get().engine(),
+                                                                forward_prim_desc);
+    });
   primitive_ = std::make_shared<dnnl::convolution_backward_weights>(backward_prim_desc);
 
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DIFF_DST, dst_desc);
-  AddArgument(DNNL_ARG_DIFF_WEIGHTS, weights_desc);
+  AddReorderArgument(DNNL_ARG_SRC, src_desc, backward_prim_desc.src_desc(), false);
+  AddReorderArgument(DNNL_ARG_DIFF_DST, dst_desc, backward_prim_desc.diff_dst_desc(), false);
+  AddReorderArgument(DNNL_ARG_DIFF_WEIGHTS, weights_desc, backward_prim_desc.diff_weights_desc(), true);
 }
 
 bool Conv2dGradFilterCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
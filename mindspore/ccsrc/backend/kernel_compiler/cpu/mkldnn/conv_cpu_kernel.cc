@@ -49,7 +49,7 @@ void ConvCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     weight_shape.insert(weight_shape.begin(), group);
     weight_shape[1] = weight_shape[1] / group;
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  dnnl::memory::desc src_desc = GetInputMemDesc(kernel_node, 0, src_shape);
   dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
   dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
   std::vector<int> stride_ori;
@@ -98,15 +98,39 @@ void ConvCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     padding_l.emplace_back(int_padding_l[i]);
     padding_r.emplace_back(int_padding_r[i]);
   }
-  dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+  bool input_blocked = IsInputBlocked(kernel_node, 0);
+  bool output_blocked = IsOutputBlocked(kernel_node, 0);
+  if (!input_blocked && !output_blocked && !IsBF16ComputeEnabled()) {
+    dnnl::convolution_forward::desc desc =
+      dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
+                                      weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+    auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
+    AddArgument(DNNL_ARG_SRC, src_desc);
+    AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+    AddArgument(DNNL_ARG_DST, dst_desc);
+    return;
+  }
 
-  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+  // The primitive chooses the blocked layouts and the compute type of the src and the weights, the weights and the
+  // tensors in the default layout are reordered, the dst is always in float32.
+  auto prim_desc = CreateComputePrimDesc<dnnl::convolution_forward::primitive_desc>(
+    [&](dnnl::memory::data_type data_type) {
+      dnnl::convolution_forward::desc desc = dnnl::convolution_forward::desc(
+        dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, AnyFormatMemDesc(src_desc, data_type),
+        AnyFormatMemDesc(weights_desc, data_type), AnyFormatMemDesc(dst_desc), strides, dilates, padding_l,
+        padding_r);
+      return dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    });
   primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
+  AddReorderArgument(DNNL_ARG_SRC, src_desc, prim_desc.src_desc(), false);
+  AddReorderArgument(DNNL_ARG_WEIGHTS, weights_desc, prim_desc.weights_desc(), false);
+  if (output_blocked) {
+    SetBlockedOutputDesc(0, prim_desc.dst_desc());
+    AddArgument(DNNL_ARG_DST, prim_desc.dst_desc());
+  } else {
+    AddReorderArgument(DNNL_ARG_DST, dst_desc, prim_desc.dst_desc(), true);
+  }
 }
 
 bool ConvCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -56,14 +56,20 @@ void EltWiseCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (src_shape.size() == 0) {
     src_shape.insert(src_shape.begin(), 1);
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  dnnl::memory::desc src_desc = GetInputMemDesc(kernel_node, 0, src_shape);
 
   auto desc = GetForwardEltwiseDesc(kernel_node, src_desc);
   auto prim_desc = dnnl::eltwise_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
   primitive_ = std::make_shared<dnnl::eltwise_forward>(prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, src_desc);
+  // The output keeps the layout of the input, it is reordered if the consumers need the default layout.
+  if (IsOutputBlocked(kernel_node, 0)) {
+    SetBlockedOutputDesc(0, src_desc);
+    AddArgument(DNNL_ARG_DST, src_desc);
+  } else {
+    AddReorderArgument(DNNL_ARG_DST, GetDefaultMemDesc(src_shape), src_desc, true);
+  }
 }
 
 bool EltWiseCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
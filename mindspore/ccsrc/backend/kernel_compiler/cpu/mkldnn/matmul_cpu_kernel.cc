@@ -168,6 +168,37 @@ void MatMulCPUKernel::InitX64Kernel(bool trans_a, bool trans_b, const std::vecto
   }
   dim_m_ = static_cast<dnnl_dim_t>(o_shape[rank_ - kIndexOffset]);
   dim_n_ = static_cast<dnnl_dim_t>(o_shape[rank_ - 1]);
+  if (IsBF16ComputeEnabled()) {
+    InitBF16Kernel();
+  }
+}
+
+void MatMulCPUKernel::InitBF16Kernel() {
+  // The matrices are viewed as [batch, rows, cols] with the strides of the transposes, and reordered to bfloat16.
+  auto batch = static_cast<dnnl_dim_t>(batch_);
+  dnnl::memory::dims a_strides = {dim_m_ * dim_k_, dim_k_, 1};
+  if (trans_a_ == TRANSPOSE_YES) {
+    a_strides = {dim_m_ * dim_k_, 1, dim_m_};
+  }
+  dnnl::memory::dims b_strides = {dim_k_ * dim_n_, dim_n_, 1};
+  if (trans_b_ == TRANSPOSE_YES) {
+    b_strides = {dim_k_ * dim_n_, 1, dim_k_};
+  }
+  dnnl::memory::desc a_desc({batch, dim_m_, dim_k_}, dnnl::memory::data_type::f32, a_strides);
+  dnnl::memory::desc b_desc({batch, dim_k_, dim_n_}, dnnl::memory::data_type::f32, b_strides);
+  dnnl::memory::desc o_desc({batch, dim_m_, dim_n_}, dnnl::memory::data_type::f32, dnnl::memory::format_tag::abc);
+  auto prim_desc = CreateComputePrimDesc<dnnl::matmul::primitive_desc>([&](dnnl::memory::data_type data_type) {
+    dnnl::matmul::desc desc(AnyFormatMemDesc(a_desc, data_type), AnyFormatMemDesc(b_desc, data_type), o_desc);
+    return dnnl::matmul::primitive_desc(desc, MKLKernelEngine::Get().engine());
+  });
+  if (prim_desc.src_desc().data_type() != dnnl::memory::data_type::bf16) {
+    // The sgemm is faster than the float32 primitive with the reorders.
+    return;
+  }
+  primitive_ = std::make_shared<dnnl::matmul>(prim_desc);
+  AddReorderArgument(DNNL_ARG_SRC, a_desc, prim_desc.src_desc(), false);
+  AddReorderArgument(DNNL_ARG_WEIGHTS, b_desc, prim_desc.weights_desc(), false);
+  AddArgument(DNNL_ARG_DST, o_desc);
 }
 
 void MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -224,13 +255,12 @@ void MatMulCPUKernel::ParallelRun(float *output) {
       batch_b_ptr_ = b_pack_ptr_ + i * param_.deep_ * param_.col_align_;
       batch_o_ptr_ = output + i * param_.row_ * param_.col_;
     }
-    std::vector<common::Task> tasks;
-    size_t thread_index = 0;
-    while (thread_index < thread_count_) {
-      tasks.push_back(std::bind(&MatMulCPUKernel::FloatRun, this, thread_index));
-      thread_index++;
-    }
-    (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+    auto task = [this](size_t start, size_t end) {
+      for (size_t thread_index = start; thread_index < end; ++thread_index) {
+        (void)FloatRun(thread_index);
+      }
+    };
+    common::ThreadPool::GetInstance().ParallelFor(task, thread_count_);
   }
 }
 
@@ -265,6 +295,13 @@ bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, cons
 #ifdef ENABLE_ARM
   LaunchARM(input_a, input_b, output);
 #else
+  if (primitive_ != nullptr) {
+    SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
+    SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+    SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+    ExecutePrimitive();
+    return true;
+  }
   LaunchX64(input_a, input_b, output);
 #endif
   return true;
@@ -42,6 +42,7 @@ class MatMulCPUKernel : public MKLCPUKernel {
                      const std::vector<size_t> &o_shape);
   void InitX64Kernel(bool trans_a, bool trans_b, const std::vector<size_t> &a_shape, const std::vector<size_t> &b_shape,
                      const std::vector<size_t> &o_shape);
+  void InitBF16Kernel();
   void LaunchX64(const float *input_a, const float *input_b, float *output);
   void LaunchARM(const float *input_a, const float *input_b, float *output);
   void ParallelRun(float *output);
@@ -146,14 +146,94 @@ void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc,
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
 
+void MKLCPUKernel::AddReorderArgument(int arg_key, const dnnl::memory::desc &tensor_desc,
+                                      const dnnl::memory::desc &prim_desc, bool is_output) {
+  if (tensor_desc == prim_desc) {
+    AddArgument(arg_key, prim_desc);
+    return;
+  }
+  AddArgument(arg_key, prim_desc, true);
+  tensor_arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(tensor_desc);
+  if (is_output) {
+    reorder_outputs_.emplace_back(arg_key);
+  } else {
+    reorder_inputs_.emplace_back(arg_key);
+  }
+}
+
 void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
+  auto tensor_iter = tensor_arguments_.find(arg_key);
+  if (tensor_iter != tensor_arguments_.end()) {
+    tensor_iter->second.set_data_handle(ptr);
+    return;
+  }
   auto arg_iter = arguments_.find(arg_key);
   if (arg_iter != arguments_.end()) {
     arg_iter->second.set_data_handle(ptr);
   }
 }
 
-void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
+void MKLCPUKernel::ExecutePrimitive() {
+  for (auto arg_key : reorder_inputs_) {
+    Reorder(&tensor_arguments_[arg_key], &arguments_[arg_key]);
+  }
+  MKLKernelEngine::Get().Execute(primitive_, arguments_);
+  for (auto arg_key : reorder_outputs_) {
+    Reorder(&arguments_[arg_key], &tensor_arguments_[arg_key]);
+  }
+}
+
+bool MKLCPUKernel::IsBF16ComputeEnabled() const { return common::GetEnv(kEnvCPUBF16Compute) == "1"; }
+
+bool MKLCPUKernel::IsInputBlocked(const CNodePtr &kernel_node, size_t index) const {
+  return AnfAlgo::GetInputFormat(kernel_node, index) == kOpFormat_MKL_BLOCKED;
+}
+
+bool MKLCPUKernel::IsOutputBlocked(const CNodePtr &kernel_node, size_t index) const {
+  return AnfAlgo::GetOutputFormat(kernel_node, index) == kOpFormat_MKL_BLOCKED;
+}
+
+dnnl::memory::desc MKLCPUKernel::GetInputMemDesc(const CNodePtr &kernel_node, size_t index,
+                                                 const std::vector<size_t> &shape) {
+  if (!IsInputBlocked(kernel_node, index)) {
+    return GetDefaultMemDesc(shape);
+  }
+  // The kernels are built in the execution order, so the producer has chosen its layout.
+  auto prev_node = AnfAlgo::GetPrevNodeOutput(kernel_node, index);
+  auto prev_kernel = dynamic_cast<MKLCPUKernel *>(AnfAlgo::GetKernelMod(prev_node.first));
+  if (prev_kernel == nullptr) {
+    MS_LOG(EXCEPTION) << "The input " << index << " of " << kernel_node->fullname_with_scope()
+                      << " is in the blocked format, but it is not produced by a built oneDNN kernel.";
+  }
+  return prev_kernel->GetBlockedOutputDesc(prev_node.second);
+}
+
+void MKLCPUKernel::SetBlockedOutputDesc(size_t index, const dnnl::memory::desc &mem_desc) {
+  blocked_output_descs_[index] = mem_desc;
+}
+
+const dnnl::memory::desc &MKLCPUKernel::GetBlockedOutputDesc(size_t index) const {
+  auto iter = blocked_output_descs_.find(index);
+  if (iter == blocked_output_descs_.end()) {
+    MS_LOG(EXCEPTION) << "The output " << index << " is not in the blocked format.";
+  }
+  return iter->second;
+}
+
+void MKLCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  // The blocked layout pads the channels, so the size may be larger than the one of the default layout.
+  for (size_t i = 0; i < input_size_list_.size(); ++i) {
+    if (IsInputBlocked(kernel_node, i)) {
+      input_size_list_[i] = GetInputMemDesc(kernel_node, i, {}).get_size();
+    }
+  }
+  for (auto &item : blocked_output_descs_) {
+    if (item.first < output_size_list_.size()) {
+      output_size_list_[item.first] = item.second.get_size();
+    }
+  }
+}
 
 void MKLCPUKernel::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   MKLKernelEngine::Get().Reorder(src_mem, dst_mem);
@@ -26,12 +26,43 @@
 
 namespace mindspore {
 namespace kernel {
+// Set ENV_CPU_BF16_COMPUTE=1 to compute the convolutions, their grads and the matmuls in bfloat16, the tensors stay
+// in float32.
+constexpr auto kEnvCPUBF16Compute = "ENV_CPU_BF16_COMPUTE";
+
 class MKLCPUKernel : public CPUKernel {
  public:
   MKLCPUKernel() = default;
   ~MKLCPUKernel() override = default;
+  // The layout chosen by the primitive for an output in kOpFormat_MKL_BLOCKED, the consumers read the output with it.
+  const dnnl::memory::desc &GetBlockedOutputDesc(size_t index) const;
 
  protected:
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
+  bool IsInputBlocked(const CNodePtr &kernel_node, size_t index) const;
+  bool IsOutputBlocked(const CNodePtr &kernel_node, size_t index) const;
+  // The layout of the input tensor, which is the one of the producer if the input is in kOpFormat_MKL_BLOCKED.
+  dnnl::memory::desc GetInputMemDesc(const CNodePtr &kernel_node, size_t index, const std::vector<size_t> &shape);
+  void SetBlockedOutputDesc(size_t index, const dnnl::memory::desc &mem_desc);
+  // Bind the argument of the primitive to a tensor whose layout is 'tensor_desc'. If the primitive prefers another
+  // layout, the argument is bound to an internal buffer, and the data is reordered before the execution for the
+  // inputs and after the execution for the outputs.
+  void AddReorderArgument(int arg_key, const dnnl::memory::desc &tensor_desc, const dnnl::memory::desc &prim_desc,
+                          bool is_output);
+  bool IsBF16ComputeEnabled() const;
+  // Create the primitive descriptor with 'creator' in bfloat16 if it is enabled, the cpu without bfloat16 support
+  // falls back to float32.
+  template <typename PrimDesc, typename Creator>
+  PrimDesc CreateComputePrimDesc(const Creator &creator) const {
+    if (IsBF16ComputeEnabled()) {
+      try {
+        return creator(dnnl::memory::data_type::bf16);
+      } catch (const dnnl::error &e) {
+        MS_LOG(INFO) << "The bfloat16 primitive is not supported, use float32 instead: " << e.what();
+      }
+    }
+    return creator(dnnl::memory::data_type::f32);
+  }
   bool BinaryBroadCast(std::vector<size_t> *src0_shape, std::vector<size_t> *src1_shape,
                        std::vector<size_t> *dst_shape);
   void GetPadding(const CNodePtr &kernel_node, const std::string &pad_mode, const std::vector<size_t> &src_shape,
@@ -48,7 +79,21 @@ class MKLCPUKernel : public CPUKernel {
     return dnnl::memory::desc{{dimensions}, dnnl::memory::data_type::f32, layout};
   }
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
+
+ private:
+  std::unordered_map<int, dnnl::memory> tensor_arguments_;
+  std::vector<int> reorder_inputs_;
+  std::vector<int> reorder_outputs_;
+  std::unordered_map<size_t, dnnl::memory::desc> blocked_output_descs_;
 };
+
+inline dnnl::memory::desc AnyFormatMemDesc(const dnnl::memory::desc &mem_desc) {
+  return dnnl::memory::desc(mem_desc.dims(), mem_desc.data_type(), dnnl::memory::format_tag::any);
+}
+
+inline dnnl::memory::desc AnyFormatMemDesc(const dnnl::memory::desc &mem_desc, dnnl::memory::data_type data_type) {
+  return dnnl::memory::desc(mem_desc.dims(), data_type, dnnl::memory::format_tag::any);
+}
 }  // namespace kernel
 }  // namespace mindspore
 
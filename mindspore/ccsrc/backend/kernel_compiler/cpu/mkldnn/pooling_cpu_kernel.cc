@@ -23,7 +23,7 @@
 namespace mindspore {
 namespace kernel {
 void PoolingCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
-  CPUKernel::InitInputOutputSize(kernel_node);
+  MKLCPUKernel::InitInputOutputSize(kernel_node);
   workspace_size_list_.emplace_back(workspace_size_);
 }
 
@@ -31,8 +31,11 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  dnnl::memory::desc src_desc = GetInputMemDesc(kernel_node, 0, src_shape);
   dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  // The output keeps the blocked layout of the input.
+  bool blocked = IsInputBlocked(kernel_node, 0) || IsOutputBlocked(kernel_node, 0);
+  dnnl::memory::desc prim_dst_desc = blocked ? AnyFormatMemDesc(dst_desc) : dst_desc;
   std::vector<int> origin_kernel_sizes;
   std::vector<int> strides;
   std::vector<int64_t> kernel_sizes_me = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, KERNEL_SIZE);
@@ -72,18 +75,23 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     padding_r.emplace_back(int_padding_r[i]);
   }
   dnnl::pooling_forward::desc desc =
-    dnnl::pooling_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::pooling_max, src_desc, dst_desc,
-                                strides_dims, kernels_dims, padding_l, padding_r);
+    dnnl::pooling_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::pooling_max, src_desc,
+                                prim_dst_desc, strides_dims, kernels_dims, padding_l, padding_r);
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
   if (kernel_name == prim::kPrimAvgPool->name() || kernel_name == prim::kPrimAvgPool3D->name()) {
     desc = dnnl::pooling_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::pooling_avg, src_desc,
-                                       dst_desc, strides_dims, kernels_dims, padding_l, padding_r);
+                                       prim_dst_desc, strides_dims, kernels_dims, padding_l, padding_r);
   }
   auto prim_desc = dnnl::pooling_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
   workspace_size_ = prim_desc.workspace_desc().get_size();
   primitive_ = std::make_shared<dnnl::pooling_forward>(prim_desc);
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
+  if (IsOutputBlocked(kernel_node, 0)) {
+    SetBlockedOutputDesc(0, prim_desc.dst_desc());
+    AddArgument(DNNL_ARG_DST, prim_desc.dst_desc());
+  } else {
+    AddReorderArgument(DNNL_ARG_DST, dst_desc, prim_desc.dst_desc(), true);
+  }
   AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc());
 }
 
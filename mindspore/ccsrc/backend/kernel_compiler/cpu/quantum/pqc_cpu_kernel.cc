@@ -219,11 +219,8 @@ bool PQCCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, const s
     }
   }
 
-  std::vector<common::Task> tasks;
   std::vector<std::shared_ptr<ComputeParam>> thread_params;
-  tasks.reserve(n_threads_user_);
-
-  size_t end = 0;
+  std::vector<size_t> sample_offsets = {0};
   size_t offset = n_samples_ / n_threads_user_;
   size_t left = n_samples_ % n_threads_user_;
   for (size_t i = 0; i < n_threads_user_; ++i) {
@@ -245,19 +242,16 @@ bool PQCCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, const s
     params->result_len_cp = result_len_;
     params->encoder_g_len_cp = encoder_g_len_;
     params->ansatz_g_len_cp = ansatz_g_len_;
-    size_t start = end;
-    end = start + offset;
-    if (i < left) {
-      end += 1;
-    }
-    auto task = [&params, start, end, i]() {
-      ComputerForwardBackward(params, start, end, i);
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(task);
+    sample_offsets.push_back(sample_offsets.back() + offset + (i < left ? 1 : 0));
     thread_params.emplace_back(params);
   }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
+  // Each thread has its own simulators, so each block runs the samples of one thread.
+  auto task = [&thread_params, &sample_offsets](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      ComputerForwardBackward(thread_params[i], sample_offsets[i], sample_offsets[i + 1], i);
+    }
+  };
+  common::ThreadPool::GetInstance().ParallelFor(task, n_threads_user_);
   return true;
 }
 }  // namespace kernel
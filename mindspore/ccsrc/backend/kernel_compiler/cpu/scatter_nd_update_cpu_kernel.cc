@@ -116,20 +116,8 @@ void ScatterNdUpdateCPUKernel::LaunchKernel(const std::vector<AddressPtr> &input
   params.indices_unit_rank_ = indices_unit_rank_;
   params.out_strides_ = &out_strides_;
 
-  std::vector<common::Task> tasks;
-  size_t start = 0;
-  auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  size_t once_compute_size = (num_units_ + max_thread_num - 1) / max_thread_num;
-  while (start < num_units_) {
-    size_t end = (start + once_compute_size) > num_units_ ? num_units_ : (start + once_compute_size);
-    auto task = [&params, start, end]() -> int {
-      Compute<T>(&params, start, end);
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(task);
-    start += once_compute_size;
-  }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
+  auto task = [&params](size_t start, size_t end) { Compute<T>(&params, start, end); };
+  CPUKernelUtils::ParallelFor(task, num_units_, static_cast<float>(unit_size_));
 
   auto ret = memcpy_s(outputs[0]->addr, outputs[0]->size, x, inputs[0]->size);
   if (ret != 0) {
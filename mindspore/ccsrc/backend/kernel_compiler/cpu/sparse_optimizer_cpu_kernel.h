@@ -119,21 +119,9 @@ class SparseOptimizerCPUKernel : public CPUKernel {
   template <typename T>
   void MultiThreadCompute(const MultiThreadComputeFunc<T> &func, MultiThreadComputeParams<T> *params,
                           size_t total_compute_size) const {
-    std::vector<common::Task> tasks;
-    auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-    tasks.reserve(max_thread_num);
-    size_t start = 0;
-    size_t once_compute_size = (total_compute_size + max_thread_num - 1) / max_thread_num;
-    while (start < total_compute_size) {
-      size_t end = (start + once_compute_size) > total_compute_size ? total_compute_size : (start + once_compute_size);
-      auto task = [&func, &params, start, end]() {
-        func(params, start, end);
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
-      start += once_compute_size;
-    }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+    // Each index updates a row of the parameter, so all the threads are used.
+    auto task = [&func, params](size_t start, size_t end) { func(params, start, end); };
+    common::ThreadPool::GetInstance().ParallelFor(task, total_compute_size);
   }
 
  private:
@@ -170,8 +158,6 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     }
     size_t thread_indices_size = input_grad->indices_size_ / param.thread_num_;
     size_t left_indices_size = input_grad->indices_size_ % param.thread_num_;
-    std::vector<common::Task> tasks;
-    tasks.reserve(param.thread_num_);
     segments.reserve(param.thread_num_);
 
     size_t current_indices_offset = 0;
@@ -185,14 +171,14 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       segments[i]->value_ = input_grad->value_ + current_indices_offset * param.value_stride_;
       segments[i]->indices_ = input_grad->indices_ + current_indices_offset;
       segments[i]->indices_size_ = indices_size;
-      auto task = [&segments, &param, &segment_bucket_sizes, i]() {
-        CalculateEachBucketSize<T>(segments[i], param.max_index_, segment_bucket_sizes[i].get());
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
       current_indices_offset += indices_size;
     }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+    auto task = [&segments, &param, &segment_bucket_sizes](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        CalculateEachBucketSize<T>(segments[i], param.max_index_, segment_bucket_sizes[i].get());
+      }
+    };
+    common::ThreadPool::GetInstance().ParallelFor(task, param.thread_num_);
   }
 
   template <typename T>
@@ -260,18 +246,16 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       }
       each_thread_buckets.emplace_back(thread_buckets);
     }
-    std::vector<common::Task> tasks;
-    tasks.reserve(thread_num);
-    current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      auto task = [&param, &segments, &each_thread_buckets, i, current_indices_offset]() {
-        CopySegmentIndicesToBucket<T>(param, segments[i], current_indices_offset, each_thread_buckets[i]);
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
-      current_indices_offset += segments[i]->indices_size_;
+    std::vector<size_t> segment_offsets(thread_num, 0);
+    for (size_t i = 1; i < thread_num; ++i) {
+      segment_offsets[i] = segment_offsets[i - 1] + segments[i - 1]->indices_size_;
     }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+    auto task = [&param, &segments, &each_thread_buckets, &segment_offsets](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        CopySegmentIndicesToBucket<T>(param, segments[i], segment_offsets[i], each_thread_buckets[i]);
+      }
+    };
+    common::ThreadPool::GetInstance().ParallelFor(task, thread_num);
   }
 
   template <typename T>
@@ -379,8 +363,6 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     MS_EXCEPTION_IF_NULL(reduced_buckets_ptr);
     auto &reduced_buckets = *reduced_buckets_ptr;
     size_t thread_num = buckets.size();
-    std::vector<common::Task> tasks;
-    tasks.reserve(thread_num);
 
     size_t current_indices_offset = 0;
     for (size_t i = 0; i < thread_num; ++i) {
@@ -388,18 +370,18 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       reduced_buckets[i]->value_ = param.workspace_grad_->value_ + current_indices_offset * param.value_stride_;
       reduced_buckets[i]->indices_ = param.workspace_grad_->indices_ + current_indices_offset;
       reduced_buckets[i]->indices_size_ = buckets[i]->indices_size_;
-      auto task = [&param, &buckets, &reduced_buckets, i]() {
+      current_indices_offset += buckets[i]->indices_size_;
+    }
+    auto task = [&param, &buckets, &reduced_buckets](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
         if (param.use_sort_reduce_) {
           SortAndReduceBucketSparseGradient<T>(param, buckets[i], reduced_buckets[i]);
         } else {
           ReduceBucketSparseGradient<T>(param, buckets[i], reduced_buckets[i]);
         }
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
-      current_indices_offset += buckets[i]->indices_size_;
-    }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+      }
+    };
+    common::ThreadPool::GetInstance().ParallelFor(task, thread_num);
   }
 
   template <typename T>
@@ -188,8 +188,6 @@ int StridedSliceCPUKernel::RunTaskOnSplitAxis(uint8_t *input_addr, uint8_t *outp
 }
 
 void StridedSliceCPUKernel::ParallelRun(uint8_t *input_addr, uint8_t *output_addr, int thread_num) {
-  int thread_index = 0;
-  std::vector<common::Task> tasks;
   std::function<int(StridedSliceCPUKernel *, uint8_t *, uint8_t *, int)> execute_func;
   if (parallel_strategy_ == kOnOuter) {
     execute_func = &StridedSliceCPUKernel::RunTaskOnOuter;
@@ -199,11 +197,12 @@ void StridedSliceCPUKernel::ParallelRun(uint8_t *input_addr, uint8_t *output_add
     MS_LOG(EXCEPTION) << "Not supported parallel execute strategy for StridedSlice.";
   }
 
-  while (thread_index < thread_num) {
-    tasks.emplace_back(std::bind(execute_func, this, input_addr, output_addr, thread_index * cal_num_per_thread_));
-    thread_index++;
-  }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
+  auto task = [&](size_t start, size_t end) {
+    for (size_t thread_index = start; thread_index < end; ++thread_index) {
+      (void)execute_func(this, input_addr, output_addr, SizeToInt(thread_index) * cal_num_per_thread_);
+    }
+  };
+  common::ThreadPool::GetInstance().ParallelFor(task, IntToSize(thread_num));
 }
 
 bool StridedSliceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
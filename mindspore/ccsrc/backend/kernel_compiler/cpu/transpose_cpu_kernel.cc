@@ -120,9 +120,9 @@ void TransposeCPUFwdKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
 template <typename T>
 void TransposeCPUFwdKernel::ParallelRun(const T *input_addr, T *output_addr, const int *output_shape, size_t count) {
   auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  const float block_size = 128.0;
-  size_t thread_num = count < block_size * max_thread_num ? std::ceil(count / block_size) : max_thread_num;
-  std::vector<common::Task> tasks;
+  size_t thread_num = count < kParallelForMinBlockCost * max_thread_num
+                        ? static_cast<size_t>(std::ceil(count / kParallelForMinBlockCost))
+                        : max_thread_num;
   std::function<void(const T *, T *, const int *, TransposeParameter *, int, int)> TransposeDims;
 
   if constexpr (std::is_same_v<T, int8_t>) {
@@ -146,14 +146,14 @@ void TransposeCPUFwdKernel::ParallelRun(const T *input_addr, T *output_addr, con
   } else if constexpr (std::is_same_v<T, bool>) {
     TransposeDims = &TransposeDimsBool;
   }
-  for (int task_id = 0; task_id < SizeToInt(thread_num); ++task_id) {
-    auto task = [&, task_id, thread_num]() {
-      TransposeDims(input_addr, output_addr, output_shape, &transpose_param_, task_id, SizeToInt(thread_num));
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(task);
-  }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
+  // The nnacl transpose splits the output by the task id, so each block runs one task.
+  auto task = [&](size_t start, size_t end) {
+    for (size_t task_id = start; task_id < end; ++task_id) {
+      TransposeDims(input_addr, output_addr, output_shape, &transpose_param_, SizeToInt(task_id),
+                    SizeToInt(thread_num));
+    }
+  };
+  common::ThreadPool::GetInstance().ParallelFor(task, thread_num);
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -109,8 +109,6 @@ class UniqueCPUKernel : public CPUKernel {
     segments.reserve(thread_num);
     segment_bucket_sizes.reserve(thread_num);
     IndexType current_offset = 0;
-    std::vector<common::Task> tasks;
-    tasks.reserve(thread_num);
     for (size_t i = 0; i < thread_num; ++i) {
       segment_bucket_sizes.emplace_back(std::make_shared<std::vector<IndexType>>(thread_num, 0));
       IndexType data_size = thread_data_size;
@@ -121,14 +119,14 @@ class UniqueCPUKernel : public CPUKernel {
       segments[i]->input_ = params->input_ + current_offset;
       segments[i]->input_size_ = data_size;
       segments[i]->thread_num_ = thread_num;
-      auto task = [&segments, &segment_bucket_sizes, i]() {
-        CalculateEachBucketSize<DataType, IndexType>(segments[i], segment_bucket_sizes[i].get());
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
       current_offset += data_size;
     }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+    auto task = [&segments, &segment_bucket_sizes](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        CalculateEachBucketSize<DataType, IndexType>(segments[i], segment_bucket_sizes[i].get());
+      }
+    };
+    common::ThreadPool::GetInstance().ParallelFor(task, thread_num);
   }
 
   template <typename DataType, typename IndexType>
@@ -217,19 +215,19 @@ class UniqueCPUKernel : public CPUKernel {
       }
       thread_buckets.emplace_back(local_buckets);
     }
-    std::vector<common::Task> tasks;
-    tasks.reserve(thread_num);
+    std::vector<IndexType> segment_offsets(thread_num, 0);
     current_offset = 0;
     for (size_t i = 0; i < thread_num; ++i) {
       MS_EXCEPTION_IF_NULL(segments[i]);
-      auto task = [&segments, &thread_buckets, current_offset, i]() {
-        SegmentToBuckets<DataType, IndexType>(segments[i], current_offset, thread_buckets[i]);
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
+      segment_offsets[i] = current_offset;
       current_offset += segments[i]->input_size_;
     }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+    auto task = [&segments, &thread_buckets, &segment_offsets](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        SegmentToBuckets<DataType, IndexType>(segments[i], segment_offsets[i], thread_buckets[i]);
+      }
+    };
+    common::ThreadPool::GetInstance().ParallelFor(task, thread_num);
     MS_LOG(DEBUG) << "End";
   }
 
@@ -291,17 +289,12 @@ class UniqueCPUKernel : public CPUKernel {
   template <typename DataType, typename IndexType>
   static void UniqueEachBucket(const std::vector<std::shared_ptr<UniqueParam<DataType, IndexType>>> &buckets) {
     MS_LOG(DEBUG) << "Start";
-    size_t thread_num = buckets.size();
-    std::vector<common::Task> tasks;
-    tasks.reserve(thread_num);
-    for (size_t i = 0; i < thread_num; ++i) {
-      auto task = [&buckets, i]() {
+    auto task = [&buckets](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
         Unique<DataType, IndexType>(buckets[i]);
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
-    }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+      }
+    };
+    common::ThreadPool::GetInstance().ParallelFor(task, buckets.size());
     MS_LOG(DEBUG) << "End";
   }
 
@@ -348,16 +341,12 @@ class UniqueCPUKernel : public CPUKernel {
     }
     result->output_size_ = current_size;
 
-    std::vector<common::Task> tasks;
-    tasks.reserve(thread_num);
-    for (size_t i = 0; i < thread_num; ++i) {
-      auto task = [&buckets, i, result, &bucket_offsets]() {
+    auto task = [&buckets, &result, &bucket_offsets](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
         TransformBucketReverseIndices<DataType, IndexType>(buckets[i], result, bucket_offsets[i]);
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
-    }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+      }
+    };
+    common::ThreadPool::GetInstance().ParallelFor(task, thread_num);
     MS_LOG(DEBUG) << "End";
   }
 
@@ -17,6 +17,7 @@
 #include "common/thread_pool.h"
 #include <algorithm>
 #include <exception>
+#include <memory>
 #include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
 #include "utils/ms_exception.h"
@@ -27,6 +28,21 @@ namespace common {
 const size_t kDeviceNum = 8;
 #endif
 const size_t kMaxThreadNum = 23;
+// The fork join workers yield this many times waiting for a block before they park.
+const size_t kForkJoinSpinCount = 2000;
+const int kForkJoinIdle = 0;
+const int kForkJoinReady = 1;
+
+namespace {
+// Whether the current thread is running a block of ParallelFor.
+thread_local bool in_parallel_for = false;
+
+class ParallelForGuard {
+ public:
+  ParallelForGuard() { in_parallel_for = true; }
+  ~ParallelForGuard() { in_parallel_for = false; }
+};
+}  // namespace
 
 ThreadPool::ThreadPool() {
   size_t process_core_num = std::thread::hardware_concurrency() - 1;
@@ -103,12 +119,127 @@ bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
   return true;
 }
 
+void ThreadPool::ForkJoinLoop(ForkJoinWorker *worker) {
+  in_parallel_for = true;
+  while (true) {
+    size_t spin_count = 0;
+    while (worker->state.load(std::memory_order_acquire) != kForkJoinReady && !fork_join_exit_) {
+      if (spin_count < kForkJoinSpinCount) {
+        ++spin_count;
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(worker->mtx);
+      worker->parked = true;
+      worker->cond_var.wait(lock, [this, worker] { return worker->state == kForkJoinReady || fork_join_exit_; });
+      worker->parked = false;
+    }
+    if (fork_join_exit_) {
+      return;
+    }
+    try {
+      (*worker->task)(worker->begin, worker->end);
+    } catch (...) {
+      worker->exception = std::current_exception();
+    }
+    worker->state.store(kForkJoinIdle, std::memory_order_release);
+  }
+}
+
+void ThreadPool::StartForkJoinWorkers() {
+  fork_join_exit_ = false;
+  // The calling thread runs the first block.
+  for (size_t i = 1; i < max_thread_num_; ++i) {
+    fork_join_workers_.emplace_back(std::make_unique<ForkJoinWorker>());
+    fork_join_threads_.emplace_back(std::thread(&ThreadPool::ForkJoinLoop, this, fork_join_workers_.back().get()));
+  }
+}
+
+void ThreadPool::StopForkJoinWorkers() {
+  std::lock_guard<std::mutex> fork_join_lock(fork_join_mtx_);
+  fork_join_exit_ = true;
+  for (auto &worker : fork_join_workers_) {
+    std::lock_guard<std::mutex> lock(worker->mtx);
+    worker->cond_var.notify_one();
+  }
+  for (auto &it : fork_join_threads_) {
+    if (it.joinable()) {
+      it.join();
+    }
+  }
+  fork_join_threads_.clear();
+  fork_join_workers_.clear();
+}
+
+void ThreadPool::ParallelFor(const RangeTask &task, size_t count, size_t grain_size) {
+  if (count == 0) {
+    return;
+  }
+  grain_size = std::max(grain_size, static_cast<size_t>(1));
+  size_t block_num = std::min(max_thread_num_, (count + grain_size - 1) / grain_size);
+  if (block_num <= 1 || in_parallel_for) {
+    task(0, count);
+    return;
+  }
+  // The workers are busy with the loop of another thread, e.g. a request handler of the parameter server, then the
+  // callers are already running in parallel.
+  std::unique_lock<std::mutex> fork_join_lock(fork_join_mtx_, std::try_to_lock);
+  if (!fork_join_lock.owns_lock()) {
+    task(0, count);
+    return;
+  }
+  if (fork_join_workers_.empty()) {
+    StartForkJoinWorkers();
+  }
+  // The first 'remainder' blocks have one more element than the others.
+  size_t block_size = count / block_num;
+  size_t remainder = count % block_num;
+  size_t first_end = block_size + (remainder > 0 ? 1 : 0);
+  size_t begin = first_end;
+  for (size_t i = 1; i < block_num; ++i) {
+    auto &worker = fork_join_workers_[i - 1];
+    worker->task = &task;
+    worker->begin = begin;
+    begin += block_size + (i < remainder ? 1 : 0);
+    worker->end = begin;
+    worker->exception = nullptr;
+    worker->state = kForkJoinReady;
+    if (worker->parked) {
+      std::lock_guard<std::mutex> lock(worker->mtx);
+      worker->cond_var.notify_one();
+    }
+  }
+
+  std::exception_ptr exception = nullptr;
+  {
+    ParallelForGuard guard;
+    try {
+      task(0, first_end);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+  }
+  for (size_t i = 1; i < block_num; ++i) {
+    auto &worker = fork_join_workers_[i - 1];
+    while (worker->state.load(std::memory_order_acquire) != kForkJoinIdle) {
+      std::this_thread::yield();
+    }
+    if (exception == nullptr) {
+      exception = worker->exception;
+    }
+  }
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+
 ThreadPool &ThreadPool::GetInstance() {
   static ThreadPool instance{};
   return instance;
 }
 
 void ThreadPool::ClearThreadPool() {
+  StopForkJoinWorkers();
   std::lock_guard<std::mutex> sync_run_lock(pool_mtx_);
   if (exit_run_) {
     return;
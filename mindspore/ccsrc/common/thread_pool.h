@@ -27,6 +27,7 @@
 #include <memory>
 #include <utility>
 #include <functional>
+#include <exception>
 #include <iostream>
 #include "utils/log_adapter.h"
 
@@ -34,6 +35,7 @@ namespace mindspore {
 namespace common {
 enum Status { FAIL = -1, SUCCESS = 0 };
 using Task = std::function<int()>;
+using RangeTask = std::function<void(size_t, size_t)>;
 
 class ThreadPool {
  public:
@@ -43,11 +45,32 @@ class ThreadPool {
   static ThreadPool &GetInstance();
   bool SyncRun(const std::vector<Task> &tasks);
   size_t GetSyncRunThreadNum() { return max_thread_num_; }
+  // Fork join loop over [0, count), which is split statically into at most GetSyncRunThreadNum() blocks of at least
+  // grain_size elements. The calling thread runs the first block and the persistent workers run the others, no task
+  // is allocated for the blocks. The nested calls from a running block, and the calls while the workers are busy with
+  // another thread, run in the calling thread. The first exception thrown by the blocks is rethrown after all of them
+  // finish.
+  void ParallelFor(const RangeTask &task, size_t count, size_t grain_size = 1);
   void ClearThreadPool();
 
  private:
+  // The block of a fork join worker, the dispatching thread writes it while the state is idle.
+  struct ForkJoinWorker {
+    const RangeTask *task{nullptr};
+    size_t begin{0};
+    size_t end{0};
+    std::exception_ptr exception{nullptr};
+    std::atomic_int state{0};
+    std::atomic_bool parked{false};
+    std::mutex mtx;
+    std::condition_variable cond_var;
+  };
+
   ThreadPool();
   void SyncRunLoop();
+  void ForkJoinLoop(ForkJoinWorker *worker);
+  void StartForkJoinWorkers();
+  void StopForkJoinWorkers();
 
   size_t max_thread_num_{1};
   std::mutex pool_mtx_;
@@ -58,6 +81,11 @@ class ThreadPool {
   size_t task_finished_count_{0};
   std::condition_variable finished_cond_var_;
   std::vector<std::thread> sync_run_threads_{};
+
+  std::mutex fork_join_mtx_;
+  std::atomic_bool fork_join_exit_ = {false};
+  std::vector<std::unique_ptr<ForkJoinWorker>> fork_join_workers_{};
+  std::vector<std::thread> fork_join_threads_{};
 };
 }  // namespace common
 }  // namespace mindspore
@@ -431,7 +431,8 @@ bool IsNeedPadding(const std::string &format, const size_t shape_size) {
   if (shape_size == 0) {
     return false;
   }
-  if (format == kOpFormat_DEFAULT || format == kOpFormat_FRAC_NZ || format == kOpFormat_ChannelLast) {
+  if (format == kOpFormat_DEFAULT || format == kOpFormat_FRAC_NZ || format == kOpFormat_ChannelLast ||
+      format == kOpFormat_MKL_BLOCKED) {
     return false;
   } else if (shape_size < kNchwDims) {
     return true;
@@ -636,7 +637,7 @@ std::vector<size_t> TransShapeToDevice(const std::vector<size_t> &shape, const s
                                                                     {kOpFormat_NDC1HWC0, Ndc1hwc0DeviceShape},
                                                                     {kOpFormat_FRACTAL_Z_3D, Fracz3DDeviceShape}};
 
-  if (format == kOpFormat_ND || format == kOpFormat_DEFAULT) {
+  if (format == kOpFormat_ND || format == kOpFormat_DEFAULT || format == kOpFormat_MKL_BLOCKED) {
     return shape;
   }
   if (groups > 1 && format == kOpFormat_FRAC_Z) {
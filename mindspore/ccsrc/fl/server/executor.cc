@@ -103,10 +103,18 @@ bool Executor::HandleModelUpdate(const std::string &param_name, const UploadData
     return true;
   }
 
-  std::mutex &mtx = parameter_mutex_[param_name];
-  std::unique_lock<std::mutex> lock(mtx);
   auto &param_aggr = param_aggrs_[param_name];
+  if (param_aggr->IsConcurrentAggregation()) {
+    // The aggregators read the uploaded data in place and are threadsafe, so the clients are not serialized here.
+    if (!param_aggr->LaunchAggregators(upload_data)) {
+      MS_LOG(ERROR) << "Launching aggregators for parameter " << param_name << " failed.";
+      return false;
+    }
+    return true;
+  }
 
+  std::mutex &mtx = parameter_mutex_[param_name];
+  std::unique_lock<std::mutex> lock(mtx);
   if (!param_aggr->UpdateData(upload_data)) {
     MS_LOG(ERROR) << "Updating data for parameter " << param_name << " failed.";
     return false;
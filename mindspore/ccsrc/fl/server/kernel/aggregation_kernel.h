@@ -64,6 +64,9 @@ class AggregationKernel : public CPUKernel {
     return;
   }
 
+  // Whether Launch could be called concurrently, in which the inputs uploaded by different clients are read in place.
+  virtual bool SupportConcurrentLaunch() const { return false; }
+
   // Reinitialize aggregation kernel after scaling operations are done.
   virtual bool ReInitForScaling() { return true; }
 
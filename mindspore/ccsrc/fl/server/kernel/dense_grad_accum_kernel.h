@@ -21,9 +21,11 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <atomic>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "fl/server/kernel/aggregation_kernel.h"
 #include "fl/server/kernel/aggregation_kernel_factory.h"
+#include "fl/server/kernel/striped_accumulator.h"
 
 namespace mindspore {
 namespace ps {
@@ -32,7 +34,7 @@ namespace kernel {
 template <typename T>
 class DenseGradAccumKernel : public AggregationKernel {
  public:
-  DenseGradAccumKernel() = default;
+  DenseGradAccumKernel() : launch_count_(0), finish_count_(0) {}
   ~DenseGradAccumKernel() override = default;
 
   void InitKernel(const CNodePtr &kernel_node) override {
@@ -55,38 +57,62 @@ class DenseGradAccumKernel : public AggregationKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override {
-    if (accum_count_ == 0) {
+    if (inputs[1]->size > inputs[0]->size) {
+      MS_LOG(ERROR) << "The new grad size " << inputs[1]->size << " is greater than the grad size " << inputs[0]->size;
+      return false;
+    }
+    // A rejected launch is not counted, so it does not take the place of a client in this round.
+    size_t launch_count = launch_count_.load();
+    do {
+      if (launch_count >= done_count_) {
+        MS_LOG(ERROR) << "accum_count_ should not be greater than done_count_ " << done_count_;
+        return false;
+      }
+    } while (!launch_count_.compare_exchange_weak(launch_count, launch_count + 1));
+    bool clear_ret = true;
+    accumulator_.StartRound([&inputs, &clear_ret]() {
       int ret = memset_s(inputs[0]->addr, inputs[0]->size, 0x00, inputs[0]->size);
       if (ret != 0) {
         MS_LOG(ERROR) << "memset_s error, errorno(" << ret << ")";
-        return false;
+        clear_ret = false;
       }
+    });
+    if (!clear_ret) {
+      return false;
     }
 
     T *grad_addr = reinterpret_cast<T *>(inputs[0]->addr);
     T *new_grad_addr = reinterpret_cast<T *>(inputs[1]->addr);
-    for (size_t i = 0; i < inputs[0]->size / sizeof(T); i++) {
-      grad_addr[i] += new_grad_addr[i];
-    }
+    accumulator_.Accumulate(grad_addr, new_grad_addr, inputs[1]->size / sizeof(T));
 
-    accum_count_++;
-    if (accum_count_ > done_count_) {
-      MS_LOG(ERROR) << "accum_count_ should not be greater than done_count_ " << done_count_;
-      return false;
-    }
-    if (accum_count_ == done_count_) {
-      for (size_t i = 0; i < inputs[0]->size / sizeof(T); i++) {
+    // The last finished launch averages the grad after all the others are accumulated.
+    size_t finish_count = ++finish_count_;
+    if (finish_count == done_count_) {
+      size_t grad_num = inputs[0]->size / sizeof(T);
+      for (size_t i = 0; i < grad_num; i++) {
         grad_addr[i] /= done_count_;
       }
     }
     return true;
   }
 
-  void Reset() { accum_count_ = 0; }
+  void Reset() {
+    launch_count_ = 0;
+    finish_count_ = 0;
+    accumulator_.EndRound();
+  }
+
+  bool IsAggregationDone() { return finish_count_ >= done_count_; }
 
-  bool IsAggregationDone() { return accum_count_ >= done_count_; }
+  bool SupportConcurrentLaunch() const override { return true; }
 
   void GenerateReuseKernelNodeInfo() override { return; }
+
+ private:
+  // The count of the started and the finished launches in this round.
+  std::atomic<size_t> launch_count_;
+  std::atomic<size_t> finish_count_;
+  StripedAccumulator accumulator_;
 };
 }  // namespace kernel
 }  // namespace server
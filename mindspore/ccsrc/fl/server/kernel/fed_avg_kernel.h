@@ -22,6 +22,7 @@
 #include <utility>
 #include <vector>
 #include <functional>
+#include <atomic>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "fl/server/common.h"
 #include "fl/server/collective_ops_impl.h"
@@ -29,6 +30,7 @@
 #include "fl/server/local_meta_store.h"
 #include "fl/server/kernel/aggregation_kernel.h"
 #include "fl/server/kernel/aggregation_kernel_factory.h"
+#include "fl/server/kernel/striped_accumulator.h"
 
 namespace mindspore {
 namespace ps {
@@ -39,10 +41,13 @@ namespace kernel {
 
 // Pay attention that this kernel is the distributed version of federated average, which means each server node in the
 // cluster in invalved in the aggragation process. So the DistributedCountService and CollectiveOpsImpl are called.
+
+// The clients are aggregated concurrently by the StripedAccumulator, and the weight is averaged once when the count of
+// the round is reached.
 template <typename T, typename S>
 class FedAvgKernel : public AggregationKernel {
  public:
-  FedAvgKernel() : participated_(false) {}
+  FedAvgKernel() : launch_count_(0) {}
   ~FedAvgKernel() override = default;
 
   void InitKernel(const CNodePtr &kernel_node) override {
@@ -69,10 +74,7 @@ class FedAvgKernel : public AggregationKernel {
     MS_EXCEPTION_IF_NULL(weight_node);
     name_ = cnode_name + "." + weight_node->fullname_with_scope();
     first_cnt_handler_ = [&](std::shared_ptr<core::MessageHandler>) {
-      std::unique_lock<std::mutex> lock(weight_mutex_);
-      if (!participated_) {
-        ClearWeightAndDataSize();
-      }
+      accumulator_.StartRound([this]() { ClearWeightAndDataSize(); });
     };
     last_cnt_handler_ = [&](std::shared_ptr<core::MessageHandler>) {
       T *weight_addr = reinterpret_cast<T *>(weight_addr_->addr);
@@ -87,8 +89,10 @@ class FedAvgKernel : public AggregationKernel {
         return;
       }
       LocalMetaStore::GetInstance().put_value(kCtxFedAvgTotalDataSize, data_size_addr[0]);
-      for (size_t i = 0; i < weight_size / sizeof(T); i++) {
-        weight_addr[i] /= data_size_addr[0];
+      T total_data_size = static_cast<T>(data_size_addr[0]);
+      size_t weight_num = weight_size / sizeof(T);
+      for (size_t i = 0; i < weight_num; i++) {
+        weight_addr[i] /= total_data_size;
       }
       done_ = true;
       return;
@@ -100,40 +104,45 @@ class FedAvgKernel : public AggregationKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override {
-    std::unique_lock<std::mutex> lock(weight_mutex_);
     // The weight and new_weight values should be multiplied by clients already, so we don't need to do multiplication
     // again.
     T *weight_addr = reinterpret_cast<T *>(inputs[0]->addr);
     S *data_size_addr = reinterpret_cast<S *>(inputs[1]->addr);
     T *new_weight_addr = reinterpret_cast<T *>(inputs[2]->addr);
     S *new_data_size_addr = reinterpret_cast<S *>(inputs[3]->addr);
-    if (accum_count_ == 0) {
-      ClearWeightAndDataSize();
+    if (inputs[2]->size > inputs[0]->size) {
+      MS_LOG(ERROR) << "The new weight size " << inputs[2]->size << " is greater than the weight size "
+                    << inputs[0]->size;
+      return false;
     }
-
-    MS_LOG(DEBUG) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
-                  << name_ << " new data size is " << new_data_size_addr[0] << ", current total data size is "
-                  << data_size_addr[0];
-    for (size_t i = 0; i < inputs[2]->size / sizeof(T); i++) {
-      weight_addr[i] += new_weight_addr[i];
+    accumulator_.StartRound([this]() { ClearWeightAndDataSize(); });
+
+    accumulator_.Accumulate(weight_addr, new_weight_addr, inputs[2]->size / sizeof(T));
+    {
+      std::lock_guard<std::mutex> lock(data_size_mutex_);
+      MS_LOG(DEBUG) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
+                    << name_ << " new data size is " << new_data_size_addr[0] << ", current total data size is "
+                    << data_size_addr[0];
+      data_size_addr[0] += new_data_size_addr[0];
     }
-    data_size_addr[0] += new_data_size_addr[0];
-    lock.unlock();
 
-    accum_count_++;
-    participated_ = true;
+    // The count is increased after the accumulation, so all the counted clients are accumulated when the last count
+    // handler averages the weight.
+    size_t launch_count = ++launch_count_;
     return DistributedCountService::GetInstance().Count(
-      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(accum_count_));
+      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(launch_count));
   }
 
   void Reset() override {
-    accum_count_ = 0;
+    launch_count_ = 0;
     done_ = false;
-    participated_ = false;
+    accumulator_.EndRound();
     DistributedCountService::GetInstance().ResetCounter(name_);
     return;
   }
 
+  bool SupportConcurrentLaunch() const override { return true; }
+
   bool IsAggregationDone() override { return done_; }
 
   void SetParameterAddress(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
@@ -185,11 +194,12 @@ class FedAvgKernel : public AggregationKernel {
   AddressPtr new_weight_addr_;
   AddressPtr new_data_size_addr_;
 
-  // Whether the kernel's Launch method is called.
-  bool participated_;
+  // The count of the launches in this round, which is used to generate the unique id of each count.
+  std::atomic<size_t> launch_count_;
 
-  // The kernel could be called concurrently so we need lock to ensure threadsafe.
-  std::mutex weight_mutex_;
+  // The kernel could be called concurrently, the weight is accumulated by chunks and the data size is locked.
+  StripedAccumulator accumulator_;
+  std::mutex data_size_mutex_;
 };
 }  // namespace kernel
 }  // namespace server
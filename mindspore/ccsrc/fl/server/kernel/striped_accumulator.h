@@ -0,0 +1,99 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_SERVER_KERNEL_STRIPED_ACCUMULATOR_H_
+#define MINDSPORE_CCSRC_PS_SERVER_KERNEL_STRIPED_ACCUMULATOR_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include "backend/kernel_compiler/cpu/nnacl/fp32/add_fp32.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+namespace kernel {
+// The number of the elements in one chunk of the accumulated buffer.
+constexpr size_t kAccumulateChunkSize = 16384;
+// The number of the mutexes which the chunks are striped to.
+constexpr size_t kAccumulateStripeNum = 64;
+
+template <typename T>
+inline void AddTo(T *dst, const T *src, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    dst[i] += src[i];
+  }
+}
+
+template <>
+inline void AddTo<float>(float *dst, const float *src, size_t count) {
+  (void)ElementAdd(dst, src, dst, static_cast<int>(count));
+}
+
+// StripedAccumulator adds the data uploaded by the concurrent clients into one buffer without a global lock. The
+// buffer is split into chunks which are locked separately, and each client starts from a different chunk, so the
+// clients add their data to different chunks at the same time.
+class StripedAccumulator {
+ public:
+  StripedAccumulator() : round_started_(false), ticket_(0) {}
+  ~StripedAccumulator() = default;
+
+  // Run 'clear' once in one round before the first accumulation, the accumulations of the round wait for it.
+  void StartRound(const std::function<void()> &clear) {
+    if (round_started_.load(std::memory_order_acquire)) {
+      return;
+    }
+    std::unique_lock<std::shared_mutex> lock(round_mutex_);
+    if (!round_started_.load(std::memory_order_relaxed)) {
+      clear();
+      round_started_.store(true, std::memory_order_release);
+    }
+  }
+
+  void EndRound() { round_started_.store(false, std::memory_order_release); }
+
+  // Add 'count' elements of 'src' to 'dst'. It could be called concurrently for the same 'dst'.
+  template <typename T>
+  void Accumulate(T *dst, const T *src, size_t count) {
+    if (count == 0) {
+      return;
+    }
+    std::shared_lock<std::shared_mutex> lock(round_mutex_);
+    size_t chunk_num = (count + kAccumulateChunkSize - 1) / kAccumulateChunkSize;
+    size_t start = ticket_.fetch_add(1, std::memory_order_relaxed) % chunk_num;
+    for (size_t i = 0; i < chunk_num; i++) {
+      size_t chunk = (start + i) % chunk_num;
+      size_t begin = chunk * kAccumulateChunkSize;
+      size_t len = std::min(kAccumulateChunkSize, count - begin);
+      std::lock_guard<std::mutex> chunk_lock(stripe_mutexes_[chunk % kAccumulateStripeNum]);
+      AddTo(dst + begin, src + begin, len);
+    }
+  }
+
+ private:
+  std::shared_mutex round_mutex_;
+  std::atomic_bool round_started_;
+  std::atomic<size_t> ticket_;
+  std::array<std::mutex, kAccumulateStripeNum> stripe_mutexes_;
+};
+}  // namespace kernel
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_SERVER_KERNEL_STRIPED_ACCUMULATOR_H_
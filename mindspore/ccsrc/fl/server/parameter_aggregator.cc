@@ -91,6 +91,44 @@ bool ParameterAggregator::LaunchAggregators() {
   return true;
 }
 
+bool ParameterAggregator::IsConcurrentAggregation() const {
+  return std::all_of(aggregation_kernel_parameters_.begin(), aggregation_kernel_parameters_.end(),
+                     [](const auto &aggregator_with_params) {
+                       return aggregator_with_params.first != nullptr &&
+                              aggregator_with_params.first->SupportConcurrentLaunch();
+                     });
+}
+
+bool ParameterAggregator::LaunchAggregators(const std::map<std::string, Address> &new_data) {
+  for (auto &aggregator_with_params : aggregation_kernel_parameters_) {
+    std::shared_ptr<kernel::AggregationKernel> aggr_kernel = aggregator_with_params.first;
+    RETURN_IF_NULL(aggr_kernel, false);
+    // The inputs of the new data point to the uploaded data of this client, the others are shared.
+    KernelParams params = aggregator_with_params.second;
+    const std::vector<std::string> &input_names = aggr_kernel->input_names();
+    for (size_t i = 0; i < input_names.size() && i < params.inputs.size(); i++) {
+      auto iter = new_data.find(input_names[i]);
+      if (iter == new_data.end()) {
+        continue;
+      }
+      RETURN_IF_NULL(params.inputs[i], false);
+      if (iter->second.size > params.inputs[i]->size) {
+        MS_LOG(ERROR) << "The size of the new data " << input_names[i] << " is " << iter->second.size
+                      << ", which is greater than " << params.inputs[i]->size;
+        return false;
+      }
+      params.inputs[i] = std::make_shared<Address>(iter->second.addr, iter->second.size);
+    }
+
+    bool ret = aggr_kernel->Launch(params.inputs, params.workspace, params.outputs);
+    if (!ret) {
+      MS_LOG(ERROR) << "Launching aggregation kernel " << typeid(aggr_kernel.get()).name() << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
 bool ParameterAggregator::LaunchOptimizers() {
   for (auto &optimizer_with_params : optimizer_kernel_parameters_) {
     KernelParams &params = optimizer_with_params.second;
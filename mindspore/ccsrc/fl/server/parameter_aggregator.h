@@ -75,6 +75,11 @@ class ParameterAggregator {
   bool LaunchAggregators();
   bool LaunchOptimizers();
 
+  // Whether all the aggregators support the concurrent launch. If so, the data uploaded by the clients could be
+  // aggregated concurrently by LaunchAggregators(new_data) without UpdateData, which reads the new data in place.
+  bool IsConcurrentAggregation() const;
+  bool LaunchAggregators(const std::map<std::string, Address> &new_data);
+
   // The implementation for primitive Pull in parameter server training mode.
   // Every call of this method will increase the count for pull by 1.
   AddressPtr Pull();
@@ -19,7 +19,9 @@
 #include <deque>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
+#include <iterator>
 
 #include "ir/anf.h"
 #include "ir/manager.h"
@@ -32,7 +34,8 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  MS_EXCEPTION_IF_NULL(prim);
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, std::vector<std::string>{prim->name()});
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -59,7 +62,12 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  std::vector<std::string> prim_names;
+  (void)std::transform(prims.begin(), prims.end(), std::back_inserter(prim_names), [](const PrimitivePtr &prim) {
+    MS_EXCEPTION_IF_NULL(prim);
+    return prim->name();
+  });
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, prim_names);
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -158,20 +166,114 @@ static void UpdateTransformingList(const OptimizerPtr &optimizer, const AnfNodeP
   }
 }
 
+void SubstitutionList::BuildPrimitiveIndex() {
+  generic_candidates_.clear();
+  prim_candidates_.clear();
+  for (size_t i = 0; i < list_.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(list_[i]);
+    if (list_[i]->prim_names_.empty()) {
+      generic_candidates_.push_back(i);
+      continue;
+    }
+    for (auto &prim_name : list_[i]->prim_names_) {
+      auto &candidates = prim_candidates_[prim_name];
+      if (candidates.empty() || candidates.back() != i) {
+        candidates.push_back(i);
+      }
+    }
+  }
+  // Merge the generic substitutions into each primitive, so that they are tried in the order of list_.
+  for (auto &item : prim_candidates_) {
+    auto &candidates = item.second;
+    std::vector<size_t> merged;
+    (void)std::merge(candidates.begin(), candidates.end(), generic_candidates_.begin(), generic_candidates_.end(),
+                     std::back_inserter(merged));
+    candidates = std::move(merged);
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::GetCandidates(const AnfNodePtr &node) const {
+  auto cnode = dyn_cast<CNode>(node);
+  if (cnode == nullptr || prim_candidates_.empty()) {
+    return generic_candidates_;
+  }
+  auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+  if (prim == nullptr) {
+    return generic_candidates_;
+  }
+  auto iter = prim_candidates_.find(prim->name());
+  return iter == prim_candidates_.end() ? generic_candidates_ : iter->second;
+}
+
+std::vector<AnfNodePtr> CollectDirtyNodes(const FuncGraphManagerPtr &manager, const FuncGraphPtr &root,
+                                          size_t begin) {
+  MS_EXCEPTION_IF_NULL(manager);
+  MS_EXCEPTION_IF_NULL(root);
+  // The whole graph traversal only reaches the graphs used by root.
+  auto &used_graphs = manager->func_graphs_used_total(root);
+  auto &change_log = manager->change_log();
+  std::deque<AnfNodePtr> todo;
+  if (begin < change_log.size()) {
+    (void)todo.insert(todo.end(), change_log.begin() + begin, change_log.end());
+  }
+  auto seen = NewSeenGeneration();
+  std::unordered_set<FuncGraphPtr> seen_graphs;
+  std::vector<AnfNodePtr> dirty_nodes;
+  auto &all_nodes = manager->all_nodes();
+  auto &node_users = manager->node_users();
+  while (!todo.empty()) {
+    AnfNodePtr node = todo.front();
+    todo.pop_front();
+    if (node == nullptr || node->seen_ == seen || !all_nodes.contains(node)) {
+      continue;
+    }
+    node->seen_ = seen;
+    auto fg = node->func_graph();
+    if (fg == nullptr || fg == root || used_graphs.contains(fg)) {
+      dirty_nodes.push_back(node);
+    }
+    auto users_iterator = node_users.find(node);
+    if (users_iterator != node_users.end()) {
+      for (auto &user : users_iterator->second) {
+        todo.emplace_back(user.first);
+      }
+    }
+    // A substitution on a call, like inline, may depend on the whole callee graph.
+    if (fg != nullptr && seen_graphs.insert(fg).second) {
+      for (auto &item : fg->func_graph_cnodes_index()) {
+        todo.emplace_back(item.first->first);
+      }
+    }
+  }
+  return dirty_nodes;
+}
+
 bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const {
+  std::deque<AnfNodePtr> todo;
+  todo.emplace_back(func_graph->output());
+  return TraverseIRToSubstitutions(optimizer, &todo, true);
+}
+
+bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer,
+                                              const std::vector<AnfNodePtr> &dirty_nodes) const {
+  std::deque<AnfNodePtr> todo(dirty_nodes.begin(), dirty_nodes.end());
+  return TraverseIRToSubstitutions(optimizer, &todo, false);
+}
+
+bool SubstitutionList::TraverseIRToSubstitutions(const OptimizerPtr &optimizer, std::deque<AnfNodePtr> *todo,
+                                                 bool visit_inputs) const {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
 #endif
+  MS_EXCEPTION_IF_NULL(todo);
   FuncGraphManagerPtr manager = optimizer->manager();
   auto seen = NewSeenGeneration();
-  std::deque<AnfNodePtr> todo;
-  todo.emplace_back(func_graph->output());
   bool changes = false;
 
   auto &all_nodes = manager->all_nodes();
-  while (!todo.empty()) {
-    AnfNodePtr node = todo.front();
-    todo.pop_front();
+  while (!todo->empty()) {
+    AnfNodePtr node = todo->front();
+    todo->pop_front();
 
     if (node == nullptr || node->seen_ == seen || !isTraversable(node) || !all_nodes.contains(node)) {
       continue;
@@ -179,17 +281,19 @@ bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, con
     node->seen_ = seen;
 
     bool change = false;
-    for (auto &substitution : list_) {
-      auto res = DoTransform(optimizer, node, substitution);
+    for (auto index : GetCandidates(node)) {
+      auto res = DoTransform(optimizer, node, list_[index]);
       if (res != nullptr) {
         change = true;
         changes = true;
         node = res;
-        todo.emplace_back(res);
+        todo->emplace_back(res);
         break;
       }
     }
-    UpdateTransformingList(optimizer, node, &todo, change, seen);
+    if (change || visit_inputs) {
+      UpdateTransformingList(optimizer, node, todo, change, seen);
+    }
   }
 #ifdef ENABLE_PROFILE
   MsProfile::StatTime("opt.transforms." + optimizer->name(), GetTime() - start);
@@ -315,7 +419,9 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
       optimizer->traverse_nodes_first() && !is_once_ && !global_sensitive_) {
     MS_LOG(DEBUG) << "IR >> SUB, " << optimizer->name() << "(r" << optimizer->CurPass_.counter << ")_"
                   << optimizer->CurPass_.name;
-    changes = ApplyIRToSubstitutions(optimizer, func_graph);
+    auto dirty_nodes = optimizer->dirty_nodes();
+    changes = dirty_nodes == nullptr ? ApplyIRToSubstitutions(optimizer, func_graph)
+                                     : ApplyIRToSubstitutions(optimizer, *dirty_nodes);
   } else {
     MS_LOG(DEBUG) << "SUB >> IR, " << optimizer->name() << "(r" << optimizer->CurPass_.counter << ")_"
                   << optimizer->CurPass_.name;
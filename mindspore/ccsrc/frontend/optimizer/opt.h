@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_OPT_H_
 #define MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_OPT_H_
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,9 +44,15 @@ class Substitution {
   PredicateFuncType predicate_{nullptr};
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
+  // the names of the primitives of the only CNodes this Substitution can match, empty if it can match any node
+  std::vector<std::string> prim_names_;
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
-               const RenormAction &renorm_action)
-      : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action) {}
+               const RenormAction &renorm_action, const std::vector<std::string> &prim_names = {})
+      : transform_(transform),
+        name_(name),
+        predicate_(predicate),
+        renorm_action_(renorm_action),
+        prim_names_(prim_names) {}
   ~Substitution() = default;
   AnfNodePtr operator()(const OptimizerPtr &optimizer, const AnfNodePtr &node);
 };
@@ -62,17 +69,31 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
 
 enum OptTraverseSubstitutionsMode { kOptTraverseFromIRToSubstitutions = 0, kOptTraverseFromSubstitutionsToIR };
 
+// Collect the nodes whose result may change after the changes logged by the manager from begin, that is the changed
+// nodes, their users up to the outputs, and the callers of the graphs of all these nodes. Only the nodes of root and
+// the graphs it uses are returned.
+std::vector<AnfNodePtr> CollectDirtyNodes(const FuncGraphManagerPtr &manager, const FuncGraphPtr &root, size_t begin);
+
 class SubstitutionList {
  public:
   explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false,
                             bool global_sensitive = false)
-      : list_(patterns), is_once_(is_once), global_sensitive_(global_sensitive) {}
+      : list_(patterns), is_once_(is_once), global_sensitive_(global_sensitive) {
+    BuildPrimitiveIndex();
+  }
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
  private:
+  void BuildPrimitiveIndex();
+  // The indexes in list_ of the substitutions which may match the node, in the order of list_.
+  const std::vector<size_t> &GetCandidates(const AnfNodePtr &node) const;
   bool ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const;
+  // Visit the dirty nodes only, and the nodes made by the substitutions with their users.
+  bool ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const std::vector<AnfNodePtr> &dirty_nodes) const;
+  // Try the substitutions on the nodes of todo, and on the inputs of the visited nodes if visit_inputs is true.
+  bool TraverseIRToSubstitutions(const OptimizerPtr &optimizer, std::deque<AnfNodePtr> *todo, bool visit_inputs) const;
   bool ApplySubstitutionToIR(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &sub) const;
   bool ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const;
   void DisplayStatusOfSubstitution(const std::unordered_map<std::string, std::vector<bool>> &status,
@@ -82,6 +103,10 @@ class SubstitutionList {
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
   bool global_sensitive_;
+  // the substitutions which can match any node
+  std::vector<size_t> generic_candidates_;
+  // the substitutions which may match a CNode of the primitive, including the generic ones
+  std::unordered_map<std::string, std::vector<size_t>> prim_candidates_;
 };
 }  // namespace opt
 }  // namespace mindspore
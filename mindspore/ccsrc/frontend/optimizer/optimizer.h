@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_OPTIMIZER_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -43,10 +44,12 @@ using OptimizeGraphFunc = std::function<bool(const FuncGraphPtr &func_graph, con
 class OptPassConfig {
  public:
   explicit OptPassConfig(const OptimizeGraphFunc &func) : func_(func) {}
-  explicit OptPassConfig(const std::vector<SubstitutionPtr> &list, bool is_once = false, bool global_sensitive = false)
-      : list_(list), is_once_(is_once), global_sensitive_(global_sensitive) {}
-  OptPassConfig(const std::initializer_list<SubstitutionPtr> &list, bool is_once = false, bool global_sensitive = false)
-      : list_(list), is_once_(is_once), global_sensitive_(global_sensitive) {}
+  explicit OptPassConfig(const std::vector<SubstitutionPtr> &list, bool is_once = false, bool global_sensitive = false,
+                         bool graph_only = false)
+      : list_(list), is_once_(is_once), global_sensitive_(global_sensitive), graph_only_(graph_only) {}
+  OptPassConfig(const std::initializer_list<SubstitutionPtr> &list, bool is_once = false, bool global_sensitive = false,
+                bool graph_only = false)
+      : list_(list), is_once_(is_once), global_sensitive_(global_sensitive), graph_only_(graph_only) {}
   ~OptPassConfig() = default;
 
   const std::vector<SubstitutionPtr> &list() const { return list_; }
@@ -59,6 +62,12 @@ class OptPassConfig {
 
   const bool global_sensitive() const { return global_sensitive_; }
 
+  // The substitutions of the list only change the graph through the manager, and whether and how they transform a
+  // node depends only on the node, its inputs, their users and the graphs it calls, with their abstracts. No state
+  // outside of the graph is read. The optimizer then runs the list only on the nodes changed since its last run, see
+  // Optimizer::step.
+  const bool graph_only() const { return graph_only_; }
+
  private:
   OptPassConfig() : is_renormalize_(true) {}
 
@@ -67,11 +76,13 @@ class OptPassConfig {
   bool is_renormalize_{false};
   bool is_once_{false};
   bool global_sensitive_{false};
+  bool graph_only_{false};
 };
 
 class OptPass {
  public:
-  explicit OptPass(const OptimizeGraphFunc &func) : pass_func_(func) {}
+  explicit OptPass(const OptimizeGraphFunc &func, bool graph_only = false)
+      : pass_func_(func), graph_only_(graph_only) {}
   ~OptPass() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
@@ -80,12 +91,14 @@ class OptPass {
 
   static OptPass Renormalize() { return OptPass(); }
   const bool is_renormalize() const { return is_renormalize_; }
+  const bool graph_only() const { return graph_only_; }
 
  private:
   OptPass() : is_renormalize_(true) {}
 
   OptimizeGraphFunc pass_func_;
   bool is_renormalize_{false};
+  bool graph_only_{false};
 };
 using OptPassGroupMap = std::vector<std::pair<std::string, OptPassConfig>>;
 
@@ -119,7 +132,8 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
 
       if (config.list().size() > 0) {
         OptimizeGraphFunc func = SubstitutionList(config.list(), config.is_once(), config.global_sensitive());
-        passes_.push_back(OptPass(func));
+        passes_.push_back(OptPass(func, config.graph_only()));
+        has_graph_only_ = has_graph_only_ || config.graph_only();
         continue;
       }
 
@@ -153,14 +167,41 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
     // Set the initial value to true, so the renormalization can be executed once if it's the
     // only pass.
     bool changes_since_last_renorm = true;
+    // The passes declared graph only are driven by the change log of the manager. Such a pass runs on the whole graph
+    // the first time, and after a Renormalize or a change made by any other pass, which may change what the graph
+    // only passes see in ways the log does not record. The number of these events is full_version. Otherwise the
+    // pass runs on the nodes changed since its last run, and their users, or is skipped if there are none. The log is
+    // only kept by the optimizers which have such a pass.
+    auto manager = (!has_graph_only_ || resource_ == nullptr) ? nullptr : resource_->manager();
+    ChangeLogGuard change_log_guard(manager);
+    size_t full_version = 0;
+    std::vector<size_t> last_full_versions(passes_.size(), SIZE_MAX);
+    std::vector<size_t> log_offsets(passes_.size(), 0);
 
     while (changes) {
       changes = false;
-      auto run_runc = [&counter, &func_graph, &changes, &changes_since_last_renorm, use_profile, this]() {
+      auto run_runc = [&counter, &func_graph, &changes, &changes_since_last_renorm, &manager, &full_version,
+                       &last_full_versions, &log_offsets, use_profile, this]() {
         for (size_t i = 0; i < passes_.size(); ++i) {
           const OptPass &opt = passes_[i];
           CurPass_ = {counter, pass_names_[i]};
-          auto opt_func = [&func_graph, &changes, &opt, &changes_since_last_renorm, this]() {
+          std::vector<AnfNodePtr> dirty_nodes;
+          bool use_worklist = manager != nullptr && opt.graph_only() && last_full_versions[i] == full_version;
+          if (use_worklist) {
+            if (log_offsets[i] == manager->change_log().size()) {
+              MS_LOG(DEBUG) << "Skip " << name_ << "(r" << counter << ")_" << pass_names_[i]
+                            << ", the graph is not changed since its last run.";
+              continue;
+            }
+            dirty_nodes = CollectDirtyNodes(manager, func_graph, log_offsets[i]);
+          }
+          if (manager != nullptr && opt.graph_only()) {
+            // The changes made by the pass itself are seen by its next run.
+            log_offsets[i] = manager->change_log().size();
+            last_full_versions[i] = full_version;
+          }
+          auto opt_func = [&func_graph, &changes, &opt, &changes_since_last_renorm, &full_version, &dirty_nodes,
+                           use_worklist, this]() {
             if (opt.is_renormalize()) {
               if (!changes_since_last_renorm) {
                 return;
@@ -188,9 +229,19 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
                 }
               }
               changes_since_last_renorm = false;
-            } else if (opt(func_graph, shared_from_this())) {
+              // The abstracts are updated, which the graph only passes depend on.
+              ++full_version;
+              return;
+            }
+            dirty_nodes_ = use_worklist ? &dirty_nodes : nullptr;
+            bool pass_changes = opt(func_graph, shared_from_this());
+            dirty_nodes_ = nullptr;
+            if (pass_changes) {
               changes = true;
               changes_since_last_renorm = true;
+              if (!opt.graph_only()) {
+                ++full_version;
+              }
             }
           };
           use_profile ? (WITH(MsProfile::GetProfile()->Step(pass_names_[i])) opt_func) : opt_func();
@@ -238,6 +289,9 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
 
   bool traverse_nodes_first() { return traverse_nodes_first_; }
 
+  // The nodes to run the current graph only pass on, or nullptr if it runs on the whole graph.
+  const std::vector<AnfNodePtr> *dirty_nodes() const { return dirty_nodes_; }
+
   struct {
     int64_t counter;
     std::string name;
@@ -246,6 +300,23 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
   bool is_on_debug_{false};
 
  private:
+  class ChangeLogGuard {
+   public:
+    explicit ChangeLogGuard(const FuncGraphManagerPtr &manager) : manager_(manager) {
+      if (manager_ != nullptr) {
+        manager_->StartChangeLog();
+      }
+    }
+    ~ChangeLogGuard() {
+      if (manager_ != nullptr) {
+        manager_->StopChangeLog();
+      }
+    }
+
+   private:
+    FuncGraphManagerPtr manager_;
+  };
+
   const std::string name_;
   pipeline::ResourceBasePtr resource_;
   std::vector<OptPass> passes_;
@@ -255,6 +326,8 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
   bool is_enable_;
   bool is_untyped_generated_;
   bool traverse_nodes_first_;
+  bool has_graph_only_{false};
+  const std::vector<AnfNodePtr> *dirty_nodes_{nullptr};
 };
 }  // namespace opt
 }  // namespace mindspore
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/auto_parallel/cost_table.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "nlohmann/json.hpp"
+#include "debug/common.h"
+#include "frontend/parallel/device_matrix.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+constexpr auto kKeyVersion = "version";
+constexpr auto kKeyBytesPerUs = "bytes_per_us";
+constexpr auto kKeyItems = "items";
+constexpr auto kKeyOpType = "op_type";
+constexpr auto kKeyInputsShape = "inputs_shape";
+constexpr auto kKeyInputsSliceShape = "inputs_slice_shape";
+constexpr auto kKeyOutputsSliceShape = "outputs_slice_shape";
+constexpr auto kKeyStageDeviceNum = "stage_device_num";
+constexpr auto kKeyForwardComputation = "forward_computation";
+constexpr auto kKeyBackwardComputation = "backward_computation";
+constexpr auto kKeyForwardCommunication = "forward_communication";
+constexpr auto kKeyBackwardCommunication = "backward_communication";
+
+std::string ShapesToString(const Shapes &shapes) {
+  std::ostringstream buffer;
+  buffer << "[";
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    buffer << ShapeToString(shapes[i]);
+    if (i + 1 != shapes.size()) {
+      buffer << ", ";
+    }
+  }
+  buffer << "]";
+  return buffer.str();
+}
+
+// The measured timings are in 'us'; unmeasured fields are kept as COST_TABLE_UNMEASURED.
+double ToCost(const nlohmann::json &item, const std::string &key, double bytes_per_us) {
+  auto iter = item.find(key);
+  if (iter == item.end() || !iter->is_number() || iter->get<double>() < 0) {
+    return COST_TABLE_UNMEASURED;
+  }
+  return iter->get<double>() * bytes_per_us;
+}
+}  // namespace
+
+std::string CostTableKey::ToString() const {
+  std::ostringstream buffer;
+  buffer << op_type << ":" << ShapesToString(inputs_shape) << ":" << ShapesToString(inputs_slice_shape) << ":"
+         << ShapesToString(outputs_slice_shape) << ":" << stage_device_num;
+  return buffer.str();
+}
+
+std::shared_ptr<CostTable> CostTable::cost_table_inst_ = nullptr;
+
+std::shared_ptr<CostTable> CostTable::GetInstance() {
+  if (cost_table_inst_ == nullptr) {
+    cost_table_inst_.reset(new (std::nothrow) CostTable());
+  }
+  return cost_table_inst_;
+}
+
+void CostTable::Clear() {
+  enabled_ = false;
+  file_path_.clear();
+  bytes_per_us_ = 1.0;
+  items_.clear();
+  std::lock_guard<std::mutex> lock(missing_mutex_);
+  missing_.clear();
+}
+
+bool CostTable::Load(const std::string &file_path) {
+  Clear();
+  auto realpath = Common::GetRealPath(file_path);
+  if (!realpath.has_value()) {
+    MS_LOG(ERROR) << "Get real path failed, path=" << file_path;
+    return false;
+  }
+  // The table is enabled even if the file does not exist yet, so that the missing keys are recorded for the first
+  // calibration run.
+  enabled_ = true;
+  file_path_ = realpath.value();
+  std::ifstream json_file(file_path_);
+  if (!json_file.is_open()) {
+    MS_LOG(WARNING) << "The cost table " << file_path_ << " does not exist, all the operators will be recorded to "
+                    << file_path_ << COST_TABLE_MISSING_SUFFIX << " for calibration.";
+    return true;
+  }
+
+  nlohmann::json table;
+  try {
+    json_file >> table;
+  } catch (nlohmann::json::parse_error &e) {
+    MS_LOG(ERROR) << "Parse cost table " << file_path_ << " failed, error: " << e.what();
+    Clear();
+    return false;
+  }
+  if (!table.contains(kKeyVersion) || table[kKeyVersion] != COST_TABLE_VERSION) {
+    MS_LOG(ERROR) << "The version of cost table " << file_path_ << " is not " << COST_TABLE_VERSION;
+    Clear();
+    return false;
+  }
+  if (table.contains(kKeyBytesPerUs) && table[kKeyBytesPerUs].is_number() && table[kKeyBytesPerUs] > 0) {
+    bytes_per_us_ = table[kKeyBytesPerUs].get<double>();
+  }
+  try {
+    for (const auto &item : table.at(kKeyItems)) {
+      CostTableKey key;
+      key.op_type = item.at(kKeyOpType).get<std::string>();
+      key.inputs_shape = item.at(kKeyInputsShape).get<Shapes>();
+      key.inputs_slice_shape = item.at(kKeyInputsSliceShape).get<Shapes>();
+      key.outputs_slice_shape = item.at(kKeyOutputsSliceShape).get<Shapes>();
+      key.stage_device_num = item.at(kKeyStageDeviceNum).get<int64_t>();
+      CostTableItem cost;
+      cost.forward_computation = ToCost(item, kKeyForwardComputation, bytes_per_us_);
+      cost.backward_computation = ToCost(item, kKeyBackwardComputation, bytes_per_us_);
+      cost.forward_communication = ToCost(item, kKeyForwardCommunication, bytes_per_us_);
+      cost.backward_communication = ToCost(item, kKeyBackwardCommunication, bytes_per_us_);
+      items_[key.ToString()] = cost;
+    }
+  } catch (nlohmann::json::exception &e) {
+    MS_LOG(ERROR) << "Parse the items of cost table " << file_path_ << " failed, error: " << e.what();
+    Clear();
+    return false;
+  }
+  MS_LOG(INFO) << "Load " << items_.size() << " items from cost table " << file_path_ << ".";
+  return true;
+}
+
+bool CostTable::Lookup(const CostTableKey &key, CostTableItem *item) const {
+  MS_EXCEPTION_IF_NULL(item);
+  auto iter = items_.find(key.ToString());
+  if (iter == items_.end()) {
+    return false;
+  }
+  *item = iter->second;
+  return true;
+}
+
+void CostTable::Insert(const CostTableKey &key, const CostTableItem &item) { items_[key.ToString()] = item; }
+
+void CostTable::RecordMissing(const CostTableKey &key, const CostTableItem &analytic_item) {
+  std::lock_guard<std::mutex> lock(missing_mutex_);
+  (void)missing_.emplace(key.ToString(), std::make_pair(key, analytic_item));
+}
+
+bool CostTable::DumpMissing() const {
+  if (!enabled_) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(missing_mutex_);
+  if (missing_.empty()) {
+    return true;
+  }
+  // The analytic costs are in bytes, which the calibration tool uses to size the collectives it profiles.
+  nlohmann::json items = nlohmann::json::array();
+  for (const auto &missing : missing_) {
+    const auto &key = missing.second.first;
+    const auto &cost = missing.second.second;
+    nlohmann::json item;
+    item[kKeyOpType] = key.op_type;
+    item[kKeyInputsShape] = key.inputs_shape;
+    item[kKeyInputsSliceShape] = key.inputs_slice_shape;
+    item[kKeyOutputsSliceShape] = key.outputs_slice_shape;
+    item[kKeyStageDeviceNum] = key.stage_device_num;
+    item[kKeyForwardComputation] = cost.forward_computation;
+    item[kKeyBackwardComputation] = cost.backward_computation;
+    item[kKeyForwardCommunication] = cost.forward_communication;
+    item[kKeyBackwardCommunication] = cost.backward_communication;
+    items.push_back(item);
+  }
+  nlohmann::json table;
+  table[kKeyVersion] = COST_TABLE_VERSION;
+  table[kKeyItems] = items;
+
+  std::string missing_file = file_path_ + COST_TABLE_MISSING_SUFFIX;
+  std::ofstream output(missing_file, std::ios::out | std::ios::trunc);
+  if (!output.is_open()) {
+    MS_LOG(ERROR) << "Open " << missing_file << " failed.";
+    return false;
+  }
+  output << table.dump(2);
+  output.close();
+  MS_LOG(INFO) << "Record " << missing_.size() << " uncalibrated operators to " << missing_file << ".";
+  return true;
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_COST_TABLE_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_COST_TABLE_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "frontend/parallel/tensor_layout/tensor_info.h"
+
+namespace mindspore {
+namespace parallel {
+#define COST_TABLE_VERSION 1
+#define COST_TABLE_MISSING_SUFFIX ".missing"
+#define COST_TABLE_UNMEASURED (-1.0)
+
+// The measured cost of one operator under one partition. The timings are converted into the unit used by the
+// analytic model (bytes) when loaded, so that calibrated and analytic costs can be mixed in one cost graph.
+// COST_TABLE_UNMEASURED means that the field was not profiled and the analytic estimate is used instead.
+struct CostTableItem {
+  double forward_computation = COST_TABLE_UNMEASURED;
+  double backward_computation = COST_TABLE_UNMEASURED;
+  double forward_communication = COST_TABLE_UNMEASURED;
+  double backward_communication = COST_TABLE_UNMEASURED;
+};
+
+// The key of the cost table: the operator type, the full input shapes, and the per device slice shapes of the
+// inputs and outputs. Together with the stage size, these determine the partition being profiled.
+struct CostTableKey {
+  std::string op_type;
+  Shapes inputs_shape;
+  Shapes inputs_slice_shape;
+  Shapes outputs_slice_shape;
+  int64_t stage_device_num = 1;
+
+  std::string ToString() const;
+};
+
+// The cost table generated by the calibration mode, which runs microbenchmarks of the kernels and collectives on the
+// local host. When a table is loaded, OperatorCost looks up the measured cost before falling back to the analytic
+// formulas, and the keys that miss are recorded so that they can be profiled by the next calibration run.
+class CostTable {
+ public:
+  ~CostTable() = default;
+  CostTable(const CostTable &) = delete;
+  CostTable &operator=(const CostTable &) = delete;
+
+  static std::shared_ptr<CostTable> GetInstance();
+
+  // Load the table from 'file_path'. Returns false if the file can not be parsed; the table is left empty then.
+  bool Load(const std::string &file_path);
+  void Clear();
+  bool enabled() const { return enabled_; }
+  const std::string &file_path() const { return file_path_; }
+  size_t size() const { return items_.size(); }
+
+  bool Lookup(const CostTableKey &key, CostTableItem *item) const;
+  void Insert(const CostTableKey &key, const CostTableItem &item);
+  // Record the analytic estimate of a key that is not in the table.
+  void RecordMissing(const CostTableKey &key, const CostTableItem &analytic_item);
+  size_t missing_size() const { return missing_.size(); }
+  // Write the missing keys to 'file_path' + COST_TABLE_MISSING_SUFFIX, as the input of the calibration tool.
+  bool DumpMissing() const;
+
+ private:
+  CostTable() = default;
+  static std::shared_ptr<CostTable> cost_table_inst_;
+
+  bool enabled_ = false;
+  std::string file_path_;
+  // The factor converting the measured time (us) to the unit of the analytic cost model
+  double bytes_per_us_ = 1.0;
+  std::map<std::string, CostTableItem> items_;
+  std::map<std::string, std::pair<CostTableKey, CostTableItem>> missing_;
+  mutable std::mutex missing_mutex_;
+};
+using CostTablePtr = std::shared_ptr<CostTable>;
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_COST_TABLE_H_
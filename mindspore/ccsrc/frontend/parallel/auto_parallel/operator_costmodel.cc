@@ -17,6 +17,7 @@
 #include "frontend/parallel/auto_parallel/operator_costmodel.h"
 
 #include <algorithm>
+#include <iterator>
 #include <random>
 #include "frontend/parallel/device_matrix.h"
 #include "frontend/parallel/tensor_layout/tensor_redistribution.h"
@@ -40,6 +41,69 @@ void OperatorCost::SetInputAndOutputTypeLength(const std::vector<size_t> &input_
 
 void OperatorCost::set_output_critical(int64_t critical) { is_outputs_critical_ = critical; }
 
+CostTableItem OperatorCost::GetCalibratedCost(const std::vector<TensorInfo> &inputs,
+                                              const std::vector<TensorInfo> &outputs, int64_t stage_id) const {
+  CostTableKey key;
+  key.op_type = op_type_;
+  (void)std::transform(inputs.begin(), inputs.end(), std::back_inserter(key.inputs_shape),
+                       [](const TensorInfo &input) { return input.shape(); });
+  (void)std::transform(inputs.begin(), inputs.end(), std::back_inserter(key.inputs_slice_shape),
+                       [](const TensorInfo &input) { return input.slice_shape(); });
+  (void)std::transform(outputs.begin(), outputs.end(), std::back_inserter(key.outputs_slice_shape),
+                       [](const TensorInfo &output) { return output.slice_shape(); });
+  CheckGlobalDeviceManager();
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  key.stage_device_num = SizeToLong(g_device_manager->GetDeviceListByStageId(stage_id).size());
+
+  CostTableItem analytic;
+  analytic.forward_computation = GetForwardComputationCost(inputs, outputs, stage_id);
+  analytic.backward_computation = GetBackwardComputationCost(inputs, outputs, stage_id);
+  analytic.forward_communication = GetForwardCommCost(inputs, outputs, stage_id);
+  analytic.backward_communication = GetBackwardCommCost(inputs, outputs, stage_id);
+
+  auto cost_table = CostTable::GetInstance();
+  CostTableItem measured;
+  if (!cost_table->Lookup(key, &measured)) {
+    cost_table->RecordMissing(key, analytic);
+    return analytic;
+  }
+  // The fields that are not profiled keep the analytic estimates.
+  auto select = [](double measured_cost, double analytic_cost) {
+    return measured_cost < 0 ? analytic_cost : measured_cost;
+  };
+  measured.forward_computation = select(measured.forward_computation, analytic.forward_computation);
+  measured.backward_computation = select(measured.backward_computation, analytic.backward_computation);
+  measured.forward_communication = select(measured.forward_communication, analytic.forward_communication);
+  measured.backward_communication = select(measured.backward_communication, analytic.backward_communication);
+  return measured;
+}
+
+double OperatorCost::GetCalibratedCommCost(const std::vector<TensorInfo> &inputs,
+                                           const std::vector<TensorInfo> &outputs, int64_t stage_id) const {
+  if (op_type_.empty() || !CostTable::GetInstance()->enabled()) {
+    return GetCommCost(inputs, outputs, stage_id);
+  }
+  auto cost = GetCalibratedCost(inputs, outputs, stage_id);
+  return cost.forward_communication + cost.backward_communication;
+}
+
+double OperatorCost::GetCalibratedForwardCommCost(const std::vector<TensorInfo> &inputs,
+                                                  const std::vector<TensorInfo> &outputs, int64_t stage_id) const {
+  if (op_type_.empty() || !CostTable::GetInstance()->enabled()) {
+    return GetForwardCommCost(inputs, outputs, stage_id);
+  }
+  return GetCalibratedCost(inputs, outputs, stage_id).forward_communication;
+}
+
+double OperatorCost::GetCalibratedForwardComputationCost(const std::vector<TensorInfo> &inputs,
+                                                         const std::vector<TensorInfo> &outputs,
+                                                         int64_t stage_id) const {
+  if (op_type_.empty() || !CostTable::GetInstance()->enabled()) {
+    return GetForwardComputationCost(inputs, outputs, stage_id);
+  }
+  return GetCalibratedCost(inputs, outputs, stage_id).forward_computation;
+}
+
 double OperatorCost::GetMemoryCost(const std::vector<TensorInfo> &inputs,
                                    const std::vector<TensorInfo> &outputs) const {
   return GetInputMemoryCost(inputs, outputs) + GetOutputMemoryCost(inputs, outputs);
@@ -18,8 +18,10 @@
 #define PARALLEL_AUTO_PARALLEL_OPERATOR_COSTMODEL_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 #include <map>
+#include "frontend/parallel/auto_parallel/cost_table.h"
 #include "frontend/parallel/device_manager.h"
 #include "frontend/parallel/tensor_layout/tensor_info.h"
 
@@ -66,6 +68,8 @@ class OperatorCost {
   void SetInputAndOutputTypeLength(const std::vector<size_t> &input_lengths, const std::vector<size_t> &output_lengths);
   std::vector<size_t> inputs_type_lengths() const { return inputs_type_lengths_; }
   std::vector<size_t> outputs_type_lengths() const { return outputs_type_lengths_; }
+  void set_op_type(const std::string &op_type) { op_type_ = op_type; }
+  const std::string &op_type() const { return op_type_; }
 
   // per device communication cost
   virtual double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
@@ -95,7 +99,22 @@ class OperatorCost {
   // per device memory cost in a inference phase
   double GetMemoryCostForInference(const std::vector<TensorInfo> &, const std::vector<TensorInfo> &) const;
 
+  // The costs used in searching strategies. When a cost table is loaded by 'costmodel_calibration_file', the costs
+  // measured on the local host are used in place of the analytic estimates; the partitions not in the table fall back
+  // to the analytic estimates, and are recorded for the next calibration run.
+  double GetCalibratedCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
+                               int64_t stage_id) const;
+  double GetCalibratedForwardCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
+                                      int64_t stage_id) const;
+  double GetCalibratedForwardComputationCost(const std::vector<TensorInfo> &inputs,
+                                             const std::vector<TensorInfo> &outputs, int64_t stage_id) const;
+
  protected:
+  CostTableItem GetCalibratedCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
+                                  int64_t stage_id) const;
+
+  // The primitive name of the operator, which is the key of this operator in the cost table.
+  std::string op_type_;
   // For each input in 'inputs_', a bool variable is true if the corresponding one is a parameter or a output of
   // pre-operator that has parameters as input.
   std::vector<bool> is_parameter_involve_;
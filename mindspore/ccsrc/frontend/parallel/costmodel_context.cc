@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "frontend/parallel/allreduce_fusion/allreduce_fusion.h"
+#include "frontend/parallel/auto_parallel/cost_table.h"
 #include "utils/ms_context.h"
 
 namespace mindspore {
@@ -57,6 +58,8 @@ void CostModelContext::ResetCostModel() {
   costmodel_allreduce_fusion_computation_time_parameter_ =
     DEFAULT_COST_MODEL_ALLREDUCE_FUSION_COMPUTATION_TIME_PARAMETER;
   dp_algo_single_loop_ = DEFAULT_DP_ALGO_SINGLE_LOOP;
+  costmodel_calibration_file_.clear();
+  CostTable::GetInstance()->Clear();
 }
 
 void CostModelContext::ResetAlgoParameters() {
@@ -89,6 +92,7 @@ void CostModelContext::PrintCostModel() {
   MS_LOG(INFO) << "tensor_slice_align_size: " << tensor_slice_alignment_size_ << ".";
   MS_LOG(INFO) << "fully_use_device: " << fully_use_device_ << ".";
   MS_LOG(INFO) << "elementwise_stra_follow: " << elementwise_stra_follow_ << ".";
+  MS_LOG(INFO) << "costmodel_calibration_file: " << costmodel_calibration_file_ << ".";
 }
 
 void CostModelContext::set_costmodel_context_for_device(const std::string &device_target) {
@@ -266,6 +270,16 @@ void CostModelContext::set_dp_algo_single_loop(bool single_loop) {
   dp_algo_single_loop_ = single_loop;
 }
 
+void CostModelContext::set_costmodel_calibration_file(const std::string &calibration_file) {
+  if (calibration_file.empty()) {
+    MS_LOG(INFO) << "costmodel_calibration_file is empty, use the analytic cost model.";
+    CostTable::GetInstance()->Clear();
+  } else if (!CostTable::GetInstance()->Load(calibration_file)) {
+    MS_LOG(EXCEPTION) << "Load the cost table from 'costmodel_calibration_file' " << calibration_file << " failed.";
+  }
+  costmodel_calibration_file_ = calibration_file;
+}
+
 struct CostRegister {
   CostRegister() {
     MsContext::device_seter([](const std::string &device_target) {
@@ -153,6 +153,10 @@ class CostModelContext {
   void set_dp_algo_single_loop(bool);
   bool dp_algo_single_loop() const { return dp_algo_single_loop_; }
 
+  // COST_MODEL_CALIBRATION_FILE
+  void set_costmodel_calibration_file(const std::string &);
+  std::string costmodel_calibration_file() const { return costmodel_calibration_file_; }
+
  private:
   CostModelContext();
   static std::shared_ptr<CostModelContext> cm_context_inst_;
@@ -224,6 +228,9 @@ class CostModelContext {
 
   // ELEMENTWISE_OP_STRA_FOLLOW
   bool elementwise_stra_follow_;
+
+  // COST_MODEL_CALIBRATION_FILE: the cost table measured on the local host, empty for the analytic cost model
+  std::string costmodel_calibration_file_;
 };
 }  // namespace parallel
 }  // namespace mindspore
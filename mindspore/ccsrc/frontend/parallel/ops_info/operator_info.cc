@@ -1368,12 +1368,13 @@ Status OperatorInfo::SetCostUnderStrategyBase(const StrategyPtr &strategy) {
   }
   int64_t stage_id = strategy->GetInputStage();
   double computation_cost =
-    operator_cost()->GetForwardComputationCost(inputs_tensor_info_, outputs_tensor_info_, stage_id);
-  double communication_cost = operator_cost()->GetCommCost(inputs_tensor_info_, outputs_tensor_info_, stage_id);
+    operator_cost()->GetCalibratedForwardComputationCost(inputs_tensor_info_, outputs_tensor_info_, stage_id);
+  double communication_cost =
+    operator_cost()->GetCalibratedCommCost(inputs_tensor_info_, outputs_tensor_info_, stage_id);
   const auto gamma = CostModelContext::GetInstance()->costmodel_gamma();
   std::shared_ptr<Cost> result = std::make_shared<Cost>(computation_cost, communication_cost);
   result->communication_without_parameter_ =
-    operator_cost()->GetForwardCommCost(inputs_tensor_info_, outputs_tensor_info_, stage_id);
+    operator_cost()->GetCalibratedForwardCommCost(inputs_tensor_info_, outputs_tensor_info_, stage_id);
   result->communication_with_partial_para_ =
     result->communication_without_parameter_ + gamma * (communication_cost - result->communication_without_parameter_);
 
@@ -31,6 +31,7 @@
 #include "base/core_ops.h"
 #include "frontend/optimizer/opt.h"
 #include "frontend/optimizer/optimizer.h"
+#include "frontend/parallel/auto_parallel/cost_table.h"
 #include "frontend/parallel/auto_parallel/dp_algo_costmodel.h"
 #include "frontend/parallel/auto_parallel/edge_costmodel.h"
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
@@ -935,6 +936,10 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
     return FAILED;
   }
   MS_LOG(INFO) << "Searching strategy succeeded.";
+  // Record the operators that are not in the cost table, as the input of the next calibration run
+  if (!CostTable::GetInstance()->DumpMissing()) {
+    MS_LOG(WARNING) << "Recording the uncalibrated operators failed.";
+  }
 
   if (entire_costgraph->InitSelectedStrategy() == SUCCESS) {
     MS_LOG(INFO) << "Init selected strategy succeeded.";
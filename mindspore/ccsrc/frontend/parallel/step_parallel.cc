@@ -1423,6 +1423,10 @@ OperatorInfoPtr OperatorInstance(const PrimitivePtr &prim, const PrimitiveAttrs
     operator_ = OperatorInstanceByName(BATCH_PARALLEL, attrs, shape_list);
     MS_EXCEPTION_IF_NULL(operator_);
   }
+  if (operator_->operator_cost() != nullptr) {
+    // The measured costs in the cost table are keyed by the primitive, even if it falls back to batch parallel
+    operator_->operator_cost()->set_op_type(prim->name());
+  }
   return operator_;
 }
 
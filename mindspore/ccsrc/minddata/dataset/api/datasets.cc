@@ -785,8 +785,9 @@ std::shared_ptr<DatasetCache> CreateDatasetCacheCharIF(session_id_type id, uint6
                                                        std::optional<std::vector<char>> hostname,
                                                        std::optional<int32_t> port,
                                                        std::optional<int32_t> num_connections,
-                                                       std::optional<int32_t> prefetch_sz) {
-  auto cache = std::make_shared<DatasetCacheImpl>(id, mem_sz, spill, hostname, port, num_connections, prefetch_sz);
+                                                       std::optional<int32_t> prefetch_sz, bool compress) {
+  auto cache =
+    std::make_shared<DatasetCacheImpl>(id, mem_sz, spill, hostname, port, num_connections, prefetch_sz, compress);
   return cache;
 }
 #endif
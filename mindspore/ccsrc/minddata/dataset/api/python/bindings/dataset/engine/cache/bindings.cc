@@ -25,7 +25,9 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                   (void)py::class_<CacheClient, std::shared_ptr<CacheClient>>(*m, "CacheClient")
                     .def(py::init([](session_id_type id, uint64_t mem_sz, bool spill,
                                      std::optional<std::string> hostname, std::optional<int32_t> port,
-                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz) {
+                                     std::optional<int32_t> num_connections, std::optional<int32_t> prefetch_sz,
+                                     std::optional<bool> compress, std::optional<std::string> eviction,
+                                     std::optional<bool> frequency_admission) {
                       std::shared_ptr<CacheClient> cc;
                       CacheClient::Builder builder;
                       builder.SetSessionId(id).SetCacheMemSz(mem_sz).SetSpill(spill);
@@ -33,6 +35,17 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                       if (port) builder.SetPort(port.value());
                       if (num_connections) builder.SetNumConnections(num_connections.value());
                       if (prefetch_sz) builder.SetPrefetchSize(prefetch_sz.value());
+                      if (compress) builder.SetCompress(compress.value());
+                      if (eviction) {
+                        if (eviction.value() == "lru") {
+                          builder.SetEviction(CacheEvictionType::kLru);
+                        } else if (eviction.value() == "clock") {
+                          builder.SetEviction(CacheEvictionType::kClock);
+                        } else {
+                          THROW_IF_ERROR(Status(StatusCode::kMDSyntaxError, "Unknown eviction: " + eviction.value()));
+                        }
+                      }
+                      if (frequency_admission) builder.SetFrequencyAdmission(frequency_admission.value());
                       THROW_IF_ERROR(builder.Build(&cc));
                       return cc;
                     }))
@@ -45,7 +58,14 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                     .def(py::init<>())
                     .def_readwrite("avg_cache_sz", &CacheServiceStat::avg_cache_sz)
                     .def_readwrite("num_mem_cached", &CacheServiceStat::num_mem_cached)
-                    .def_readwrite("num_disk_cached", &CacheServiceStat::num_disk_cached);
+                    .def_readwrite("num_disk_cached", &CacheServiceStat::num_disk_cached)
+                    .def_readwrite("num_compressed", &CacheServiceStat::num_compressed)
+                    .def_readwrite("total_raw_sz", &CacheServiceStat::total_raw_sz)
+                    .def_readwrite("total_cache_sz", &CacheServiceStat::total_cache_sz)
+                    .def_readwrite("compress_throughput", &CacheServiceStat::compress_throughput)
+                    .def_readwrite("num_hit", &CacheServiceStat::num_hit)
+                    .def_readwrite("num_miss", &CacheServiceStat::num_miss)
+                    .def_readwrite("num_evicted", &CacheServiceStat::num_evicted);
                 }));
 
 }  // namespace dataset
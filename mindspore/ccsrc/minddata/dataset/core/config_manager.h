@@ -238,6 +238,14 @@ class ConfigManager {
   // @return - Flag to indicate whether shared memory for multi-processing is enabled
   bool enable_shared_mem() { return enable_shared_mem_; }
 
+  // setter function
+  // @param enable - To allocate the data of the tensors from a pool of reusable buffers instead of the system
+  void set_enable_tensor_pool(bool enable) { enable_tensor_pool_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether the data of the tensors is allocated from the pool
+  bool enable_tensor_pool() const { return enable_tensor_pool_; }
+
  private:
   int32_t num_parallel_workers_;
   int32_t worker_connector_size_;
@@ -262,6 +270,7 @@ class ConfigManager {
   int32_t auto_num_workers_num_shards_;
   uint8_t auto_worker_config_;
   bool enable_shared_mem_;
+  std::atomic_bool enable_tensor_pool_;
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
   Status FromJson(const nlohmann::json &j);
@@ -25,6 +25,9 @@
 #include "minddata/dataset/core/device_tensor.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/util/allocator.h"
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/util/size_class_pool.h"
+#endif
 #include "minddata/dataset/util/system_pool.h"
 
 namespace mindspore {
@@ -66,6 +69,18 @@ Status GlobalContext::Init() {
   return Status::OK();
 }
 
+std::shared_ptr<MemoryPool> GlobalContext::tensor_mem_pool() {
+#ifndef ENABLE_ANDROID
+  if (config_manager_->enable_tensor_pool()) {
+    // Created on first use, so that it follows the numa setting of the pipeline.
+    std::call_once(tensor_pool_flag_,
+                   [this]() { tensor_pool_ = std::make_shared<SizeClassPool>(config_manager_->numa_enable()); });
+    return tensor_pool_;
+  }
+#endif
+  return mem_pool_;
+}
+
 // A print method typically used for debugging
 void GlobalContext::Print(std::ostream &out) const {
   out << "GlobalContext contains the following default config: " << *config_manager_ << "\n";
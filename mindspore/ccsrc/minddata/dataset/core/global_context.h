@@ -76,6 +76,10 @@ class GlobalContext {
   // @return the mem pool
   std::shared_ptr<MemoryPool> mem_pool() const { return mem_pool_; }
 
+  // Getter method
+  // @return the mem pool for the data of the tensors, which is the pool of reusable buffers if it is enabled
+  std::shared_ptr<MemoryPool> tensor_mem_pool();
+
   // Getter method
   // @return the tensor allocator as raw pointer
   const TensorAlloc *tensor_allocator() const { return tensor_allocator_.get(); }
@@ -103,6 +107,8 @@ class GlobalContext {
   static std::once_flag init_instance_flag_;
   static std::unique_ptr<GlobalContext> global_context_;        // The instance of the singleton (global)
   std::shared_ptr<MemoryPool> mem_pool_;                        // A global memory pool
+  std::once_flag tensor_pool_flag_;
+  std::shared_ptr<MemoryPool> tensor_pool_;                     // A pool of reusable buffers for the tensor data
   std::shared_ptr<ConfigManager> config_manager_;               // The configs
   std::unique_ptr<TensorAlloc> tensor_allocator_;               // An allocator for Tensors
   std::unique_ptr<CVTensorAlloc> cv_tensor_allocator_;          // An allocator for CV Tensors
@@ -84,7 +84,7 @@ errno_t memcpy_ss(uchar *dest, size_t destMax, const uchar *src, size_t count) {
 }
 Tensor::Tensor(const TensorShape &shape, const DataType &type) : shape_(shape), type_(type), data_(nullptr) {
   // grab the mem pool from global context and create the allocator for char data area
-  std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->mem_pool();
+  std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->tensor_mem_pool();
   data_allocator_ = std::make_unique<Allocator<unsigned char>>(global_pool);
 }
 
@@ -93,7 +93,8 @@ Tensor::Tensor(Tensor &&other) noexcept
       type_(other.type()),
       data_(other.GetMutableBuffer()),
       data_end_(other.data_end_),
-      data_allocator_(std::move(other.data_allocator_)) {
+      data_allocator_(std::move(other.data_allocator_)),
+      batch_(std::move(other.batch_)) {
   other.Invalidate();
 }
 
@@ -104,6 +105,7 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
     data_ = other.GetMutableBuffer();
     data_end_ = other.data_end_;
     data_allocator_ = std::move(other.data_allocator_);
+    batch_ = std::move(other.batch_);
     other.Invalidate();
   }
   return *this;
@@ -128,6 +130,40 @@ Status Tensor::CreateEmpty(const TensorShape &shape, const DataType &type, Tenso
   }
   return Status::OK();
 }
+Status Tensor::CreateFromBatchSlot(const TensorPtr &batch, dsize_t index, TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(batch);
+  CHECK_FAIL_RETURN_UNEXPECTED(batch->type().IsNumeric(), "Only the slot of a numeric tensor can be shared.");
+  CHECK_FAIL_RETURN_UNEXPECTED(batch->Rank() > 0 && index >= 0 && index < batch->shape()[0],
+                               "Slot index out of range: " + std::to_string(index));
+  CHECK_FAIL_RETURN_UNEXPECTED(batch->HasData(), "Batch tensor has no data.");
+  std::vector<dsize_t> dims = batch->shape().AsVector();
+  TensorShape shape(std::vector<dsize_t>(dims.begin() + 1, dims.end()));
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, batch->type());
+  dsize_t slot_size = batch->SizeInBytes() / batch->shape()[0];
+  (*out)->data_ = batch->data_ + index * slot_size;
+  (*out)->data_end_ = (*out)->data_ + slot_size;
+  (*out)->batch_ = batch;
+  return Status::OK();
+}
+
+Status Tensor::CreateEmptyInSlot(const TensorShape &shape, const DataType &type, BatchSlots *slots, TensorPtr *out) {
+  if (slots != nullptr && type.IsNumeric()) {
+    for (auto &slot : *slots) {
+      if (slot.first == nullptr || slot.first->type() != type || slot.first->Rank() != shape.Rank() + 1) {
+        continue;
+      }
+      std::vector<dsize_t> dims = slot.first->shape().AsVector();
+      if (TensorShape(std::vector<dsize_t>(dims.begin() + 1, dims.end())) != shape) {
+        continue;
+      }
+      TensorPtr batch = std::move(slot.first);
+      return CreateFromBatchSlot(batch, slot.second, out);
+    }
+  }
+  return CreateEmpty(shape, type, out);
+}
+
 Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src, TensorPtr *out) {
   RETURN_IF_NOT_OK(CreateEmpty(shape, type, out));
   if (src != nullptr) {
@@ -343,6 +379,11 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
 // Name: Destructor
 // Description: Destructor
 Tensor::~Tensor() {
+  // The memory of a slot belongs to its batch.
+  if (batch_ != nullptr) {
+    data_ = nullptr;
+    data_end_ = nullptr;
+  }
   if (data_ != nullptr) {
     if (data_allocator_ != nullptr) {
       data_allocator_->deallocate(data_);
@@ -482,6 +523,7 @@ void Tensor::Invalidate() {
   data_ = nullptr;
   data_end_ = nullptr;
   data_allocator_ = nullptr;
+  batch_ = nullptr;
 }
 
 template <typename T>
@@ -19,6 +19,7 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include "./securec.h"
 #ifndef ENABLE_ANDROID
@@ -109,6 +110,26 @@ class Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor over one slot along the first dimension of a batch, e.g. a row of a batch. The tensor
+  /// shares the memory of the batch instead of copying it, and keeps the batch alive.
+  /// \param[in] batch the batch tensor
+  /// \param[in] index index of the slot
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromBatchSlot(const TensorPtr &batch, dsize_t index, TensorPtr *out);
+
+  /// The batch tensors and the indices of the slots along their first dimension
+  using BatchSlots = std::vector<std::pair<TensorPtr, dsize_t>>;
+
+  /// Create an empty numeric tensor over the first free slot of its shape and type, like CreateFromBatchSlot, so the
+  /// producer of a row writes it into its batch directly. Without such a slot, it is created like CreateEmpty.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor
+  /// \param[in,out] slots the slots of the row, the slot taken is reset to nullptr. nullptr to take none.
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateEmptyInSlot(const TensorShape &shape, const DataType &type, BatchSlots *slots, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -339,6 +360,9 @@ class Tensor {
     return out;
   }
 
+  /// \return the batch tensor this tensor is a slot of, see CreateFromBatchSlot. nullptr if it owns its memory.
+  const TensorPtr &BatchOfSlot() const { return batch_; }
+
   /// Invalidate this Tensor by setting the type and shape to unknown and MData to null.
   /// Calling this method will make the Tensor and its data inaccessible, use it with caution.
   void Invalidate();
@@ -705,6 +729,8 @@ class Tensor {
   CharAllocPtr data_allocator_;
   /// pointer to the end of the physical data
   unsigned char *data_end_ = nullptr;
+  /// the batch which owns data_ if the tensor is a slot of it
+  TensorPtr batch_;
 
   /// shape for interpretation of YUV image
   std::vector<uint32_t> yuv_shape_;
@@ -762,8 +788,8 @@ inline Tensor::TensorIterator<std::string_view> Tensor::end<std::string_view>()
 /// \param[out] out output argument to hold the created Tensor
 /// \return Status Code
 template <>
-inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::string> &items, const TensorShape &shape,
-                                                    TensorPtr *out) {
+inline Status Tensor::CreateFromVector<std::string_view>(const std::vector<std::string_view> &items,
+                                                         const TensorShape &shape, TensorPtr *out) {
   CHECK_FAIL_RETURN_UNEXPECTED(
     items.size() == shape.NumOfElements(),
     "Number of elements in the vector does not match the number of elements of the shape required");
@@ -775,7 +801,7 @@ inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::strin
       return (*out)->Reshape(shape);
     }
   }
-  auto length_sum = [](dsize_t sum, const std::string &s) { return s.length() + sum; };
+  auto length_sum = [](dsize_t sum, const std::string_view &s) { return s.length() + sum; };
   dsize_t total_length = std::accumulate(items.begin(), items.end(), 0, length_sum);
 
   // total bytes needed = offset array + strings
@@ -795,8 +821,12 @@ inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::strin
     // total bytes are reduced by kOffsetSize
     num_bytes -= kOffsetSize;
     // insert actual string
-    int ret_code = memcpy_s((*out)->data_ + offset, num_bytes, common::SafeCStr(str), str.length() + 1);
-    if (ret_code != 0) MS_LOG(ERROR) << "Cannot copy string into Tensor";
+    // a string_view is not null-terminated, the terminator is written separately
+    if (!str.empty()) {
+      int ret_code = memcpy_s((*out)->data_ + offset, num_bytes, str.data(), str.length());
+      if (ret_code != 0) MS_LOG(ERROR) << "Cannot copy string into Tensor";
+    }
+    (*out)->data_[offset + str.length()] = '\0';
     //  next string will be stored right after the current one.
     offset = offset + str.length() + 1;
     // total bytes are reduced by the length of the string
@@ -813,6 +843,18 @@ inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::strin
   }
   return Status::OK();
 }
+/// Create a Tensor from a given list of strings, see CreateFromVector<std::string_view> for the memory layout.
+/// \param[in] items elements of the tensor
+/// \param[in] shape shape of the output tensor
+/// \param[out] out output argument to hold the created Tensor
+/// \return Status Code
+template <>
+inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::string> &items, const TensorShape &shape,
+                                                    TensorPtr *out) {
+  std::vector<std::string_view> views(items.begin(), items.end());
+  return CreateFromVector<std::string_view>(views, shape, out);
+}
+
 /// Create a string scalar Tensor from the given value.
 /// \param[in] item value
 /// \param[out] out Created tensor
@@ -21,6 +21,7 @@
 #include <cerrno>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <cstdlib>
 #include <vector>
@@ -436,13 +437,19 @@ Status CacheAdminArgHandler::RunCommand() {
       if (!session_info.empty()) {
         std::cout << std::setw(12) << "Session" << std::setw(12) << "Cache Id" << std::setw(12) << "Mem cached"
                   << std::setw(12) << "Disk cached" << std::setw(16) << "Avg cache size" << std::setw(10) << "Numa hit"
-                  << std::endl;
+                  << std::setw(12) << "Compressed" << std::setw(8) << "Ratio" << std::setw(8) << "MB/s" << std::setw(10)
+                  << "Hit rate" << std::setw(10) << "Evicted" << std::endl;
         for (auto curr_session : session_info) {
           std::string cache_id;
           std::string stat_mem_cached;
           std::string stat_disk_cached;
           std::string stat_avg_cached;
           std::string stat_numa_hit;
+          std::string stat_compressed;
+          std::string stat_ratio;
+          std::string stat_throughput;
+          std::string stat_hit_rate;
+          std::string stat_evicted;
           uint32_t crc = (curr_session.connection_id & 0x00000000FFFFFFFF);
           cache_id = (curr_session.connection_id == 0) ? "n/a" : std::to_string(crc);
           stat_mem_cached =
@@ -453,10 +460,37 @@ Status CacheAdminArgHandler::RunCommand() {
             (curr_session.stats.avg_cache_sz == 0) ? "n/a" : std::to_string(curr_session.stats.avg_cache_sz);
           stat_numa_hit =
             (curr_session.stats.num_numa_hit == 0) ? "n/a" : std::to_string(curr_session.stats.num_numa_hit);
+          stat_compressed =
+            (curr_session.stats.num_compressed == 0) ? "n/a" : std::to_string(curr_session.stats.num_compressed);
+          // The effective capacity of the cache is its memory size times the ratio.
+          if (curr_session.stats.num_compressed == 0 || curr_session.stats.total_cache_sz == 0) {
+            stat_ratio = "n/a";
+          } else {
+            std::ostringstream ratio;
+            ratio << std::fixed << std::setprecision(2)
+                  << static_cast<double>(curr_session.stats.total_raw_sz) / curr_session.stats.total_cache_sz;
+            stat_ratio = ratio.str();
+          }
+          stat_throughput = (curr_session.stats.compress_throughput == 0)
+                              ? "n/a"
+                              : std::to_string(curr_session.stats.compress_throughput);
+          int64_t num_lookups = curr_session.stats.num_hit + curr_session.stats.num_miss;
+          if (num_lookups == 0) {
+            stat_hit_rate = "n/a";
+          } else {
+            std::ostringstream hit_rate;
+            hit_rate << std::fixed << std::setprecision(1)
+                     << 100.0 * static_cast<double>(curr_session.stats.num_hit) / num_lookups << "%";
+            stat_hit_rate = hit_rate.str();
+          }
+          stat_evicted =
+            (curr_session.stats.num_evicted == 0) ? "n/a" : std::to_string(curr_session.stats.num_evicted);
 
           std::cout << std::setw(12) << curr_session.session_id << std::setw(12) << cache_id << std::setw(12)
                     << stat_mem_cached << std::setw(12) << stat_disk_cached << std::setw(16) << stat_avg_cached
-                    << std::setw(10) << stat_numa_hit << std::endl;
+                    << std::setw(10) << stat_numa_hit << std::setw(12) << stat_compressed << std::setw(8) << stat_ratio
+                    << std::setw(8) << stat_throughput << std::setw(10) << stat_hit_rate << std::setw(10)
+                    << stat_evicted << std::endl;
         }
       } else {
         std::cout << "No active sessions." << std::endl;
@@ -673,6 +707,9 @@ void CacheAdminArgHandler::Help() {
   std::cerr << "            [--server_info]\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
   std::cerr << "            [--help]" << std::endl;
+  std::cerr << "The spilling directory has no eviction: the rows spilled stay on disk until their session is\n"
+            << "destroyed, and once the disk is full, the rows a cache with eviction evicts from memory are dropped."
+            << std::endl;
   // Do not expose these option to the user via help or documentation, but the options do exist to aid with
   // development and tuning.
   // [ [-m | --shared_memory_size] <shared memory size> ]
@@ -24,7 +24,16 @@
 namespace mindspore {
 namespace dataset {
 CacheClient::Builder::Builder()
-    : session_id_(0), cache_mem_sz_(0), spill_(false), hostname_(""), port_(0), num_connections_(0), prefetch_size_(0) {
+    : session_id_(0),
+      cache_mem_sz_(0),
+      spill_(false),
+      hostname_(""),
+      port_(0),
+      num_connections_(0),
+      prefetch_size_(0),
+      compress_(false),
+      eviction_(CacheEvictionType::kNone),
+      admission_(false) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   hostname_ = cfg->cache_host();
   port_ = cfg->cache_port();
@@ -36,7 +45,7 @@ Status CacheClient::Builder::Build(std::shared_ptr<CacheClient> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   RETURN_IF_NOT_OK(SanityCheck());
   *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, hostname_, port_, num_connections_,
-                                       prefetch_size_);
+                                       prefetch_size_, compress_, eviction_, admission_);
   return Status::OK();
 }
 
@@ -55,10 +64,14 @@ Status CacheClient::Builder::SanityCheck() {
 
 // Constructor
 CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname,
-                         int32_t port, int32_t num_connections, int32_t prefetch_size)
+                         int32_t port, int32_t num_connections, int32_t prefetch_size, bool compress,
+                         CacheEvictionType eviction, bool admission)
     : server_connection_id_(0),
       cache_mem_sz_(cache_mem_sz),
       spill_(spill),
+      compress_(compress),
+      eviction_(eviction),
+      admission_(admission),
       client_id_(-1),
       local_bypass_(false),
       num_connections_(num_connections),
@@ -99,8 +112,11 @@ void CacheClient::Print(std::ostream &out) const {
   out << "  Session id: " << session_id() << "\n  Cache crc: " << cinfo_.crc()
       << "\n  Server cache id: " << server_connection_id_ << "\n  Cache mem size: " << GetCacheMemSz()
       << "\n  Spilling: " << std::boolalpha << isSpill() << "\n  Number of rpc workers: " << GetNumConnections()
-      << "\n  Prefetch size: " << GetPrefetchSize() << "\n  Local client support: " << std::boolalpha
-      << SupportLocalClient();
+      << "\n  Prefetch size: " << GetPrefetchSize() << "\n  Compression: " << std::boolalpha << isCompress()
+      << "\n  Eviction: "
+      << (eviction_ == CacheEvictionType::kLru ? "LRU" : (eviction_ == CacheEvictionType::kClock ? "CLOCK" : "None"))
+      << "\n  Frequency admission: " << std::boolalpha << isFrequencyAdmission()
+      << "\n  Local client support: " << std::boolalpha << SupportLocalClient();
 }
 
 std::string CacheClient::GetHostname() const { return comm_->GetHostname(); }
@@ -144,6 +160,15 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   return rc;
 }
 
+Status CacheClient::PrefetchRows(const std::vector<row_id_type> &row_id) const {
+  if (row_id.empty()) {
+    return Status::OK();
+  }
+  auto rq = std::make_shared<PrefetchRowsRequest>(this, row_id);
+  // It is only a hint. We won't wait for the result.
+  return PushRequest(rq);
+}
+
 Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
   UniqueLock lck(&mux_);
   // To create a cache, we identify ourself at the client by:
@@ -196,6 +221,17 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
     if (generate_id) {
       createFlag |= CreateCacheRequest::CreateCacheFlag::kGenerateRowId;
     }
+    if (compress_) {
+      createFlag |= CreateCacheRequest::CreateCacheFlag::kCompress;
+    }
+    if (eviction_ == CacheEvictionType::kLru) {
+      createFlag |= CreateCacheRequest::CreateCacheFlag::kEvictLru;
+    } else if (eviction_ == CacheEvictionType::kClock) {
+      createFlag |= CreateCacheRequest::CreateCacheFlag::kEvictClock;
+    }
+    if (admission_) {
+      createFlag |= CreateCacheRequest::CreateCacheFlag::kFrequencyAdmission;
+    }
     // Start the comm layer to receive reply
     RETURN_IF_NOT_OK(comm_->ServiceStart());
     // Initiate connection
@@ -52,6 +52,7 @@ class CacheClient {
   friend class CreateCacheRequest;
   friend class CacheRowRequest;
   friend class BatchFetchRequest;
+  friend class PrefetchRowsRequest;
   friend class BatchCacheRowsRequest;
 
   /// \brief A builder to help creating a CacheClient object
@@ -85,6 +86,30 @@ class CacheClient {
       return *this;
     }
 
+    /// Setter function to keep the rows compressed at the server
+    /// \param compress
+    /// \return Builder object itself
+    Builder &SetCompress(bool compress) {
+      compress_ = compress;
+      return *this;
+    }
+
+    /// Setter function to evict the rows from the server memory once it is full
+    /// \param eviction
+    /// \return Builder object itself
+    Builder &SetEviction(CacheEvictionType eviction) {
+      eviction_ = eviction;
+      return *this;
+    }
+
+    /// Setter function to only admit the rows which are hotter than the rows they evict
+    /// \param admission
+    /// \return Builder object itself
+    Builder &SetFrequencyAdmission(bool admission) {
+      admission_ = admission;
+      return *this;
+    }
+
     /// Setter function to set rpc hostname
     /// \param host
     /// \return Builder object itself
@@ -125,6 +150,9 @@ class CacheClient {
     int32_t GetPort() const { return port_; }
     int32_t GetNumConnections() const { return num_connections_; }
     int32_t GetPrefetchSize() const { return prefetch_size_; }
+    bool isCompress() const { return compress_; }
+    CacheEvictionType GetEviction() const { return eviction_; }
+    bool isFrequencyAdmission() const { return admission_; }
 
     Status SanityCheck();
 
@@ -138,14 +166,21 @@ class CacheClient {
     int32_t port_;
     int32_t num_connections_;
     int32_t prefetch_size_;
+    bool compress_;
+    CacheEvictionType eviction_;
+    bool admission_;
   };
 
   /// \brief Constructor
   /// \param session_id A user assigned session id for the current pipeline
   /// \param cache_mem_sz Size of the memory set aside for the row caching. 0 for unlimited
   /// \param spill Spill to disk if out of memory
+  /// \param compress Keep the rows compressed at the server, they are decompressed after fetching
+  /// \param eviction Evict the rows from the server memory once it is full
+  /// \param admission Only admit the rows into a full memory if they are hotter than the rows they evict
   CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname, int32_t port,
-              int32_t num_connections, int32_t prefetch_size);
+              int32_t num_connections, int32_t prefetch_size, bool compress = false,
+              CacheEvictionType eviction = CacheEvictionType::kNone, bool admission = false);
 
   /// \brief Destructor
   ~CacheClient();
@@ -163,6 +198,12 @@ class CacheClient {
   /// \return return code
   Status GetRows(const std::vector<row_id_type> &row_id, TensorTable *out) const;
 
+  /// \brief Tell the cache server which rows are going to be fetched next, so it can read the rows it spilled to
+  /// disk ahead of the fetch. It doesn't wait for the server.
+  /// \param row_id A vector of row id's
+  /// \return return code
+  Status PrefetchRows(const std::vector<row_id_type> &row_id) const;
+
   /// \brief Create a cache.
   /// \param tree_crc  A crc that was generated during tree prepare phase
   /// \param generate_id Let the cache service generate row id
@@ -231,6 +272,9 @@ class CacheClient {
   bool isSpill() const { return spill_; }
   int32_t GetNumConnections() const { return num_connections_; }
   int32_t GetPrefetchSize() const { return prefetch_size_; }
+  bool isCompress() const { return compress_; }
+  CacheEvictionType GetEviction() const { return eviction_; }
+  bool isFrequencyAdmission() const { return admission_; }
   int32_t GetClientId() const { return client_id_; }
   std::string GetHostname() const;
   int32_t GetPort() const;
@@ -273,6 +317,9 @@ class CacheClient {
   mutable RWLock mux_;
   uint64_t cache_mem_sz_;
   bool spill_;
+  bool compress_;
+  CacheEvictionType eviction_;
+  bool admission_;
   // The session_id_ and cache_crc_ work together to uniquely identify this particular cache and allow
   // sharing of the cache.
   CacheClientInfo cinfo_;
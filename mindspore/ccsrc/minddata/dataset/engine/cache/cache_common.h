@@ -23,6 +23,7 @@
 #ifdef ENABLE_CACHE
 #include <grpcpp/grpcpp.h>
 #endif
+#include <cstring>
 #include <string>
 #include <thread>
 #ifdef ENABLE_CACHE
@@ -109,6 +110,24 @@ inline int64_t round_up_4K(int64_t sz) {
 /// Memory policy
 enum CachePoolPolicy : int8_t { kOnNode, kPreferred, kLocal, kInterleave, kNone };
 
+/// \brief Eviction policy of the rows a cache keeps in memory. With a policy, the cold rows make room for the new ones
+/// (moved to the spill path if there is one) instead of the new rows not being cached at all.
+enum class CacheEvictionType : uint8_t { kNone = 0, kLru = 1, kClock = 2 };
+
+/// \brief A row which is evicted while a batch fetch of it is in flight is replaced by this number in the reply. A
+/// cached row starts with a small flatbuffer offset or the magic number of a compressed row instead.
+constexpr static uint32_t kEvictedRowMagic = 0xE71C7ED0U;
+
+/// \brief Check if a fetched row is evicted, which is a cache miss
+inline bool IsEvictedRow(const void *row, int64_t len) {
+  uint32_t magic = 0;
+  if (len < static_cast<int64_t>(sizeof(magic))) {
+    return false;
+  }
+  (void)memcpy(&magic, row, sizeof(magic));
+  return magic == kEvictedRowMagic;
+}
+
 /// Misc typedef
 using worker_id_t = int32_t;
 using numa_id_t = int32_t;
@@ -0,0 +1,289 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "minddata/dataset/engine/cache/cache_compress.h"
+#include <algorithm>
+#include <cstring>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int kHashLog = 12;
+constexpr size_t kMinMatch = 4;
+// The format requires the last 5 bytes to be literals, and the last match to start 12 bytes before the end.
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr uint8_t kRunMask = 15;
+constexpr uint8_t kMaxByte = 255;
+// The number of missed positions after which the search for a match starts to skip bytes.
+constexpr int kSkipTrigger = 6;
+// The largest consolidated row whose buffer is kept by the thread for the next row.
+constexpr size_t kMaxReusedRowSize = 4 * 1024 * 1024;
+
+inline uint32_t Read32(const char *p) {
+  uint32_t v;
+  (void)memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t Read64(const char *p) {
+  uint64_t v;
+  (void)memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline void Copy8(char *dst, const char *src) { (void)memcpy(dst, src, sizeof(uint64_t)); }
+
+inline uint32_t Hash(uint32_t v) { return (v * 2654435761U) >> (32 - kHashLog); }
+
+// Write a length which goes beyond the 4 bits of the token, as a run of 255 and the remainder.
+inline bool PutLength(size_t len, uint8_t **op, const uint8_t *end) {
+  for (; len >= kMaxByte; len -= kMaxByte) {
+    if (*op >= end) {
+      return false;
+    }
+    *(*op)++ = kMaxByte;
+  }
+  if (*op >= end) {
+    return false;
+  }
+  *(*op)++ = static_cast<uint8_t>(len);
+  return true;
+}
+
+// Write the literals of a sequence, its match is added by PutMatch unless it is the last one.
+inline bool PutLiterals(const char *lit, size_t lit_len, uint8_t **token, uint8_t **op, const uint8_t *end) {
+  if (*op >= end) {
+    return false;
+  }
+  *token = (*op)++;
+  **token = static_cast<uint8_t>((lit_len >= kRunMask ? kRunMask : lit_len) << 4);
+  if (lit_len >= kRunMask && !PutLength(lit_len - kRunMask, op, end)) {
+    return false;
+  }
+  if (static_cast<size_t>(end - *op) < lit_len) {
+    return false;
+  }
+  (void)memcpy(*op, lit, lit_len);
+  *op += lit_len;
+  return true;
+}
+
+inline bool PutMatch(size_t offset, size_t match_len, uint8_t *token, uint8_t **op, const uint8_t *end) {
+  if (end - *op < 2) {
+    return false;
+  }
+  *(*op)++ = static_cast<uint8_t>(offset & kMaxByte);
+  *(*op)++ = static_cast<uint8_t>(offset >> 8);
+  size_t len = match_len - kMinMatch;
+  *token |= static_cast<uint8_t>(len >= kRunMask ? kRunMask : len);
+  return len < kRunMask || PutLength(len - kRunMask, op, end);
+}
+
+// Read a length which goes beyond the 4 bits of the token.
+inline Status GetLength(const uint8_t *src, size_t src_sz, size_t *ip, size_t *len) {
+  uint8_t b;
+  do {
+    CHECK_FAIL_RETURN_UNEXPECTED(*ip < src_sz, "Data corruption detected. Truncated compressed row.");
+    b = src[(*ip)++];
+    *len += b;
+  } while (b == kMaxByte);
+  return Status::OK();
+}
+}  // namespace
+
+size_t LzCompress(const char *src, size_t src_sz, char *dst, size_t dst_cap) {
+  auto *op = reinterpret_cast<uint8_t *>(dst);
+  const uint8_t *end = op + dst_cap;
+  uint8_t *token = nullptr;
+  size_t anchor = 0;
+  if (src_sz > kMatchFindLimit) {
+    // Positions of the last 4-byte sequences seen, by hash. A stale or colliding entry is caught by the compare.
+    uint32_t table[1 << kHashLog] = {0};
+    const size_t match_limit = src_sz - kMatchFindLimit;
+    const size_t extend_limit = src_sz - kLastLiterals;
+    size_t pos = 0;
+    while (pos < match_limit) {
+      uint32_t seq = Read32(src + pos);
+      uint32_t h = Hash(seq);
+      size_t cand = table[h];
+      table[h] = static_cast<uint32_t>(pos);
+      if (cand >= pos || pos - cand > kMaxOffset || Read32(src + cand) != seq) {
+        // Skip faster and faster through the data which has no match.
+        pos += 1 + ((pos - anchor) >> kSkipTrigger);
+        continue;
+      }
+      // Extend the match 8 bytes at a time, the first different byte is the lowest set byte of the xor.
+      size_t len = kMinMatch;
+      while (pos + len + sizeof(uint64_t) <= extend_limit) {
+        uint64_t diff = Read64(src + cand + len) ^ Read64(src + pos + len);
+        if (diff != 0) {
+          len += static_cast<size_t>(__builtin_ctzll(diff)) >> 3;
+          break;
+        }
+        len += sizeof(uint64_t);
+      }
+      if (pos + len + sizeof(uint64_t) > extend_limit) {
+        while (pos + len < extend_limit && src[cand + len] == src[pos + len]) {
+          ++len;
+        }
+      }
+      if (!PutLiterals(src + anchor, pos - anchor, &token, &op, end) || !PutMatch(pos - cand, len, token, &op, end)) {
+        return 0;
+      }
+      pos += len;
+      anchor = pos;
+    }
+  }
+  if (!PutLiterals(src + anchor, src_sz - anchor, &token, &op, end)) {
+    return 0;
+  }
+  return static_cast<size_t>(op - reinterpret_cast<uint8_t *>(dst));
+}
+
+Status LzDecompress(const char *src, size_t src_sz, char *dst, size_t dst_sz) {
+  const auto *in = reinterpret_cast<const uint8_t *>(src);
+  size_t ip = 0;
+  size_t op = 0;
+  while (true) {
+    CHECK_FAIL_RETURN_UNEXPECTED(ip < src_sz, "Data corruption detected. Truncated compressed row.");
+    uint8_t token = in[ip++];
+    size_t lit_len = token >> 4;
+    if (lit_len == kRunMask) {
+      RETURN_IF_NOT_OK(GetLength(in, src_sz, &ip, &lit_len));
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(lit_len <= src_sz - ip && lit_len <= dst_sz - op,
+                                 "Data corruption detected. Literals out of range.");
+    constexpr size_t kShortCopy = 16;
+    if (lit_len <= kShortCopy && src_sz - ip >= kShortCopy && dst_sz - op >= kShortCopy) {
+      // Copy a fixed size instead of calling memcpy for the few bytes, the extra bytes are overwritten later.
+      Copy8(dst + op, src + ip);
+      Copy8(dst + op + sizeof(uint64_t), src + ip + sizeof(uint64_t));
+    } else {
+      (void)memcpy(dst + op, src + ip, lit_len);
+    }
+    ip += lit_len;
+    op += lit_len;
+    // The last sequence has no match.
+    if (ip == src_sz) {
+      break;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(src_sz - ip >= 2, "Data corruption detected. Truncated compressed row.");
+    size_t offset = in[ip] | (static_cast<size_t>(in[ip + 1]) << 8);
+    ip += 2;
+    CHECK_FAIL_RETURN_UNEXPECTED(offset > 0 && offset <= op, "Data corruption detected. Match offset out of range.");
+    size_t match_len = token & kRunMask;
+    if (match_len == kRunMask) {
+      RETURN_IF_NOT_OK(GetLength(in, src_sz, &ip, &match_len));
+    }
+    match_len += kMinMatch;
+    CHECK_FAIL_RETURN_UNEXPECTED(match_len <= dst_sz - op, "Data corruption detected. Match out of range.");
+    char *out = dst + op;
+    const char *match = out - offset;
+    if (offset >= sizeof(uint64_t) && dst_sz - op >= match_len + sizeof(uint64_t)) {
+      for (size_t i = 0; i < match_len; i += sizeof(uint64_t)) {
+        Copy8(out + i, match + i);
+      }
+    } else if (offset >= match_len) {
+      (void)memcpy(out, match, match_len);
+    } else {
+      // The match overlaps the bytes it produces, e.g. a run of the same byte. The output repeats every offset
+      // bytes, so the bytes from match on can be copied in chunks which double each time.
+      size_t copied = 0;
+      while (copied < match_len) {
+        size_t n = std::min(copied + offset, match_len - copied);
+        (void)memcpy(out + copied, match, n);
+        copied += n;
+      }
+    }
+    op += match_len;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(op == dst_sz, "Data corruption detected. Expect " + std::to_string(dst_sz) +
+                                               " bytes but get " + std::to_string(op));
+  return Status::OK();
+}
+
+namespace {
+// Compress a row held in one piece, the header is followed by the compressed bytes.
+bool CompressConsolidatedRow(const char *src, size_t sz, std::string *out) {
+  constexpr size_t kMinSaving = 8;
+  size_t cap = sz - sz / kMinSaving;
+  if (cap <= sizeof(CompressedRowHeader)) {
+    return false;
+  }
+  out->resize(cap);
+  size_t n = LzCompress(src, sz, &(*out)[sizeof(CompressedRowHeader)], cap - sizeof(CompressedRowHeader));
+  if (n == 0) {
+    return false;
+  }
+  CompressedRowHeader header{kCompressedRowMagic, static_cast<uint32_t>(CacheCompressCodec::kLz),
+                             static_cast<int64_t>(sz), static_cast<int64_t>(n)};
+  (void)memcpy(&(*out)[0], &header, sizeof(header));
+  out->resize(sizeof(header) + n);
+  return true;
+}
+}  // namespace
+
+bool CompressRow(const std::vector<ReadableSlice> &buf, std::string *out) {
+  if (buf.size() == 1) {
+    return CompressConsolidatedRow(static_cast<const char *>(buf.front().GetPointer()), buf.front().GetSize(), out);
+  }
+  // The codec needs the row in one piece. Reuse the buffer of the thread to consolidate it, unless a large row grew
+  // it beyond the size of the usual rows.
+  thread_local std::string raw;
+  raw.clear();
+  for (auto &v : buf) {
+    raw.append(static_cast<const char *>(v.GetPointer()), v.GetSize());
+  }
+  bool compressed = CompressConsolidatedRow(raw.data(), raw.size(), out);
+  if (raw.capacity() > kMaxReusedRowSize) {
+    std::string().swap(raw);
+  }
+  return compressed;
+}
+
+bool IsCompressedRow(const ReadableSlice &row) {
+  uint32_t magic = 0;
+  if (row.GetSize() < sizeof(CompressedRowHeader)) {
+    return false;
+  }
+  (void)memcpy(&magic, row.GetPointer(), sizeof(magic));
+  return magic == kCompressedRowMagic;
+}
+
+Status DecompressRow(const ReadableSlice &row, std::vector<char> *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(IsCompressedRow(row), "Not a compressed row");
+  CompressedRowHeader header{};
+  (void)memcpy(&header, row.GetPointer(), sizeof(header));
+  CHECK_FAIL_RETURN_UNEXPECTED(header.codec == static_cast<uint32_t>(CacheCompressCodec::kLz),
+                               "Unknown compression codec: " + std::to_string(header.codec));
+  // A compressed byte never yields more than 255 bytes, anything beyond this is a corrupted size.
+  constexpr int64_t kMaxRatio = 255;
+  auto data_sz = header.data_sz;
+  CHECK_FAIL_RETURN_UNEXPECTED(data_sz >= 0 && data_sz <= static_cast<int64_t>(row.GetSize() - sizeof(header)) &&
+                                 header.raw_sz >= 0 && header.raw_sz / kMaxRatio <= data_sz,
+                               "Data corruption detected. Invalid size of a compressed row.");
+  try {
+    out->resize(header.raw_sz);
+  } catch (const std::bad_alloc &e) {
+    return Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
+  }
+  return LzDecompress(static_cast<const char *>(row.GetPointer()) + sizeof(header), data_sz, out->data(),
+                      out->size());
+}
+}  // namespace dataset
+}  // namespace mindspore
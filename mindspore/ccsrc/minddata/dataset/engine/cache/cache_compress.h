@@ -0,0 +1,83 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_COMPRESS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_COMPRESS_H_
+
+/// This header contains the codec of the compressed memory tier of the cache server. The server compresses a row
+/// when it is cached and the client decompresses it after it is fetched, so the server only ever copies bytes.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "minddata/dataset/util/slice.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Codec of a compressed row
+enum class CacheCompressCodec : uint32_t {
+  kNone = 0,
+  kLz = 1,  ///< The LZ4 block format
+};
+
+/// \brief A compressed row is this header followed by the compressed bytes. A row which is not compressed starts with
+/// the root offset of its TensorRowHeaderMsg, which is a lot smaller than the magic number, so the two are never
+/// mistaken for each other. The fetched rows are padded, so the header also has the size of the compressed bytes.
+struct CompressedRowHeader {
+  uint32_t magic;
+  uint32_t codec;
+  int64_t raw_sz;
+  int64_t data_sz;
+};
+
+constexpr uint32_t kCompressedRowMagic = 0xCAC4E21AU;
+
+/// \brief Compress a buffer in the LZ4 block format.
+/// \param src The buffer to compress
+/// \param src_sz Size of the buffer
+/// \param dst Destination of the compressed bytes
+/// \param dst_cap Capacity of the destination
+/// \return Size of the compressed bytes, or 0 if they don't fit in the destination
+size_t LzCompress(const char *src, size_t src_sz, char *dst, size_t dst_cap);
+
+/// \brief Decompress a buffer in the LZ4 block format. The input is not trusted, any corruption is an error.
+/// \param src The compressed bytes
+/// \param src_sz Size of the compressed bytes
+/// \param dst Destination of the decompressed bytes
+/// \param dst_sz Size of the decompressed bytes, which must be exact
+/// \return Status object
+Status LzDecompress(const char *src, size_t src_sz, char *dst, size_t dst_sz);
+
+/// \brief Compress a row made of a sequence of slices. A row is only compressed if it saves at least one eighth of
+/// its size, the incompressible rows (e.g. encoded images) are cached as they are.
+/// \param[in] buf A sequence of ReadableSlice objects
+/// \param[out] out The compressed row, header included
+/// \return True if the row is compressed
+bool CompressRow(const std::vector<ReadableSlice> &buf, std::string *out);
+
+/// \brief Check if a cached row is compressed
+/// \param row The cached row
+/// \return True if the row starts with a CompressedRowHeader
+bool IsCompressedRow(const ReadableSlice &row);
+
+/// \brief Restore a compressed row
+/// \param[in] row The compressed row, header included, it may be followed by padding
+/// \param[out] out The decompressed row
+/// \return Status object
+Status DecompressRow(const ReadableSlice &row, std::vector<char> *out);
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_COMPRESS_H_
@@ -0,0 +1,179 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "minddata/dataset/engine/cache/cache_policy.h"
+#include <algorithm>
+
+namespace mindspore {
+namespace dataset {
+std::unique_ptr<CacheEvictionPolicy> CacheEvictionPolicy::Create(CacheEvictionType type) {
+  switch (type) {
+    case CacheEvictionType::kLru:
+      return std::make_unique<LruPolicy>();
+    case CacheEvictionType::kClock:
+      return std::make_unique<ClockPolicy>();
+    default:
+      return nullptr;
+  }
+}
+
+void LruPolicy::Add(int64_t key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+  } else {
+    lru_.push_front(key);
+    index_.emplace(key, lru_.begin());
+  }
+}
+
+void LruPolicy::Touch(int64_t key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+  }
+}
+
+void LruPolicy::Remove(int64_t key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    lru_.erase(it->second);
+    index_.erase(it);
+  }
+}
+
+bool LruPolicy::Victim(int64_t *key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (lru_.empty()) {
+    return false;
+  }
+  *key = lru_.back();
+  return true;
+}
+
+void ClockPolicy::Add(int64_t key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    ring_[it->second].referenced = true;
+    return;
+  }
+  size_t slot;
+  if (free_slots_.empty()) {
+    slot = ring_.size();
+    ring_.push_back({key, true, false});
+  } else {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+    ring_[slot] = {key, true, false};
+  }
+  index_.emplace(key, slot);
+}
+
+void ClockPolicy::Touch(int64_t key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    ring_[it->second].referenced = true;
+  }
+}
+
+void ClockPolicy::Remove(int64_t key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    ring_[it->second].used = false;
+    free_slots_.push_back(it->second);
+    index_.erase(it);
+  }
+}
+
+bool ClockPolicy::Victim(int64_t *key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (index_.empty()) {
+    return false;
+  }
+  // Every referenced row is passed over once with its bit cleared, so two turns always find a victim.
+  while (true) {
+    if (hand_ >= ring_.size()) {
+      hand_ = 0;
+    }
+    auto &slot = ring_[hand_];
+    if (slot.used && !slot.referenced) {
+      *key = slot.key;
+      return true;
+    }
+    slot.referenced = false;
+    ++hand_;
+  }
+}
+
+FrequencySketch::FrequencySketch() : counters_(kDepth << kWidthBits, 0), num_samples_(0) {
+  // Halve the counters once the accesses are ten times the width, as TinyLFU does.
+  constexpr int64_t kSampleFactor = 10;
+  sample_period_ = kSampleFactor << kWidthBits;
+}
+
+void FrequencySketch::Index(int64_t key, size_t (&index)[kDepth]) const {
+  // Mix the row id, each row of counters takes its index from a different part of the hash.
+  auto h = static_cast<uint64_t>(key);
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+  h ^= h >> 31;
+  constexpr uint64_t kMask = (1ULL << kWidthBits) - 1;
+  for (int32_t i = 0; i < kDepth; ++i) {
+    index[i] = (static_cast<size_t>(i) << kWidthBits) + ((h >> (i * kWidthBits)) & kMask);
+  }
+}
+
+void FrequencySketch::Increment(int64_t key) {
+  size_t index[kDepth];
+  Index(key, index);
+  std::unique_lock<std::mutex> lck(mux_);
+  // Only the smallest counters are incremented, the others already count more than this row.
+  uint8_t min_count = kMaxCount;
+  for (auto i : index) {
+    min_count = std::min(min_count, counters_[i]);
+  }
+  if (min_count < kMaxCount) {
+    for (auto i : index) {
+      if (counters_[i] == min_count) {
+        ++counters_[i];
+      }
+    }
+  }
+  if (++num_samples_ >= sample_period_) {
+    for (auto &c : counters_) {
+      c >>= 1;
+    }
+    num_samples_ /= 2;
+  }
+}
+
+int32_t FrequencySketch::Estimate(int64_t key) {
+  size_t index[kDepth];
+  Index(key, index);
+  std::unique_lock<std::mutex> lck(mux_);
+  uint8_t min_count = kMaxCount;
+  for (auto i : index) {
+    min_count = std::min(min_count, counters_[i]);
+  }
+  return min_count;
+}
+}  // namespace dataset
+}  // namespace mindspore
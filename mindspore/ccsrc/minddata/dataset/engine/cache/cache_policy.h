@@ -0,0 +1,131 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_POLICY_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_POLICY_H_
+
+/// This header contains the policies of the memory tier of a CachePool: which row to evict when the memory is full,
+/// and whether a new row is worth evicting it at all.
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "minddata/dataset/engine/cache/cache_common.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief An eviction policy keeps track of the rows in memory and picks the next one to evict. It is thread safe.
+class CacheEvictionPolicy {
+ public:
+  virtual ~CacheEvictionPolicy() = default;
+
+  /// \brief Factory
+  /// \param type The policy
+  /// \return The policy, or nullptr for CacheEvictionType::kNone
+  static std::unique_ptr<CacheEvictionPolicy> Create(CacheEvictionType type);
+
+  /// \brief A row is cached in memory
+  virtual void Add(int64_t key) = 0;
+
+  /// \brief A row in memory is fetched
+  virtual void Touch(int64_t key) = 0;
+
+  /// \brief A row is no longer in memory
+  virtual void Remove(int64_t key) = 0;
+
+  /// \brief Pick the row to evict next. The row is still tracked until it is removed.
+  /// \param[out] key The row to evict
+  /// \return False if there is no row in memory
+  virtual bool Victim(int64_t *key) = 0;
+
+  virtual std::string Name() const = 0;
+};
+
+/// \brief Evict the least recently used row
+class LruPolicy : public CacheEvictionPolicy {
+ public:
+  LruPolicy() = default;
+  ~LruPolicy() override = default;
+
+  void Add(int64_t key) override;
+  void Touch(int64_t key) override;
+  void Remove(int64_t key) override;
+  bool Victim(int64_t *key) override;
+  std::string Name() const override { return "LRU"; }
+
+ private:
+  std::mutex mux_;
+  std::list<int64_t> lru_;  // the most recently used row first
+  std::unordered_map<int64_t, std::list<int64_t>::iterator> index_;
+};
+
+/// \brief Approximate LRU with a clock. A fetch only sets the reference bit of the row instead of moving it in a list,
+/// and the hand gives the rows it passes over a second chance by clearing their bit.
+class ClockPolicy : public CacheEvictionPolicy {
+ public:
+  ClockPolicy() : hand_(0) {}
+  ~ClockPolicy() override = default;
+
+  void Add(int64_t key) override;
+  void Touch(int64_t key) override;
+  void Remove(int64_t key) override;
+  bool Victim(int64_t *key) override;
+  std::string Name() const override { return "CLOCK"; }
+
+ private:
+  struct Slot {
+    int64_t key;
+    bool used;
+    bool referenced;
+  };
+  std::mutex mux_;
+  std::vector<Slot> ring_;
+  std::vector<size_t> free_slots_;
+  std::unordered_map<int64_t, size_t> index_;
+  size_t hand_;
+};
+
+/// \brief A count-min sketch of the recent access frequency of the rows, in the manner of TinyLFU. A new row is only
+/// admitted into a full memory if it is accessed more often than the row it would evict. The counters saturate at 15
+/// and are all halved periodically, so the old accesses fade out. It is thread safe.
+class FrequencySketch {
+ public:
+  FrequencySketch();
+  ~FrequencySketch() = default;
+
+  /// \brief Count one access to a row
+  void Increment(int64_t key);
+
+  /// \brief Estimate the number of recent accesses to a row
+  int32_t Estimate(int64_t key);
+
+ private:
+  static constexpr int32_t kDepth = 4;
+  static constexpr int32_t kWidthBits = 16;
+  static constexpr uint8_t kMaxCount = 15;
+  std::mutex mux_;
+  std::vector<uint8_t> counters_;  // kDepth rows of 2^kWidthBits counters
+  int64_t num_samples_;
+  int64_t sample_period_;  // the number of accesses after which the counters are halved
+
+  void Index(int64_t key, size_t (&index)[kDepth]) const;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_POLICY_H_
@@ -14,19 +14,57 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
 #include "utils/ms_utils.h"
+#include "minddata/dataset/engine/cache/cache_compress.h"
 #include "minddata/dataset/engine/cache/cache_pool.h"
 #include "minddata/dataset/engine/cache/cache_server.h"
 #include "minddata/dataset/util/services.h"
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+namespace {
+// The prefetched rows wait in memory for their Read, which is only a few windows of rows later.
+constexpr size_t kStagingMemSize = 64 * 1048576;
+constexpr int32_t kNumPrefetchers = 4;
+constexpr int32_t kPrefetchQueCapacity = 64;
+// A staged row which is not read after so many hints is not going to be read, e.g. the epoch stopped early.
+constexpr uint64_t kMaxHintAge = 1024;
+}  // namespace
+
+CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root, bool compress,
+                     CacheEvictionType eviction, bool admission, int32_t num_spill_writers)
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      sm_(nullptr),
+      num_spill_writers_(num_spill_writers),
+      tree_(nullptr),
+      compress_(compress),
+      compress_bytes_(0),
+      compress_time_ns_(0),
+      policy_(CacheEvictionPolicy::Create(eviction)),
+      sketch_(nullptr),
+      mem_in_use_(0),
+      num_hit_(0),
+      num_miss_(0),
+      num_evicted_(0),
+      warned_no_room_(false),
+      staged_bytes_(0),
+      num_hints_(0),
+      num_prefetched_(0),
+      num_prefetch_hit_(0) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
   min_avail_mem_ = CacheServerHW::GetTotalSystemMemory() * (1.0 - mp_->GetMemoryCapRatio());
+  // The quota is the memory cap of the pool until the server shares the memory among the caches.
+  mem_quota_ = CacheServerHW::GetTotalSystemMemory() * mp_->GetMemoryCapRatio();
+  if (policy_ != nullptr && admission) {
+    sketch_ = std::make_unique<FrequencySketch>();
+  }
 }
 
 Status CachePool::DoServiceStart() {
@@ -35,10 +73,16 @@ Status CachePool::DoServiceStart() {
   if (!root_.toString().empty()) {
     Path spill = GetSpillPath();
     RETURN_IF_NOT_OK(spill.CreateDirectories());
-    auto &cs = CacheServer::GetInstance();
-    sm_ = std::make_shared<StorageManager>(spill, cs.GetNumWorkers());
+    sm_ = std::make_shared<StorageManager>(spill, num_spill_writers_);
     RETURN_IF_NOT_OK(sm_->ServiceStart());
     MS_LOG(INFO) << "CachePool will use disk folder: " << spill.toString();
+    // A few threads read ahead the rows on disk which the clients are going to fetch.
+    prefetch_q_ = std::make_unique<Queue<std::vector<PrefetchRow>>>(kPrefetchQueCapacity);
+    RETURN_IF_NOT_OK(vg_.ServiceStart());
+    RETURN_IF_NOT_OK(prefetch_q_->Register(&vg_));
+    for (auto i = 0; i < kNumPrefetchers; ++i) {
+      RETURN_IF_NOT_OK(vg_.CreateAsyncTask("Spill prefetcher", std::bind(&CachePool::Prefetcher, this)));
+    }
   }
   return Status::OK();
 }
@@ -46,6 +90,14 @@ Status CachePool::DoServiceStart() {
 Status CachePool::DoServiceStop() {
   Status rc;
   Status rc2;
+  // Stop the prefetchers before the storage they read from.
+  rc = vg_.ServiceStop();
+  if (rc.IsError()) {
+    rc2 = rc;
+  }
+  if (num_prefetched_ > 0) {
+    MS_LOG(INFO) << "Rows read ahead from disk: " << num_prefetched_ << ". Taken by a fetch: " << num_prefetch_hit_;
+  }
   if (sm_ != nullptr) {
     rc = sm_->ServiceStop();
     if (rc.IsError()) {
@@ -79,19 +131,43 @@ Status CachePool::DoServiceStop() {
 
 CachePool::~CachePool() noexcept { (void)ServiceStop(); }
 
-Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf) {
+Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlice> &raw_buf) {
   DataLocator bl;
   Status rc;
   size_t sz = 0;
   // We will consolidate all the slices into one piece.
-  for (auto &v : buf) {
+  for (auto &v : raw_buf) {
     sz += v.GetSize();
   }
+  bl.raw_sz = sz;
+  // A compressed row replaces the slices. It is restored by the client, so the fetch path just copies it like any
+  // other row.
+  std::string compressed;
+  std::vector<ReadableSlice> compressed_buf;
+  if (compress_) {
+    auto start = std::chrono::steady_clock::now();
+    if (CompressRow(raw_buf, &compressed)) {
+      compressed_buf.emplace_back(compressed.data(), compressed.size());
+      sz = compressed.size();
+    }
+    auto end = std::chrono::steady_clock::now();
+    compress_bytes_ += bl.raw_sz;
+    compress_time_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  }
+  const std::vector<ReadableSlice> &buf = compressed_buf.empty() ? raw_buf : compressed_buf;
   bl.sz = sz;
+  bool admit = true;
+  if (policy_ != nullptr) {
+    // The room is reserved from here on, it is given back if the row is not kept in memory.
+    RETURN_IF_NOT_OK(MakeRoom(key, sz, &admit));
+  }
   // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
   // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
   // than the lower bound. (The default is 20% of physical RAM)
-  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
+  if (!admit) {
+    // The row is colder than the rows in memory, it is treated like a row which doesn't fit.
+    rc = Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
+  } else if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
     MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
                     << ". The cache server will not cache any more data.";
     rc = Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
@@ -103,7 +179,13 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
       temp_mem_usage_ = 0;
     }
   }
+  if (rc.IsError() && policy_ != nullptr && admit) {
+    mem_in_use_ -= sz;
+  }
   if (rc.IsOk()) {
+    if (policy_ == nullptr) {
+      mem_in_use_ += sz;
+    }
     temp_mem_usage_ += sz;
     // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
     if (CacheServerHW::numa_enabled()) {
@@ -126,6 +208,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     }
     if (rc.IsError()) {
       mp_->Deallocate(bl.ptr);
+      mem_in_use_ -= sz;
       bl.ptr = nullptr;
       return rc;
     }
@@ -133,7 +216,16 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     // If no memory, write to disk.
     if (sm_ != nullptr) {
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
-      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
+      rc = sm_->Write(&bl.storage_key, buf);
+      // With eviction, a row which has no room anywhere is not cached. It is looked up as a miss.
+      if (rc == StatusCode::kMDNoSpace && policy_ != nullptr) {
+        WarnNoRoom(key, rc);
+        return Status::OK();
+      }
+      RETURN_IF_NOT_OK(rc);
+    } else if (policy_ != nullptr) {
+      WarnNoRoom(key, rc);
+      return Status::OK();
     } else {
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
@@ -148,16 +240,115 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   } catch (const std::bad_alloc &e) {
     rc = Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
   }
+  if (rc == StatusCode::kMDDuplicateKey && policy_ != nullptr) {
+    // The row may have been dropped from the cache, in which case it is cached again.
+    rc = Reinsert(key, bl);
+  }
   // Duplicate key is treated as error and we will also free the memory.
   if (rc.IsError() && bl.ptr != nullptr) {
     mp_->Deallocate(bl.ptr);
+    mem_in_use_ -= bl.sz;
     bl.ptr = nullptr;
     return rc;
   }
+  if (rc.IsOk() && bl.ptr != nullptr && policy_ != nullptr) {
+    policy_->Add(key);
+  }
   return rc;
 }
 
-Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
+Status CachePool::MakeRoom(CachePool::key_type key, size_t sz, bool *admit) {
+  std::unique_lock<std::mutex> lck(evict_mux_);
+  *admit = true;
+  while (mem_in_use_ + sz > mem_quota_) {
+    key_type victim = 0;
+    if (!policy_->Victim(&victim)) {
+      // Nothing left to evict, the row is bigger than the quota.
+      *admit = false;
+      break;
+    }
+    if (sketch_ != nullptr && sketch_->Estimate(key) <= sketch_->Estimate(victim)) {
+      *admit = false;
+      break;
+    }
+    RETURN_IF_NOT_OK(Evict(victim));
+  }
+  if (*admit) {
+    mem_in_use_ += sz;
+  }
+  return Status::OK();
+}
+
+Status CachePool::EvictOverQuota() {
+  if (policy_ == nullptr || mem_in_use_ <= mem_quota_) {
+    return Status::OK();
+  }
+  std::unique_lock<std::mutex> lck(evict_mux_, std::try_to_lock);
+  if (!lck.owns_lock()) {
+    return Status::OK();
+  }
+  key_type victim = 0;
+  while (mem_in_use_ > mem_quota_ && policy_->Victim(&victim)) {
+    RETURN_IF_NOT_OK(Evict(victim));
+  }
+  return Status::OK();
+}
+
+void CachePool::WarnNoRoom(CachePool::key_type key, const Status &rc) {
+  if (!warned_no_room_.exchange(true)) {
+    MS_LOG(WARNING) << "The cache has no room left in memory nor on disk, the new rows which don't fit are not cached "
+                    << "and are looked up as a miss. " << rc.ToString();
+  }
+  MS_LOG(DEBUG) << "Row " << key << " is not cached. " << rc.ToString();
+}
+
+Status CachePool::Evict(CachePool::key_type key) {
+  DataLocator bl;
+  {
+    auto r = tree_->Search(key);
+    if (r.second) {
+      bl = r.first.value();
+    }
+  }
+  policy_->Remove(key);
+  if (bl.ptr == nullptr) {
+    return Status::OK();
+  }
+  DataLocator moved(bl);
+  moved.ptr = nullptr;
+  moved.node_hit = false;
+  Status rc = Status(StatusCode::kMDNoSpace, __LINE__, __FILE__);
+  if (sm_ != nullptr) {
+    rc = sm_->Write(&moved.storage_key, {ReadableSlice(bl.ptr, bl.sz)});
+  }
+  if (rc.IsError()) {
+    MS_LOG(DEBUG) << "Drop row " << key << " from the cache. " << rc.ToString();
+    // A dropped row keeps a locator of size 0. It is looked up as a miss and it can be cached again.
+    moved.sz = 0;
+    moved.raw_sz = 0;
+    moved.storage_key = 0;
+  }
+  // The readers copy a row under the lock of its leaf, the update waits for them before the memory is freed.
+  (void)tree_->DoUpdate(key, moved);
+  mp_->Deallocate(bl.ptr);
+  mem_in_use_ -= bl.sz;
+  ++num_evicted_;
+  return Status::OK();
+}
+
+Status CachePool::Reinsert(CachePool::key_type key, const DataLocator &bl) {
+  std::unique_lock<std::mutex> lck(evict_mux_);
+  {
+    auto r = tree_->Search(key);
+    if (!r.second || r.first->sz > 0) {
+      return Status(StatusCode::kMDDuplicateKey, __LINE__, __FILE__);
+    }
+  }
+  (void)tree_->DoUpdate(key, bl);
+  return Status::OK();
+}
+
+Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) {
   RETURN_UNEXPECTED_IF_NULL(dest);
   auto r = tree_->Search(key);
   if (r.second) {
@@ -165,7 +356,7 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
     if (it->ptr != nullptr) {
       ReadableSlice src(it->ptr, it->sz);
       RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
-    } else if (sm_ != nullptr) {
+    } else if (sm_ != nullptr && it->sz > 0 && !ReadStagedRow(key, dest)) {
       size_t expectedLength = 0;
       RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
       if (expectedLength != it->sz) {
@@ -183,6 +374,144 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
   return Status::OK();
 }
 
+Status CachePool::FetchRow(CachePool::key_type key, WritableSlice *dest) {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  size_t sz = dest->GetSize();
+  size_t bytesRead = 0;
+  RETURN_IF_NOT_OK(Read(key, dest, &bytesRead));
+  if (bytesRead == 0 && HasEviction() && sz >= sizeof(kEvictedRowMagic)) {
+    (void)memcpy(dest->GetMutablePointer(), &kEvictedRowMagic, sizeof(kEvictedRowMagic));
+    return Status::OK();
+  }
+  if (bytesRead != sz) {
+    std::string errMsg = "Unexpected length. Read " + std::to_string(bytesRead) + ". Expected " + std::to_string(sz) +
+                         "." + " Internal key: " + std::to_string(key);
+    MS_LOG(ERROR) << errMsg;
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+  return Status::OK();
+}
+
+bool CachePool::ReadStagedRow(CachePool::key_type key, WritableSlice *dest) {
+  if (prefetch_q_ == nullptr) {
+    return false;
+  }
+  std::string data;
+  {
+    std::unique_lock<std::mutex> lck(staging_mux_);
+    auto it = staged_.find(key);
+    if (it == staged_.end()) {
+      return false;
+    }
+    // A read in flight is abandoned, the prefetcher finds the row gone and throws it away.
+    data = std::move(it->second.data);
+    staged_bytes_ -= it->second.sz;
+    staged_.erase(it);
+  }
+  if (data.empty() || !WritableSlice::Copy(dest, ReadableSlice(data.data(), data.size())).IsOk()) {
+    return false;
+  }
+  ++num_prefetch_hit_;
+  return true;
+}
+
+Status CachePool::Prefetch(const std::vector<CachePool::key_type> &keys) {
+  if (prefetch_q_ == nullptr) {
+    return Status::OK();
+  }
+  // Only the rows on disk are read ahead. Their locators don't change, the rows are never moved back to memory.
+  std::vector<PrefetchRow> rows;
+  rows.reserve(keys.size());
+  for (auto key : keys) {
+    auto r = tree_->Search(key);
+    if (r.second && r.first->ptr == nullptr && r.first->sz > 0) {
+      rows.push_back({key, r.first->storage_key, r.first->sz});
+    }
+  }
+  if (rows.empty()) {
+    return Status::OK();
+  }
+  std::unique_lock<std::mutex> hint_lck(hint_mux_);
+  if (prefetch_q_->size() == prefetch_q_->capacity()) {
+    // The prefetchers are busy, the rows would come too late anyway.
+    return Status::OK();
+  }
+  std::vector<PrefetchRow> batch;
+  batch.reserve(rows.size());
+  {
+    std::unique_lock<std::mutex> lck(staging_mux_);
+    ++num_hints_;
+    DropStaleRows();
+    for (auto &row : rows) {
+      if (staged_bytes_ + row.sz > kStagingMemSize) {
+        break;
+      }
+      if (staged_.emplace(row.key, StagedRow{std::string(), row.sz, num_hints_}).second) {
+        staged_order_.emplace_back(num_hints_, row.key);
+        staged_bytes_ += row.sz;
+        batch.push_back(row);
+      }
+    }
+  }
+  if (batch.empty()) {
+    return Status::OK();
+  }
+  // The hints are serialized and the queue is not full, so this doesn't block.
+  return prefetch_q_->Add(std::move(batch));
+}
+
+void CachePool::DropStaleRows() {
+  while (!staged_order_.empty()) {
+    auto &front = staged_order_.front();
+    auto it = staged_.find(front.second);
+    if (it != staged_.end() && it->second.hint == front.first) {
+      if (front.first + kMaxHintAge > num_hints_) {
+        break;
+      }
+      staged_bytes_ -= it->second.sz;
+      staged_.erase(it);
+    }
+    staged_order_.pop_front();
+  }
+}
+
+Status CachePool::Prefetcher() {
+  TaskManager::FindMe()->Post();
+  while (true) {
+    std::vector<PrefetchRow> batch;
+    RETURN_IF_NOT_OK(prefetch_q_->PopFront(&batch));
+    // Read in the order of the storage, the rows of a window are often written close to each other.
+    std::sort(batch.begin(), batch.end(),
+              [](const PrefetchRow &a, const PrefetchRow &b) { return a.storage_key < b.storage_key; });
+    for (auto &row : batch) {
+      {
+        std::unique_lock<std::mutex> lck(staging_mux_);
+        if (staged_.find(row.key) == staged_.end()) {
+          continue;
+        }
+      }
+      std::string data(row.sz, '\0');
+      WritableSlice dest(&data[0], row.sz);
+      size_t bytes_read = 0;
+      Status rc = sm_->Read(row.storage_key, &dest, &bytes_read);
+      std::unique_lock<std::mutex> lck(staging_mux_);
+      auto it = staged_.find(row.key);
+      if (it == staged_.end() || !it->second.data.empty()) {
+        continue;
+      }
+      if (rc.IsError() || bytes_read != row.sz) {
+        // Leave it to the fetch, which reads the row again and reports the error.
+        MS_LOG(DEBUG) << "Failed to read ahead row " << row.key << ". " << rc.ToString();
+        staged_bytes_ -= it->second.sz;
+        staged_.erase(it);
+        continue;
+      }
+      it->second.data = std::move(data);
+      ++num_prefetched_;
+    }
+  }
+}
+
 Path CachePool::GetSpillPath() const {
   auto spill = Path(root_) / subfolder_;
   return spill;
@@ -190,14 +519,27 @@ Path CachePool::GetSpillPath() const {
 
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   tree_->LockShared();  // Prevent any node split while we search.
-  CacheStat cs{-1, -1, 0, 0, 0, 0};
+  CacheStat cs{-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
   int64_t total_sz = 0;
+  int64_t total_raw_sz = 0;
   if (tree_->begin() != tree_->end()) {
-    cs.min_key = tree_->begin().key();
-    cs.max_key = cs.min_key;  // will adjust later.
     for (auto it = tree_->begin(); it != tree_->end(); ++it) {
       it.LockShared();
+      // A row dropped by the eviction is not cached.
+      if (it.value().sz == 0) {
+        it.Unlock();
+        continue;
+      }
+      auto cur_key = it.key();
+      if (cs.num_mem_cached + cs.num_disk_cached == 0) {
+        cs.min_key = cur_key;
+        cs.max_key = cur_key;  // will adjust later.
+      }
       total_sz += it.value().sz;
+      total_raw_sz += it.value().raw_sz;
+      if (it.value().raw_sz > it.value().sz) {
+        ++cs.num_compressed;
+      }
       if (it.value().ptr != nullptr) {
         ++cs.num_mem_cached;
       } else {
@@ -206,7 +548,6 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
       if (it.value().node_hit) {
         ++cs.num_numa_hit;
       }
-      auto cur_key = it.key();
       if (GetMissingKeys) {
         for (auto i = cs.max_key + 1; i < cur_key; ++i) {
           cs.gap.push_back((i));
@@ -224,26 +565,58 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     }
   }
   tree_->Unlock();
+  cs.total_raw_sz = total_raw_sz;
+  cs.total_cache_sz = total_sz;
+  // bytes per microsecond is MB/s
+  constexpr uint64_t kNsPerUs = 1000;
+  uint64_t compress_time_us = compress_time_ns_ / kNsPerUs;
+  if (compress_time_us > 0) {
+    cs.compress_throughput = static_cast<int64_t>(compress_bytes_ / compress_time_us);
+  }
+  cs.num_hit = num_hit_;
+  cs.num_miss = num_miss_;
+  cs.num_evicted = num_evicted_;
+  cs.num_prefetched = num_prefetched_;
+  cs.num_prefetch_hit = num_prefetch_hit_;
   return cs;
 }
 
 Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb,
                                  flatbuffers::Offset<DataLocatorMsg> *out) const {
   RETURN_UNEXPECTED_IF_NULL(out);
-  auto r = tree_->Search(key);
-  if (r.second) {
-    auto &it = r.first;
-    DataLocatorMsgBuilder bld(*fbb);
-    bld.add_key(key);
-    bld.add_size(it->sz);
-    bld.add_node_id(it->node_id);
-    bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
-    auto offset = bld.Finish();
-    *out = offset;
+  bool hit = false;
+  bool in_memory = false;
+  {
+    auto r = tree_->Search(key);
+    // A row dropped by the eviction has a locator of size 0, which is a miss.
+    if (r.second) {
+      auto &it = r.first;
+      hit = it->sz > 0;
+      in_memory = it->ptr != nullptr;
+      DataLocatorMsgBuilder bld(*fbb);
+      bld.add_key(key);
+      bld.add_size(it->sz);
+      bld.add_node_id(it->node_id);
+      // A row which can be evicted must be read under its lock, the address is not given out.
+      bld.add_addr(HasEviction() ? 0 : reinterpret_cast<int64_t>(it->ptr));
+      auto offset = bld.Finish();
+      *out = offset;
+    } else {
+      // Key not in the cache.
+      auto offset = CreateDataLocatorMsg(*fbb, key, 0, 0, 0);
+      *out = offset;
+    }
+  }
+  if (hit) {
+    ++num_hit_;
   } else {
-    // Key not in the cache.
-    auto offset = CreateDataLocatorMsg(*fbb, key, 0, 0, 0);
-    *out = offset;
+    ++num_miss_;
+  }
+  if (in_memory && policy_ != nullptr) {
+    policy_->Touch(key);
+  }
+  if (sketch_ != nullptr) {
+    sketch_->Increment(key);
   }
   return Status::OK();
 }
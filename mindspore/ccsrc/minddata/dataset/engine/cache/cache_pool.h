@@ -16,17 +16,23 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "minddata/dataset/engine/cache/cache_common.h"
 #include "minddata/dataset/engine/cache/cache_numa.h"
+#include "minddata/dataset/engine/cache/cache_policy.h"
 #include "minddata/dataset/engine/cache/storage_manager.h"
 #include "minddata/dataset/util/allocator.h"
+#include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/service.h"
 #include "minddata/dataset/util/slice.h"
+#include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/auto_index.h"
 #include "minddata/dataset/util/btree.h"
 
@@ -48,35 +54,40 @@ class CachePool : public Service {
   // An internal class to locate the whereabouts of a backed up buffer which can be either in
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator() : ptr(nullptr), sz(0), raw_sz(0), node_id(0), node_hit(false), storage_key(0) {}
     ~DataLocator() = default;
     DataLocator(const DataLocator &other) = default;
     DataLocator &operator=(const DataLocator &other) = default;
     DataLocator(DataLocator &&other) noexcept {
       ptr = other.ptr;
       sz = other.sz;
+      raw_sz = other.raw_sz;
       node_id = other.node_id;
       node_hit = other.node_hit;
       storage_key = other.storage_key;
       other.ptr = nullptr;
       other.sz = 0;
+      other.raw_sz = 0;
       other.storage_key = 0;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
         ptr = other.ptr;
         sz = other.sz;
+        raw_sz = other.raw_sz;
         node_id = other.node_id;
         node_hit = other.node_hit;
         storage_key = other.storage_key;
         other.ptr = nullptr;
         other.sz = 0;
+        other.raw_sz = 0;
         other.storage_key = 0;
       }
       return *this;
     }
     pointer ptr;
     size_t sz;
+    size_t raw_sz;      // size of the row before compression, same as sz if it is not compressed
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
     StorageManager::key_type storage_key;
@@ -95,13 +106,30 @@ class CachePool : public Service {
     int64_t num_disk_cached;
     int64_t average_cache_sz;
     int64_t num_numa_hit;
+    int64_t num_compressed;
+    int64_t total_raw_sz;         // bytes of the rows before compression
+    int64_t total_cache_sz;       // bytes the rows take in memory and on disk
+    int64_t compress_throughput;  // MB/s of the compression of the rows
+    int64_t num_hit;              // lookups of the rows which are cached
+    int64_t num_miss;             // lookups of the rows which are not cached, or evicted
+    int64_t num_evicted;          // rows evicted from memory, to disk if possible
+    int64_t num_prefetched;       // rows read ahead from disk
+    int64_t num_prefetch_hit;     // rows read ahead from disk and then taken by a Read
     std::vector<key_type> gap;
   };
 
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "");
+  /// \param compress Keep the rows compressed in memory and on disk. The client restores them after fetching.
+  /// \param eviction The policy to evict the rows from memory once it is full. The evicted rows are moved to disk if
+  /// there is a spill path, or else dropped and looked up as a miss. The disk tier has no eviction, the StorageManager
+  /// is append-only: the rows on disk stay there, and once it is full the evicted rows are dropped.
+  /// \param admission Only admit a new row into a full memory if it is accessed more often than the row to evict.
+  /// \param num_spill_writers Number of the files the spill path writes to at once, the server gives one per worker.
+  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "", bool compress = false,
+                     CacheEvictionType eviction = CacheEvictionType::kNone, bool admission = false,
+                     int32_t num_spill_writers = 1);
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -125,9 +153,22 @@ class CachePool : public Service {
   /// \brief Restore a cached buffer (from memory or disk)
   /// \param[in] key A previous key returned from Insert
   /// \param[out] dest The cached buffer will be copied to this destination represented by a WritableSlice
-  /// \param[out] bytesRead Optional. Number of bytes read.
+  /// \param[out] bytesRead Optional. Number of bytes read, 0 if the buffer has been evicted.
   /// \return Error code
-  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
+  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr);
+
+  /// \brief Copy a row into the reply of a batch fetch. A row which is evicted after the fetch is planned is replaced
+  /// by kEvictedRowMagic, which the client takes as a miss.
+  /// \param[in] key The row
+  /// \param[out] dest The place of the row in the reply, of the size the row had when the fetch is planned
+  /// \return Error code
+  Status FetchRow(key_type key, WritableSlice *dest);
+
+  /// \brief Read the buffers spilled to disk ahead of their Read. They are kept in a staging area, which the next
+  /// Read of the buffer takes them from. The hint is dropped if the readers are too far behind.
+  /// \param[in] keys The buffers which are going to be read next, in the order of the reads
+  /// \return Error code
+  Status Prefetch(const std::vector<key_type> &keys);
 
   /// \brief Serialize a DataLocator
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
@@ -139,6 +180,25 @@ class CachePool : public Service {
 
   std::string MyName() const { return subfolder_; }
 
+  bool IsCompressed() const { return compress_; }
+
+  /// \brief If the rows are evicted from memory once it is full. The rows in memory may then be moved or freed at
+  /// any time, so they must be read through Read which holds the lock of the row.
+  bool HasEviction() const { return policy_ != nullptr; }
+
+  /// \brief Set the amount of memory the rows may take before they are evicted. Nothing is evicted here, the rows
+  /// beyond a lower quota are evicted by the next insert or by EvictOverQuota.
+  /// \param quota Memory size in bytes
+  void SetMemoryQuota(uint64_t quota) { mem_quota_ = quota; }
+
+  /// \brief Evict the rows from memory until they are within the quota. It returns at once if another thread is
+  /// evicting.
+  /// \return Status object
+  Status EvictOverQuota();
+
+  /// \brief Memory taken by the rows
+  uint64_t GetMemoryInUse() const { return mem_in_use_; }
+
   /// \brief Toggle locking
   /// \note Once locking is off. It is user's responsibility to ensure concurrency
   void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
@@ -148,12 +208,73 @@ class CachePool : public Service {
   Path root_;
   const std::string subfolder_;
   std::shared_ptr<StorageManager> sm_;
+  int32_t num_spill_writers_;
   std::shared_ptr<data_index> tree_;
+  bool compress_;
+  std::atomic<uint64_t> compress_bytes_;    // bytes of the rows given to the compressor
+  std::atomic<uint64_t> compress_time_ns_;  // time spent in the compressor
+  std::unique_ptr<CacheEvictionPolicy> policy_;
+  std::unique_ptr<FrequencySketch> sketch_;  // the admission filter, if any
+  std::mutex evict_mux_;                     // serialize the evictions and the updates of the dropped rows
+  std::atomic<uint64_t> mem_quota_;
+  std::atomic<uint64_t> mem_in_use_;
+  mutable std::atomic<int64_t> num_hit_;
+  mutable std::atomic<int64_t> num_miss_;
+  std::atomic<int64_t> num_evicted_;
+  std::atomic<bool> warned_no_room_;  // a row with no room in memory nor on disk is reported once
+  // A buffer read ahead from disk, until it is taken by Read. An empty data means the read is still in flight.
+  struct StagedRow {
+    std::string data;
+    size_t sz;
+    uint64_t hint;  // the hint which asked for it
+  };
+  struct PrefetchRow {
+    key_type key;
+    StorageManager::key_type storage_key;
+    size_t sz;
+  };
+  TaskGroup vg_;
+  std::unique_ptr<Queue<std::vector<PrefetchRow>>> prefetch_q_;
+  std::mutex hint_mux_;  // serialize the hints, so adding to the queue never blocks
+  std::mutex staging_mux_;
+  std::unordered_map<key_type, StagedRow> staged_;
+  std::deque<std::pair<uint64_t, key_type>> staged_order_;  // the staged rows by hint, oldest first
+  size_t staged_bytes_;
+  uint64_t num_hints_;
+  std::atomic<int64_t> num_prefetched_;
+  std::atomic<int64_t> num_prefetch_hit_;
   std::atomic<uint64_t> soft_mem_limit_;  // the available memory in the machine
   std::atomic<uint64_t> temp_mem_usage_;  // temporary count on the amount of memory usage by cache every 100Mb (because
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
   uint64_t min_avail_mem_;                // lower bound of the available memory
   const int kMemoryCapAdjustInterval = 104857600;
+
+  /// \brief Evict the rows from memory until the quota has room for a new row, and reserve the room. The reservation
+  /// is made under evict_mux_, so the concurrent inserts never take more than the quota together.
+  /// \param[in] key The new row
+  /// \param[in] sz Size of the new row
+  /// \param[out] admit False if the new row is colder than the row to evict, nothing is reserved then
+  /// \return Status object
+  Status MakeRoom(key_type key, size_t sz, bool *admit);
+
+  /// \brief Move a row from memory to disk, or drop it if there is no room on disk. Called with evict_mux_ held.
+  Status Evict(key_type key);
+
+  /// \brief Insert a row again after it is dropped
+  Status Reinsert(key_type key, const DataLocator &bl);
+
+  /// \brief Report a row which is not cached because there is no room for it in memory nor on disk
+  void WarnNoRoom(key_type key, const Status &rc);
+
+  /// \brief Main loop of the threads reading the prefetched rows from disk
+  Status Prefetcher();
+
+  /// \brief Take a row from the staging area
+  /// \return True if the row is copied to dest
+  bool ReadStagedRow(key_type key, WritableSlice *dest);
+
+  /// \brief Drop the staged rows which are not read long after their hint. Called with staging_mux_ held.
+  void DropStaleRows();
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -24,6 +24,7 @@
 #include <thread>
 #include "minddata/dataset/include/dataset/constants.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
+#include "minddata/dataset/engine/cache/cache_compress.h"
 #include "minddata/dataset/engine/cache/cache_fbb.h"
 namespace mindspore {
 namespace dataset {
@@ -152,6 +153,19 @@ BatchFetchRequest::BatchFetchRequest(const CacheClient *cc, const std::vector<ro
   rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
 }
 
+PrefetchRowsRequest::PrefetchRowsRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id)
+    : BaseRequest(RequestType::kPrefetchRows) {
+  rq_.set_connection_id(cc->server_connection_id_);
+  rq_.set_client_id(cc->client_id_);
+  flatbuffers::FlatBufferBuilder fbb;
+  auto off_t = fbb.CreateVector(row_id);
+  TensorRowIdsBuilder bld(fbb);
+  bld.add_row_id(off_t);
+  auto off = bld.Finish();
+  fbb.Finish(off);
+  rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
+}
+
 Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr) {
   RETURN_UNEXPECTED_IF_NULL(out);
   auto num_elements = row_id_.size();
@@ -176,12 +190,18 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
   TensorTable tbl;
   tbl.reserve(num_elements);
   ReadableSlice all(ptr, sz);
+  // The rows which the server keeps compressed are restored here, one at a time.
+  std::vector<char> raw_row;
   for (auto i = 0; i < num_elements; ++i) {
     auto len = offset_array[i + 1] - offset_array[i];
     TensorRow row;
     row.setId(row_id_.at(i));
-    if (len > 0) {
+    if (len > 0 && !IsEvictedRow(ptr + offset_array[i], len)) {
       ReadableSlice row_data(all, offset_array[i], len);
+      if (IsCompressedRow(row_data)) {
+        RETURN_IF_NOT_OK(DecompressRow(row_data, &raw_row));
+        row_data = ReadableSlice(raw_row.data(), raw_row.size());
+      }
       // Next we de-serialize flat buffer to get back each column
       auto msg = GetTensorRowHeaderMsg(row_data.GetPointer());
       auto msg_sz = msg->size_of_this();
@@ -197,7 +217,8 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
         ts_offset += data.GetSize();
       }
     } else {
-      CHECK_FAIL_RETURN_UNEXPECTED(len == 0, "Data corruption detected.");
+      // An evicted row is a miss like a row which is not cached.
+      CHECK_FAIL_RETURN_UNEXPECTED(len >= 0, "Data corruption detected.");
     }
     tbl.push_back(std::move(row));
   }
@@ -303,6 +324,13 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.num_compressed = msg->num_compressed();
+  stat_.total_raw_sz = msg->total_raw_sz();
+  stat_.total_cache_sz = msg->total_cache_sz();
+  stat_.compress_throughput = msg->compress_throughput();
+  stat_.num_hit = msg->num_hit();
+  stat_.num_miss = msg->num_miss();
+  stat_.num_evicted = msg->num_evicted();
   return Status::OK();
 }
 
@@ -331,6 +359,13 @@ Status ListSessionsRequest::PostReply() {
     stats.min_row_id = current_session_info->stats()->min_row_id();
     stats.max_row_id = current_session_info->stats()->max_row_id();
     stats.cache_service_state = current_session_info->stats()->state();
+    stats.num_compressed = current_session_info->stats()->num_compressed();
+    stats.total_raw_sz = current_session_info->stats()->total_raw_sz();
+    stats.total_cache_sz = current_session_info->stats()->total_cache_sz();
+    stats.compress_throughput = current_session_info->stats()->compress_throughput();
+    stats.num_hit = current_session_info->stats()->num_hit();
+    stats.num_miss = current_session_info->stats()->num_miss();
+    stats.num_evicted = current_session_info->stats()->num_evicted();
     current_info.stats = stats;  // fixed length struct.  = operator is safe
     session_info_list_.push_back(current_info);
   }
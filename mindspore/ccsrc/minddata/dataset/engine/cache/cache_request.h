@@ -42,6 +42,13 @@ struct CacheServiceStat {
   int64_t num_disk_cached;
   int64_t avg_cache_sz;
   int64_t num_numa_hit;
+  int64_t num_compressed;
+  int64_t total_raw_sz;
+  int64_t total_cache_sz;
+  int64_t compress_throughput;
+  int64_t num_hit;
+  int64_t num_miss;
+  int64_t num_evicted;
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
@@ -87,6 +94,7 @@ class BaseRequest {
     kBatchCacheRows = 19,
     kInternalCacheRow = 20,
     kGetCacheState = 21,
+    kPrefetchRows = 22,
     // Add new request before it.
     kRequestUnknown = 32767
   };
@@ -136,7 +144,7 @@ class BaseRequest {
   bool IsRowRequest() const {
     return type_ == RequestType::kBatchCacheRows || type_ == RequestType::kBatchFetchRows ||
            type_ == RequestType::kInternalCacheRow || type_ == RequestType::kInternalFetchRow ||
-           type_ == RequestType::kCacheRow;
+           type_ == RequestType::kCacheRow || type_ == RequestType::kPrefetchRows;
   }
 
   /// \brief Return if the request is of admin request type
@@ -240,11 +248,28 @@ class BatchFetchRequest : public BaseRequest {
   std::vector<row_id_type> row_id_;
 };
 
+/// \brief A hint of the rows the client is going to fetch next. The server reads the ones it spilled to disk ahead
+/// of the fetch. There is nothing to wait for, the client just sends it.
+class PrefetchRowsRequest : public BaseRequest {
+ public:
+  friend class CacheServer;
+  PrefetchRowsRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id);
+  ~PrefetchRowsRequest() override = default;
+};
+
 /// \brief Request to create a cache for the current connection
 class CreateCacheRequest : public BaseRequest {
  public:
   friend class CacheServer;
-  enum class CreateCacheFlag : uint32_t { kNone = 0, kSpillToDisk = 1, kGenerateRowId = 1u << 1L };
+  enum class CreateCacheFlag : uint32_t {
+    kNone = 0,
+    kSpillToDisk = 1,
+    kGenerateRowId = 1u << 1L,
+    kCompress = 1u << 2L,
+    kEvictLru = 1u << 3L,
+    kEvictClock = 1u << 4L,
+    kFrequencyAdmission = 1u << 5L
+  };
 
   /// \brief Constructor
   /// \param connection_id
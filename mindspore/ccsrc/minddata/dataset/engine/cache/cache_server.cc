@@ -154,6 +154,11 @@ Status CacheServer::GlobalMemoryCheck(uint64_t cache_mem_sz) {
   int64_t max_avail = avail_mem;
   while (it != end) {
     auto &cs = it->second;
+    // A cache with unlimited size which evicts rows gives back its memory for a share.
+    if (cs->HasEviction() && cs->cache_mem_sz_ == 0) {
+      ++it;
+      continue;
+    }
     CacheService::ServiceStat stat;
     RETURN_IF_NOT_OK(cs->GetStat(&stat));
     int64_t mem_consumed = stat.stat_.num_mem_cached * stat.stat_.average_cache_sz;
@@ -181,6 +186,32 @@ Status CacheServer::GlobalMemoryCheck(uint64_t cache_mem_sz) {
   return Status::OK();
 }
 
+void CacheServer::ShareMemory() {
+  int64_t avail_mem = CacheServerHW::GetTotalSystemMemory() * memory_cap_ratio_;
+  int64_t num_shares = 0;
+  for (auto const &it : all_caches_) {
+    auto &cs = it.second;
+    if (!cs->HasEviction()) {
+      avail_mem -= static_cast<int64_t>(cs->GetMemoryInUse());
+    } else if (cs->cache_mem_sz_ > 0) {
+      avail_mem -= static_cast<int64_t>(cs->cache_mem_sz_);
+    } else {
+      ++num_shares;
+    }
+  }
+  if (num_shares == 0) {
+    return;
+  }
+  uint64_t share = avail_mem > 0 ? avail_mem / num_shares : 0;
+  for (auto const &it : all_caches_) {
+    auto &cs = it.second;
+    if (cs->HasEviction() && cs->cache_mem_sz_ == 0) {
+      MS_LOG(INFO) << "Cache " << it.first << " may use " << share << " bytes of memory before it evicts rows.";
+      cs->SetMemoryQuota(share);
+    }
+  }
+}
+
 Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   CHECK_FAIL_RETURN_UNEXPECTED(rq->has_connection_info(), "Missing connection info");
   std::string cookie;
@@ -209,6 +240,21 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
     (flag & CreateCacheRequest::CreateCacheFlag::kSpillToDisk) == CreateCacheRequest::CreateCacheFlag::kSpillToDisk;
   bool generate_id =
     (flag & CreateCacheRequest::CreateCacheFlag::kGenerateRowId) == CreateCacheRequest::CreateCacheFlag::kGenerateRowId;
+  bool compress =
+    (flag & CreateCacheRequest::CreateCacheFlag::kCompress) == CreateCacheRequest::CreateCacheFlag::kCompress;
+  auto eviction = CacheEvictionType::kNone;
+  if ((flag & CreateCacheRequest::CreateCacheFlag::kEvictLru) == CreateCacheRequest::CreateCacheFlag::kEvictLru) {
+    eviction = CacheEvictionType::kLru;
+  } else if ((flag & CreateCacheRequest::CreateCacheFlag::kEvictClock) ==
+             CreateCacheRequest::CreateCacheFlag::kEvictClock) {
+    eviction = CacheEvictionType::kClock;
+  }
+  bool admission = (flag & CreateCacheRequest::CreateCacheFlag::kFrequencyAdmission) ==
+                   CreateCacheRequest::CreateCacheFlag::kFrequencyAdmission;
+  if (generate_id && eviction != CacheEvictionType::kNone) {
+    // A non-mappable dataset is read from the cache only, every row must stay.
+    MS_LOG(WARNING) << "Eviction is ignored by the cache of a non-mappable dataset.";
+  }
   if (spill && top_.empty()) {
     RETURN_STATUS_UNEXPECTED("Server is not set up with spill support.");
   }
@@ -233,11 +279,12 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
     RETURN_IF_NOT_OK(GlobalMemoryCheck(cache_mem_sz));
     std::unique_ptr<CacheService> cs;
     try {
-      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id);
+      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id, compress, eviction, admission);
       RETURN_IF_NOT_OK(cs->ServiceStart());
       cookie = cs->cookie();
       client_id = cs->num_clients_.fetch_add(1);
       all_caches_.emplace(connection_id, std::move(cs));
+      ShareMemory();
     } catch (const std::bad_alloc &e) {
       return Status(StatusCode::kMDOutOfMemory);
     }
@@ -283,6 +330,7 @@ Status CacheServer::DestroyCache(CacheRequest *rq) {
       // It has been destroyed by another duplicate request.
       MS_LOG(INFO) << "Duplicate request for " + std::to_string(id) + " to create cache service";
     }
+    ShareMemory();
   }
   // We aren't touching the session list even though we may be dropping the last remaining cache of a session.
   // Leave that to be done by the drop session command.
@@ -558,6 +606,26 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
   return Status::OK();
 }
 
+Status CacheServer::PrefetchRows(CacheRequest *rq) {
+  auto connection_id = rq->connection_id();
+  // Hold the shared lock to prevent the cache from being dropped.
+  SharedLock lck(&rwLock_);
+  CacheService *cs = GetService(connection_id);
+  if (cs == nullptr) {
+    std::string errMsg = "Cache id " + std::to_string(connection_id) + " not found";
+    return Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__, errMsg);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(!rq->buf_data().empty(), "Missing row id");
+  auto p = flatbuffers::GetRoot<TensorRowIds>(rq->buf_data(0).data());
+  std::vector<row_id_type> row_id;
+  auto sz = p->row_id()->size();
+  row_id.reserve(sz);
+  for (uint32_t i = 0; i < sz; ++i) {
+    row_id.push_back(p->row_id()->Get(i));
+  }
+  return cs->PrefetchRows(row_id);
+}
+
 Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
   auto connection_id = rq->connection_id();
   // Hold the shared lock to prevent the cache from being dropped.
@@ -578,6 +646,13 @@ Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.stat_.max_key);
     bld.add_min_row_id(svc_stat.stat_.min_key);
     bld.add_state(svc_stat.state_);
+    bld.add_num_compressed(svc_stat.stat_.num_compressed);
+    bld.add_total_raw_sz(svc_stat.stat_.total_raw_sz);
+    bld.add_total_cache_sz(svc_stat.stat_.total_cache_sz);
+    bld.add_compress_throughput(svc_stat.stat_.compress_throughput);
+    bld.add_num_hit(svc_stat.stat_.num_hit);
+    bld.add_num_miss(svc_stat.stat_.num_miss);
+    bld.add_num_evicted(svc_stat.stat_.num_evicted);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -709,9 +784,12 @@ Status CacheServer::ListSessions(CacheReply *reply) {
         auto &cs = it.second;
         CacheService::ServiceStat svc_stat;
         RETURN_IF_NOT_OK(cs->GetStat(&svc_stat));
-        auto current_stats = CreateServiceStatMsg(fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached,
-                                                  svc_stat.stat_.average_cache_sz, svc_stat.stat_.num_numa_hit,
-                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_);
+        auto current_stats = CreateServiceStatMsg(
+          fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached, svc_stat.stat_.average_cache_sz,
+          svc_stat.stat_.num_numa_hit, svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_,
+          svc_stat.stat_.num_compressed, svc_stat.stat_.total_raw_sz, svc_stat.stat_.total_cache_sz,
+          svc_stat.stat_.compress_throughput, svc_stat.stat_.num_hit, svc_stat.stat_.num_miss,
+          svc_stat.stat_.num_evicted);
         auto current_session_info = CreateListSessionMsg(fbb, current_session_id, current_conn_id, current_stats);
         session_msgs_vector.push_back(current_session_info);
       }
@@ -828,6 +906,10 @@ Status CacheServer::ProcessRowRequest(CacheServerRequest *cache_req, bool *inter
       cache_req->rc_ = BatchFetchRows(&rq, &reply);
       break;
     }
+    case BaseRequest::RequestType::kPrefetchRows: {
+      cache_req->rc_ = PrefetchRows(&rq);
+      break;
+    }
     case BaseRequest::RequestType::kInternalFetchRow: {
       *internal_request = true;
       cache_req->rc_ = InternalFetchRow(&rq);
@@ -1079,6 +1161,9 @@ Status CacheServer::DestroySession(CacheRequest *rq) {
       ++it;
     }
   }
+  if (found) {
+    ShareMemory();
+  }
   // Finally remove the session itself
   auto n = active_sessions_.erase(drop_session_id);
   if (n > 0) {
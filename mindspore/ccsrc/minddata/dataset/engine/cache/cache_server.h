@@ -315,6 +315,12 @@ class CacheServer : public Service {
   /// \return Status object
   Status GlobalMemoryCheck(uint64_t cache_mem_sz);
 
+  /// \brief Share the memory among the caches which evict rows. A cache with a size keeps it, and the rest of the
+  /// memory cap is divided evenly among the caches with unlimited size. It is done whenever a cache is created or
+  /// destroyed, with the lock of the cache list held. It only sets the quotas, a cache evicts the rows beyond its
+  /// quota in its own requests.
+  void ShareMemory();
+
   /// \brief Create a cache service. We allow multiple clients to create the same cache service.
   /// Subsequent duplicate requests are ignored. The first cache client to create the service will be given
   /// a special unique cookie.
@@ -469,6 +475,11 @@ class CacheServer : public Service {
   /// \return Status object
   Status BatchFetchRows(CacheRequest *rq, CacheReply *reply);
 
+  /// \brief Internal function to read ahead the spilled rows a client is going to fetch
+  /// \param rq Request
+  /// \return Status object
+  Status PrefetchRows(CacheRequest *rq);
+
   /// \brief Main function to fetch rows in batch. The output is a contiguous memory which will be decoded
   /// by the CacheClient. Cache miss is not an error, and will be coded in the output to mark an empty row.
   /// \param[in] v A vector of row id.
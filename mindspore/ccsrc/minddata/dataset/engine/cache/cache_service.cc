@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
 */
+#include <cstring>
 #include <random>
 #include "minddata/dataset/engine/cache/cache_service.h"
 #include "minddata/dataset/engine/cache/cache_server.h"
@@ -22,12 +23,16 @@
 
 namespace mindspore {
 namespace dataset {
-CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id)
+CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id, bool compress,
+                           CacheEvictionType eviction, bool admission)
     : root_(root),
       cache_mem_sz_(mem_sz * 1048576L),  // mem_sz is in MB unit
       cp_(nullptr),
       next_id_(0),
       generate_id_(generate_id),
+      compress_(compress),
+      eviction_(generate_id ? CacheEvictionType::kNone : eviction),
+      admission_(admission),
       num_clients_(0),
       st_(generate_id ? CacheServiceState::kBuildPhase : CacheServiceState::kNone) {}
 
@@ -53,7 +58,7 @@ Status CacheService::DoServiceStart() {
     RETURN_STATUS_UNEXPECTED("Unable to bring up numa memory pool");
   }
   // Put together a CachePool for backing up the Tensor.
-  cp_ = std::make_shared<CachePool>(numa_pool_, root_);
+  cp_ = std::make_shared<CachePool>(numa_pool_, root_, compress_, eviction_, admission_, cs.GetNumWorkers());
   RETURN_IF_NOT_OK(cp_->ServiceStart());
   // Assign a name to this cache. Used for exclusive connection. But we can just use CachePool's name.
   cookie_ = cp_->MyName();
@@ -204,6 +209,16 @@ std::ostream &operator<<(std::ostream &out, const CacheService &cs) {
   } else {
     out << cs.GetSpillPath();
   }
+  out << "\nCompression: " << std::boolalpha << cs.compress_;
+  out << "\nEviction: ";
+  if (cs.eviction_ == CacheEvictionType::kLru) {
+    out << "LRU";
+  } else if (cs.eviction_ == CacheEvictionType::kClock) {
+    out << "CLOCK";
+  } else {
+    out << "None";
+  }
+  out << "\nFrequency admission: " << std::boolalpha << (cs.HasEviction() && cs.admission_);
   return out;
 }
 
@@ -240,6 +255,11 @@ Status CacheService::PreBatchFetch(connection_id_type connection_id, const std::
     RETURN_STATUS_UNEXPECTED("Can't accept fetch request in non-fetch phase. Current phase: " +
                              std::to_string(static_cast<int>(st_.load())));
   }
+  // Give back the memory beyond the share of this cache, e.g. after another cache is created. Nothing is evicted
+  // once the locking is off, the rows are read with no lock.
+  if (st_ != CacheServiceState::kNoLocking) {
+    RETURN_IF_NOT_OK(cp_->EvictOverQuota());
+  }
   std::vector<flatbuffers::Offset<DataLocatorMsg>> datalocator_v;
   datalocator_v.reserve(v.size());
   for (auto row_id : v) {
@@ -256,10 +276,17 @@ Status CacheService::PreBatchFetch(connection_id_type connection_id, const std::
   return Status::OK();
 }
 
+Status CacheService::PrefetchRows(const std::vector<row_id_type> &v) {
+  SharedLock rw(&rw_lock_);
+  if (HasBuildPhase() && st_ != CacheServiceState::kFetchPhase) {
+    return Status::OK();
+  }
+  return cp_->Prefetch(v);
+}
+
 Status CacheService::InternalFetchRow(const FetchRowMsg *p) {
   RETURN_UNEXPECTED_IF_NULL(p);
   SharedLock rw(&rw_lock_);
-  size_t bytesRead = 0;
   int64_t key = p->key();
   size_t sz = p->size();
   void *source_addr = reinterpret_cast<void *>(p->source_addr());
@@ -271,13 +298,7 @@ Status CacheService::InternalFetchRow(const FetchRowMsg *p) {
     ReadableSlice src(source_addr, sz);
     RETURN_IF_NOT_OK(WritableSlice::Copy(&dest, src));
   } else {
-    RETURN_IF_NOT_OK(cp_->Read(key, &dest, &bytesRead));
-    if (bytesRead != sz) {
-      std::string errMsg = "Unexpected length. Read " + std::to_string(bytesRead) + ". Expected " + std::to_string(sz) +
-                           "." + " Internal key: " + std::to_string(key);
-      MS_LOG(ERROR) << errMsg;
-      RETURN_STATUS_UNEXPECTED(errMsg);
-    }
+    RETURN_IF_NOT_OK(cp_->FetchRow(key, &dest));
   }
   return Status::OK();
 }
@@ -327,6 +348,13 @@ Status CacheService::BuildPhaseDone() {
   }
 }
 
+void CacheService::SetMemoryQuota(uint64_t quota) {
+  SharedLock rw(&rw_lock_);
+  if (cp_ != nullptr) {
+    cp_->SetMemoryQuota(quota);
+  }
+}
+
 Status CacheService::ToggleWriteMode(bool on_off) {
   UniqueLock rw(&rw_lock_);
   if (HasBuildPhase()) {
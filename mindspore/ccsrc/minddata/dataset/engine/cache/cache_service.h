@@ -49,7 +49,12 @@ class CacheService : public Service {
   /// \param root Spill path. Empty string means no spilling
   /// \param generate_id If the cache service should generate row id for buffer that is cached.
   /// For non-mappable dataset, this should be set to true.
-  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id);
+  /// \param compress If the rows are kept compressed. The client decompresses them after fetching.
+  /// \param eviction The policy to evict the rows from memory once it is full. Not for a cache with a build phase,
+  /// which must keep all the rows.
+  /// \param admission If the new rows are only admitted into a full memory if they are hotter than the rows to evict
+  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id, bool compress = false,
+               CacheEvictionType eviction = CacheEvictionType::kNone, bool admission = false);
   ~CacheService() override;
 
   Status DoServiceStart() override;
@@ -75,6 +80,12 @@ class CacheService : public Service {
   Status PreBatchFetch(connection_id_type connection_id, const std::vector<row_id_type> &v,
                        const std::shared_ptr<flatbuffers::FlatBufferBuilder> &);
 
+  /// \brief Read the rows spilled to disk ahead of their fetch. It is only a hint, rows which are not spilled or
+  /// can't be fetched yet are ignored.
+  /// \param v A vector of row id
+  /// \return Status object
+  Status PrefetchRows(const std::vector<row_id_type> &v);
+
   /// \brief Getter function
   /// \return Spilling path
   Path GetSpillPath() const;
@@ -123,6 +134,14 @@ class CacheService : public Service {
   Status BuildPhaseDone();
   /// \brief For kToggleWriteMode request
   Status ToggleWriteMode(bool on_off);
+  /// \brief If the rows are evicted once the memory is full
+  bool HasEviction() const { return eviction_ != CacheEvictionType::kNone; }
+  /// \brief Set the share of the server memory this cache may use before it evicts the rows. The rows beyond a
+  /// lower share are evicted by the next requests of this cache, not by the caller.
+  /// \param quota Memory size in bytes
+  void SetMemoryQuota(uint64_t quota);
+  /// \brief Memory taken by the rows
+  uint64_t GetMemoryInUse() const { return cp_ == nullptr ? 0 : cp_->GetMemoryInUse(); }
 
  private:
   mutable RWLock rw_lock_;
@@ -131,6 +150,9 @@ class CacheService : public Service {
   std::shared_ptr<CachePool> cp_;
   std::atomic<row_id_type> next_id_;
   bool generate_id_;
+  bool compress_;
+  CacheEvictionType eviction_;
+  bool admission_;
   std::string cookie_;
   std::atomic<int32_t> num_clients_;
   std::atomic<CacheServiceState> st_;
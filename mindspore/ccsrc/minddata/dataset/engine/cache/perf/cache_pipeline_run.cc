@@ -374,8 +374,15 @@ Status CachePipelineRun::RunReadEpoch() {
     std::shuffle(all_keys.begin(), all_keys.end(), GetRandomDevice());
   }
 
+  // Like the cache ops, hint the server with the rows coming next so it can read the spilled ones ahead.
+  const auto window = std::max<size_t>(cc_->GetPrefetchSize(), 1);
   int32_t worker_id = 0;
-  for (auto id : all_keys) {
+  for (size_t i = 0; i < all_keys.size(); ++i) {
+    auto id = all_keys[i];
+    if (cc_->isSpill() && i % window == 0) {
+      auto last = all_keys.begin() + std::min(i + window, all_keys.size());
+      (void)cc_->PrefetchRows(std::vector<row_id_type>(all_keys.begin() + i, last));
+    }
     keys.push_back(id);
     auto blk = std::make_unique<IOBlock>(IOBlock(keys, IOBlock::kDeIoBlockNone));
     RETURN_IF_NOT_OK(io_block_queues_[worker_id++ % num_workers]->Add(std::move(blk)));
@@ -167,6 +167,27 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
   }
 }
 
+bool BatchOp::IsBatchOfSlots(const TensorQTable &rows, size_t col, std::shared_ptr<Tensor> *batch) {
+  auto first = rows.front().at(col);
+  const auto &owner = first->BatchOfSlot();
+  if (owner == nullptr || owner->shape()[0] != static_cast<dsize_t>(rows.size())) {
+    return false;
+  }
+  // Row j must be slot j of the batch, with the same shape and type as the other rows.
+  dsize_t slot_size = owner->SizeInBytes() / owner->shape()[0];
+  dsize_t j = 0;
+  for (const auto &row : rows) {
+    const auto &t = row.at(col);
+    if (t->BatchOfSlot() != owner || t->GetBuffer() != owner->GetBuffer() + j * slot_size ||
+        t->shape() != first->shape() || t->type() != first->type()) {
+      return false;
+    }
+    ++j;
+  }
+  *batch = owner;
+  return true;
+}
+
 Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size) {
   if ((*src)->size() != batch_size) {
     RETURN_STATUS_UNEXPECTED("[Internal ERROR] Source table size does not match the batch_size.");
@@ -190,7 +211,9 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *d
     TensorShape new_shape = first_shape.PrependDim(static_cast<int64_t>(batch_size));
 
     std::shared_ptr<Tensor> new_tensor;
-    if (first_type.IsNumeric()) {  // numeric tensor
+    if (first_type.IsNumeric() && IsBatchOfSlots(**src, i, &new_tensor)) {
+      // The rows were written into their slots of the batch by the MapOp before, there is nothing to copy.
+    } else if (first_type.IsNumeric()) {  // numeric tensor
       RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
       dsize_t j = 0;
       for (auto row : **src) {
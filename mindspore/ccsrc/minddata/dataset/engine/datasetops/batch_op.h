@@ -200,6 +200,13 @@ class BatchOp : public ParallelOp {
   // @return Status The status code returned
   static Status BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size);
 
+  // check if a column of the rows is made of the slots of one batch tensor, in order
+  // @param const TensorQTable &rows rows to batch
+  // @param size_t col the column
+  // @param std::shared_ptr<Tensor> *batch the batch tensor the column of the rows are the slots of, in order
+  // @return bool true if the column of the rows is a batch already, see MapOp::SetFusedBatchSize
+  static bool IsBatchOfSlots(const TensorQTable &rows, size_t col, std::shared_ptr<Tensor> *batch);
+
   // @param table
   // @param const PadInfo &pad_info pad info
   // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
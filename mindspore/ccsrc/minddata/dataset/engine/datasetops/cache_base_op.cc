@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "minddata/dataset/engine/datasetops/cache_base_op.h"
+#include <deque>
 #include <iomanip>
 #include <iostream>
 #include <utility>
@@ -21,6 +22,11 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// The number of windows of rows the cache server is told about before they are fetched
+constexpr size_t kPrefetchHintWindows = 2;
+}  // namespace
+
 // A print method typically used for debugging
 void CacheBase::Print(std::ostream &out, bool show_all) const {
   if (!show_all) {
@@ -79,6 +85,32 @@ Status CacheBase::FetchSamplesToWorkers() {
     RETURN_IF_NOT_OK(qList[worker_id]->Add(std::move(blk)));
     return Status::OK();
   };
+  // Send a window of rows to a prefetcher, and tell the WorkerEntry to wait for them to come back.
+  auto dispatch = [this, &send_to_que, &prefetch_cnt, &buf_cnt](std::vector<row_id_type> &window) -> Status {
+    RETURN_IF_NOT_OK(send_to_que(prefetch_queues_, prefetch_cnt++ % num_prefetchers_, window));
+    std::vector<row_id_type> keys(1);
+    for (auto row_id : window) {
+      keys[0] = row_id;
+      RETURN_IF_NOT_OK(send_to_que(io_block_queues_, buf_cnt++ % num_workers_, keys));
+    }
+    return Status::OK();
+  };
+  // If the cache spills to disk, the server is told about a window of rows kPrefetchHintWindows windows before it is
+  // dispatched, so the rows on disk are read while the windows before it are fetched.
+  const size_t lookahead = cache_client_->isSpill() ? kPrefetchHintWindows : 0;
+  std::deque<std::vector<row_id_type>> hinted_windows;
+  auto send_window = [this, &dispatch, &hinted_windows, lookahead](std::vector<row_id_type> *window) -> Status {
+    if (lookahead > 0) {
+      (void)cache_client_->PrefetchRows(*window);
+    }
+    hinted_windows.push_back(std::move(*window));
+    window->clear();
+    while (hinted_windows.size() > lookahead) {
+      RETURN_IF_NOT_OK(dispatch(hinted_windows.front()));
+      hinted_windows.pop_front();
+    }
+    return Status::OK();
+  };
   // Instead of sending sampler id to WorkerEntry, we send them to the Prefetcher which will redirect them
   // to the WorkerEntry.
   do {
@@ -89,8 +121,6 @@ Status CacheBase::FetchSamplesToWorkers() {
     num_cache_miss_ = 0;
     row_cnt_ = 0;
     ++wait_cnt;
-    std::vector<row_id_type> keys;
-    keys.reserve(1);
     std::vector<row_id_type> prefetch_keys;
     prefetch_keys.reserve(prefetch_size_);
     TensorRow sample_row;
@@ -102,29 +132,19 @@ Status CacheBase::FetchSamplesToWorkers() {
         prefetch_keys.push_back(*itr);
         // Batch enough rows for performance reason.
         if (row_cnt_ % prefetch_size_ == 0) {
-          RETURN_IF_NOT_OK(send_to_que(prefetch_queues_, prefetch_cnt++ % num_prefetchers_, prefetch_keys));
-          // Now we tell the WorkerEntry to wait for them to come back.
-          for (auto row_id : prefetch_keys) {
-            keys.push_back(row_id);
-            RETURN_IF_NOT_OK(send_to_que(io_block_queues_, buf_cnt++ % num_workers_, keys));
-            keys.clear();
-          }
-          prefetch_keys.clear();
+          RETURN_IF_NOT_OK(send_window(&prefetch_keys));
+          prefetch_keys.reserve(prefetch_size_);
         }
       }
       RETURN_IF_NOT_OK(sampler_->GetNextSample(&sample_row));
     }
-    // Deal with any partial keys left.
+    // Deal with any partial keys left, and the windows still waiting for their turn.
     if (!prefetch_keys.empty()) {
-      RETURN_IF_NOT_OK(send_to_que(prefetch_queues_, prefetch_cnt++ % num_prefetchers_, prefetch_keys));
-      for (auto row_id : prefetch_keys) {
-        keys.push_back(row_id);
-        RETURN_IF_NOT_OK(send_to_que(io_block_queues_, buf_cnt++ % num_workers_, keys));
-        keys.clear();
-      }
+      RETURN_IF_NOT_OK(send_window(&prefetch_keys));
     }
-    if (!keys.empty()) {
-      RETURN_IF_NOT_OK(send_to_que(io_block_queues_, buf_cnt++ % num_workers_, keys));
+    while (!hinted_windows.empty()) {
+      RETURN_IF_NOT_OK(dispatch(hinted_windows.front()));
+      hinted_windows.pop_front();
     }
     // send the eoe
     RETURN_IF_NOT_OK(
@@ -187,6 +187,10 @@ Status CacheOp::WaitForCachingAllRows() {
   MS_LOG(INFO) << "Number of rows cached in memory : " << stat.num_mem_cached;
   MS_LOG(INFO) << "Number of rows spilled to disk : " << stat.num_disk_cached;
   MS_LOG(INFO) << "Average cache size : " << stat.avg_cache_sz;
+  if (stat.num_compressed > 0) {
+    MS_LOG(INFO) << "Number of rows compressed : " << stat.num_compressed << ", " << stat.total_raw_sz << " bytes in "
+                 << stat.total_cache_sz << " bytes, compressed at " << stat.compress_throughput << " MB/s";
+  }
   // Now all rows are cached and we have done a sync point check up. Next phase is
   // is pick up fetch input from sampler and pass up to the caller.
   RETURN_IF_NOT_OK(sampler_->HandshakeRandomAccessOp(this));
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <utility>
@@ -33,15 +34,49 @@ CpuMapJob::CpuMapJob(std::vector<std::shared_ptr<TensorOp>> operations) : MapJob
 // Destructor
 CpuMapJob::~CpuMapJob() = default;
 
+// A function to execute a cpu map job on a block of rows at once
+Status CpuMapJob::RunBatch(const std::vector<TensorRow> &in, std::vector<TensorRow> *out) {
+  std::vector<TensorRow> input_table;
+  std::vector<TensorRow> result_table;
+  for (size_t i = 0; i < ops_.size(); i++) {
+    result_table.clear();
+    const std::vector<TensorRow> &op_in = i == 0 ? in : input_table;
+    if (i + 1 == ops_.size() && !output_slots_.empty()) {
+      // The last operation creates the outputs of each row on the slots of that row.
+      for (size_t row = 0; row < op_in.size(); row++) {
+        TensorRow result_row;
+        RETURN_IF_NOT_OK(ops_[i]->ComputeInSlots(op_in[row], &result_row, OutputSlots(row)));
+        result_table.push_back(std::move(result_row));
+      }
+    } else {
+      RETURN_IF_NOT_OK(ops_[i]->BatchCompute(op_in, &result_table));
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(result_table.size() == in.size(),
+                                 "map operation: [" + ops_[i]->Name() + "] returns a wrong number of rows.");
+    input_table = std::move(result_table);
+  }
+  *out = std::move(input_table);
+  return Status::OK();
+}
+
 // A function to execute a cpu map job
 Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
+  if (in.size() > 1 && !ops_.empty() &&
+      std::all_of(ops_.begin(), ops_.end(), [](const auto &op) { return op->SupportBatch(); })) {
+    if (RunBatch(in, out).IsOk()) {
+      return Status::OK();
+    }
+    // Run the rows one by one again, so the error tells which operation and data file fail.
+    out->clear();
+  }
   int32_t num_rows = in.size();
   for (int32_t row = 0; row < num_rows; row++) {
     TensorRow input_row = in[row];
     TensorRow result_row;
     for (size_t i = 0; i < ops_.size(); i++) {
-      // Call compute function for cpu
-      Status rc = ops_[i]->Compute(input_row, &result_row);
+      // Call compute function for cpu. The last one creates the outputs on the slots of the row if it has some.
+      Status rc = i + 1 == ops_.size() ? ops_[i]->ComputeInSlots(input_row, &result_row, OutputSlots(row))
+                                       : ops_[i]->Compute(input_row, &result_row);
       if (rc.IsError()) {
         std::string err_msg = "";
         std::string op_name = ops_[i]->Name();
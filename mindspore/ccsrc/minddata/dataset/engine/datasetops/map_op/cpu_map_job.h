@@ -35,6 +35,13 @@ class CpuMapJob : public MapJob {
 
   // A pure virtual run function to execute a cpu map job
   Status Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) override;
+
+ private:
+  // Run each TensorOp on all the rows at once, if all of them support BatchCompute
+  // @param in The rows to be processed
+  // @param out The result rows
+  // @return Status The status code returned
+  Status RunBatch(const std::vector<TensorRow> &in, std::vector<TensorRow> *out);
 };
 
 }  // namespace dataset
@@ -17,6 +17,7 @@
 #define DATASET_ENGINE_DATASETOPS_MAP_OP_MAP_JOB_H_
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/core/tensor.h"
@@ -45,8 +46,17 @@ class MapJob {
   // A pure virtual run function to execute a particular map job
   virtual Status Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) = 0;
 
+  // The outputs of the last operation on the i-th row are created on slots[i], see TensorOp::ComputeInSlots
+  void SetOutputSlots(std::vector<Tensor::BatchSlots> slots) { output_slots_ = std::move(slots); }
+
  protected:
+  // @return the output slots of a row, nullptr if it has none
+  Tensor::BatchSlots *OutputSlots(size_t row) {
+    return row < output_slots_.size() ? &output_slots_[row] : nullptr;
+  }
+
   std::vector<std::shared_ptr<TensorOp>> ops_;
+  std::vector<Tensor::BatchSlots> output_slots_;
 };
 
 }  // namespace dataset
@@ -37,7 +37,10 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
     : ParallelOp(num_workers, op_connector_size),
       tfuncs_(std::move(tensor_funcs)),
       in_columns_(in_col_names),
-      out_columns_(out_col_names) {
+      out_columns_(out_col_names),
+      batch_compute_(false),
+      fused_batch_size_(0),
+      num_written_in_slot_(0) {
   // Set connector size via config.
   // If caller didn't specify the out_col_names, assume they are same as the in_columns.
   if (out_columns_.empty() || out_columns_[0].empty()) {
@@ -75,17 +78,31 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
 }
 
 // A helper function that fetch worker map job from local queues and extract the data and map job list
-Status MapOp::FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list) {
+Status MapOp::FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list,
+                            BatchSlot *slot) {
   std::unique_ptr<MapWorkerJob> worker_job;
   // Fetch the next worker job and TensorRow
   RETURN_IF_NOT_OK(local_queues_[worker_id]->PopFront(&worker_job));
   // Extract the TensorRow and job list from the map worker job.
   *row = std::move(worker_job->tensor_row);
   *job_list = std::move(worker_job->jobs);
+  *slot = worker_job->slot;
 
   return Status::OK();
 }
 
+bool MapOp::TryFetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list,
+                             BatchSlot *slot) {
+  std::unique_ptr<MapWorkerJob> worker_job;
+  if (!local_queues_[worker_id]->TryPopFront(&worker_job)) {
+    return false;
+  }
+  *row = std::move(worker_job->tensor_row);
+  *job_list = std::move(worker_job->jobs);
+  *slot = worker_job->slot;
+  return true;
+}
+
 Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job) {
   std::shared_ptr<MapJob> map_job = nullptr;
   MapTargetDevice prev_target = MapTargetDevice::kCpu;
@@ -128,6 +145,8 @@ Status MapOp::operator()() {
     return rc;
   }
 
+  batch_compute_ = !tfuncs_.empty() && std::all_of(tfuncs_.begin(), tfuncs_.end(),
+                                                   [](const auto &op) { return op->SupportBatch(); });
   // The operator class just starts off threads by calling the tree_ function
   rc =
     tree_->LaunchWorkers(num_workers_, std::bind(&MapOp::WorkerEntry, this, std::placeholders::_1), NameWithID(), id());
@@ -136,6 +155,9 @@ Status MapOp::operator()() {
   RETURN_IF_NOT_OK(rc);
   // num_rows received, including eoe, num_epoch, num_step of current epoch
   int64_t num_rows = 0, ep_step = 0, total_step = 0;
+  // The slot of the next row if the rows are written into the batches of the next op. A batch ends at an eoe.
+  BatchSlot next_slot;
+  next_slot.batch_id = 0;
 
   RETURN_IF_NOT_OK(callback_manager_.Begin(CallbackParam(0, ep_step, total_step)));
 
@@ -158,6 +180,13 @@ Status MapOp::operator()() {
 
       // Populate map worker job for a worker to execute
       RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
+      if (fused_batch_size_ > 0) {
+        worker_job->slot = next_slot;
+        if (++next_slot.index == fused_batch_size_) {
+          ++next_slot.batch_id;
+          next_slot.index = 0;
+        }
+      }
 
       // Push map worker job to the corresponding worker's queue
       RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(worker_job)));
@@ -173,6 +202,11 @@ Status MapOp::operator()() {
 
       ep_step = 0;
     }
+    if (next_slot.index > 0) {
+      EndFusedBatch(next_slot);
+      ++next_slot.batch_id;
+      next_slot.index = 0;
+    }
     // Propagate the eoe row to worker
     std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
     RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(worker_job)));
@@ -204,8 +238,13 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
 
   TensorRow in_row;
   std::vector<std::shared_ptr<MapJob>> job_list;
+  std::vector<TensorRow> in_rows;
+  std::vector<TensorRow> out_rows;
+  std::vector<std::shared_ptr<MapJob>> next_job_list;
+  BatchSlot slot;
+  std::vector<BatchSlot> slots;
   // Fetch next data row and map job list
-  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
+  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list, &slot));
 
   // Now that init work is done, drop into the main fetching loop.
   // Map op does not use child iterator, and it needs to manually handle eoe and eof's itself
@@ -229,44 +268,77 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
       } else if (in_row.quit()) {
         break;
       }
-      RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
+      RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list, &slot));
       continue;
     }
     CHECK_FAIL_RETURN_UNEXPECTED(in_row.size() != 0, "MapOp got an empty TensorRow.");
-    TensorRow out_row;
+    in_rows.clear();
+    in_rows.push_back(std::move(in_row));
+    slots.clear();
+    slots.push_back(slot);
+    // Take the rows already waiting in the local queue as one block. The rows of a worker are consecutive in its
+    // output, so pushing the block in order keeps the order of the rows.
+    bool fetched = false;
+    while (batch_compute_ && in_rows.size() < kMaxBlockRows) {
+      fetched = TryFetchNextWork(worker_id, &in_row, &next_job_list, &slot);
+      if (!fetched || in_row.Flags() != TensorRow::kFlagNone || in_row.size() == 0) {
+        break;
+      }
+      in_rows.push_back(std::move(in_row));
+      slots.push_back(slot);
+      fetched = false;
+    }
+    out_rows.clear();
+    if (fused_batch_size_ > 0 && !job_list.empty()) {
+      // The last TensorOp writes the outputs of the rows into their slots.
+      std::vector<Tensor::BatchSlots> output_slots(slots.size());
+      for (size_t i = 0; i < slots.size(); ++i) {
+        RETURN_IF_NOT_OK(GetFusedBatchSlots(slots[i], &output_slots[i]));
+      }
+      job_list.back()->SetOutputSlots(std::move(output_slots));
+    }
     // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
-    RETURN_IF_NOT_OK(WorkerCompute(in_row, &out_row, job_list));
-    // Push the row onto the connector for next operator to consume.
-    RETURN_IF_NOT_OK(out_connector_->Add(std::move(out_row), static_cast<int>(worker_id)));
-    // Fetch next data row and map job list
-    RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
+    RETURN_IF_NOT_OK(WorkerCompute(&in_rows, &out_rows, job_list));
+    // Push the rows onto the connector for next operator to consume.
+    for (size_t i = 0; i < out_rows.size(); ++i) {
+      if (slots[i].batch_id >= 0) {
+        RETURN_IF_NOT_OK(PlaceInBatch(slots[i], &out_rows[i]));
+      }
+      RETURN_IF_NOT_OK(out_connector_->Add(std::move(out_rows[i]), static_cast<int>(worker_id)));
+    }
+    // The row which ends the block is handled next, otherwise fetch next data row and map job list
+    if (fetched) {
+      job_list = std::move(next_job_list);
+    } else {
+      RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list, &slot));
+    }
   }
   return Status::OK();
 }
 
-Status MapOp::WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
+Status MapOp::WorkerCompute(std::vector<TensorRow> *in_rows, std::vector<TensorRow> *out_rows,
                             const std::vector<std::shared_ptr<MapJob>> &job_list) {
-  int32_t num_cols = in_row.size();
-
   std::vector<TensorRow> job_input_table;
-  std::vector<TensorRow> original_table;
-  TensorRow to_process;
-  // Prepare the data that we need from in_row
-  // to_process   : A vector of Tensors only holding cols in input_columns.
-
-  // From the current row, select the Tensor that need to be passed to TensorOp
-  (void)std::transform(to_process_indices_.begin(), to_process_indices_.end(), std::back_inserter(to_process),
-                       [&in_row](const auto &it) { return std::move(in_row[it]); });
-  to_process.setId(in_row.getId());
-  std::vector<std::string> cur_row_path = in_row.getPath();
-  if (cur_row_path.size() > 0) {
-    std::vector<std::string> to_process_path;
-    (void)std::transform(to_process_indices_.begin(), to_process_indices_.end(), std::back_inserter(to_process_path),
-                         [&cur_row_path](const auto &it) { return cur_row_path[it]; });
-    to_process.setPath(to_process_path);
+  job_input_table.reserve(in_rows->size());
+  for (const auto &in_row : *in_rows) {
+    TensorRow to_process;
+    // Prepare the data that we need from in_row
+    // to_process   : A vector of Tensors only holding cols in input_columns.
+
+    // From the current row, select the Tensor that need to be passed to TensorOp
+    (void)std::transform(to_process_indices_.begin(), to_process_indices_.end(), std::back_inserter(to_process),
+                         [&in_row](const auto &it) { return in_row[it]; });
+    to_process.setId(in_row.getId());
+    const std::vector<std::string> &cur_row_path = in_row.getPath();
+    if (cur_row_path.size() > 0) {
+      std::vector<std::string> to_process_path;
+      (void)std::transform(to_process_indices_.begin(), to_process_indices_.end(),
+                           std::back_inserter(to_process_path),
+                           [&cur_row_path](const auto &it) { return cur_row_path[it]; });
+      to_process.setPath(to_process_path);
+    }
+    job_input_table.push_back(std::move(to_process));
   }
-  job_input_table.push_back(std::move(to_process));
-  original_table.push_back(std::move(in_row));
 
   // Variable to keep the result after executing the job.
   std::vector<TensorRow> result_table;
@@ -281,31 +353,145 @@ Status MapOp::WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
     }
   }
 
-  // Sanity check a row in result_table
+  // Sanity check the rows in result_table
+  CHECK_FAIL_RETURN_UNEXPECTED(result_table.size() == in_rows->size(), "Result of a tensorOp misses some rows");
   if (!result_table.empty() && out_columns_.size() != result_table[0].size()) {
     RETURN_STATUS_UNEXPECTED("Result of a tensorOp doesn't match output column names");
   }
 
   // Merging the data processed by job (result_table) with the data that are not used.
-  if (in_columns_.size() == out_columns_.size()) {
-    // Place the processed tensor back into the original index of the input tensor
-    for (size_t i = 0; i < result_table[0].size(); i++) {
-      original_table[0][to_process_indices_[i]] = std::move(result_table[0][i]);
-    }
-    *out_row = std::move(original_table[0]);
-  } else {
-    // Append the data in the original table that we did not use to the end of each row in result_table.
-    for (int32_t i = 0; i < num_cols; i++) {
-      if (keep_input_columns_[i]) {
-        result_table[0].push_back(std::move(original_table[0][i]));
+  out_rows->reserve(out_rows->size() + result_table.size());
+  for (size_t row = 0; row < result_table.size(); row++) {
+    TensorRow &in_row = (*in_rows)[row];
+    TensorRow &result_row = result_table[row];
+    if (in_columns_.size() == out_columns_.size()) {
+      // Place the processed tensor back into the original index of the input tensor
+      for (size_t i = 0; i < result_row.size(); i++) {
+        in_row[to_process_indices_[i]] = std::move(result_row[i]);
       }
+      out_rows->push_back(std::move(in_row));
+    } else {
+      // Append the data in the original table that we did not use to the end of each row in result_table.
+      for (size_t i = 0; i < in_row.size(); i++) {
+        if (keep_input_columns_[i]) {
+          result_row.push_back(std::move(in_row[i]));
+        }
+      }
+      out_rows->push_back(std::move(result_row));
     }
-    *out_row = std::move(result_table[0]);
   }
 
   return Status::OK();
 }
 
+Status MapOp::AllocateFusedBatch(FusedBatch *batch) {
+  batch->columns.clear();
+  for (const auto &col : fused_layout_) {
+    std::shared_ptr<Tensor> t;
+    if (col.second.IsNumeric()) {
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(col.first.PrependDim(fused_batch_size_), col.second, &t));
+    }
+    batch->columns.push_back(std::move(t));
+  }
+  return Status::OK();
+}
+
+MapOp::FusedBatch &MapOp::FindFusedBatch(int64_t batch_id) {
+  auto &batch = fused_batches_[batch_id];
+  if (batch.expected_rows == 0) {
+    batch.expected_rows = fused_batch_size_;
+  }
+  return batch;
+}
+
+void MapOp::SetFusedLayout(const TensorRow &row) {
+  fused_layout_.clear();
+  for (const auto &t : row) {
+    bool numeric = t->type().IsNumeric() && t->HasData();
+    fused_layout_.emplace_back(t->shape(), numeric ? t->type() : DataType(DataType::DE_UNKNOWN));
+  }
+}
+
+Status MapOp::GetFusedBatchSlots(const BatchSlot &slot, Tensor::BatchSlots *slots) {
+  std::unique_lock<std::mutex> lck(fused_mux_);
+  auto &batch = FindFusedBatch(slot.batch_id);
+  // Until the first row is placed, the layout of the rows is not known.
+  if (batch.columns.empty() && !fused_layout_.empty()) {
+    RETURN_IF_NOT_OK(AllocateFusedBatch(&batch));
+  }
+  for (const auto &col : batch.columns) {
+    if (col != nullptr) {
+      slots->emplace_back(col, slot.index);
+    }
+  }
+  return Status::OK();
+}
+
+void MapOp::EndFusedBatch(const BatchSlot &next_slot) {
+  std::unique_lock<std::mutex> lck(fused_mux_);
+  auto &batch = fused_batches_[next_slot.batch_id];
+  batch.expected_rows = next_slot.index;
+  if (batch.num_rows == batch.expected_rows) {
+    (void)fused_batches_.erase(next_slot.batch_id);
+  }
+}
+
+Status MapOp::PlaceInBatch(const BatchSlot &slot, TensorRow *row) {
+  std::vector<std::shared_ptr<Tensor>> columns;
+  {
+    std::unique_lock<std::mutex> lck(fused_mux_);
+    auto &batch = FindFusedBatch(slot.batch_id);
+    if (batch.columns.empty()) {
+      // The first row placed decides the layout of the rows.
+      SetFusedLayout(*row);
+      RETURN_IF_NOT_OK(AllocateFusedBatch(&batch));
+    }
+    columns = batch.columns;
+    if (++batch.num_rows == batch.expected_rows) {
+      (void)fused_batches_.erase(slot.batch_id);
+    }
+  }
+  auto in_slot = [&slot](const std::shared_ptr<Tensor> &t, const std::shared_ptr<Tensor> &batch) {
+    return t->BatchOfSlot() == batch && t->GetBuffer() == batch->GetBuffer() + slot.index * t->SizeInBytes();
+  };
+  // A tensor which took the slot of another column is moved out, the slot is overwritten by its own column.
+  for (size_t i = 0; i < row->size(); i++) {
+    auto &t = (*row)[i];
+    const auto &owner = t->BatchOfSlot();
+    if (owner != nullptr && (i >= columns.size() || owner != columns[i] || !in_slot(t, owner) ||
+                             t->shape().PrependDim(fused_batch_size_) != owner->shape())) {
+      auto src = t;
+      RETURN_IF_NOT_OK(Tensor::CreateFromTensor(src, &t));
+    }
+  }
+  bool mismatch = false;
+  for (size_t i = 0; i < row->size() && i < columns.size(); i++) {
+    auto &t = (*row)[i];
+    auto &batch = columns[i];
+    if (batch == nullptr) {
+      continue;
+    }
+    if (t->BatchOfSlot() == batch) {
+      // Written into its slot by the last TensorOp already.
+      ++num_written_in_slot_;
+      continue;
+    }
+    // A tensor which doesn't match the others is left as it is. BatchOp copies it, or reports the mismatch.
+    if (t->type() != batch->type() || t->shape().PrependDim(fused_batch_size_) != batch->shape()) {
+      mismatch = true;
+      continue;
+    }
+    RETURN_IF_NOT_OK(batch->InsertTensor({slot.index}, t));
+    RETURN_IF_NOT_OK(Tensor::CreateFromBatchSlot(batch, slot.index, &t));
+  }
+  if (mismatch || row->size() != columns.size()) {
+    // The rows changed their layout, the next batches take the layout of this row.
+    std::unique_lock<std::mutex> lck(fused_mux_);
+    SetFusedLayout(*row);
+  }
+  return Status::OK();
+}
+
 Status MapOp::ComputeColMap() {
   // If the map has not been set up yet in the base class, then set it up
   if (column_name_id_map_.empty()) {
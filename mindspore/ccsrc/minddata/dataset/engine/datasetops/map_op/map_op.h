@@ -17,7 +17,9 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_MAP_OP_H_
 
 #include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -114,20 +116,51 @@ class MapOp : public ParallelOp {
 
   const auto &TFuncs() const { return tfuncs_; }
 
+  // Write the output rows into the batches of the BatchOp this op feeds, instead of letting BatchOp copy them.
+  // @param batch_size The fixed batch size of the BatchOp, 0 to turn it off
+  void SetFusedBatchSize(int32_t batch_size) { fused_batch_size_ = batch_size; }
+
+  // @return The number of the output tensors the last TensorOp wrote into their slots of the batches, which are
+  //     neither allocated nor copied on their own
+  int64_t NumWrittenInSlot() const { return num_written_in_slot_; }
+
  private:
+  // The slot of a row in the batches of the BatchOp after this op, when the two are fused.
+  struct BatchSlot {
+    int64_t batch_id = -1;
+    int32_t index = 0;
+  };
+
   // A unit of job for map worker thread.
   // MapWorkerJob holds a list of MapJob where each MapJob can be a CpuMapJob, GpuMapJob or DvppMapJob.
   struct MapWorkerJob {
     explicit MapWorkerJob(TensorRow tr) : tensor_row(std::move(tr)) {}
     std::vector<std::shared_ptr<MapJob>> jobs;
     TensorRow tensor_row;
+    BatchSlot slot;
+  };
+
+  // A batch being filled by the workers. It is dropped once all its rows are placed, BatchOp takes it from them.
+  struct FusedBatch {
+    std::vector<std::shared_ptr<Tensor>> columns;  // nullptr for a column which is not numeric
+    int32_t num_rows = 0;                          // rows placed in the batch
+    int32_t expected_rows = 0;                     // the batch size, or less for the last batch of an epoch
   };
 
   // A helper function to create jobs for workers.
   Status GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job);
 
   // A helper function that fetch worker map job from local queues and extract the data and map job list
-  Status FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list);
+  Status FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list,
+                       BatchSlot *slot);
+
+  // A helper function like FetchNextWork, but returns false instead of waiting if the local queue is empty
+  bool TryFetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list,
+                        BatchSlot *slot);
+
+  // The maximum number of rows a worker takes from its local queue at once when all the TensorOps support
+  // BatchCompute
+  static constexpr size_t kMaxBlockRows = 32;
 
   // Local queues where worker threads get a job from
   QueueList<std::unique_ptr<MapWorkerJob>> local_queues_;
@@ -149,6 +182,20 @@ class MapOp : public ParallelOp {
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
 
+  // True if all the TensorOps support BatchCompute, then the workers run them on blocks of rows.
+  bool batch_compute_;
+
+  // The batch size of the BatchOp fed by this op if the output rows are written into its batches, 0 otherwise.
+  int32_t fused_batch_size_;
+
+  // The batches being filled by the workers, by batch id
+  std::mutex fused_mux_;
+  std::map<int64_t, FusedBatch> fused_batches_;
+  // The shape and type of each column of the last rows placed, the batches are allocated for them before the rows are
+  // computed. The type is unknown for a column which is not numeric.
+  std::vector<std::pair<TensorShape, DataType>> fused_layout_;
+  std::atomic<int64_t> num_written_in_slot_;
+
   // Private function for worker/thread to loop continuously. It comprises the main
   // logic of MapOp: getting the data from previous Op, validating user specified column names,
   // applying a list of TensorOps to each of the data, process the results and then
@@ -158,11 +205,44 @@ class MapOp : public ParallelOp {
   Status WorkerEntry(int32_t worker_id) override;  //  In: workerId assigned by tree_
 
   // Private function for worker thread to perform TensorOp's compute function and get the result.
-  // @param in_row Input TensorRow
-  // @param[out] out_row Generated TensorRow
-  Status WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
+  // @param in_rows Input TensorRows, their tensors are moved into the result
+  // @param[out] out_rows Generated TensorRows, one for each input row
+  Status WorkerCompute(std::vector<TensorRow> *in_rows, std::vector<TensorRow> *out_rows,
                        const std::vector<std::shared_ptr<MapJob>> &job_list);
 
+  // Find or add a batch being filled, fused_mux_ must be held.
+  // @param batch_id The id of the batch
+  // @return The batch
+  FusedBatch &FindFusedBatch(int64_t batch_id);
+
+  // Take the layout of the batches from a row, fused_mux_ must be held.
+  // @param row The output row
+  void SetFusedLayout(const TensorRow &row);
+
+  // Allocate the columns of a batch for the rows of fused_layout_, fused_mux_ must be held.
+  // @param[out] batch The batch
+  // @return Status The status code returned
+  Status AllocateFusedBatch(FusedBatch *batch);
+
+  // Get the slots of a row in its batch before the row is computed, the last TensorOp writes its outputs into them.
+  // The batch is allocated by its first row, unless no row is placed yet.
+  // @param slot The slot of the row
+  // @param[out] slots The slots of the numeric columns of the row
+  // @return Status The status code returned
+  Status GetFusedBatchSlots(const BatchSlot &slot, Tensor::BatchSlots *slots);
+
+  // Tell the workers the number of rows of the last batch of an epoch, which is not full.
+  // @param next_slot The slot after the last row of the batch
+  void EndFusedBatch(const BatchSlot &next_slot);
+
+  // Put the tensors of an output row in its slot of the batch. The tensors the last TensorOp wrote into their slots
+  // stay as they are. The others are copied into their slots while they are still in the cache of the worker, and
+  // replaced by tensors sharing the memory of the slot. BatchOp then takes the batch as it is.
+  // @param slot The slot of the row
+  // @param[in, out] row The output row
+  // @return Status The status code returned
+  Status PlaceInBatch(const BatchSlot &slot, TensorRow *row);
+
   // Private function that create the final column name to index mapping and
   // get indices of the columns this mapop does not use.
   // @param col_name_id_map The column name to index mapping obtained from child operator
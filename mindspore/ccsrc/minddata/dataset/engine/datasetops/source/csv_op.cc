@@ -16,12 +16,15 @@
 #include "minddata/dataset/engine/datasetops/source/csv_op.h"
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <stdexcept>
 
 #include "debug/common.h"
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/engine/datasetops/source/csv_scanner.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/util/random.h"
@@ -34,8 +37,8 @@ CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
              const std::vector<std::string> &column_name, int32_t num_workers, int64_t num_samples,
              int32_t worker_connector_size, int32_t op_connector_size, bool shuffle_files, int32_t num_devices,
              int32_t device_id)
-    : NonMappableLeafOp(std::min(num_workers, static_cast<int32_t>(csv_files_list.size())), worker_connector_size,
-                        num_samples, op_connector_size, shuffle_files, num_devices, device_id),
+    : NonMappableLeafOp(num_workers, worker_connector_size, num_samples, op_connector_size, shuffle_files, num_devices,
+                        device_id),
       csv_files_list_(std::move(csv_files_list)),
       field_delim_(field_delim),
       column_default_list_(column_default),
@@ -44,7 +47,9 @@ CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
 Status CsvOp::Init() {
   RETURN_IF_NOT_OK(filename_index_->insert(csv_files_list_));
 
-  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(csv_files_list_.size() / num_workers_) + 1);
+  // The rows of a shard are split into about num_workers_ blocks, plus the partial blocks at the ends of the files.
+  int64_t num_blocks = 2 * (static_cast<int64_t>(csv_files_list_.size()) + num_workers_);
+  int32_t safe_queue_size = static_cast<int32_t>(num_blocks / num_workers_ + 1);
   io_block_queues_.Init(num_workers_, safe_queue_size);
 
   RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_connector_size_));
@@ -59,395 +64,204 @@ CsvOp::CsvParser::CsvParser(int32_t worker_id, JaggedConnector *connector, char
       rows_connector_(connector),
       csv_field_delim_(field_delim),
       column_default_(column_default),
-      file_path_(file_path),
-      cur_state_(START_OF_FILE),
-      pos_(0),
+      cur_state_(START_OF_ROW),
       cur_col_(0),
       total_rows_(0),
       start_offset_(0),
       end_offset_(std::numeric_limits<int64_t>::max()),
-      err_message_("unknown") {}
+      file_path_(file_path) {}
 
-void CsvOp::CsvParser::Reset() {
-  cur_state_ = START_OF_FILE;
-  pos_ = 0;
-  cur_col_ = 0;
+Status CsvOp::CsvParser::ParseError(const std::string &err_message) const {
+  RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse file: " + file_path_ + ": line " +
+                           std::to_string(total_rows_ + 1) + ". Error message: " + err_message);
 }
 
-CsvOp::CsvParser::Message CsvOp::CsvParser::GetMessage(int c) {
-  if (c == csv_field_delim_) {
-    return Message::MS_DELIM;
-  } else if (c == '"') {
-    return Message::MS_QUOTE;
-  } else if (c == '\r' || c == '\n') {
-    return Message::MS_END_OF_LINE;
-  } else if (c == std::char_traits<char>::eof()) {
-    return Message::MS_END_OF_FILE;
-  } else {
-    return Message::MS_NORMAL;
+void CsvOp::CsvParser::StartRow() {
+  cur_col_ = 0;
+  field_.clear();
+  if (InRange()) {
+    TensorRow row(column_default_.size(), nullptr);
+    std::vector<std::string> file_path(column_default_.size(), file_path_);
+    row.setPath(file_path);
+    cur_row_ = std::move(row);
   }
 }
 
-int CsvOp::CsvParser::ProcessMessage(int c) {
-  Message m = GetMessage(c);
-  StateDiagram::iterator it = sd.find({cur_state_, m});
-  if (it == sd.end()) {
-    return -1;
+Status CsvOp::CsvParser::PutRecord() {
+  if (cur_col_ >= column_default_.size()) {
+    return ParseError("Number of file columns does not match the default records");
+  }
+  if (InRange()) {
+    // The numbers are parsed from the field in place, with the same rules as std::stoi and std::stof.
+    std::shared_ptr<Tensor> t;
+    const char *begin = field_.c_str();
+    char *end = nullptr;
+    errno = 0;
+    switch (column_default_[cur_col_]->type) {
+      case CsvOp::INT: {
+        int64_t value = strtol(begin, &end, 10);
+        CHECK_FAIL_RETURN_UNEXPECTED(end != begin, "Invalid data, " + file_path_ + ": line " +
+                                                     std::to_string(total_rows_ + 1) + ", type does not match.");
+        CHECK_FAIL_RETURN_UNEXPECTED(errno != ERANGE && value >= std::numeric_limits<int32_t>::min() &&
+                                       value <= std::numeric_limits<int32_t>::max(),
+                                     "Invalid data, " + file_path_ + ": line " + std::to_string(total_rows_ + 1) +
+                                       ", value out of range.");
+        RETURN_IF_NOT_OK(Tensor::CreateScalar(static_cast<int32_t>(value), &t));
+        break;
+      }
+      case CsvOp::FLOAT: {
+        float value = strtof(begin, &end);
+        CHECK_FAIL_RETURN_UNEXPECTED(end != begin, "Invalid data, " + file_path_ + ": line " +
+                                                     std::to_string(total_rows_ + 1) + ", type does not match.");
+        CHECK_FAIL_RETURN_UNEXPECTED(errno != ERANGE, "Invalid data, " + file_path_ + ": line " +
+                                                        std::to_string(total_rows_ + 1) + ", value out of range.");
+        RETURN_IF_NOT_OK(Tensor::CreateScalar(value, &t));
+        break;
+      }
+      default:
+        RETURN_IF_NOT_OK(Tensor::CreateScalar(field_, &t));
+        break;
+    }
+    cur_row_[cur_col_] = std::move(t);
   }
-  int ret = it->second.second(*this, c);
-  cur_state_ = it->second.first;
-  return ret;
+  field_.clear();
+  cur_col_++;
+  return Status::OK();
 }
 
-int CsvOp::CsvParser::PutChar(int c) {
-  if (pos_ >= str_buf_.size()) {
-    str_buf_.resize(str_buf_.size() * 2);
+Status CsvOp::CsvParser::PutRow() {
+  if (InRange()) {
+    if (cur_col_ != column_default_.size()) {
+      return ParseError("The number of columns does not match the definition.");
+    }
+    RETURN_IF_NOT_OK(rows_connector_->Add(worker_id_, std::move(cur_row_)));
   }
-  str_buf_[pos_] = c;
-  pos_++;
-  return 0;
+  total_rows_++;
+  return Status::OK();
 }
 
-int CsvOp::CsvParser::PutRecord(int c) {
-  std::string s = std::string(str_buf_.begin(), str_buf_.begin() + pos_);
-  std::shared_ptr<Tensor> t;
-  if (cur_col_ >= column_default_.size()) {
-    err_message_ = "Number of file columns does not match the default records";
-    return -1;
-  }
-  Status rc;
-  switch (column_default_[cur_col_]->type) {
-    case CsvOp::INT:
-      rc = Tensor::CreateScalar(std::stoi(s), &t);
-      if (rc.IsError()) {
-        err_message_ = rc.ToString();
-        return -1;
-      }
+// The transitions of the state machine, a run of the characters which are not structural acts like one character.
+//
+//               |    abc     |     ,      |       "       |      \n       |     EOF     |
+// |-------------|------------|------------|---------------|---------------|-------------|
+// | START_OF_ROW| UNQUOTE    | DELIM      | QUOTE         | START_OF_ROW  | end         |
+// | DELIM       | UNQUOTE    | DELIM      | QUOTE         | START_OF_ROW  | PutRow      |
+// | UNQUOTE     | UNQUOTE    | DELIM      | exception     | START_OF_ROW  | PutRow      |
+// | QUOTE       | QUOTE      | QUOTE      | SECOND_QUOTE  | QUOTE         | exception   |
+// | SECOND_QUOTE| exception  | DELIM      | QUOTE, put "  | START_OF_ROW  | PutRow      |
+//
+// The delimiters and the line ends in quotes are not structural, they are in the runs of the QUOTE state.
+Status CsvOp::CsvParser::PutChars(const char *chars, size_t size) {
+  switch (cur_state_) {
+    case START_OF_ROW:
+      StartRow();
+      cur_state_ = UNQUOTE;
       break;
-    case CsvOp::FLOAT:
-      rc = Tensor::CreateScalar(std::stof(s), &t);
-      if (rc.IsError()) {
-        err_message_ = rc.ToString();
-        return -1;
-      }
+    case DELIM:
+      cur_state_ = UNQUOTE;
       break;
+    case SECOND_QUOTE:
+      return ParseError("Receive unquote char in quote field.");
     default:
-      rc = Tensor::CreateScalar(s, &t);
-      if (rc.IsError()) {
-        err_message_ = rc.ToString();
-        return -1;
-      }
       break;
   }
-  if (cur_col_ >= cur_row_.size()) {
-    err_message_ = "Number of file columns does not match the tensor table";
-    return -1;
+  if (InRange()) {
+    (void)field_.append(chars, size);
   }
-  cur_row_[cur_col_] = std::move(t);
-  pos_ = 0;
-  cur_col_++;
-  return 0;
+  return Status::OK();
 }
 
-int CsvOp::CsvParser::PutRow(int c) {
-  if (total_rows_ < start_offset_) {
-    total_rows_++;
-    cur_col_ = 0;
-    return 0;
-  }
-
-  if (total_rows_ >= end_offset_) {
-    cur_col_ = 0;
-    return 0;
-  }
-
-  int ret = PutRecord(c);
-  if (ret < 0) {
-    return ret;
+Status CsvOp::CsvParser::PutDelim() {
+  if (cur_state_ == START_OF_ROW) {
+    StartRow();
   }
-
-  if (cur_col_ != column_default_.size()) {
-    err_message_ = "The number of columns does not match the definition.";
-    return -1;
-  }
-
-  total_rows_++;
-  cur_col_ = 0;
-
-  Status s = rows_connector_->Add(worker_id_, std::move(cur_row_));
-  if (s.IsError()) {
-    err_message_ = s.ToString();
-    if (s.StatusCode() == kMDInterrupted) return -2;
-    return -1;
-  }
-
-  return 0;
+  cur_state_ = DELIM;
+  return PutRecord();
 }
 
-int CsvOp::CsvParser::AddRow(int c) {
-  total_rows_++;
-  return 0;
+Status CsvOp::CsvParser::PutQuote() {
+  switch (cur_state_) {
+    case START_OF_ROW:
+      StartRow();
+      cur_state_ = QUOTE;
+      break;
+    case DELIM:
+      cur_state_ = QUOTE;
+      break;
+    case UNQUOTE:
+      return ParseError("Invalid quote in unquote field.");
+    case QUOTE:
+      cur_state_ = SECOND_QUOTE;
+      break;
+    case SECOND_QUOTE:
+      // an escaped quote
+      if (InRange()) {
+        field_.push_back('"');
+      }
+      cur_state_ = QUOTE;
+      break;
+  }
+  return Status::OK();
 }
 
-int CsvOp::CsvParser::EndFile(int c) {
-  if (cur_col_ > 0) {
-    int ret = PutRow(c);
-    if (ret < 0) {
-      return ret;
-    }
+Status CsvOp::CsvParser::PutEndOfLine() {
+  if (cur_state_ == START_OF_ROW) {
+    return Status::OK();
   }
-  return 0;
+  cur_state_ = START_OF_ROW;
+  RETURN_IF_NOT_OK(PutRecord());
+  return PutRow();
 }
 
-int CsvOp::CsvParser::CatchException(int c) {
-  if (GetMessage(c) == Message::MS_QUOTE && cur_state_ == State::UNQUOTE) {
-    err_message_ = "Invalid quote in unquote field.";
-  } else if (GetMessage(c) == Message::MS_END_OF_FILE && cur_state_ == State::QUOTE) {
-    err_message_ = "Reach the end of file in quote field.";
-  } else if (GetMessage(c) == Message::MS_NORMAL && cur_state_ == State::SECOND_QUOTE) {
-    err_message_ = "Receive unquote char in quote field.";
+Status CsvOp::CsvParser::EndFile() {
+  if (cur_state_ == QUOTE) {
+    return ParseError("Reach the end of file in quote field.");
   }
-  return -1;
+  return PutEndOfLine();
 }
 
-int CsvOp::CsvParser::CountRows(int c) {
-  Message m;
-  if (c == '"') {
-    m = Message::MS_QUOTE;
-  } else if (c == '\r' || c == '\n' || c == std::char_traits<char>::eof()) {
-    m = Message::MS_END_OF_LINE;
-  } else {
-    m = Message::MS_NORMAL;
+Status CsvOp::CsvParser::Parse(std::istream *stream, int64_t first_row) {
+  total_rows_ = first_row;
+  cur_state_ = START_OF_ROW;
+  CsvBlockReader reader(stream, csv_field_delim_);
+  const char *block = nullptr;
+  size_t size = 0;
+  CsvBlockMasks masks;
+  while (total_rows_ < end_offset_ && reader.Next(&block, &size, &masks)) {
+    uint64_t structural = masks.delim | masks.quote | masks.eol;
+    size_t pos = 0;
+    while (pos < size) {
+      // only a quote ends a run in quotes
+      uint64_t candidates = (cur_state_ == QUOTE ? masks.quote : structural) >> pos;
+      size_t next = candidates == 0 ? size : pos + __builtin_ctzll(candidates);
+      if (next > pos) {
+        RETURN_IF_NOT_OK(PutChars(block + pos, next - pos));
+      }
+      if (next == size) {
+        break;
+      }
+      uint64_t bit = 1ULL << next;
+      if (masks.delim & bit) {
+        RETURN_IF_NOT_OK(PutDelim());
+      } else if (masks.quote & bit) {
+        RETURN_IF_NOT_OK(PutQuote());
+      } else {
+        RETURN_IF_NOT_OK(PutEndOfLine());
+        if (total_rows_ >= end_offset_) {
+          return Status::OK();
+        }
+      }
+      pos = next + 1;
+    }
   }
-  StateDiagram::iterator it = sdl.find({cur_state_, m});
-  if (it == sdl.end()) {
-    return -1;
+  if (total_rows_ >= end_offset_) {
+    return Status::OK();
   }
-  cur_state_ = it->second.first;
-  return it->second.second(*this, c);
-}
-
-Status CsvOp::CsvParser::InitCsvParser() {
-  str_buf_.resize(CSV_BUFFER_SIZE);
-
-  // State diagram for counting rows
-  sdl = {// START_OF_FILE
-         // |---------------------------------------|
-         // |    abc    |    "      |      \n       |
-         // |---------------------------------------|
-         // | UNQUOTE   |   QUOTE   | START_OF_FILE |
-         // |---------------------------------------|
-         // |  NullFunc |  NullFunc |    NullFunc   |
-         // |---------------------------------------|
-         {{State::START_OF_FILE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::START_OF_FILE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::START_OF_FILE, Message::MS_END_OF_LINE}, {State::START_OF_FILE, &CsvParser::NullFunc}},
-
-         // UNQUOTE
-         // |-------------------------------------|
-         // |    abc    |    "      |    \n       |
-         // |-------------------------------------|
-         // | UNQUOTE   | QUOTE     | END_OF_LINE |
-         // |-------------------------------------|
-         // |  NullFunc | NullFunc  |  AddRow     |
-         // |-------------------------------------|
-         {{State::UNQUOTE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::UNQUOTE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::UNQUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::AddRow}},
-
-         // QUOTE
-         // |--------------------------------------|
-         // |    abc    |      "       |    \n     |
-         // |--------------------------------------|
-         // | QUOTE     | SECOND_QUOTE |   QUOTE   |
-         // |--------------------------------------|
-         // |  NullFunc |  NullFunc    | NullFunc  |
-         // |--------------------------------------|
-         {{State::QUOTE, Message::MS_NORMAL}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::QUOTE, Message::MS_QUOTE}, {State::SECOND_QUOTE, &CsvParser::NullFunc}},
-         {{State::QUOTE, Message::MS_END_OF_LINE}, {State::QUOTE, &CsvParser::NullFunc}},
-
-         // SECOND_QUOTE
-         // |-------------------------------------|
-         // |    abc    |     "     |     \n      |
-         // |-------------------------------------|
-         // | UNQUOTE   | QUOTE     | END_OF_LINE |
-         // |-------------------------------------|
-         // |  NullFunc | NullFunc  | AddRow      |
-         // |-------------------------------------|
-         {{State::SECOND_QUOTE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::SECOND_QUOTE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::SECOND_QUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::AddRow}},
-
-         // END_OF_LINE
-         // |-------------------------------------|
-         // |    abc    |     "     |     \n      |
-         // |-------------------------------------|
-         // | UNQUOTE   | QUOTE     | END_OF_LINE |
-         // |-------------------------------------|
-         // | NullFunc  |  NullFunc | NullFunc    |
-         // |-------------------------------------|
-         {{State::END_OF_LINE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::END_OF_LINE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::END_OF_LINE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::NullFunc}}};
-
-  // State diagram for CSV parser
-  sd = {// START_OF_FILE
-        // |-------------------------------------------------------------------|
-        // |    abc    |    ,     |    "     |      \n        |       EOF      |
-        // |-------------------------------------------------------------------|
-        // | UNQUOTE   | DELIM    | QUOTE    | START_OF_FILE  | END_OF_FILE    |
-        // |-------------------------------------------------------------------|
-        // | lambda    | lambda   | lambda   | NullFunc       |  NullFunc      |
-        // |-------------------------------------------------------------------|
-        {{State::START_OF_FILE, Message::MS_NORMAL},
-         {State::UNQUOTE,
-          [this](CsvParser &, char c) -> int {
-            TensorRow row(column_default_.size(), nullptr);
-            std::vector<std::string> file_path(column_default_.size(), file_path_);
-            row.setPath(file_path);
-            this->cur_row_ = std::move(row);
-            this->str_buf_[0] = c;
-            this->pos_ = 1;
-            return 0;
-          }}},
-        {{State::START_OF_FILE, Message::MS_DELIM},
-         {State::DELIM,
-          [this](CsvParser &, char c) -> int {
-            TensorRow row(column_default_.size(), nullptr);
-            std::vector<std::string> file_path(column_default_.size(), file_path_);
-            row.setPath(file_path);
-            this->cur_row_ = std::move(row);
-            return this->PutRecord(c);
-          }}},
-        {{State::START_OF_FILE, Message::MS_QUOTE},
-         {State::QUOTE,
-          [this](CsvParser &, char c) -> int {
-            TensorRow row(column_default_.size(), nullptr);
-            std::vector<std::string> file_path(column_default_.size(), file_path_);
-            row.setPath(file_path);
-            this->cur_row_ = std::move(row);
-            this->pos_ = 0;
-            return 0;
-          }}},
-        {{State::START_OF_FILE, Message::MS_END_OF_LINE}, {State::START_OF_FILE, &CsvParser::NullFunc}},
-        {{State::START_OF_FILE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::NullFunc}},
-
-        // UNQUOTE
-        // |-------------------------------------------------------------------|
-        // |    abc    |    ,       |     "     |      \n     |       EOF      |
-        // |-------------------------------------------------------------------|
-        // | UNQUOTE   | DELIM      | EXCEPTION | END_OF_LINE | END_OF_FILE    |
-        // |-------------------------------------------------------------------|
-        // | PutChar   | PutRecord  | exception | PutRow      | EndFile        |
-        // |-------------------------------------------------------------------|
-        {{State::UNQUOTE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::PutChar}},
-        {{State::UNQUOTE, Message::MS_DELIM}, {State::DELIM, &CsvParser::PutRecord}},
-        {{State::UNQUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::PutRow}},
-        {{State::UNQUOTE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}},
-        // UNQUOTE-Exception
-        {{State::UNQUOTE, Message::MS_QUOTE}, {State::EXCEPTION, &CsvParser::CatchException}},
-
-        // DELIM
-        // |-------------------------------------------------------------------|
-        // |    abc    |    ,       |     "     |      \n     |       EOF      |
-        // |-------------------------------------------------------------------|
-        // | UNQUOTE   | DELIM      | QUOTE     | END_OF_LINE | END_OF_FILE    |
-        // |-------------------------------------------------------------------|
-        // | PutChar   | PutRecord  | lambda    | PutRow      | EndFile        |
-        // |-------------------------------------------------------------------|
-        {{State::DELIM, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::PutChar}},
-        {{State::DELIM, Message::MS_DELIM}, {State::DELIM, &CsvParser::PutRecord}},
-        {{State::DELIM, Message::MS_QUOTE},
-         {State::QUOTE,
-          [this](CsvParser &, char c) -> int {
-            this->pos_ = 0;
-            return 0;
-          }}},
-        {{State::DELIM, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::PutRow}},
-        {{State::DELIM, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}},
-
-        // QUOTE
-        // |-----------------------------------------------------------------|
-        // |    abc    |    ,     |     "        |    \n    |       EOF      |
-        // |-----------------------------------------------------------------|
-        // | QUOTE     | QUOTE    | SECOND_QUOTE | QUOTE    | EXCEPTION      |
-        // |-----------------------------------------------------------------|
-        // | PutChar   | PutChar  |  NullFunc    | PutChar  | exception      |
-        // |-----------------------------------------------------------------|
-        {{State::QUOTE, Message::MS_NORMAL}, {State::QUOTE, &CsvParser::PutChar}},
-        {{State::QUOTE, Message::MS_DELIM}, {State::QUOTE, &CsvParser::PutChar}},
-        {{State::QUOTE, Message::MS_QUOTE}, {State::SECOND_QUOTE, &CsvParser::NullFunc}},
-        {{State::QUOTE, Message::MS_END_OF_LINE}, {State::QUOTE, &CsvParser::PutChar}},
-        // QUOTE-Exception
-        {{State::QUOTE, Message::MS_END_OF_FILE}, {State::EXCEPTION, &CsvParser::CatchException}},
-
-        // SECOND_QUOTE
-        // |------------------------------------------------------------------|
-        // |    abc    |     ,      |    "     |    \n       |       EOF      |
-        // |------------------------------------------------------------------|
-        // | EXCEPTION | DELIM      | QUOTE    | END_OF_LINE | END_OF_FILE    |
-        // |------------------------------------------------------------------|
-        // | exception | PutRecord | PutChar   | PutRow      | EndFile        |
-        // |------------------------------------------------------------------|
-        {{State::SECOND_QUOTE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::PutChar}},
-        {{State::SECOND_QUOTE, Message::MS_DELIM}, {State::DELIM, &CsvParser::PutRecord}},
-        {{State::SECOND_QUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::PutRow}},
-        {{State::SECOND_QUOTE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}},
-        // SECOND_QUOTE-Exception
-        {{State::SECOND_QUOTE, Message::MS_NORMAL}, {State::EXCEPTION, &CsvParser::CatchException}},
-
-        // END_OF_LINE
-        // |-------------------------------------------------------|
-        // |   abc   |   ,    |   "    |      \n     |     EOF     |
-        // |-------------------------------------------------------|
-        // | UNQUOTE | DELIM  | QUOTE  | END_OF_LINE | END_OF_FILE |
-        // |-------------------------------------------------------|
-        // | lambda  | lambda | lambda |  NullFunc   | EndFile     |
-        // |-------------------------------------------------------|
-        {{State::END_OF_LINE, Message::MS_NORMAL},
-         {State::UNQUOTE,
-          [this](CsvParser &, char c) -> int {
-            if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
-              TensorRow row(column_default_.size(), nullptr);
-              std::vector<std::string> file_path(column_default_.size(), file_path_);
-              row.setPath(file_path);
-              this->cur_row_ = std::move(row);
-            }
-            this->str_buf_[0] = c;
-            this->pos_ = 1;
-            return 0;
-          }}},
-        {{State::END_OF_LINE, Message::MS_DELIM},
-         {State::DELIM,
-          [this](CsvParser &, char c) -> int {
-            if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
-              TensorRow row(column_default_.size(), nullptr);
-              std::vector<std::string> file_path(column_default_.size(), file_path_);
-              row.setPath(file_path);
-              this->cur_row_ = std::move(row);
-            }
-            return this->PutRecord(c);
-          }}},
-        {{State::END_OF_LINE, Message::MS_QUOTE},
-         {State::QUOTE,
-          [this](CsvParser &, char c) -> int {
-            if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
-              TensorRow row(column_default_.size(), nullptr);
-              std::vector<std::string> file_path(column_default_.size(), file_path_);
-              row.setPath(file_path);
-              this->cur_row_ = std::move(row);
-            }
-            return 0;
-          }}},
-        {{State::END_OF_LINE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::NullFunc}},
-        {{State::END_OF_LINE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}}};
-  return Status::OK();
+  return EndFile();
 }
 
 Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t end_offset, int32_t worker_id) {
   CsvParser csv_parser(worker_id, jagged_rows_connector_.get(), field_delim_, column_default_list_, file);
-  RETURN_IF_NOT_OK(csv_parser.InitCsvParser());
   csv_parser.SetStartOffset(start_offset);
   csv_parser.SetEndOffset(end_offset);
 
@@ -458,7 +272,7 @@ Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t en
   }
 
   std::ifstream ifs;
-  ifs.open(realpath.value(), std::ifstream::in);
+  ifs.open(realpath.value(), std::ifstream::in | std::ifstream::binary);
   if (!ifs.is_open()) {
     RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + file);
   }
@@ -466,29 +280,20 @@ Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t en
     std::string tmp;
     getline(ifs, tmp);
   }
-  csv_parser.Reset();
-  try {
-    while (ifs.good()) {
-      // when ifstream reaches the end of file, the function get() return std::char_traits<char>::eof()
-      // which is a 32-bit -1, it's not equal to the 8-bit -1 on Euler OS. So instead of char, we use
-      // int to receive its return value.
-      int chr = ifs.get();
-      int err = csv_parser.ProcessMessage(chr);
-      if (err != 0) {
-        if (err == -2) return Status(kMDInterrupted);
-        RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse file: " + file + ": line " +
-                                 std::to_string(csv_parser.GetTotalRows() + 1) +
-                                 ". Error message: " + csv_parser.GetErrorMessage());
-      }
-    }
-  } catch (std::invalid_argument &ia) {
-    std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
-    RETURN_STATUS_UNEXPECTED("Invalid data, " + file + ": line " + err_row + ", type does not match.");
-  } catch (std::out_of_range &oor) {
-    std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
-    RETURN_STATUS_UNEXPECTED("Invalid data, " + file + ": line " + err_row + ", value out of range.");
+  if (!ifs.good()) {
+    return Status::OK();
   }
-  return Status::OK();
+
+  // Start from the nearest checkpoint before the first row, instead of the beginning of the file.
+  int64_t first_row = 0;
+  auto itr = file_checkpoints_.find(file);
+  if (itr != file_checkpoints_.end() && !itr->second.empty()) {
+    int64_t checkpoint =
+      std::min(start_offset / kCsvRowsPerCheckpoint, static_cast<int64_t>(itr->second.size()) - 1);
+    (void)ifs.seekg(itr->second[checkpoint], std::ios::cur);
+    first_row = checkpoint * kCsvRowsPerCheckpoint;
+  }
+  return csv_parser.Parse(&ifs, first_row);
 }
 
 // A print method typically used for debugging
@@ -540,10 +345,14 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
     for (auto file_info : file_index) {
       if (NeedPushFileToBlockQueue(file_info.first, &start_offset, &end_offset, pre_count)) {
-        auto ioBlock =
-          std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-        RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-        queue_index = (queue_index + 1) % num_workers_;
+        // split the rows of the file, so that several workers parse a large file together
+        for (int64_t block_start = start_offset; block_start < end_offset; block_start += rows_per_block_) {
+          int64_t block_end = std::min(block_start + rows_per_block_, end_offset);
+          auto ioBlock =
+            std::make_unique<FilenameBlock>(file_info.second, block_start, block_end, IOBlock::kDeIoBlockNone);
+          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+          queue_index = (queue_index + 1) % num_workers_;
+        }
       }
 
       pre_count += filename_numrows_[file_info.first];
@@ -577,18 +386,13 @@ Status CsvOp::CalculateNumRowsPerShard() {
   }
 
   num_rows_per_shard_ = static_cast<int64_t>(std::ceil(num_rows_ * 1.0 / num_devices_));
+  // A block has at least the rows between two checkpoints, so a small file is still parsed by one worker.
+  rows_per_block_ = std::max((num_rows_per_shard_ + num_workers_ - 1) / num_workers_, kCsvRowsPerCheckpoint);
   MS_LOG(DEBUG) << "Number rows per shard is " << num_rows_per_shard_;
   return Status::OK();
 }
 
 int64_t CsvOp::CountTotalRows(const std::string &file) {
-  CsvParser csv_parser(0, jagged_rows_connector_.get(), field_delim_, column_default_list_, file);
-  Status rc = csv_parser.InitCsvParser();
-  if (rc.IsError()) {
-    MS_LOG(ERROR) << "Failed to initialize CSV Parser. Error:" << rc;
-    return 0;
-  }
-
   auto realpath = Common::GetRealPath(file);
   if (!realpath.has_value()) {
     MS_LOG(ERROR) << "Get real path failed, path=" << file;
@@ -596,7 +400,7 @@ int64_t CsvOp::CountTotalRows(const std::string &file) {
   }
 
   std::ifstream ifs;
-  ifs.open(realpath.value(), std::ifstream::in);
+  ifs.open(realpath.value(), std::ifstream::in | std::ifstream::binary);
   if (!ifs.is_open()) {
     return 0;
   }
@@ -604,15 +408,22 @@ int64_t CsvOp::CountTotalRows(const std::string &file) {
     std::string tmp;
     getline(ifs, tmp);
   }
-  csv_parser.Reset();
-  while (ifs.good()) {
-    int chr = ifs.get();
-    if (csv_parser.CountRows(chr) != 0) {
-      break;
-    }
+  if (!ifs.good()) {
+    return 0;
   }
 
-  return csv_parser.GetTotalRows();
+  // The quotes and the line ends of a block are counted at once, no character goes through the state machine.
+  CsvRowCounter counter(kCsvRowsPerCheckpoint);
+  CsvBlockReader reader(&ifs, field_delim_);
+  const char *block = nullptr;
+  size_t size = 0;
+  CsvBlockMasks masks;
+  while (reader.Next(&block, &size, &masks)) {
+    counter.Feed(masks, size);
+  }
+  counter.Finish();
+  file_checkpoints_[file] = counter.checkpoints();
+  return counter.rows();
 }
 
 Status CsvOp::CountAllFileRows(const std::vector<std::string> &files, bool csv_header, int64_t *count) {
@@ -22,6 +22,7 @@
 #include <map>
 #include <utility>
 #include <limits>
+#include <istream>
 
 #include "minddata/dataset/util/auto_index.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
@@ -32,7 +33,8 @@
 namespace mindspore {
 namespace dataset {
 
-const size_t CSV_BUFFER_SIZE = 4096;
+// The interval of the rows whose offsets are kept, a worker starts to parse a file at the nearest one before its rows
+const int64_t kCsvRowsPerCheckpoint = 4096;
 using StringIndex = AutoIndexObj<std::string>;
 class JaggedConnector;
 
@@ -58,9 +60,10 @@ class CsvOp : public NonMappableLeafOp {
   };
 
   /// CsvParser is a class that parsing CSV file.
-  /// We design a state machine to implement CSV syntactic analysis. It contains two state diagram,'sd' and 'sdl'.
-  /// The 'sd' is used for parsing CSV syntactic, it's complete and complicate.
-  /// The 'sdl' is used for counting the record rows, it's concise and it runs fast.
+  /// The file is read in blocks of 64 bytes, and the delimiters, quotes and line ends of a block are found at once as
+  /// bit masks. The parser only steps through these structural characters with its state machine, the runs of the
+  /// other characters in between are copied as a whole. The rows out of [start_offset, end_offset) are checked for
+  /// syntax only, their fields are not converted.
   struct CsvParser {
    public:
     CsvParser() = delete;
@@ -70,77 +73,52 @@ class CsvOp : public NonMappableLeafOp {
 
     ~CsvParser() = default;
 
-    void Reset();
-
     void SetStartOffset(int64_t start_offset) { start_offset_ = start_offset; }
 
     void SetEndOffset(int64_t end_offset) { end_offset_ = end_offset; }
 
-    int ProcessMessage(int c);
-
-    int CountRows(int c);
-
-    Status InitCsvParser();
+    /// Parse the rows from the current position of a stream until the end offset or the end of the stream.
+    /// @param stream - the stream, which must be positioned at the beginning of a row.
+    /// @param first_row - the row id of the first row in the stream.
+    /// @return Status - the error code returned.
+    Status Parse(std::istream *stream, int64_t first_row);
 
     int64_t GetTotalRows() { return total_rows_; }
 
-    std::string GetErrorMessage() { return err_message_; }
-
    private:
-    enum State : uint8_t {
-      START_OF_FILE = 0,
-      UNQUOTE,
-      DELIM,
-      QUOTE,
-      SECOND_QUOTE,
-      END_OF_LINE,
-      END_OF_FILE,
-      EXCEPTION
-    };
+    enum State : uint8_t { START_OF_ROW = 0, DELIM, UNQUOTE, QUOTE, SECOND_QUOTE };
 
-    enum Message : uint8_t {
-      MS_NORMAL = 0,
-      MS_DELIM,
-      MS_QUOTE,
-      MS_END_OF_LINE,
-      MS_END_OF_FILE,
-    };
+    bool InRange() const { return total_rows_ >= start_offset_ && total_rows_ < end_offset_; }
 
-    typedef std::pair<State, Message> StateMessagePair;
-    typedef std::pair<State, std::function<int(CsvParser &, int)>> StateActionPair;
-    typedef std::map<StateMessagePair, StateActionPair> StateDiagram;
+    Status PutChars(const char *chars, size_t size);
 
-    Message GetMessage(int c);
+    Status PutDelim();
 
-    int NullFunc(int c) { return 0; }
+    Status PutQuote();
 
-    int PutChar(int c);
+    Status PutEndOfLine();
 
-    int PutRecord(int c);
+    Status EndFile();
 
-    int PutRow(int c);
+    void StartRow();
 
-    int EndFile(int c);
+    Status PutRecord();
 
-    int AddRow(int c);
+    Status PutRow();
 
-    int CatchException(int c);
+    Status ParseError(const std::string &err_message) const;
 
     int32_t worker_id_;
     JaggedConnector *rows_connector_;
     const char csv_field_delim_;
     std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_;
     State cur_state_;
-    size_t pos_;
-    int cur_col_;
+    size_t cur_col_;
     int64_t total_rows_;
     int64_t start_offset_;
     int64_t end_offset_;
-    StateDiagram sd;
-    StateDiagram sdl;
-    std::vector<char> str_buf_;
+    std::string field_;
     TensorRow cur_row_;
-    std::string err_message_;
     std::string file_path_;
   };
 
@@ -204,7 +182,7 @@ class CsvOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status CalculateNumRowsPerShard() override;
 
-  /// Count number of rows in each file.
+  /// Count number of rows in each file, and keep the offsets of every kCsvRowsPerCheckpoint rows of the file.
   /// @param filename - csv file name.
   /// @return int64_t - the total number of rows in file.
   int64_t CountTotalRows(const std::string &file);
@@ -232,6 +210,10 @@ class CsvOp : public NonMappableLeafOp {
   std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list_;
   std::vector<std::string> column_name_list_;
   bool check_flag_ = false;
+  // The offsets of the rows kCsvRowsPerCheckpoint * i of a file, relative to the end of the header
+  std::map<std::string, std::vector<int64_t>> file_checkpoints_;
+  // The number of rows in an IOBlock, a file is read by several workers in blocks
+  int64_t rows_per_block_ = 0;
 };
 }  // namespace dataset
 }  // namespace mindspore
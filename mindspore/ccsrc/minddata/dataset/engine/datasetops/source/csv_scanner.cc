@@ -0,0 +1,144 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/csv_scanner.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// The size of the chunks the stream is read in
+constexpr size_t kCsvReadSize = 1 << 20;
+
+#if defined(__SSE2__)
+constexpr size_t kLaneSize = 16;
+
+// Get the bits of the bytes of a block which equal c.
+inline uint64_t MatchBytes(const __m128i (&lanes)[kCsvBlockSize / kLaneSize], char c) {
+  const __m128i target = _mm_set1_epi8(c);
+  uint64_t mask = 0;
+  for (size_t i = 0; i < kCsvBlockSize / kLaneSize; ++i) {
+    auto bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lanes[i], target)));
+    mask |= static_cast<uint64_t>(bits) << (i * kLaneSize);
+  }
+  return mask;
+}
+#else
+constexpr uint64_t kLow7Bits = 0x7F7F7F7F7F7F7F7FULL;
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+// The multiplier which moves the bit 8 * j of a word to the bit 56 + j, for the 8 bytes j.
+constexpr uint64_t kGatherBits = 0x0102040810204080ULL;
+
+// Get the bits of the bytes of a block which equal c. The 8 bytes of a word are compared at once, the high bit of a
+// byte of the xor is clear only for equal bytes, and it is gathered into one bit per byte by a multiplication.
+inline uint64_t MatchBytes(const uint64_t (&words)[kCsvBlockSize / sizeof(uint64_t)], char c) {
+  const uint64_t pattern = kOnes * static_cast<uint8_t>(c);
+  uint64_t mask = 0;
+  for (size_t i = 0; i < kCsvBlockSize / sizeof(uint64_t); ++i) {
+    uint64_t diff = words[i] ^ pattern;
+    uint64_t equal = ~(((diff & kLow7Bits) + kLow7Bits) | diff | kLow7Bits);
+    mask |= (((equal >> 7) * kGatherBits) >> 56) << (i * sizeof(uint64_t));
+  }
+  return mask;
+}
+#endif
+}  // namespace
+
+void ScanCsvBlock(const char *block, char field_delim, CsvBlockMasks *masks) {
+#if defined(__SSE2__)
+  __m128i data[kCsvBlockSize / kLaneSize];
+  for (size_t i = 0; i < kCsvBlockSize / kLaneSize; ++i) {
+    data[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i * kLaneSize));
+  }
+#else
+  // the bytes of a block are little-endian words, byte j of a word is the byte 8 * i + j of the block
+  uint64_t data[kCsvBlockSize / sizeof(uint64_t)];
+  (void)memcpy(data, block, kCsvBlockSize);
+#endif
+  masks->delim = MatchBytes(data, field_delim);
+  masks->quote = MatchBytes(data, '"') & ~masks->delim;
+  masks->eol = (MatchBytes(data, '\r') | MatchBytes(data, '\n')) & ~masks->delim;
+}
+
+CsvBlockReader::CsvBlockReader(std::istream *stream, char field_delim)
+    : stream_(stream), field_delim_(field_delim), buffer_(kCsvReadSize + kCsvBlockSize), buffer_size_(0), pos_(0) {}
+
+bool CsvBlockReader::Next(const char **block, size_t *size, CsvBlockMasks *masks) {
+  if (pos_ >= buffer_size_) {
+    (void)stream_->read(buffer_.data(), static_cast<std::streamsize>(kCsvReadSize));
+    buffer_size_ = static_cast<size_t>(stream_->gcount());
+    pos_ = 0;
+    if (buffer_size_ == 0) {
+      return false;
+    }
+    // pad the last block, its masks are cut to the valid bytes anyway
+    (void)memset(buffer_.data() + buffer_size_, 0, kCsvBlockSize);
+  }
+  *block = buffer_.data() + pos_;
+  *size = std::min(kCsvBlockSize, buffer_size_ - pos_);
+  ScanCsvBlock(*block, field_delim_, masks);
+  if (*size < kCsvBlockSize) {
+    uint64_t valid = (1ULL << *size) - 1;
+    masks->delim &= valid;
+    masks->quote &= valid;
+    masks->eol &= valid;
+  }
+  pos_ += kCsvBlockSize;
+  return true;
+}
+
+CsvRowCounter::CsvRowCounter(int64_t rows_per_checkpoint)
+    : rows_per_checkpoint_(rows_per_checkpoint), rows_(0), offset_(0), in_quote_(0), prev_eol_(true) {
+  if (rows_per_checkpoint_ > 0) {
+    checkpoints_.push_back(0);
+  }
+}
+
+void CsvRowCounter::Feed(const CsvBlockMasks &masks, size_t size) {
+  uint64_t in_quote = PrefixXor(masks.quote) ^ in_quote_;
+  // A row ends at a line end outside quotes, unless the byte before it is a line end too.
+  uint64_t row_ends = masks.eol & ~in_quote & ~((masks.eol << 1) | static_cast<uint64_t>(prev_eol_));
+  auto num_ends = static_cast<int64_t>(__builtin_popcountll(row_ends));
+  if (rows_per_checkpoint_ > 0 && (rows_ + num_ends) / rows_per_checkpoint_ > rows_ / rows_per_checkpoint_) {
+    // the next row begins after the line end which ends a multiple of rows_per_checkpoint_ rows
+    while (row_ends != 0) {
+      int bit = __builtin_ctzll(row_ends);
+      row_ends &= row_ends - 1;
+      if (++rows_ % rows_per_checkpoint_ == 0) {
+        checkpoints_.push_back(offset_ + bit + 1);
+      }
+    }
+  } else {
+    rows_ += num_ends;
+  }
+  in_quote_ = ((in_quote >> (size - 1)) & 1) ? ~0ULL : 0;
+  prev_eol_ = ((masks.eol >> (size - 1)) & 1) != 0;
+  offset_ += static_cast<int64_t>(size);
+}
+
+void CsvRowCounter::Finish() {
+  if (!prev_eol_ && in_quote_ == 0) {
+    rows_++;
+  }
+  prev_eol_ = true;
+}
+}  // namespace dataset
+}  // namespace mindspore
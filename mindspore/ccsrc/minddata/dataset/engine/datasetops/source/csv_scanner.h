@@ -0,0 +1,115 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_CSV_SCANNER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_CSV_SCANNER_H_
+
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+// The number of bytes which are classified at once, one bit of a mask per byte
+constexpr size_t kCsvBlockSize = 64;
+
+// The positions of the structural characters in a block of CSV text, bit i of a mask stands for byte i of the block.
+// A character is only in one of the masks, the delimiter takes precedence over the quote and the line ends.
+struct CsvBlockMasks {
+  uint64_t delim;
+  uint64_t quote;
+  uint64_t eol;  // '\r' or '\n'
+};
+
+// Classify the kCsvBlockSize bytes of a block.
+// @param block - the block, which must have kCsvBlockSize readable bytes.
+// @param field_delim - the field delimiter.
+// @param masks - the masks of the structural characters.
+void ScanCsvBlock(const char *block, char field_delim, CsvBlockMasks *masks);
+
+// Bit i of the result is the xor of the bits 0 to i of the mask, it turns the mask of the quotes into the mask of the
+// bytes inside quotes.
+inline uint64_t PrefixXor(uint64_t mask) {
+  mask ^= mask << 1;
+  mask ^= mask << 2;
+  mask ^= mask << 4;
+  mask ^= mask << 8;
+  mask ^= mask << 16;
+  mask ^= mask << 32;
+  return mask;
+}
+
+// CsvBlockReader reads a stream in blocks of kCsvBlockSize bytes and classifies them. The stream is read in large
+// chunks, and the last block is padded, the masks never have a bit beyond the valid bytes.
+class CsvBlockReader {
+ public:
+  // Constructor of CsvBlockReader
+  // @param stream - the stream to read from its current position.
+  // @param field_delim - the field delimiter.
+  CsvBlockReader(std::istream *stream, char field_delim);
+
+  ~CsvBlockReader() = default;
+
+  // Get the next block.
+  // @param block - the next block, which stays valid until the next call.
+  // @param size - the number of valid bytes in the block, only the last block may have less than kCsvBlockSize.
+  // @param masks - the masks of the structural characters in the valid bytes.
+  // @return bool - false if the stream is at its end.
+  bool Next(const char **block, size_t *size, CsvBlockMasks *masks);
+
+ private:
+  std::istream *stream_;
+  char field_delim_;
+  std::vector<char> buffer_;
+  size_t buffer_size_;
+  size_t pos_;
+};
+
+// CsvRowCounter counts the rows of CSV text from the masks of its blocks, with the same rules as the parser: a row
+// ends at a line end outside quotes, the blank lines are not rows and the end of the text ends the last row. It may
+// also record the offsets where the rows begin at regular intervals, which are safe places to start parsing from.
+class CsvRowCounter {
+ public:
+  // Constructor of CsvRowCounter
+  // @param rows_per_checkpoint - the interval of the rows whose offsets are recorded, 0 to record none.
+  explicit CsvRowCounter(int64_t rows_per_checkpoint);
+
+  ~CsvRowCounter() = default;
+
+  // Count the rows which end in the next block.
+  // @param masks - the masks of the block.
+  // @param size - the number of valid bytes in the block.
+  void Feed(const CsvBlockMasks &masks, size_t size);
+
+  // End the text, a last row with no line end is counted.
+  void Finish();
+
+  // @return int64_t - the number of rows.
+  int64_t rows() const { return rows_; }
+
+  // @return std::vector<int64_t> - the offset of the row rows_per_checkpoint * i, relative to the first block, at i.
+  const std::vector<int64_t> &checkpoints() const { return checkpoints_; }
+
+ private:
+  int64_t rows_per_checkpoint_;
+  int64_t rows_;
+  int64_t offset_;
+  uint64_t in_quote_;  // all ones if the next block starts inside quotes
+  bool prev_eol_;      // whether the previous byte is a line end, or there is none
+  std::vector<int64_t> checkpoints_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_CSV_SCANNER_H_
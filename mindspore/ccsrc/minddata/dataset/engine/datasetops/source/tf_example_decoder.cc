@@ -0,0 +1,529 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_example_decoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr uint32_t kWireVarint = 0;
+constexpr uint32_t kWireFixed64 = 1;
+constexpr uint32_t kWireLengthDelimited = 2;
+constexpr uint32_t kWireFixed32 = 5;
+// Example.features, Features.feature, the key and the value of a map entry, and the values of a list are all field 1,
+// except the value of a map entry.
+constexpr uint32_t kFieldOne = 1;
+constexpr uint32_t kMapValueField = 2;
+constexpr int kVarintShift = 7;
+constexpr int kVarintBits = 64;
+constexpr uint8_t kVarintMore = 0x80;
+constexpr uint8_t kVarintPayload = 0x7F;
+constexpr char kParseError[] = "Invalid data, failed to parse the Example in tfrecord file, the record is corrupted.";
+
+// WireReader reads the fields of a serialized protobuf message without copying them.
+class WireReader {
+ public:
+  explicit WireReader(const std::string_view &data) : pos_(data.data()), end_(data.data() + data.size()) {}
+
+  bool Done() const { return pos_ == end_; }
+
+  bool ReadVarint(uint64_t *value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < kVarintBits && pos_ != end_; shift += kVarintShift) {
+      auto byte = static_cast<uint8_t>(*pos_++);
+      result |= static_cast<uint64_t>(byte & kVarintPayload) << shift;
+      if ((byte & kVarintMore) == 0) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadTag(uint32_t *field, uint32_t *wire_type) {
+    constexpr int kTagTypeBits = 3;
+    constexpr uint64_t kTagTypeMask = 0x7;
+    uint64_t tag = 0;
+    if (!ReadVarint(&tag) || (tag >> kTagTypeBits) == 0 || (tag >> kTagTypeBits) > UINT32_MAX) {
+      return false;
+    }
+    *field = static_cast<uint32_t>(tag >> kTagTypeBits);
+    *wire_type = static_cast<uint32_t>(tag & kTagTypeMask);
+    return true;
+  }
+
+  bool ReadBytes(std::string_view *value) {
+    uint64_t len = 0;
+    if (!ReadVarint(&len) || len > static_cast<uint64_t>(end_ - pos_)) {
+      return false;
+    }
+    *value = std::string_view(pos_, len);
+    pos_ += len;
+    return true;
+  }
+
+  bool ReadFixed32(const char **value) {
+    constexpr int64_t kFixed32Size = 4;
+    if (end_ - pos_ < kFixed32Size) {
+      return false;
+    }
+    *value = pos_;
+    pos_ += kFixed32Size;
+    return true;
+  }
+
+  bool Skip(uint32_t wire_type) {
+    constexpr int64_t kFixed64Size = 8;
+    uint64_t varint = 0;
+    std::string_view bytes;
+    const char *fixed32 = nullptr;
+    switch (wire_type) {
+      case kWireVarint:
+        return ReadVarint(&varint);
+      case kWireFixed64:
+        if (end_ - pos_ < kFixed64Size) {
+          return false;
+        }
+        pos_ += kFixed64Size;
+        return true;
+      case kWireLengthDelimited:
+        return ReadBytes(&bytes);
+      case kWireFixed32:
+        return ReadFixed32(&fixed32);
+      default:
+        // Groups are deprecated and never used by Example.
+        return false;
+    }
+  }
+
+ private:
+  const char *pos_;
+  const char *end_;
+};
+
+// Walk the values (field 1) of the list messages of a column. A repeated scalar field may be packed into one
+// length-delimited run, or be written one value per field with single_wire_type, so both have a callback.
+// @param lists - the payloads of the list messages.
+// @param single_wire_type - the wire type of one unpacked value.
+// @param on_packed - called with a packed run, returns false if the run is invalid.
+// @param on_single - called with the reader positioned at an unpacked value, reads the value and returns false if it
+//     can't be read.
+// @return bool - false if the lists are corrupted.
+template <typename PackedFn, typename SingleFn>
+bool ForEachValue(const std::vector<std::string_view> &lists, uint32_t single_wire_type, PackedFn on_packed,
+                  SingleFn on_single) {
+  for (const auto &list : lists) {
+    WireReader reader(list);
+    while (!reader.Done()) {
+      uint32_t field = 0;
+      uint32_t wire_type = 0;
+      if (!reader.ReadTag(&field, &wire_type)) {
+        return false;
+      }
+      if (field != kFieldOne) {
+        if (!reader.Skip(wire_type)) {
+          return false;
+        }
+        continue;
+      }
+      if (wire_type == kWireLengthDelimited) {
+        std::string_view packed;
+        if (!reader.ReadBytes(&packed) || !on_packed(packed)) {
+          return false;
+        }
+      } else if (wire_type == single_wire_type) {
+        if (!on_single(&reader)) {
+          return false;
+        }
+      } else if (!reader.Skip(wire_type)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}  // namespace
+
+TFExampleDecoder::TFExampleDecoder(const DataSchema *data_schema) : data_schema_(data_schema) {
+  int32_t num_columns = data_schema_->NumColumns();
+  column_names_.reserve(num_columns);
+  for (int32_t col = 0; col < num_columns; ++col) {
+    column_names_.push_back(data_schema_->column(col).name());
+  }
+  // The names are not moved any more, the index can refer to them now.
+  for (int32_t col = 0; col < num_columns; ++col) {
+    column_index_.emplace(column_names_[col], col);
+  }
+  columns_.resize(num_columns);
+}
+
+Status TFExampleDecoder::Decode(const std::string_view &example, TensorRow *out_row) {
+  for (auto &column : columns_) {
+    column.found = false;
+    column.kind = kKindNotSet;
+    column.lists.clear();
+  }
+
+  WireReader reader(example);
+  while (!reader.Done()) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), kParseError);
+    if (field == kFieldOne && wire_type == kWireLengthDelimited) {
+      std::string_view features;
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadBytes(&features), kParseError);
+      RETURN_IF_NOT_OK(ScanFeatures(features));
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), kParseError);
+    }
+  }
+
+  for (int32_t col = 0; col < static_cast<int32_t>(columns_.size()); ++col) {
+    const ColDescriptor &current_col = data_schema_->column(col);
+    const ColumnSlices &slices = columns_[col];
+    if (!slices.found) {
+      RETURN_STATUS_UNEXPECTED("Invalid parameter, column name: " + current_col.name() + " does not exist.");
+    }
+    std::shared_ptr<Tensor> ts;
+    switch (slices.kind) {
+      case kBytesList:
+        RETURN_IF_NOT_OK(DecodeBytesList(current_col, slices, &ts));
+        break;
+      case kFloatList:
+        RETURN_IF_NOT_OK(DecodeFloatList(current_col, slices, &ts));
+        break;
+      case kInt64List:
+        RETURN_IF_NOT_OK(DecodeIntListSwitch(current_col, slices, &ts));
+        break;
+      default:
+        RETURN_STATUS_UNEXPECTED("Invalid data, column type in tf record file must be uint8, int64 or float32.");
+    }
+    (*out_row)[col] = std::move(ts);
+  }
+  return Status::OK();
+}
+
+Status TFExampleDecoder::ScanFeatures(const std::string_view &features) {
+  WireReader reader(features);
+  while (!reader.Done()) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), kParseError);
+    if (field != kFieldOne || wire_type != kWireLengthDelimited) {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), kParseError);
+      continue;
+    }
+    std::string_view entry;
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadBytes(&entry), kParseError);
+
+    // The key of a map entry may come after its value, so find the key first and only walk the value if it is a column.
+    std::string_view key;
+    WireReader key_reader(entry);
+    while (!key_reader.Done()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(key_reader.ReadTag(&field, &wire_type), kParseError);
+      if (field == kFieldOne && wire_type == kWireLengthDelimited) {
+        CHECK_FAIL_RETURN_UNEXPECTED(key_reader.ReadBytes(&key), kParseError);
+      } else {
+        CHECK_FAIL_RETURN_UNEXPECTED(key_reader.Skip(wire_type), kParseError);
+      }
+    }
+    auto itr = column_index_.find(key);
+    if (itr == column_index_.end()) {
+      continue;
+    }
+
+    // A later entry of the same key replaces the earlier one.
+    ColumnSlices *slices = &columns_[itr->second];
+    slices->found = true;
+    slices->kind = kKindNotSet;
+    slices->lists.clear();
+    WireReader value_reader(entry);
+    while (!value_reader.Done()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(value_reader.ReadTag(&field, &wire_type), kParseError);
+      if (field == kMapValueField && wire_type == kWireLengthDelimited) {
+        std::string_view feature;
+        CHECK_FAIL_RETURN_UNEXPECTED(value_reader.ReadBytes(&feature), kParseError);
+        RETURN_IF_NOT_OK(ScanFeature(feature, slices));
+      } else {
+        CHECK_FAIL_RETURN_UNEXPECTED(value_reader.Skip(wire_type), kParseError);
+      }
+    }
+  }
+  return Status::OK();
+}
+
+Status TFExampleDecoder::ScanFeature(const std::string_view &feature, ColumnSlices *slices) {
+  WireReader reader(feature);
+  while (!reader.Done()) {
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), kParseError);
+    if (field < kBytesList || field > kInt64List || wire_type != kWireLengthDelimited) {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), kParseError);
+      continue;
+    }
+    std::string_view list;
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadBytes(&list), kParseError);
+    // Setting another case of the oneof clears the current one, the same case is merged.
+    auto kind = static_cast<FeatureKind>(field);
+    if (slices->kind != kind) {
+      slices->kind = kind;
+      slices->lists.clear();
+    }
+    slices->lists.push_back(list);
+  }
+  return Status::OK();
+}
+
+Status TFExampleDecoder::DecodeBytesList(const ColDescriptor &current_col, const ColumnSlices &slices,
+                                         std::shared_ptr<Tensor> *tensor) {
+  // kBytesList can map to the following DE types ONLY!
+  // DE_UINT8, DE_INT8
+  // Must be single byte type for each element!
+  if (current_col.type() != DataType::DE_UINT8 && current_col.type() != DataType::DE_INT8 &&
+      current_col.type() != DataType::DE_STRING) {
+    std::string err_msg = "Invalid data, invalid data type for Tensor at column: " + current_col.name() +
+                          ", data type should be int8, uint8 or string, but got " + current_col.type().ToString();
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+
+  // The values of a BytesList are never packed, they are found as they are.
+  strings_.clear();
+  for (const auto &list : slices.lists) {
+    WireReader reader(list);
+    while (!reader.Done()) {
+      uint32_t field = 0;
+      uint32_t wire_type = 0;
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadTag(&field, &wire_type), kParseError);
+      if (field == kFieldOne && wire_type == kWireLengthDelimited) {
+        std::string_view value;
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadBytes(&value), kParseError);
+        strings_.push_back(value);
+      } else {
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), kParseError);
+      }
+    }
+  }
+  auto num_elements = static_cast<int32_t>(strings_.size());
+
+  if (current_col.type() == DataType::DE_STRING) {
+    TensorShape shape = TensorShape::CreateScalar();
+    RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &shape));
+    return Tensor::CreateFromVector(strings_, shape, tensor);
+  }
+
+  int64_t max_size = 0;
+  for (const auto &value : strings_) {
+    max_size = std::max(max_size, static_cast<int64_t>(value.size()));
+  }
+  int64_t pad_size = max_size;
+
+  // if user provides a shape in the form of [-1, d1, 2d, ... , dn], we need to pad to d1 * d2 * ... * dn
+  if (current_col.hasShape()) {
+    TensorShape cur_shape = current_col.shape();
+    if (cur_shape.Size() >= 2 && cur_shape[0] == TensorShape::kDimUnknown) {
+      int64_t new_pad_size = 1;
+      for (int i = 1; i < cur_shape.Size(); ++i) {
+        if (cur_shape[i] == TensorShape::kDimUnknown) {
+          std::string err_msg =
+            "Invalid data, more than one unknown dimension in the shape of column: " + current_col.name();
+          RETURN_STATUS_UNEXPECTED(err_msg);
+        }
+        new_pad_size *= cur_shape[i];
+      }
+      pad_size = new_pad_size;
+      CHECK_FAIL_RETURN_UNEXPECTED(max_size <= pad_size, "Invalid data, the bytes of column: " + current_col.name() +
+                                                           " are longer than its shape " + cur_shape.ToString());
+    } else {
+      if (cur_shape.known() && cur_shape.NumOfElements() != max_size) {
+        std::string err_msg = "Shape in schema's column '" + current_col.name() + "' is incorrect." +
+                              "\nshape received: " + cur_shape.ToString() +
+                              "\ntotal elements in shape received: " + std::to_string(cur_shape.NumOfElements()) +
+                              "\nexpected total elements in shape: " + std::to_string(max_size);
+        RETURN_STATUS_UNEXPECTED(err_msg);
+      }
+    }
+  }
+
+  // know how many elements there are and the total bytes, create tensor here:
+  TensorShape current_shape = TensorShape::CreateScalar();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements * pad_size, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
+
+  // the tensor is just created and not shared yet, so its buffer is written in place
+  auto current_tensor_addr = const_cast<unsigned char *>((*tensor)->GetBuffer());
+  int64_t tensor_bytes_remaining = num_elements * pad_size;
+  for (const auto &value : strings_) {
+    if (!value.empty()) {
+      int ret_code = memcpy_s(current_tensor_addr, tensor_bytes_remaining, value.data(), value.size());
+      CHECK_FAIL_RETURN_UNEXPECTED(ret_code == 0, "memcpy_s failed when reading bytesList element into Tensor");
+    }
+    current_tensor_addr += value.size();
+    tensor_bytes_remaining -= value.size();
+
+    // pad
+    int64_t chars_to_pad = pad_size - static_cast<int64_t>(value.size());
+    if (chars_to_pad > 0) {
+      int ret_code = memset_s(current_tensor_addr, tensor_bytes_remaining, static_cast<int>(' '), chars_to_pad);
+      CHECK_FAIL_RETURN_UNEXPECTED(ret_code == 0, "memset_s failed when padding Tensor");
+    }
+    current_tensor_addr += chars_to_pad;
+    tensor_bytes_remaining -= chars_to_pad;
+  }
+  return Status::OK();
+}
+
+Status TFExampleDecoder::DecodeFloatList(const ColDescriptor &current_col, const ColumnSlices &slices,
+                                         std::shared_ptr<Tensor> *tensor) {
+  // KFloatList can only map to DE types:
+  // DE_FLOAT32
+  if (current_col.type() != DataType::DE_FLOAT32) {
+    std::string err_msg = "Invalid data, invalid data type for Tensor at column: " + current_col.name() +
+                          ", data type should be float32, but got " + current_col.type().ToString();
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+
+  // Count the values first, so they can be copied into the tensor with no staging array.
+  int64_t num_elements = 0;
+  const char *value = nullptr;
+  bool valid = ForEachValue(
+    slices.lists, kWireFixed32,
+    [&num_elements](const std::string_view &packed) {
+      num_elements += packed.size() / sizeof(float);
+      return packed.size() % sizeof(float) == 0;
+    },
+    [&num_elements, &value](WireReader *reader) {
+      ++num_elements;
+      return reader->ReadFixed32(&value);
+    });
+  CHECK_FAIL_RETURN_UNEXPECTED(valid, kParseError);
+
+  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
+
+  // The fixed32 values are little-endian on the wire, the same as the tensor buffer.
+  auto dst = reinterpret_cast<char *>(const_cast<unsigned char *>((*tensor)->GetBuffer()));
+  int64_t bytes_remaining = num_elements * static_cast<int64_t>(sizeof(float));
+  valid = ForEachValue(
+    slices.lists, kWireFixed32,
+    [&dst, &bytes_remaining](const std::string_view &packed) {
+      if (packed.empty()) {
+        return true;
+      }
+      if (memcpy_s(dst, bytes_remaining, packed.data(), packed.size()) != 0) {
+        return false;
+      }
+      dst += packed.size();
+      bytes_remaining -= packed.size();
+      return true;
+    },
+    [&dst, &bytes_remaining, &value](WireReader *reader) {
+      if (!reader->ReadFixed32(&value) || memcpy_s(dst, bytes_remaining, value, sizeof(float)) != 0) {
+        return false;
+      }
+      dst += sizeof(float);
+      bytes_remaining -= sizeof(float);
+      return true;
+    });
+  CHECK_FAIL_RETURN_UNEXPECTED(valid, "memcpy_s failed when reading floatList element into Tensor");
+  return Status::OK();
+}
+
+// Determines which template type to use and calls DecodeIntList
+Status TFExampleDecoder::DecodeIntListSwitch(const ColDescriptor &current_col, const ColumnSlices &slices,
+                                             std::shared_ptr<Tensor> *tensor) {
+  if (current_col.type() == DataType::DE_UINT64) {
+    RETURN_IF_NOT_OK(DecodeIntList<uint64_t>(current_col, slices, tensor));
+  } else if (current_col.type() == DataType::DE_INT64) {
+    RETURN_IF_NOT_OK(DecodeIntList<int64_t>(current_col, slices, tensor));
+  } else if (current_col.type() == DataType::DE_UINT32) {
+    RETURN_IF_NOT_OK(DecodeIntList<uint32_t>(current_col, slices, tensor));
+  } else if (current_col.type() == DataType::DE_INT32) {
+    RETURN_IF_NOT_OK(DecodeIntList<int32_t>(current_col, slices, tensor));
+  } else if (current_col.type() == DataType::DE_UINT16) {
+    RETURN_IF_NOT_OK(DecodeIntList<uint16_t>(current_col, slices, tensor));
+  } else if (current_col.type() == DataType::DE_INT16) {
+    RETURN_IF_NOT_OK(DecodeIntList<int16_t>(current_col, slices, tensor));
+  } else if (current_col.type() == DataType::DE_UINT8) {
+    RETURN_IF_NOT_OK(DecodeIntList<uint8_t>(current_col, slices, tensor));
+  } else if (current_col.type() == DataType::DE_INT8) {
+    RETURN_IF_NOT_OK(DecodeIntList<int8_t>(current_col, slices, tensor));
+  } else {
+    std::string err_msg = "Invalid data, invalid datatype for Tensor at column: " + current_col.name() +
+                          ", data type should be uint64, int64, uint32, int32, uint16, int16, uint8 or int8" +
+                          ", but got " + current_col.type().ToString();
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+// Decodes the varints of an int64 list and casts the values to type T, must be an integral type compatible with int64_t
+template <typename T>
+Status TFExampleDecoder::DecodeIntList(const ColDescriptor &current_col, const ColumnSlices &slices,
+                                       std::shared_ptr<Tensor> *tensor) {
+  // Every varint ends with a byte whose high bit is clear, so the values of a packed run are counted without decoding.
+  int64_t num_elements = 0;
+  uint64_t value = 0;
+  bool valid = ForEachValue(
+    slices.lists, kWireVarint,
+    [&num_elements](const std::string_view &packed) {
+      for (char c : packed) {
+        num_elements += (static_cast<uint8_t>(c) & kVarintMore) == 0 ? 1 : 0;
+      }
+      return packed.empty() || (static_cast<uint8_t>(packed.back()) & kVarintMore) == 0;
+    },
+    [&num_elements, &value](WireReader *reader) {
+      ++num_elements;
+      return reader->ReadVarint(&value);
+    });
+  CHECK_FAIL_RETURN_UNEXPECTED(valid, kParseError);
+
+  // know how many elements there are, create tensor here:
+  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
+
+  auto dst = reinterpret_cast<T *>(const_cast<unsigned char *>((*tensor)->GetBuffer()));
+  int64_t i = 0;
+  auto store = [dst, num_elements, &i](uint64_t element) {
+    if (i >= num_elements) {
+      return false;
+    }
+    dst[i++] = static_cast<T>(static_cast<int64_t>(element));
+    return true;
+  };
+  valid = ForEachValue(
+    slices.lists, kWireVarint,
+    [&store, &value](const std::string_view &packed) {
+      WireReader reader(packed);
+      while (!reader.Done()) {
+        if (!reader.ReadVarint(&value) || !store(value)) {
+          return false;
+        }
+      }
+      return true;
+    },
+    [&store, &value](WireReader *reader) { return reader->ReadVarint(&value) && store(value); });
+  CHECK_FAIL_RETURN_UNEXPECTED(valid && i == num_elements, kParseError);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,117 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_DECODER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_DECODER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// TFExampleDecoder decodes serialized dataengine::Example records straight from the protobuf wire format.
+// The features of an Example are walked once, the ones which are not columns of the schema are skipped without being
+// decoded, and the values of the columns are written into their tensors with no intermediate protobuf objects.
+class TFExampleDecoder {
+ public:
+  // Constructor of TFExampleDecoder
+  // @param data_schema - the schema of the columns to be decoded, which must outlive the decoder.
+  explicit TFExampleDecoder(const DataSchema *data_schema);
+
+  ~TFExampleDecoder() = default;
+
+  // The column index refers to the column names of the decoder itself, so it can't be copied.
+  TFExampleDecoder(const TFExampleDecoder &) = delete;
+  TFExampleDecoder &operator=(const TFExampleDecoder &) = delete;
+
+  // Decode a serialized Example into a row with one tensor per column of the schema.
+  // @param example - the serialized Example, it must stay valid until the call returns.
+  // @param out_row - the row to put the tensors in, it must have one slot per column.
+  // @return Status - the error code returned.
+  Status Decode(const std::string_view &example, TensorRow *out_row);
+
+ private:
+  // The oneof case of a dataengine::Feature, the values are the field numbers.
+  enum FeatureKind : uint32_t { kKindNotSet = 0, kBytesList = 1, kFloatList = 2, kInt64List = 3 };
+
+  // The payloads of the list messages of a column in the current Example. Protobuf merges a message which occurs more
+  // than once, so a column may have more than one payload of the same kind.
+  struct ColumnSlices {
+    bool found;
+    FeatureKind kind;
+    std::vector<std::string_view> lists;
+  };
+
+  // Collect the payloads of the columns from a serialized Features message.
+  // @param features - the serialized Features message.
+  // @return Status - the error code returned.
+  Status ScanFeatures(const std::string_view &features);
+
+  // Collect the payload of a serialized Feature message into the slices of a column.
+  // @param feature - the serialized Feature message.
+  // @param slices - the slices of the column the feature belongs to.
+  // @return Status - the error code returned.
+  Status ScanFeature(const std::string_view &feature, ColumnSlices *slices);
+
+  // Decode the values of a bytes list into a tensor.
+  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // @param slices - the payloads of the BytesList messages of the column.
+  // @param tensor - the tensor created from the values.
+  // @return Status - the error code returned.
+  Status DecodeBytesList(const ColDescriptor &current_col, const ColumnSlices &slices,
+                         std::shared_ptr<Tensor> *tensor);
+
+  // Decode the values of a float list into a tensor.
+  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // @param slices - the payloads of the FloatList messages of the column.
+  // @param tensor - the tensor created from the values.
+  // @return Status - the error code returned.
+  Status DecodeFloatList(const ColDescriptor &current_col, const ColumnSlices &slices,
+                         std::shared_ptr<Tensor> *tensor);
+
+  // Decode the values of an int64 list into a tensor, casting the values to type T.
+  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // @param slices - the payloads of the Int64List messages of the column.
+  // @param tensor - the tensor created from the values.
+  // @return Status - the error code returned.
+  template <typename T>
+  Status DecodeIntList(const ColDescriptor &current_col, const ColumnSlices &slices, std::shared_ptr<Tensor> *tensor);
+
+  // Determines which template type to use and calls DecodeIntList
+  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // @param slices - the payloads of the Int64List messages of the column.
+  // @param tensor - the tensor created from the values.
+  // @return Status - the error code returned.
+  Status DecodeIntListSwitch(const ColDescriptor &current_col, const ColumnSlices &slices,
+                             std::shared_ptr<Tensor> *tensor);
+
+  const DataSchema *data_schema_;
+  std::vector<std::string> column_names_;
+  std::unordered_map<std::string_view, int32_t> column_index_;  // keys refer to column_names_
+  std::vector<ColumnSlices> columns_;                           // reused by every Example
+  std::vector<std::string_view> strings_;                       // reused by every string column
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_DECODER_H_
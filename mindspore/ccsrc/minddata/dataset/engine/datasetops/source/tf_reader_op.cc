@@ -20,7 +20,10 @@
 #include <future>
 #include <memory>
 #include <mutex>
+#include <numeric>
+#include <random>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -30,9 +33,11 @@
 #include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_decoder.h"
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/jagged_connector.h"
+#include "minddata/dataset/util/random.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/wait_post.h"
@@ -41,6 +46,8 @@
 namespace mindspore {
 namespace dataset {
 const int64_t kTFRecordFileLimit = 0x140000000;
+// The number of rows in an IOBlock when the rows are shuffled globally
+const int64_t kShuffleRowsPerBlock = 64;
 
 bool TFReaderOp::ValidateFirstRowCrc(const std::string &filename) {
   auto realpath = Common::GetRealPath(filename);
@@ -87,7 +94,11 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
       dataset_files_list_(std::move(dataset_files_list)),
       columns_to_load_(std::move(columns_to_load)),
       data_schema_(std::move(data_schema)),
-      equal_rows_per_shard_(equal_rows_per_shard) {}
+      equal_rows_per_shard_(equal_rows_per_shard),
+      rows_per_block_(0),
+      shuffle_rows_(false),
+      shuffle_rows_seed_(0),
+      shuffle_rows_epoch_(0) {}
 
 // A print method typically used for debugging
 void TFReaderOp::Print(std::ostream &out, bool show_all) const {
@@ -102,6 +113,7 @@ void TFReaderOp::Print(std::ostream &out, bool show_all) const {
     // Then show any custom derived-internal stuff
     out << "\nTotal rows: " << total_rows_ << "\nDevice id: " << device_id_ << "\nNumber of devices: " << num_devices_
         << "\nShuffle files: " << ((shuffle_files_) ? "yes" : "no")
+        << "\nShuffle rows: " << ((shuffle_rows_) ? "yes" : "no")
         << "\nDataset files list: Size: " << dataset_files_list_.size() << "\n";
     for (size_t i = 0; i < dataset_files_list_.size(); ++i) {
       out << " " << dataset_files_list_[i];
@@ -133,6 +145,7 @@ Status TFReaderOp::Init() {
 
   // Build the index with our files such that each file corresponds to a key id.
   RETURN_IF_NOT_OK(filename_index_->insert(dataset_files_list_));
+  RETURN_IF_NOT_OK(LoadFileIndexes());
 
   // The creation of the internal connector has been delayed until now, since we may have adjusted the
   // number of workers.  Now that the worker count is established, create the connector now in the
@@ -141,21 +154,72 @@ Status TFReaderOp::Init() {
 
   jagged_rows_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_);
 
-  // temporary: make size large enough to hold all files + EOE to avoid hangs
-  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(dataset_files_list_.size() / num_workers_)) + 1;
+  // temporary: make size large enough to hold all blocks of an epoch + EOE to avoid hangs
+  int64_t num_blocks = static_cast<int64_t>(dataset_files_list_.size());
+  if (shuffle_rows_) {
+    int64_t shard_rows = (file_row_begin_.back() + num_devices_ - 1) / num_devices_;
+    num_blocks = (shard_rows + kShuffleRowsPerBlock - 1) / kShuffleRowsPerBlock;
+  } else if (!file_indexes_.empty()) {
+    // an indexed file is split into blocks of rows_per_block_ rows, a shard has at most one partial block per file
+    num_blocks = 2 * (num_blocks + static_cast<int64_t>(num_devices_) * num_workers_);
+  }
+  int32_t safe_queue_size = static_cast<int32_t>(num_blocks / num_workers_) + 1;
   io_block_queues_.Init(num_workers_, safe_queue_size);
 
   return Status::OK();
 }
 
+Status TFReaderOp::LoadFileIndexes() {
+  file_indexes_.clear();
+  int64_t total_rows = 0;
+  for (const auto &filename : dataset_files_list_) {
+    std::shared_ptr<TFRecordIndex> index;
+    Status rc = TFRecordIndex::Get(filename, &index);
+    if (rc.IsError()) {
+      MS_LOG(DEBUG) << "TFRecord file is read without index, " << rc.GetErrDescription();
+      continue;
+    }
+    file_indexes_[filename] = index;
+    total_rows += index->num_rows();
+  }
+
+  // The first global row id of every file, followed by the total number of rows
+  file_row_begin_.clear();
+  if (file_indexes_.size() == dataset_files_list_.size()) {
+    int64_t row_begin = 0;
+    for (const auto &filename : dataset_files_list_) {
+      file_row_begin_.push_back(row_begin);
+      row_begin += file_indexes_[filename]->num_rows();
+    }
+    file_row_begin_.push_back(row_begin);
+  }
+
+  // Split the indexed files into blocks, so the workers share the rows of a shard evenly.
+  int64_t num_readers = static_cast<int64_t>(num_devices_) * num_workers_;
+  rows_per_block_ = std::max<int64_t>(1, (total_rows + num_readers - 1) / num_readers);
+
+  if (shuffle_rows_ && (file_row_begin_.empty() || (!equal_rows_per_shard_ && num_devices_ > 1) || total_rows == 0)) {
+    MS_LOG(INFO) << "The rows of TFRecord files are not shuffled globally, it needs the index of every file and "
+                 << "the shards to be split by rows. The files are shuffled instead.";
+    shuffle_rows_ = false;
+  }
+  return Status::OK();
+}
+
 Status TFReaderOp::CalculateNumRowsPerShard() {
-  if (!equal_rows_per_shard_) {
+  if (!equal_rows_per_shard_ && !shuffle_rows_) {
     return Status::OK();
   }
 
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    std::vector<std::string> file(1, it.value());
-    int64_t num = CountTotalRowsSectioned(file, 0, 1);
+    auto index_itr = file_indexes_.find(it.value());
+    int64_t num = 0;
+    if (index_itr != file_indexes_.end()) {
+      num = index_itr->second->num_rows();
+    } else {
+      std::vector<std::string> file(1, it.value());
+      num = CountTotalRowsSectioned(file, 0, 1);
+    }
     filename_numrows_[it.value()] = num;
     num_rows_ += num;
   }
@@ -191,18 +255,13 @@ Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock = std::make_unique<FilenameBlock>(*it, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFile(*it, (*filename_index_)[*it], &queue_index));
         }
       } else {
         // Do an index lookup using that key to get the filename.
         std::string file_name = (*filename_index_)[*it];
         if (NeedPushFileToBlockQueue(file_name, &start_offset, &end_offset, pre_count)) {
-          auto ioBlock = std::make_unique<FilenameBlock>(*it, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          MS_LOG(DEBUG) << "File name " << *it << " start offset " << start_offset << " end_offset " << end_offset;
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFileRange(*it, file_name, start_offset, end_offset, &queue_index));
         }
 
         pre_count += filename_numrows_[file_name];
@@ -239,17 +298,12 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock =
-            std::make_unique<FilenameBlock>(it.key(), kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFile(it.key(), it.value(), &queue_index));
         }
       } else {
         std::string file_name = it.value();
         if (NeedPushFileToBlockQueue(file_name, &start_offset, &end_offset, pre_count)) {
-          auto ioBlock = std::make_unique<FilenameBlock>(it.key(), start_offset, end_offset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFileRange(it.key(), file_name, start_offset, end_offset, &queue_index));
         }
 
         pre_count += filename_numrows_[file_name];
@@ -267,8 +321,74 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
   return Status::OK();
 }
 
+Status TFReaderOp::FillIOBlockRowShuffle() {
+  // Every device shuffles all the rows with the same seed and takes its own part of them. The seed of an epoch is the
+  // configured seed plus the epoch, so the order changes every epoch and is the same in every run with a fixed seed.
+  // A single device without a configured seed takes a random one, the devices of a shard group must agree on theirs.
+  if (shuffle_rows_epoch_ == 0) {
+    shuffle_rows_seed_ = num_devices_ == 1 ? GetSeed() : GlobalContext::config_manager()->seed();
+  }
+  uint32_t seed = shuffle_rows_seed_ + shuffle_rows_epoch_++;
+  std::vector<int64_t> all_rows(file_row_begin_.back());
+  std::iota(all_rows.begin(), all_rows.end(), 0);
+  std::mt19937 rng(seed);
+  std::shuffle(all_rows.begin(), all_rows.end(), rng);
+  shuffled_rows_.resize(num_rows_per_shard_);
+  for (int64_t i = 0; i < num_rows_per_shard_; ++i) {
+    shuffled_rows_[i] = all_rows[(device_id_ * num_rows_per_shard_ + i) % all_rows.size()];
+  }
+
+  // The blocks only carry the range of shuffled_rows_ to read, the rows of a block may be in any file.
+  int64_t key = filename_index_->begin().key();
+  int32_t queue_index = 0;
+  for (int64_t start_offset = 0; start_offset < num_rows_per_shard_; start_offset += kShuffleRowsPerBlock) {
+    {
+      std::unique_lock<std::mutex> lock(load_io_block_queue_mutex_);
+      if (load_io_block_queue_ == false) {
+        break;
+      }
+    }
+    int64_t end_offset = std::min(start_offset + kShuffleRowsPerBlock, num_rows_per_shard_);
+    auto ioBlock = std::make_unique<FilenameBlock>(key, start_offset, end_offset, IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+    queue_index = (queue_index + 1) % num_workers_;
+  }
+  RETURN_IF_NOT_OK(PostEndOfEpoch(queue_index));
+  return Status::OK();
+}
+
+Status TFReaderOp::PushFile(int64_t key, const std::string &file_name, int32_t *queue_index) {
+  auto index_itr = file_indexes_.find(file_name);
+  if (index_itr != file_indexes_.end()) {
+    return PushFileRange(key, file_name, 0, index_itr->second->num_rows(), queue_index);
+  }
+  auto ioBlock = std::make_unique<FilenameBlock>(key, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
+  RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(ioBlock)));
+  *queue_index = (*queue_index + 1) % num_workers_;
+  return Status::OK();
+}
+
+Status TFReaderOp::PushFileRange(int64_t key, const std::string &file_name, int64_t start_offset, int64_t end_offset,
+                                 int32_t *queue_index) {
+  // The range of an indexed file is split into blocks, the workers seek to their first rows.
+  int64_t block_rows = file_indexes_.count(file_name) > 0 ? rows_per_block_ : end_offset - start_offset;
+  int64_t block_start = start_offset;
+  do {
+    int64_t block_end = std::min(block_start + block_rows, end_offset);
+    auto ioBlock = std::make_unique<FilenameBlock>(key, block_start, block_end, IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(ioBlock)));
+    MS_LOG(DEBUG) << "File name " << key << " start offset " << block_start << " end_offset " << block_end;
+    *queue_index = (*queue_index + 1) % num_workers_;
+    block_start = block_end;
+  } while (block_start < end_offset);
+  return Status::OK();
+}
+
 // Reads a tf_file file and loads the data into multiple TensorRows.
 Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) {
+  if (shuffle_rows_) {
+    return LoadShuffledRows(start_offset, end_offset, worker_id);
+  }
   auto realpath = Common::GetRealPath(filename);
   if (!realpath.has_value()) {
     MS_LOG(ERROR) << "Get real path failed, path=" << filename;
@@ -281,274 +401,105 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
   }
 
-  int64_t rows_read = 0;
   int64_t rows_total = 0;
+  auto index_itr = file_indexes_.find(filename);
+  if (index_itr != file_indexes_.end() && start_offset != kInvalidOffset) {
+    // seek to the first row instead of skipping the rows before it
+    if (start_offset >= index_itr->second->num_rows()) {
+      return Status::OK();
+    }
+    (void)reader.seekg(index_itr->second->offset(start_offset), std::ios::beg);
+    rows_total = start_offset;
+  }
+  TFExampleDecoder decoder(data_schema_.get());
+  // The buffer is reused by all the records, it only grows to the size of the largest one.
+  std::string serialized_example;
 
   while (reader.peek() != EOF) {
     if (!load_jagged_connector_) {
       break;
     }
+    if (start_offset != kInvalidOffset && rows_total >= end_offset) {
+      break;
+    }
     RETURN_IF_INTERRUPTED();
 
-    // read length
-    int64_t record_length = 0;
-    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
-
-    // ignore crc header
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-    // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(record_length);
-    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
-
-    int32_t num_columns = data_schema_->NumColumns();
-    TensorRow newRow(num_columns, nullptr);
-
-    if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Invalid file, failed to parse tfrecord file : " + filename;
-        MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
-
-      std::vector<std::string> file_path(num_columns, filename);
-      newRow.setPath(file_path);
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
-      rows_read++;
-      RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
+    if (start_offset == kInvalidOffset || rows_total >= start_offset) {
+      RETURN_IF_NOT_OK(LoadRecord(&reader, filename, &decoder, &serialized_example, worker_id));
+    } else {
+      // the rows of other shards are skipped without being read
+      int64_t record_length = 0;
+      (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.good() && record_length >= 0,
+                                   "Invalid file, failed to read tfrecord file : " + filename);
+      (void)reader.seekg(static_cast<std::streamoff>(sizeof(int32_t) + record_length + sizeof(int32_t)),
+                         std::ios::cur);
     }
-
-    // ignore crc footer
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
     rows_total++;
   }
 
   return Status::OK();
 }
 
-// Parses a single row and puts the data into a tensor table.
-Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, TensorRow *out_row) {
-  int32_t num_columns = data_schema_->NumColumns();
-  for (int32_t col = 0; col < num_columns; ++col) {
-    const ColDescriptor current_col = data_schema_->column(col);
-    const dataengine::Features &example_features = tf_file->features();
-    const google::protobuf::Map<std::string, dataengine::Feature> &feature_map = example_features.feature();
-    auto iter_column = feature_map.find(current_col.name());
-    if (iter_column == feature_map.end()) {
-      RETURN_STATUS_UNEXPECTED("Invalid parameter, column name: " + current_col.name() + " does not exist.");
-    }
-    const dataengine::Feature &column_values_list = iter_column->second;
-    RETURN_IF_NOT_OK(LoadFeature(out_row, column_values_list, current_col, col));
-  }
-
-  return Status::OK();
-}
-
-// Parses a single cell and puts the data into a tensor table.
-Status TFReaderOp::LoadFeature(TensorRow *tensor_row, const dataengine::Feature &column_values_list,
-                               const ColDescriptor &current_col, int32_t col) {
-  const dataengine::Feature::KindCase column_list_type = column_values_list.kind_case();
-  std::unique_ptr<float[]> float_array;     // For staging data from protobuf deserialization
-  const unsigned char *data_ptr = nullptr;  // Generic pointer used for populating the Tensor
-
-  // This variable will point into the above staging variables.
-  // Also used for creating shape attributes.
-  int32_t num_elements = 0;
-
-  // we build a tensor first a read directly into it if we need to cast
-  std::shared_ptr<Tensor> ts;
-
-  // Depending on the type of data from the tf_file, we want to extract 2 things:
-  // 1) A pointer to the data as a const unsigned char *
-  // 2) The number of elements of the data
-  // After those are determined, we can then build the tensor to represent this data.
-  switch (column_list_type) {
-    case dataengine::Feature::KindCase::kBytesList: {
-      RETURN_IF_NOT_OK(LoadBytesList(current_col, column_values_list, &num_elements, &ts));
-
-      break;
-    }
-    case dataengine::Feature::KindCase::kFloatList: {
-      RETURN_IF_NOT_OK(LoadFloatList(current_col, column_values_list, &num_elements, &float_array));
-
-      data_ptr = reinterpret_cast<const unsigned char *>(float_array.get());
-
-      // only floatList needs to create the tensor here, other two lists read directly
-      // into the tensor
-      TensorShape current_shape = TensorShape::CreateUnknownRankShape();
-      RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(current_shape, current_col.type(), data_ptr, &ts));
-      break;
-    }
-    case dataengine::Feature::KindCase::kInt64List: {
-      RETURN_IF_NOT_OK(LoadIntListSwitch(current_col, column_values_list, &num_elements, &ts));
+Status TFReaderOp::LoadShuffledRows(int64_t start_offset, int64_t end_offset, int32_t worker_id) {
+  // The rows of a block are read in the order of the files, so that each file is opened once and read forward.
+  std::vector<int64_t> rows(shuffled_rows_.begin() + start_offset, shuffled_rows_.begin() + end_offset);
+  std::sort(rows.begin(), rows.end());
+  TFExampleDecoder decoder(data_schema_.get());
+  std::string serialized_example;
+  std::ifstream reader;
+  int64_t file_id = -1;
+  for (int64_t row : rows) {
+    if (!load_jagged_connector_) {
       break;
     }
-    case dataengine::Feature::KindCase::KIND_NOT_SET: {
-      std::string err_msg = "Invalid data, column type in tf record file must be uint8, int64 or float32.";
-      RETURN_STATUS_UNEXPECTED(err_msg);
-    }
-    default: {
-      std::string err_msg = "Invalid data, column type in tf record file must be uint8, int64 or float32.";
-      RETURN_STATUS_UNEXPECTED(err_msg);
-    }
-  }
-
-  (*tensor_row)[col] = std::move(ts);
-
-  return Status::OK();
-}
-
-Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                 int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
-  // kBytesList can map to the following DE types ONLY!
-  // DE_UINT8, DE_INT8
-  // Must be single byte type for each element!
-  if (current_col.type() != DataType::DE_UINT8 && current_col.type() != DataType::DE_INT8 &&
-      current_col.type() != DataType::DE_STRING) {
-    std::string err_msg = "Invalid data, invalid data type for Tensor at column: " + current_col.name() +
-                          ", data type should be int8, uint8 or string, but got " + current_col.type().ToString();
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  }
-
-  const dataengine::BytesList &bytes_list = column_values_list.bytes_list();
-
-  *num_elements = bytes_list.value_size();
-
-  if (current_col.type() == DataType::DE_STRING) {
-    TensorShape shape = TensorShape::CreateScalar();
-    RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &shape));
-    RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, shape, tensor));
-    return Status::OK();
-  }
-
-  uint64_t max_size = 0;
-  for (uint32_t i = 0; i < bytes_list.value_size(); ++i) {
-#if defined(__APPLE__)
-    max_size = fmax(max_size, bytes_list.value(i).size());
-#else
-    max_size = std::max(max_size, bytes_list.value(i).size());
-#endif
-  }
-
-  int64_t pad_size = max_size;
-
-  // if user provides a shape in the form of [-1, d1, 2d, ... , dn], we need to pad to d1 * d2 * ... * dn
-  if (current_col.hasShape()) {
-    TensorShape cur_shape = current_col.shape();
-    if (cur_shape.Size() >= 2 && cur_shape[0] == TensorShape::kDimUnknown) {
-      int64_t new_pad_size = 1;
-      for (int i = 1; i < cur_shape.Size(); ++i) {
-        if (cur_shape[i] == TensorShape::kDimUnknown) {
-          std::string err_msg =
-            "Invalid data, more than one unknown dimension in the shape of column: " + current_col.name();
-          RETURN_STATUS_UNEXPECTED(err_msg);
-        }
-        new_pad_size *= cur_shape[i];
-      }
-      pad_size = new_pad_size;
-    } else {
-      if (cur_shape.known() && cur_shape.NumOfElements() != max_size) {
-        std::string err_msg = "Shape in schema's column '" + current_col.name() + "' is incorrect." +
-                              "\nshape received: " + cur_shape.ToString() +
-                              "\ntotal elements in shape received: " + std::to_string(cur_shape.NumOfElements()) +
-                              "\nexpected total elements in shape: " + std::to_string(max_size);
-        RETURN_STATUS_UNEXPECTED(err_msg);
-      }
+    RETURN_IF_INTERRUPTED();
+    if (file_id < 0 || row >= file_row_begin_[file_id + 1]) {
+      file_id = std::upper_bound(file_row_begin_.begin(), file_row_begin_.end(), row) - file_row_begin_.begin() - 1;
+      const std::string &next_file = dataset_files_list_[file_id];
+      auto realpath = Common::GetRealPath(next_file);
+      CHECK_FAIL_RETURN_UNEXPECTED(realpath.has_value(), "Get real path failed, path=" + next_file);
+      reader.close();
+      reader.clear();
+      reader.open(realpath.value());
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.is_open(), "Invalid file, failed to open file: " + next_file);
     }
+    const std::string &filename = dataset_files_list_[file_id];
+    (void)reader.seekg(file_indexes_.at(filename)->offset(row - file_row_begin_[file_id]), std::ios::beg);
+    RETURN_IF_NOT_OK(LoadRecord(&reader, filename, &decoder, &serialized_example, worker_id));
   }
-
-  // know how many elements there are and the total bytes, create tensor here:
-  TensorShape current_shape = TensorShape::CreateScalar();
-  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape((*num_elements) * pad_size, &current_shape));
-  RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, current_shape, current_col.type(), pad_size, tensor));
-
   return Status::OK();
 }
 
-Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                 int32_t *num_elements, std::unique_ptr<float[]> *float_array) {
-  // KFloatList can only map to DE types:
-  // DE_FLOAT32
-  if (current_col.type() != DataType::DE_FLOAT32) {
-    std::string err_msg = "Invalid data, invalid data type for Tensor at column: " + current_col.name() +
-                          ", data type should be string, but got " + current_col.type().ToString();
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  }
-
-  const dataengine::FloatList &float_list = column_values_list.float_list();
-
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = float_list.value_size();
-  *float_array = std::make_unique<float[]>(*num_elements);
-  for (int i = 0; i < float_list.value_size(); ++i) {
-    (*float_array)[i] = float_list.value(i);
-  }
-
-  return Status::OK();
-}
-
-// Determines which template type to use and calls LoadIntList
-Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                     int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
-  if (current_col.type() == DataType::DE_UINT64) {
-    RETURN_IF_NOT_OK(LoadIntList<uint64_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.type() == DataType::DE_INT64) {
-    RETURN_IF_NOT_OK(LoadIntList<int64_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.type() == DataType::DE_UINT32) {
-    RETURN_IF_NOT_OK(LoadIntList<uint32_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.type() == DataType::DE_INT32) {
-    RETURN_IF_NOT_OK(LoadIntList<int32_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.type() == DataType::DE_UINT16) {
-    RETURN_IF_NOT_OK(LoadIntList<uint16_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.type() == DataType::DE_INT16) {
-    RETURN_IF_NOT_OK(LoadIntList<int16_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.type() == DataType::DE_UINT8) {
-    RETURN_IF_NOT_OK(LoadIntList<uint8_t>(current_col, column_values_list, num_elements, tensor));
-  } else if (current_col.type() == DataType::DE_INT8) {
-    RETURN_IF_NOT_OK(LoadIntList<int8_t>(current_col, column_values_list, num_elements, tensor));
-  } else {
-    std::string err_msg = "Invalid data, invalid datatype for Tensor at column: " + current_col.name() +
-                          ", data type should be uint64, int64, uint32, int32, uint16, int16, uint8 or int8" +
-                          ", but got " + current_col.type().ToString();
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  }
-
-  return Status::OK();
-}
-
-// Reads values from a bytes list and casts the value to type T, must be an integral type
-// compatible with int64_t
-template <typename T>
-Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                               int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
-  if (!(current_col.type().IsInt())) {
-    std::string err_msg = "Invalid data, invalid data type for Tensor at column: " + current_col.name() +
-                          ", data type should be int, but got " + current_col.type().ToString();
-    RETURN_STATUS_UNEXPECTED(err_msg);
-  }
-
-  const dataengine::Int64List &int64_list = column_values_list.int64_list();
+Status TFReaderOp::LoadRecord(std::ifstream *reader, const std::string &filename, TFExampleDecoder *decoder,
+                              std::string *serialized_example, int32_t worker_id) {
+  // read length
+  int64_t record_length = 0;
+  (void)reader->read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+  CHECK_FAIL_RETURN_UNEXPECTED(reader->good() && record_length >= 0,
+                               "Invalid file, failed to read tfrecord file : " + filename);
 
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = int64_list.value_size();
+  // ignore crc header
+  (void)reader->ignore(static_cast<std::streamsize>(sizeof(int32_t)));
 
-  // know how many elements there are, create tensor here:
-  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
-  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &current_shape));
-  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
+  // read serialized Example
+  serialized_example->resize(record_length);
+  (void)reader->read(&(*serialized_example)[0], static_cast<std::streamsize>(record_length));
+  CHECK_FAIL_RETURN_UNEXPECTED(reader->gcount() == record_length,
+                               "Invalid file, failed to read tfrecord file : " + filename);
 
-  int64_t i = 0;
-  auto it = (*tensor)->begin<T>();
-  for (; it != (*tensor)->end<T>(); i++, ++it) {
-    T element = static_cast<T>(int64_list.value(i));
-    *it = element;
-  }
+  // ignore crc footer
+  (void)reader->ignore(static_cast<std::streamsize>(sizeof(int32_t)));
 
+  int32_t num_columns = data_schema_->NumColumns();
+  TensorRow newRow(num_columns, nullptr);
+  std::vector<std::string> file_path(num_columns, filename);
+  newRow.setPath(file_path);
+  Status rc = decoder->Decode(std::string_view(serialized_example->data(), record_length), &newRow);
+  if (rc.IsError()) {
+    RETURN_STATUS_UNEXPECTED(rc.GetErrDescription() + " File: " + filename);
+  }
+  RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
   return Status::OK();
 }
 
@@ -688,6 +639,17 @@ int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &file
       continue;
     }
 
+    int64_t num_rows = 0;
+    std::shared_ptr<TFRecordIndex> index;
+    if (TFRecordIndex::CountRows(filenames[i], &num_rows).IsOk()) {
+      rows_read += num_rows;
+      continue;
+    }
+    if (TFRecordIndex::SaveEnabled() && TFRecordIndex::Get(filenames[i], &index).IsOk()) {
+      rows_read += index->num_rows();
+      continue;
+    }
+
     std::ifstream reader;
     reader.open(realpath.value());
     if (!reader) {
@@ -727,6 +689,9 @@ Status TFReaderOp::ComputeColMap() {
   return Status::OK();
 }
 Status TFReaderOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
+  if (shuffle_rows_) {
+    return FillIOBlockRowShuffle();
+  }
   if (shuffle_files_) {
     return FillIOBlockShuffle(i_keys);
   }
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <condition_variable>
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -32,14 +33,9 @@
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
+#include "minddata/dataset/engine/datasetops/source/tf_record_index.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 
-namespace dataengine {
-class Example;
-class Feature;
-class BytesList;
-}  // namespace dataengine
-
 namespace mindspore {
 namespace dataset {
 template <typename T>
@@ -50,6 +46,7 @@ class Connector;
 
 class JaggedConnector;
 class FilenameBlock;
+class TFExampleDecoder;
 
 using StringIndex = AutoIndexObj<std::string>;
 
@@ -104,6 +101,15 @@ class TFReaderOp : public NonMappableLeafOp {
 
   static bool ValidateFirstRowCrc(const std::string &filename);
 
+  /// Request reading the rows in a global random order, instead of shuffling the files only. It must be called before
+  /// Init(), which keeps it only if every file has an index and the rows are sharded by row.
+  /// @param shuffle_rows - whether or not to shuffle the rows.
+  void SetShuffleRows(bool shuffle_rows) { shuffle_rows_ = shuffle_rows; }
+
+  /// Check the rows are read in a global random order, valid after Init().
+  /// @return bool - true if the rows are shuffled by the op itself.
+  bool ShuffleRows() const { return shuffle_rows_; }
+
  private:
   // Reads a tf_file file and loads the data into multiple TensorRows.
   // @param filename - the tf_file file to read.
@@ -113,57 +119,26 @@ class TFReaderOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
-  // Parses a single row and puts the data into a tensor table.
-  // @param tf_file - the row to be parsed.
-  // @param tensor_table - the tensor table to put the parsed data in.
-  // @param row - the id of the row filled in the tensor table.
+  // Reads a range of the rows in shuffled_rows_ and loads them into multiple TensorRows.
+  // @param start_offset - the start offset in shuffled_rows_.
+  // @param end_offset - the end offset in shuffled_rows_.
+  // @param worker_id - the id of the worker that is executing this function.
   // @return Status - the error code returned.
-  Status LoadExample(const dataengine::Example *tf_file, TensorRow *out_row);
+  Status LoadShuffledRows(int64_t start_offset, int64_t end_offset, int32_t worker_id);
 
-  // Parses a single cell and puts the data into a tensor table.
-  // @param tensor_table - the tensor table to put the parsed data in.
-  // @param column_values_list - the cell to parse.
-  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // Reads the record at the current position of a file and sends its row to the jagged connector.
+  // @param reader - the stream of the tf_file file.
+  // @param filename - the tf_file file to read.
+  // @param decoder - the decoder of the records.
+  // @param serialized_example - the buffer to read the record into.
+  // @param worker_id - the id of the worker that is executing this function.
   // @return Status - the error code returned.
-  Status LoadFeature(TensorRow *tensor_row, const dataengine::Feature &column_values_list,
-                     const ColDescriptor &current_col, int32_t col);
+  Status LoadRecord(std::ifstream *reader, const std::string &filename, TFExampleDecoder *decoder,
+                    std::string *serialized_example, int32_t worker_id);
 
-  /// Reads values from a bytes list
-  /// @param current_col - the column descriptor containing the expected shape and type of the data.
-  /// @param column_values_list - the cell that contains the bytes list to read from.
-  /// @param elementStr - the string we read the value into.
-  /// @return Status - the error code returned.
-  static Status LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                              int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
-
-  /// Reads values from a float list
-  /// @param current_col - the column descriptor containing the expected shape and type of the data.
-  /// @param column_values_list - the cell that contains the float list to read from.
-  /// @Param numElements - number of values in the float list.
-  /// @param float_array - the array we read the values into.
-  /// @return Status - the error code returned.
-  Status LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                       int32_t *num_elements, std::unique_ptr<float[]> *float_array);
-
-  /// Reads values from a bytes list and casts the value to type T, must be an integral
-  /// type compatible with int64_t
-  /// @param current_col - the column descriptor containing the expected shape and type of the data.
-  /// @param column_values_list - the cell that contains the int list to read from.
-  /// @Param num_elements - number of values in the int list.
-  /// @param tensor - the tensor we read the values into.
-  /// @return Status - the error code returned.
-  template <typename T>
-  Status LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                     int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
-
-  /// Determines which template type to use and calls LoadIntList
-  /// @param current_col - the column descriptor containing the expected shape and type of the data.
-  /// @param column_values_list - the cell that contains the int list to read from.
-  /// @Param numElements - number of values in the int list.
-  /// @param tensor - the tensor we read the values into.
-  /// @return Status - the error code returned.
-  Status LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                           int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
+  // Loads the indexes of the files which have one, and decides whether the rows can be shuffled.
+  // @return Status - the error code returned.
+  Status LoadFileIndexes();
 
   /// Reads one row of data from a tf file and creates a schema based on that row
   /// @return Status - the error code returned.
@@ -193,6 +168,28 @@ class TFReaderOp : public NonMappableLeafOp {
    */
   Status FillIOBlockNoShuffle();
 
+  // Fill IO block queue with ranges of the rows of this shard in a global random order
+  // @return Status - the error code returned.
+  Status FillIOBlockRowShuffle();
+
+  // Push all the rows of a file. A file without an index is pushed as one block with no offsets.
+  // @param key - the key of the file.
+  // @param file_name - the name of the file.
+  // @param queue_index - the queue to push the first block to, the next queue after the last block is returned.
+  // @return Status - the error code returned.
+  Status PushFile(int64_t key, const std::string &file_name, int32_t *queue_index);
+
+  // Push the rows [start_offset, end_offset) of a file. If the file has an index, it can be read from any row, so the
+  // range is split into blocks of rows_per_block_ rows which go to different workers.
+  // @param key - the key of the file.
+  // @param file_name - the name of the file.
+  // @param start_offset - the first row to read.
+  // @param end_offset - one greater than the last row to read.
+  // @param queue_index - the queue to push the first block to, the next queue after the last block is returned.
+  // @return Status - the error code returned.
+  Status PushFileRange(int64_t key, const std::string &file_name, int64_t start_offset, int64_t end_offset,
+                       int32_t *queue_index);
+
   // Calculate number of rows in each shard.
   // @return Status - the error code returned.
   Status CalculateNumRowsPerShard() override;
@@ -206,6 +203,15 @@ class TFReaderOp : public NonMappableLeafOp {
   std::unique_ptr<DataSchema> data_schema_;
 
   bool equal_rows_per_shard_;
+
+  // The indexes of the files which have one, they are only read after Init().
+  std::map<std::string, std::shared_ptr<TFRecordIndex>> file_indexes_;
+  int64_t rows_per_block_;
+  bool shuffle_rows_;
+  uint32_t shuffle_rows_seed_;   // the seed of the first epoch of the row shuffle
+  uint32_t shuffle_rows_epoch_;  // the number of epochs shuffled so far
+  std::vector<int64_t> file_row_begin_;  // the first row of each file in all the rows, followed by the number of rows
+  std::vector<int64_t> shuffled_rows_;   // the rows of this shard in the order of the current epoch
 };
 }  // namespace dataset
 }  // namespace mindspore
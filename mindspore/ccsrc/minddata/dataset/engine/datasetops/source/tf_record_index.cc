@@ -0,0 +1,185 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_record_index.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "debug/common.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr char kTFRecordIndexMagic[8] = "MSTFIDX";
+constexpr uint32_t kTFRecordIndexVersion = 2;
+constexpr char kTFRecordIndexSuffix[] = ".idx";
+// A record is its uint64 length, the masked crc of the length, the data and the masked crc of the data.
+constexpr int64_t kRecordHeaderSize = sizeof(int64_t) + sizeof(int32_t);
+constexpr int64_t kRecordFooterSize = sizeof(int32_t);
+
+// The index file is the header followed by the int64_t offsets of the records.
+struct TFRecordIndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  // The size and the modification time in nanoseconds of the TFRecord file which the index is built from
+  int64_t file_size;
+  int64_t file_mtime_ns;
+  int64_t num_rows;
+};
+
+// A file rewritten in the same second with the same size is told apart by the nanoseconds of its mtime.
+Status GetFileStat(const std::string &filename, int64_t *size, int64_t *mtime_ns) {
+  constexpr int64_t kNsPerSecond = 1000000000;
+  struct stat st;
+  CHECK_FAIL_RETURN_UNEXPECTED(stat(filename.c_str(), &st) == 0, "Failed to get the status of file: " + filename);
+  *size = st.st_size;
+#if defined(_WIN32) || defined(_WIN64)
+  *mtime_ns = static_cast<int64_t>(st.st_mtime) * kNsPerSecond;
+#elif defined(__APPLE__)
+  *mtime_ns = static_cast<int64_t>(st.st_mtimespec.tv_sec) * kNsPerSecond + st.st_mtimespec.tv_nsec;
+#else
+  *mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * kNsPerSecond + st.st_mtim.tv_nsec;
+#endif
+  return Status::OK();
+}
+
+// Read and check the header of the index file of a TFRecord file.
+Status ReadHeader(const std::string &filename, std::ifstream *in, TFRecordIndexHeader *header) {
+  std::string index_file = TFRecordIndex::IndexFileName(filename);
+  in->open(index_file, std::ios::in | std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED(in->is_open(), "There is no index file: " + index_file);
+  (void)in->read(reinterpret_cast<char *>(header), sizeof(TFRecordIndexHeader));
+  CHECK_FAIL_RETURN_UNEXPECTED(in->gcount() == static_cast<std::streamsize>(sizeof(TFRecordIndexHeader)) &&
+                                 memcmp(header->magic, kTFRecordIndexMagic, sizeof(kTFRecordIndexMagic)) == 0 &&
+                                 header->version == kTFRecordIndexVersion && header->num_rows >= 0 &&
+                                 header->num_rows <= header->file_size / (kRecordHeaderSize + kRecordFooterSize),
+                               "Invalid index file: " + index_file);
+  int64_t file_size = 0;
+  int64_t file_mtime_ns = 0;
+  RETURN_IF_NOT_OK(GetFileStat(filename, &file_size, &file_mtime_ns));
+  CHECK_FAIL_RETURN_UNEXPECTED(header->file_size == file_size && header->file_mtime_ns == file_mtime_ns,
+                               "The index file is out of date: " + index_file);
+  return Status::OK();
+}
+}  // namespace
+
+std::string TFRecordIndex::IndexFileName(const std::string &filename) { return filename + kTFRecordIndexSuffix; }
+
+bool TFRecordIndex::SaveEnabled() {
+  std::string save = common::GetEnv(kTFRecordIndexEnv);
+  return save == "1" || save == "true" || save == "True";
+}
+
+Status TFRecordIndex::CountRows(const std::string &filename, int64_t *num_rows) {
+  std::ifstream in;
+  TFRecordIndexHeader header;
+  RETURN_IF_NOT_OK(ReadHeader(filename, &in, &header));
+  *num_rows = header.num_rows;
+  return Status::OK();
+}
+
+Status TFRecordIndex::Get(const std::string &filename, std::shared_ptr<TFRecordIndex> *index) {
+  auto new_index = std::make_shared<TFRecordIndex>();
+  Status rc = new_index->Load(filename);
+  if (rc.IsError()) {
+    if (!SaveEnabled()) {
+      return rc;
+    }
+    RETURN_IF_NOT_OK(new_index->Build(filename));
+    rc = new_index->Save(filename);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to write the index of TFRecord file: " << filename << ", " << rc.GetErrDescription();
+    }
+  }
+  *index = std::move(new_index);
+  return Status::OK();
+}
+
+Status TFRecordIndex::Load(const std::string &filename) {
+  std::ifstream in;
+  TFRecordIndexHeader header;
+  RETURN_IF_NOT_OK(ReadHeader(filename, &in, &header));
+  std::vector<int64_t> offsets(header.num_rows);
+  auto bytes = static_cast<std::streamsize>(offsets.size() * sizeof(int64_t));
+  (void)in.read(reinterpret_cast<char *>(offsets.data()), bytes);
+  CHECK_FAIL_RETURN_UNEXPECTED(in.gcount() == bytes, "Invalid index file: " + IndexFileName(filename));
+  file_size_ = header.file_size;
+  file_mtime_ns_ = header.file_mtime_ns;
+  offsets_ = std::move(offsets);
+  return Status::OK();
+}
+
+Status TFRecordIndex::Build(const std::string &filename) {
+  auto realpath = Common::GetRealPath(filename);
+  CHECK_FAIL_RETURN_UNEXPECTED(realpath.has_value(), "Get real path failed, path=" + filename);
+  RETURN_IF_NOT_OK(GetFileStat(realpath.value(), &file_size_, &file_mtime_ns_));
+  std::ifstream reader(realpath.value(), std::ios::in | std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED(reader.is_open(), "Invalid file, failed to open file: " + filename);
+
+  // Only the lengths are read, the data of the records are skipped by seeking.
+  offsets_.clear();
+  int64_t offset = 0;
+  while (offset + kRecordHeaderSize <= file_size_) {
+    int64_t record_length = 0;
+    (void)reader.seekg(offset, std::ios::beg);
+    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.good(), "Invalid file, failed to read tfrecord file: " + filename);
+    int64_t next_offset = offset + kRecordHeaderSize + record_length + kRecordFooterSize;
+    if (record_length < 0 || next_offset > file_size_) {
+      MS_LOG(WARNING) << "The last record of TFRecord file is incomplete and not indexed, file: " << filename
+                      << ", offset: " << offset;
+      break;
+    }
+    offsets_.push_back(offset);
+    offset = next_offset;
+  }
+  return Status::OK();
+}
+
+Status TFRecordIndex::Save(const std::string &filename) const {
+  TFRecordIndexHeader header;
+  (void)memcpy(header.magic, kTFRecordIndexMagic, sizeof(kTFRecordIndexMagic));
+  header.version = kTFRecordIndexVersion;
+  header.reserved = 0;
+  header.file_size = file_size_;
+  header.file_mtime_ns = file_mtime_ns_;
+  header.num_rows = num_rows();
+
+  // Write a temporary file and rename it, so the other processes never see a partial index.
+  std::string index_file = IndexFileName(filename);
+  std::string temp_file = index_file + ".tmp." + std::to_string(getpid());
+  std::ofstream out(temp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(out.is_open(), "Failed to create index file: " + temp_file);
+  (void)out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  (void)out.write(reinterpret_cast<const char *>(offsets_.data()),
+                  static_cast<std::streamsize>(offsets_.size() * sizeof(int64_t)));
+  out.close();
+  if (out.fail() || rename(temp_file.c_str(), index_file.c_str()) != 0) {
+    (void)remove(temp_file.c_str());
+    RETURN_STATUS_UNEXPECTED("Failed to write index file: " + index_file);
+  }
+  MS_LOG(INFO) << "Write TFRecord index " << index_file << " with " << offsets_.size() << " records.";
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// The environment variable which enables writing the index files. If it is set to "1" or "true", the index of a
+// TFRecord file without a valid one is written the first time the file is scanned. An existing valid index is always
+// used, however it was written.
+const char kTFRecordIndexEnv[] = "MS_TFRECORD_INDEX";
+
+// TFRecordIndex is the offset of every record in a TFRecord file, so the records can be counted without reading the
+// file and a record can be read with one seek. It is saved beside the file as "<file>.idx", which is only valid as
+// long as the size and the modification time of the file are the ones it is built from.
+class TFRecordIndex {
+ public:
+  TFRecordIndex() = default;
+
+  ~TFRecordIndex() = default;
+
+  // Get the name of the index file of a TFRecord file
+  // @param filename - the TFRecord file.
+  // @return std::string - the index file name.
+  static std::string IndexFileName(const std::string &filename);
+
+  // Check writing the index files is enabled by kTFRecordIndexEnv
+  // @return bool - true if the missing index files should be written.
+  static bool SaveEnabled();
+
+  // Count the records of a TFRecord file from the header of its index file only.
+  // @param filename - the TFRecord file.
+  // @param num_rows - the number of records.
+  // @return Status - the error code returned, fails if there is no valid index file.
+  static Status CountRows(const std::string &filename, int64_t *num_rows);
+
+  // Get the index of a TFRecord file. The index file is loaded if it is valid. Otherwise, if SaveEnabled(), the file
+  // is scanned and its index file is written, a failure to write the index file is not an error.
+  // @param filename - the TFRecord file.
+  // @param index - the index of the file.
+  // @return Status - the error code returned, fails if the file has no index.
+  static Status Get(const std::string &filename, std::shared_ptr<TFRecordIndex> *index);
+
+  // Load the index file of a TFRecord file.
+  // @param filename - the TFRecord file.
+  // @return Status - the error code returned, fails if there is no valid index file.
+  Status Load(const std::string &filename);
+
+  // Build the index by scanning the record headers of a TFRecord file.
+  // @param filename - the TFRecord file.
+  // @return Status - the error code returned.
+  Status Build(const std::string &filename);
+
+  // Write the index file of the TFRecord file the index is built from, the file is replaced atomically.
+  // @param filename - the TFRecord file.
+  // @return Status - the error code returned.
+  Status Save(const std::string &filename) const;
+
+  // @return int64_t - the number of records in the file.
+  int64_t num_rows() const { return static_cast<int64_t>(offsets_.size()); }
+
+  // @param row - the row id of a record in the file, which must be less than num_rows().
+  // @return int64_t - the offset of the length field of the record in the file.
+  int64_t offset(int64_t row) const { return offsets_[row]; }
+
+ private:
+  int64_t file_size_ = 0;
+  int64_t file_mtime_ns_ = 0;
+  std::vector<int64_t> offsets_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_INDEX_H_
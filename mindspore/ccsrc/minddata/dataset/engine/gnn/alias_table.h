@@ -0,0 +1,89 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_ALIAS_TABLE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_ALIAS_TABLE_H_
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "minddata/dataset/util/random.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+// Get the random generator of the calling thread, so the samplers share no state between threads.
+inline std::mt19937 *GetThreadRandomGenerator() {
+  thread_local std::mt19937 rnd(GetSeed());
+  return &rnd;
+}
+
+// Build the alias table (Vose's method) of 'num' non-normalized weights into 'prob' and 'alias', after which
+// sampling an index in proportion to its weight costs O(1). If no weight is positive, the samples are uniform.
+// @param const float *weights - Non-normalized weights
+// @param size_t num - Number of weights
+// @param float *prob - Returned probability of keeping the slot, num elements
+// @param uint32_t *alias - Returned index which the slot switches to, num elements
+inline void BuildAliasTable(const float *weights, size_t num, float *prob, uint32_t *alias) {
+  double sum = 0.0;
+  for (size_t i = 0; i < num; ++i) {
+    sum += weights[i] > 0 ? weights[i] : 0;
+  }
+  std::vector<double> scaled(num, 1.0);
+  if (sum > 0) {
+    for (size_t i = 0; i < num; ++i) {
+      scaled[i] = (weights[i] > 0 ? weights[i] : 0) * num / sum;
+    }
+  }
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (size_t i = 0; i < num; ++i) {
+    scaled[i] < 1.0 ? small.push_back(i) : large.push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    uint32_t s = small.back();
+    small.pop_back();
+    uint32_t l = large.back();
+    prob[s] = static_cast<float>(scaled[s]);
+    alias[s] = l;
+    scaled[l] = scaled[l] + scaled[s] - 1.0;
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // The rest are 1.0 except for the rounding errors.
+  for (uint32_t i : small) {
+    prob[i] = 1.0;
+    alias[i] = i;
+  }
+  for (uint32_t i : large) {
+    prob[i] = 1.0;
+    alias[i] = i;
+  }
+}
+
+// Sample an index from the alias table built by BuildAliasTable, num must be greater than 0.
+inline uint32_t SampleAliasTable(const float *prob, const uint32_t *alias, size_t num, std::mt19937 *rnd) {
+  std::uniform_int_distribution<uint32_t> index_dist(0, static_cast<uint32_t>(num - 1));
+  std::uniform_real_distribution<float> prob_dist(0.0, 1.0);
+  uint32_t index = index_dist(*rnd);
+  return prob_dist(*rnd) < prob[index] ? index : alias[index];
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_ALIAS_TABLE_H_
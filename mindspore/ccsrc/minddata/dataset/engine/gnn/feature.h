@@ -42,6 +42,9 @@ class Feature {
   // @return NodeIdType - Returned feature type
   FeatureType type() const { return type_name_; }
 
+  // @return bool - whether the value is the (offset, length) of the data in the shared memory or the graph image
+  bool is_shared_memory() const { return is_shared_memory_; }
+
  private:
   FeatureType type_name_;
   std::shared_ptr<Tensor> value_;
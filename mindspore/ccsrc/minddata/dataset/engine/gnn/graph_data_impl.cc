@@ -21,9 +21,16 @@
 #include <numeric>
 #include <utility>
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
 #include "minddata/dataset/core/tensor_shape.h"
+#include "minddata/dataset/engine/gnn/alias_table.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 #include "minddata/dataset/util/random.h"
+#include "utils/ms_utils.h"
 namespace mindspore {
 namespace dataset {
 namespace gnn {
@@ -415,6 +422,13 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
           feature = default_feature;
         }
       }
+#if !defined(_WIN32) && !defined(_WIN64)
+      if (feature->is_shared_memory()) {
+        RETURN_IF_NOT_OK(InsertImageFeature(feature, index, fea_tensor));
+        index++;
+        continue;
+      }
+#endif
       RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
       index++;
     }
@@ -499,6 +513,13 @@ Status GraphDataImpl::GetEdgeFeature(const std::shared_ptr<Tensor> &edges,
       if (!GetEdgeByEdgeId(*edge_itr, &edge).IsOk() || !edge->GetFeatures(f_type, &feature).IsOk()) {
         feature = default_feature;
       }
+#if !defined(_WIN32) && !defined(_WIN64)
+      if (feature->is_shared_memory()) {
+        RETURN_IF_NOT_OK(InsertImageFeature(feature, index, fea_tensor));
+        index++;
+        continue;
+      }
+#endif
       RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
       index++;
     }
@@ -607,6 +628,17 @@ Status GraphDataImpl::GraphInfo(py::dict *out) {
 #endif
 
 Status GraphDataImpl::LoadNodeAndEdge() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  std::string image_file = common::GetEnv(kGnnGraphImageEnv);
+  // The server shares the features through the shared memory already
+  if (!image_file.empty() && !server_mode_) {
+    return LoadGraphImage(image_file);
+  }
+#endif
+  return LoadMindRecord();
+}
+
+Status GraphDataImpl::LoadMindRecord() {
   GraphLoader gl(this, dataset_file_, num_workers_, server_mode_);
   // ask graph_loader to load everything into memory
   RETURN_IF_NOT_OK(gl.InitAndLoad());
@@ -615,6 +647,55 @@ Status GraphDataImpl::LoadNodeAndEdge() {
   return Status::OK();
 }
 
+#if !defined(_WIN32) && !defined(_WIN64)
+Status GraphDataImpl::LoadGraphImage(const std::string &image_file) {
+  // The processes which load the graph at the same time wait for the first one to write the image.
+  std::string lock_file = image_file + ".lock";
+  int lock_fd = open(lock_file.c_str(), O_CREAT | O_RDWR, 0666);
+  CHECK_FAIL_RETURN_UNEXPECTED(lock_fd != -1, "Failed to open lock file: " + lock_file);
+  if (flock(lock_fd, LOCK_EX) != 0) {
+    (void)close(lock_fd);
+    RETURN_STATUS_UNEXPECTED("Failed to lock file: " + lock_file);
+  }
+  auto graph_image = std::make_unique<GraphImage>(image_file);
+  Status rc = graph_image->Open(dataset_file_);
+  if (rc.IsOk()) {
+    rc = graph_image->Load(this);
+    graph_image_ = std::move(graph_image);
+  } else {
+    MS_LOG(INFO) << "Load graph from " << dataset_file_ << " and write graph image, " << rc.ToString();
+    rc = LoadMindRecord();
+    if (rc.IsOk()) {
+      Status s = graph_image->Save(this, dataset_file_);
+      if (s.IsError()) {
+        MS_LOG(WARNING) << "Failed to write graph image, the other processes load the graph by themselves. "
+                        << s.ToString();
+      }
+    }
+  }
+  (void)flock(lock_fd, LOCK_UN);
+  (void)close(lock_fd);
+  return rc;
+}
+
+Status GraphDataImpl::InsertImageFeature(const std::shared_ptr<Feature> &feature, dsize_t index,
+                                         const std::shared_ptr<Tensor> &out) {
+  CHECK_FAIL_RETURN_UNEXPECTED(graph_image_ != nullptr, "The feature is not in a graph image.");
+  const uint8_t *data = nullptr;
+  int64_t len = 0;
+  RETURN_IF_NOT_OK(graph_image_->GetFeatureData(feature, &data, &len));
+  uchar *start_addr = nullptr;
+  TensorShape remaining = TensorShape::CreateScalar();
+  RETURN_IF_NOT_OK(out->StartAddrOfIndex({index}, &start_addr, &remaining));
+  int64_t size = remaining.NumOfElements() * out->type().SizeInBytes();
+  CHECK_FAIL_RETURN_UNEXPECTED(size == len, "The size of the feature does not match the default feature.");
+  if (len > 0 && memcpy_s(start_addr, size, data, len) != EOK) {
+    RETURN_STATUS_UNEXPECTED("Failed to copy the feature from the graph image.");
+  }
+  return Status::OK();
+}
+#endif
+
 Status GraphDataImpl::GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node) {
   auto itr = node_id_map_.find(id);
   if (itr == node_id_map_.end()) {
@@ -638,7 +719,13 @@ Status GraphDataImpl::GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge
 }
 
 GraphDataImpl::RandomWalkBase::RandomWalkBase(GraphDataImpl *graph)
-    : graph_(graph), step_home_param_(1.0), step_away_param_(1.0), default_node_(-1), num_walks_(1), num_workers_(1) {}
+    : graph_(graph),
+      step_home_param_(1.0),
+      step_away_param_(1.0),
+      default_node_(-1),
+      num_walks_(1),
+      num_workers_(1),
+      rnd_(GetSeed()) {}
 
 Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_list,
                                             const std::vector<NodeType> &meta_path, float step_home_param,
@@ -681,35 +768,40 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, EdgeTransitionMap *edge_transitions,
+                                                   std::vector<NodeIdType> *walk_path) {
   // Simulate a random walk starting from start node.
   auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
   // walk simulate
   while (walk.size() - 1 < meta_path_.size()) {
-    // current nodE
+    // current node
     auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
-
-    // current neighbors
-    std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
-    std::sort(cur_neighbors.begin(), cur_neighbors.end());
-
-    // break if no neighbors
-    if (cur_neighbors.empty()) {
-      break;
-    }
-
-    // walk by the fist node, then by the previous 2 nodes
-    std::shared_ptr<StochasticIndex> stochastic_index;
+    NodeIdType next_node_id;
     if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
+      // walk by the first node, every neighbor has the same probability
+      std::shared_ptr<Node> cur_node;
+      RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
+      std::vector<NodeIdType> cur_neighbors;
+      RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[0], &cur_neighbors, true));
+      // break if no neighbors
+      if (cur_neighbors.empty()) {
+        break;
+      }
+      std::uniform_int_distribution<size_t> distribution(0, cur_neighbors.size() - 1);
+      next_node_id = cur_neighbors[distribution(rnd_)];
     } else {
+      // then by the previous 2 nodes
       NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+      std::shared_ptr<EdgeTransition> transition;
+      RETURN_IF_NOT_OK(GetEdgeTransition(prev_node_id, cur_node_id, walk.size() - 2, edge_transitions, &transition));
+      // break if no neighbors
+      if (transition->neighbors.empty()) {
+        break;
+      }
+      uint32_t index = SampleAliasTable(transition->alias_prob.data(), transition->alias_index.data(),
+                                        transition->neighbors.size(), &rnd_);
+      next_node_id = transition->neighbors[index];
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
     walk.push_back(next_node_id);
   }
 
@@ -722,53 +814,47 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
 }
 
 Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
+  // The transitions are shared by the walks of this call only, so their memory is bounded by the edges walked.
+  EdgeTransitionMap edge_transitions;
   for (int32_t i = 0; i < num_walks_; ++i) {
     for (const auto &node : node_list_) {
       std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
+      RETURN_IF_NOT_OK(Node2vecWalk(node, &edge_transitions, &walk));
       walks->push_back(walk);
     }
   }
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                                                         std::shared_ptr<StochasticIndex> *node_probability) {
-  // Generate alias nodes
-  std::shared_ptr<Node> node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(node_id, &node));
-  std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
-  std::sort(neighbors.begin(), neighbors.end());
-  auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
-  *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
-  return Status::OK();
-}
+Status GraphDataImpl::RandomWalkBase::GetEdgeTransition(const NodeIdType &src, const NodeIdType &dst,
+                                                        uint32_t meta_path_index, EdgeTransitionMap *edge_transitions,
+                                                        std::shared_ptr<EdgeTransition> *edge_transition) {
+  // The alias table of an edge only depends on the edge and the node types, so it is built once and reused by the
+  // following walks.
+  auto key = std::make_tuple(src, dst, meta_path_[meta_path_index], meta_path_[meta_path_index + 1]);
+  auto itr = edge_transitions->find(key);
+  if (itr != edge_transitions->end()) {
+    *edge_transition = itr->second;
+    return Status::OK();
+  }
 
-Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
-                                                         uint32_t meta_path_index,
-                                                         std::shared_ptr<StochasticIndex> *edge_probability) {
-  // Get the alias edge setup lists for a given edge.
   std::shared_ptr<Node> src_node;
   RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(src, &src_node));
   std::vector<NodeIdType> src_neighbors;
   RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
+  std::sort(src_neighbors.begin(), src_neighbors.end());
 
   std::shared_ptr<Node> dst_node;
   RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(dst, &dst_node));
-  std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
+  auto transition = std::make_shared<EdgeTransition>();
+  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &transition->neighbors, true));
 
-  std::sort(dst_neighbors.begin(), dst_neighbors.end());
   std::vector<float> non_normalized_probability;
-  for (const auto &dst_nbr : dst_neighbors) {
+  non_normalized_probability.reserve(transition->neighbors.size());
+  for (const auto &dst_nbr : transition->neighbors) {
     if (dst_nbr == src) {
       non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
-      continue;
-    }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
+    } else if (std::binary_search(src_neighbors.begin(), src_neighbors.end(), dst_nbr)) {
       // stay close, this node connect both src and dst
       non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
     } else {
@@ -776,69 +862,14 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
       non_normalized_probability.push_back(1.0 / step_away_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
     }
   }
-
-  *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+  transition->alias_prob.resize(non_normalized_probability.size());
+  transition->alias_index.resize(non_normalized_probability.size());
+  BuildAliasTable(non_normalized_probability.data(), non_normalized_probability.size(), transition->alias_prob.data(),
+                  transition->alias_index.data());
+  (void)edge_transitions->emplace(key, transition);
+  *edge_transition = transition;
   return Status::OK();
 }
-
-StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
-  uint32_t K = probability.size();
-  std::vector<int32_t> switch_to_large_index(K, 0);
-  std::vector<float> weight(K, .0);
-  std::vector<int32_t> smaller;
-  std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
-  float accumulate_threshold = 0.0;
-  for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
-    accumulate_threshold += threshold_one;
-    weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
-    weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
-  }
-
-  while ((!smaller.empty()) && (!larger.empty())) {
-    uint32_t small = smaller.back();
-    smaller.pop_back();
-    uint32_t large = larger.back();
-    larger.pop_back();
-    switch_to_large_index[small] = large;
-    weight[large] = weight[large] + weight[small] - 1.0;
-    weight[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
-  }
-  return StochasticIndex(switch_to_large_index, weight);
-}
-
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
-  const uint32_t size_of_index = switch_to_large_index.size();
-
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(0.0, 1.0);
-
-  // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
-
-  if (distribution(random_device) < weight[random_idx]) {
-    return random_idx;
-  }
-  return switch_to_large_index[random_idx];
-}
-
-template <typename T>
-std::vector<float> GraphDataImpl::RandomWalkBase::Normalize(const std::vector<T> &non_normalized_probability) {
-  float sum_probability =
-    1.0 * std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0);
-  if (sum_probability < kGnnEpsilon) {
-    sum_probability = 1.0;
-  }
-  std::vector<float> normalized_probability;
-  std::transform(non_normalized_probability.begin(), non_normalized_probability.end(),
-                 std::back_inserter(normalized_probability), [&](T value) -> float { return value / sum_probability; });
-  return normalized_probability;
-}
 }  // namespace gnn
 }  // namespace dataset
 }  // namespace mindspore
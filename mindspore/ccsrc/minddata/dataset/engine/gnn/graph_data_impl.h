@@ -23,10 +23,12 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include <tuple>
 #include <utility>
 
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
+#include "minddata/dataset/engine/gnn/graph_image.h"
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
 #endif
 #include "minddata/mindrecord/include/common/shard_utils.h"
@@ -37,7 +39,6 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
-using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
 
 class GraphDataImpl : public GraphData {
  public:
@@ -172,6 +173,7 @@ class GraphDataImpl : public GraphData {
 
  private:
   friend class GraphLoader;
+  friend class GraphImage;
   class RandomWalkBase {
    public:
     explicit RandomWalkBase(GraphDataImpl *graph);
@@ -185,20 +187,21 @@ class GraphDataImpl : public GraphData {
     Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
-
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                              std::shared_ptr<StochasticIndex> *node_probability);
-
-    Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
-
-    static StochasticIndex GenerateProbability(const std::vector<float> &probability);
-
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
-
-    template <typename T>
-    std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
+    // The neighbors of the destination node of an edge and the alias table of their transition probabilities.
+    struct EdgeTransition {
+      std::vector<NodeIdType> neighbors;
+      std::vector<float> alias_prob;
+      std::vector<uint32_t> alias_index;
+    };
+    // The edge transitions keyed by (src, dst, src neighbor type, dst neighbor type)
+    using EdgeTransitionMap =
+      std::map<std::tuple<NodeIdType, NodeIdType, NodeType, NodeType>, std::shared_ptr<EdgeTransition>>;
+
+    Status Node2vecWalk(const NodeIdType &start_node, EdgeTransitionMap *edge_transitions,
+                        std::vector<NodeIdType> *walk_path);
+
+    Status GetEdgeTransition(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
+                             EdgeTransitionMap *edge_transitions, std::shared_ptr<EdgeTransition> *edge_transition);
 
     GraphDataImpl *graph_;
     std::vector<NodeIdType> node_list_;
@@ -209,12 +212,31 @@ class GraphDataImpl : public GraphData {
 
     int32_t num_walks_;    // Number of walks per source. Default is 1
     int32_t num_workers_;  // The number of worker threads. Default is 1
+    std::mt19937 rnd_;     // Seeded by the dataset seed, so the walks are reproducible when it is set
   };
 
-  // Load graph data from mindrecord file
+  // Load graph data from the graph image if it is enabled, otherwise from mindrecord file
   // @return Status The status code returned
   Status LoadNodeAndEdge();
 
+  // Load graph data from mindrecord file
+  // @return Status The status code returned
+  Status LoadMindRecord();
+
+#if !defined(_WIN32) && !defined(_WIN64)
+  // Map the graph image, the image is written from mindrecord file first if there is no valid one
+  // @param std::string image_file - the graph image file
+  // @return Status The status code returned
+  Status LoadGraphImage(const std::string &image_file);
+
+  // Copy a feature in the graph image into the output tensor
+  // @param std::shared_ptr<Feature> feature - the feature in the graph image
+  // @param dsize_t index - the index of the feature in the output tensor
+  // @param std::shared_ptr<Tensor> out - the output tensor
+  // @return Status The status code returned
+  Status InsertImageFeature(const std::shared_ptr<Feature> &feature, dsize_t index, const std::shared_ptr<Tensor> &out);
+#endif
+
   // Create Tensor By Vector
   // @param std::vector<std::vector<T>> &data -
   // @param DataType type -
@@ -277,6 +299,8 @@ class GraphDataImpl : public GraphData {
   bool server_mode_;
 #if !defined(_WIN32) && !defined(_WIN64)
   std::unique_ptr<GraphSharedMemory> graph_shared_memory_;
+  // The nodes refer to the mapped image, so it is released after them
+  std::unique_ptr<GraphImage> graph_image_;
 #endif
   std::unordered_map<NodeType, std::vector<NodeIdType>> node_type_map_;
   std::unordered_map<NodeIdType, std::shared_ptr<Node>> node_id_map_;
@@ -0,0 +1,587 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_image.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/engine/gnn/graph_data_impl.h"
+#include "minddata/dataset/engine/gnn/local_edge.h"
+#include "minddata/dataset/engine/gnn/local_node.h"
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+constexpr char kGraphImageMagic[8] = {'M', 'S', 'G', 'N', 'N', 'I', 'M', 'G'};
+constexpr uint32_t kGraphImageVersion = 2;
+constexpr int64_t kGraphImageAlign = 8;
+constexpr uint8_t kNodeFeatureOwner = 0;
+constexpr uint8_t kEdgeFeatureOwner = 1;
+
+// The image starts with the header, which is followed by the arrays in the order of GraphImage::Save. Each array is
+// its uint64_t length and its elements, aligned to kGraphImageAlign, so the arrays can be used in place.
+struct GraphImageHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  // The size and the modification time in nanoseconds of the MindRecord file which the image is written from
+  int64_t source_size;
+  int64_t source_mtime_ns;
+};
+
+int64_t AlignUp(int64_t size) { return (size + kGraphImageAlign - 1) / kGraphImageAlign * kGraphImageAlign; }
+
+// The nanoseconds tell apart a MindRecord file which is rewritten with the same size within a second.
+Status GetSourceStat(const std::string &mr_file, int64_t *size, int64_t *mtime_ns) {
+  constexpr int64_t kNsPerSecond = 1000000000;
+  struct stat st;
+  CHECK_FAIL_RETURN_UNEXPECTED(stat(mr_file.c_str(), &st) == 0, "Failed to get the status of file: " + mr_file);
+  *size = st.st_size;
+#if defined(__APPLE__)
+  *mtime_ns = static_cast<int64_t>(st.st_mtimespec.tv_sec) * kNsPerSecond + st.st_mtimespec.tv_nsec;
+#else
+  *mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * kNsPerSecond + st.st_mtim.tv_nsec;
+#endif
+  return Status::OK();
+}
+
+class ImageWriter {
+ public:
+  explicit ImageWriter(std::ofstream *out) : out_(out), offset_(0) {}
+
+  void Write(const void *data, int64_t len) {
+    (void)out_->write(reinterpret_cast<const char *>(data), len);
+    offset_ += len;
+  }
+
+  void Align() {
+    const char zeros[kGraphImageAlign] = {0};
+    Write(zeros, AlignUp(offset_) - offset_);
+  }
+
+  template <typename T>
+  void WriteArray(const std::vector<T> &data) {
+    uint64_t num = data.size();
+    Write(&num, sizeof(num));
+    Write(data.data(), num * sizeof(T));
+    Align();
+  }
+
+ private:
+  std::ofstream *out_;
+  int64_t offset_;
+};
+
+class ImageReader {
+ public:
+  ImageReader(const uint8_t *base, int64_t size, int64_t offset) : base_(base), size_(size), offset_(offset) {}
+
+  template <typename T>
+  Status ReadArray(const T **data, uint64_t *num) {
+    CHECK_FAIL_RETURN_UNEXPECTED(offset_ + static_cast<int64_t>(sizeof(uint64_t)) <= size_,
+                                 "The graph image is truncated.");
+    *num = *reinterpret_cast<const uint64_t *>(base_ + offset_);
+    offset_ += sizeof(uint64_t);
+    CHECK_FAIL_RETURN_UNEXPECTED(*num <= static_cast<uint64_t>(size_ - offset_) / sizeof(T),
+                                 "The graph image is truncated.");
+    *data = reinterpret_cast<const T *>(base_ + offset_);
+    offset_ = AlignUp(offset_ + *num * sizeof(T));
+    return Status::OK();
+  }
+
+  template <typename T>
+  Status ReadArray(uint64_t expected_num, const T **data) {
+    uint64_t num = 0;
+    RETURN_IF_NOT_OK(ReadArray(data, &num));
+    CHECK_FAIL_RETURN_UNEXPECTED(num == expected_num, "The graph image is corrupted.");
+    return Status::OK();
+  }
+
+ private:
+  const uint8_t *base_;
+  int64_t size_;
+  int64_t offset_;
+};
+
+// The features are written into one blob, and are referred to by their index in the feature arrays.
+class FeatureCollector {
+ public:
+  FeatureCollector() : blob_size_(0) {}
+
+  Status Add(FeatureType type, const std::shared_ptr<Tensor> &tensor) {
+    CHECK_FAIL_RETURN_UNEXPECTED(tensor->type().IsNumeric(), "Only the numeric features can be saved.");
+    types_.push_back(type);
+    offsets_.push_back(blob_size_);
+    lens_.push_back(tensor->SizeInBytes());
+    blob_size_ = AlignUp(blob_size_ + tensor->SizeInBytes());
+    tensors_.push_back(tensor);
+    return Status::OK();
+  }
+
+  uint32_t size() const { return types_.size(); }
+
+  void Write(ImageWriter *writer) const {
+    writer->WriteArray(types_);
+    writer->WriteArray(offsets_);
+    writer->WriteArray(lens_);
+    uint64_t blob_size = blob_size_;
+    writer->Write(&blob_size, sizeof(blob_size));
+    for (const auto &tensor : tensors_) {
+      writer->Write(tensor->GetBuffer(), tensor->SizeInBytes());
+      writer->Align();
+    }
+  }
+
+ private:
+  std::vector<FeatureType> types_;
+  std::vector<int64_t> offsets_;
+  std::vector<int64_t> lens_;
+  std::vector<std::shared_ptr<Tensor>> tensors_;
+  int64_t blob_size_;
+};
+
+template <typename K, typename V>
+std::vector<K> SortedKeys(const std::unordered_map<K, V> &map) {
+  std::vector<K> keys;
+  std::transform(map.begin(), map.end(), std::back_inserter(keys), [](const auto &itr) { return itr.first; });
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+}  // namespace
+
+GraphImage::GraphImage(const std::string &image_file)
+    : image_file_(image_file), memory_ptr_(nullptr), memory_size_(0) {}
+
+GraphImage::~GraphImage() {
+  if (memory_ptr_ != nullptr) {
+    (void)munmap(memory_ptr_, memory_size_);
+    memory_ptr_ = nullptr;
+  }
+}
+
+Status GraphImage::Save(GraphDataImpl *graph, const std::string &mr_file) {
+  GraphImageHeader header;
+  if (memcpy_s(header.magic, sizeof(header.magic), kGraphImageMagic, sizeof(kGraphImageMagic)) != EOK) {
+    RETURN_STATUS_UNEXPECTED("Failed to write the header of graph image.");
+  }
+  header.version = kGraphImageVersion;
+  header.reserved = 0;
+  RETURN_IF_NOT_OK(GetSourceStat(mr_file, &header.source_size, &header.source_mtime_ns));
+
+  FeatureCollector features;
+  // The nodes are saved type by type, so node_type_map_ keeps its order after loading.
+  std::vector<NodeIdType> node_ids;
+  std::vector<NodeType> node_types;
+  std::vector<WeightType> node_weights;
+  std::vector<uint32_t> type_begin(1, 0);
+  std::vector<NodeType> neighbor_types;
+  std::vector<uint32_t> neighbor_offsets;
+  std::vector<uint64_t> neighbor_begin(1, 0);
+  std::vector<NodeIdType> neighbor_ids;
+  std::vector<float> alias_prob;
+  std::vector<uint32_t> alias_index;
+  std::vector<uint64_t> adjacent_begin(1, 0);
+  std::vector<NodeIdType> adjacent_ids;
+  std::vector<EdgeIdType> adjacent_edges;
+  std::vector<uint32_t> node_feature_begin(1, 0);
+  for (auto type : SortedKeys(graph->node_type_map_)) {
+    auto feature_itr = graph->node_feature_map_.find(type);
+    for (auto id : graph->node_type_map_[type]) {
+      std::shared_ptr<Node> node;
+      RETURN_IF_NOT_OK(graph->GetNodeByNodeId(id, &node));
+      auto local_node = std::dynamic_pointer_cast<LocalNode>(node);
+      CHECK_FAIL_RETURN_UNEXPECTED(local_node != nullptr, "Only the local nodes can be saved.");
+      node_ids.push_back(id);
+      node_types.push_back(type);
+      node_weights.push_back(node->weight());
+
+      const NeighborTable &table = local_node->neighbor_table();
+      uint32_t neighbor_num = table.type_num == 0 ? 0 : table.offsets[table.type_num];
+      neighbor_types.insert(neighbor_types.end(), table.types, table.types + table.type_num);
+      neighbor_offsets.insert(neighbor_offsets.end(), table.offsets, table.offsets + table.type_num + 1);
+      type_begin.push_back(neighbor_types.size());
+      neighbor_ids.insert(neighbor_ids.end(), table.ids, table.ids + neighbor_num);
+      alias_prob.insert(alias_prob.end(), table.alias_prob, table.alias_prob + neighbor_num);
+      alias_index.insert(alias_index.end(), table.alias_index, table.alias_index + neighbor_num);
+      neighbor_begin.push_back(neighbor_ids.size());
+      adjacent_ids.insert(adjacent_ids.end(), table.adjacent_ids, table.adjacent_ids + table.adjacent_num);
+      adjacent_edges.insert(adjacent_edges.end(), table.adjacent_edges, table.adjacent_edges + table.adjacent_num);
+      adjacent_begin.push_back(adjacent_ids.size());
+
+      if (feature_itr != graph->node_feature_map_.end()) {
+        for (auto feature_type : feature_itr->second) {
+          std::shared_ptr<Feature> feature;
+          if (node->GetFeatures(feature_type, &feature).IsOk()) {
+            RETURN_IF_NOT_OK(features.Add(feature_type, feature->Value()));
+          }
+        }
+      }
+      node_feature_begin.push_back(features.size());
+    }
+  }
+
+  std::vector<EdgeIdType> edge_ids;
+  std::vector<EdgeType> edge_types;
+  std::vector<WeightType> edge_weights;
+  std::vector<NodeIdType> edge_src;
+  std::vector<NodeIdType> edge_dst;
+  std::vector<uint32_t> edge_feature_begin(1, features.size());
+  for (auto type : SortedKeys(graph->edge_type_map_)) {
+    auto feature_itr = graph->edge_feature_map_.find(type);
+    for (auto id : graph->edge_type_map_[type]) {
+      std::shared_ptr<Edge> edge;
+      RETURN_IF_NOT_OK(graph->GetEdgeByEdgeId(id, &edge));
+      std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> nodes;
+      RETURN_IF_NOT_OK(edge->GetNode(&nodes));
+      edge_ids.push_back(id);
+      edge_types.push_back(type);
+      edge_weights.push_back(edge->weight());
+      edge_src.push_back(nodes.first->id());
+      edge_dst.push_back(nodes.second->id());
+      if (feature_itr != graph->edge_feature_map_.end()) {
+        for (auto feature_type : feature_itr->second) {
+          std::shared_ptr<Feature> feature;
+          if (edge->GetFeatures(feature_type, &feature).IsOk()) {
+            RETURN_IF_NOT_OK(features.Add(feature_type, feature->Value()));
+          }
+        }
+      }
+      edge_feature_begin.push_back(features.size());
+    }
+  }
+
+  // The default features keep their type and shape besides the data.
+  std::vector<uint8_t> default_owners;
+  std::vector<uint32_t> default_indexes;
+  std::vector<uint8_t> default_dtypes;
+  std::vector<uint32_t> default_ranks;
+  std::vector<int64_t> default_dims;
+  auto add_defaults = [&](uint8_t owner, const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &defaults) {
+    for (auto feature_type : SortedKeys(defaults)) {
+      auto tensor = defaults.at(feature_type)->Value();
+      default_owners.push_back(owner);
+      default_indexes.push_back(features.size());
+      default_dtypes.push_back(tensor->type().value());
+      auto dims = tensor->shape().AsVector();
+      default_ranks.push_back(dims.size());
+      default_dims.insert(default_dims.end(), dims.begin(), dims.end());
+      RETURN_IF_NOT_OK(features.Add(feature_type, tensor));
+    }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(add_defaults(kNodeFeatureOwner, graph->default_node_feature_map_));
+  RETURN_IF_NOT_OK(add_defaults(kEdgeFeatureOwner, graph->default_edge_feature_map_));
+
+  std::vector<uint8_t> map_owners;
+  std::vector<int8_t> map_owner_types;
+  std::vector<FeatureType> map_features;
+  for (const auto &itr : graph->node_feature_map_) {
+    for (auto feature_type : itr.second) {
+      map_owners.push_back(kNodeFeatureOwner);
+      map_owner_types.push_back(itr.first);
+      map_features.push_back(feature_type);
+    }
+  }
+  for (const auto &itr : graph->edge_feature_map_) {
+    for (auto feature_type : itr.second) {
+      map_owners.push_back(kEdgeFeatureOwner);
+      map_owner_types.push_back(itr.first);
+      map_features.push_back(feature_type);
+    }
+  }
+
+  // Write a temporary file and rename it, so the other processes never see a partial image.
+  std::string temp_file = image_file_ + ".tmp." + std::to_string(getpid());
+  std::ofstream out(temp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(out.is_open(), "Failed to create graph image: " + temp_file);
+  ImageWriter writer(&out);
+  writer.Write(&header, sizeof(header));
+  writer.Align();
+  std::string schema = graph->data_schema_.dump();
+  writer.WriteArray(std::vector<char>(schema.begin(), schema.end()));
+  writer.WriteArray(node_ids);
+  writer.WriteArray(node_types);
+  writer.WriteArray(node_weights);
+  writer.WriteArray(type_begin);
+  writer.WriteArray(neighbor_types);
+  writer.WriteArray(neighbor_offsets);
+  writer.WriteArray(neighbor_begin);
+  writer.WriteArray(neighbor_ids);
+  writer.WriteArray(alias_prob);
+  writer.WriteArray(alias_index);
+  writer.WriteArray(adjacent_begin);
+  writer.WriteArray(adjacent_ids);
+  writer.WriteArray(adjacent_edges);
+  writer.WriteArray(node_feature_begin);
+  writer.WriteArray(edge_ids);
+  writer.WriteArray(edge_types);
+  writer.WriteArray(edge_weights);
+  writer.WriteArray(edge_src);
+  writer.WriteArray(edge_dst);
+  writer.WriteArray(edge_feature_begin);
+  writer.WriteArray(default_owners);
+  writer.WriteArray(default_indexes);
+  writer.WriteArray(default_dtypes);
+  writer.WriteArray(default_ranks);
+  writer.WriteArray(default_dims);
+  writer.WriteArray(map_owners);
+  writer.WriteArray(map_owner_types);
+  writer.WriteArray(map_features);
+  features.Write(&writer);
+  out.close();
+  if (out.fail() || rename(temp_file.c_str(), image_file_.c_str()) != 0) {
+    (void)remove(temp_file.c_str());
+    RETURN_STATUS_UNEXPECTED("Failed to write graph image: " + image_file_);
+  }
+  MS_LOG(INFO) << "Write graph image " << image_file_ << " with " << node_ids.size() << " nodes and "
+               << edge_ids.size() << " edges.";
+  return Status::OK();
+}
+
+Status GraphImage::Open(const std::string &mr_file) {
+  CHECK_FAIL_RETURN_UNEXPECTED(memory_ptr_ == nullptr, "The graph image is already opened: " + image_file_);
+  int fd = open(image_file_.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd != -1, "Failed to open graph image: " + image_file_);
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < static_cast<int64_t>(sizeof(GraphImageHeader))) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Invalid graph image: " + image_file_);
+  }
+  void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED(ptr != MAP_FAILED, "Failed to map graph image: " + image_file_);
+  memory_ptr_ = reinterpret_cast<uint8_t *>(ptr);
+  memory_size_ = st.st_size;
+
+  const auto *header = reinterpret_cast<const GraphImageHeader *>(memory_ptr_);
+  CHECK_FAIL_RETURN_UNEXPECTED(memcmp(header->magic, kGraphImageMagic, sizeof(kGraphImageMagic)) == 0 &&
+                                 header->version == kGraphImageVersion,
+                               "Invalid graph image: " + image_file_);
+  int64_t source_size = 0;
+  int64_t source_mtime_ns = 0;
+  RETURN_IF_NOT_OK(GetSourceStat(mr_file, &source_size, &source_mtime_ns));
+  CHECK_FAIL_RETURN_UNEXPECTED(header->source_size == source_size && header->source_mtime_ns == source_mtime_ns,
+                               "The graph image " + image_file_ + " is out of date.");
+  return Status::OK();
+}
+
+Status GraphImage::Load(GraphDataImpl *graph) {
+  CHECK_FAIL_RETURN_UNEXPECTED(memory_ptr_ != nullptr, "The graph image is not opened: " + image_file_);
+  CHECK_FAIL_RETURN_UNEXPECTED(graph->node_id_map_.empty() && graph->edge_id_map_.empty(), "The graph is not empty.");
+  ImageReader reader(memory_ptr_, memory_size_, AlignUp(sizeof(GraphImageHeader)));
+  const char *schema = nullptr;
+  uint64_t schema_len = 0;
+  RETURN_IF_NOT_OK(reader.ReadArray(&schema, &schema_len));
+  graph->data_schema_ = mindrecord::json::parse(std::string(schema, schema_len));
+
+  const NodeIdType *node_ids = nullptr;
+  const NodeType *node_types = nullptr;
+  const WeightType *node_weights = nullptr;
+  const uint32_t *type_begin = nullptr;
+  const NodeType *neighbor_types = nullptr;
+  const uint32_t *neighbor_offsets = nullptr;
+  const uint64_t *neighbor_begin = nullptr;
+  const NodeIdType *neighbor_ids = nullptr;
+  const float *alias_prob = nullptr;
+  const uint32_t *alias_index = nullptr;
+  const uint64_t *adjacent_begin = nullptr;
+  const NodeIdType *adjacent_ids = nullptr;
+  const EdgeIdType *adjacent_edges = nullptr;
+  const uint32_t *node_feature_begin = nullptr;
+  uint64_t node_num = 0;
+  uint64_t type_num = 0;
+  uint64_t neighbor_num = 0;
+  uint64_t adjacent_num = 0;
+  RETURN_IF_NOT_OK(reader.ReadArray(&node_ids, &node_num));
+  RETURN_IF_NOT_OK(reader.ReadArray(node_num, &node_types));
+  RETURN_IF_NOT_OK(reader.ReadArray(node_num, &node_weights));
+  RETURN_IF_NOT_OK(reader.ReadArray(node_num + 1, &type_begin));
+  RETURN_IF_NOT_OK(reader.ReadArray(&neighbor_types, &type_num));
+  RETURN_IF_NOT_OK(reader.ReadArray(type_num + node_num, &neighbor_offsets));
+  RETURN_IF_NOT_OK(reader.ReadArray(node_num + 1, &neighbor_begin));
+  RETURN_IF_NOT_OK(reader.ReadArray(&neighbor_ids, &neighbor_num));
+  RETURN_IF_NOT_OK(reader.ReadArray(neighbor_num, &alias_prob));
+  RETURN_IF_NOT_OK(reader.ReadArray(neighbor_num, &alias_index));
+  RETURN_IF_NOT_OK(reader.ReadArray(node_num + 1, &adjacent_begin));
+  RETURN_IF_NOT_OK(reader.ReadArray(&adjacent_ids, &adjacent_num));
+  RETURN_IF_NOT_OK(reader.ReadArray(adjacent_num, &adjacent_edges));
+  RETURN_IF_NOT_OK(reader.ReadArray(node_num + 1, &node_feature_begin));
+
+  const EdgeIdType *edge_ids = nullptr;
+  const EdgeType *edge_types = nullptr;
+  const WeightType *edge_weights = nullptr;
+  const NodeIdType *edge_src = nullptr;
+  const NodeIdType *edge_dst = nullptr;
+  const uint32_t *edge_feature_begin = nullptr;
+  uint64_t edge_num = 0;
+  RETURN_IF_NOT_OK(reader.ReadArray(&edge_ids, &edge_num));
+  RETURN_IF_NOT_OK(reader.ReadArray(edge_num, &edge_types));
+  RETURN_IF_NOT_OK(reader.ReadArray(edge_num, &edge_weights));
+  RETURN_IF_NOT_OK(reader.ReadArray(edge_num, &edge_src));
+  RETURN_IF_NOT_OK(reader.ReadArray(edge_num, &edge_dst));
+  RETURN_IF_NOT_OK(reader.ReadArray(edge_num + 1, &edge_feature_begin));
+
+  const uint8_t *default_owners = nullptr;
+  const uint32_t *default_indexes = nullptr;
+  const uint8_t *default_dtypes = nullptr;
+  const uint32_t *default_ranks = nullptr;
+  const int64_t *default_dims = nullptr;
+  uint64_t default_num = 0;
+  uint64_t dims_num = 0;
+  RETURN_IF_NOT_OK(reader.ReadArray(&default_owners, &default_num));
+  RETURN_IF_NOT_OK(reader.ReadArray(default_num, &default_indexes));
+  RETURN_IF_NOT_OK(reader.ReadArray(default_num, &default_dtypes));
+  RETURN_IF_NOT_OK(reader.ReadArray(default_num, &default_ranks));
+  RETURN_IF_NOT_OK(reader.ReadArray(&default_dims, &dims_num));
+
+  const uint8_t *map_owners = nullptr;
+  const int8_t *map_owner_types = nullptr;
+  const FeatureType *map_features = nullptr;
+  uint64_t map_num = 0;
+  RETURN_IF_NOT_OK(reader.ReadArray(&map_owners, &map_num));
+  RETURN_IF_NOT_OK(reader.ReadArray(map_num, &map_owner_types));
+  RETURN_IF_NOT_OK(reader.ReadArray(map_num, &map_features));
+
+  const FeatureType *feature_types = nullptr;
+  const int64_t *feature_offsets = nullptr;
+  const int64_t *feature_lens = nullptr;
+  const uint8_t *blob = nullptr;
+  uint64_t feature_num = 0;
+  uint64_t blob_size = 0;
+  RETURN_IF_NOT_OK(reader.ReadArray(&feature_types, &feature_num));
+  RETURN_IF_NOT_OK(reader.ReadArray(feature_num, &feature_offsets));
+  RETURN_IF_NOT_OK(reader.ReadArray(feature_num, &feature_lens));
+  RETURN_IF_NOT_OK(reader.ReadArray(&blob, &blob_size));
+
+  CHECK_FAIL_RETURN_UNEXPECTED(type_begin[node_num] == type_num && neighbor_begin[node_num] == neighbor_num &&
+                                 adjacent_begin[node_num] == adjacent_num && node_feature_begin[0] == 0 &&
+                                 node_feature_begin[node_num] == edge_feature_begin[0] &&
+                                 edge_feature_begin[edge_num] <= feature_num,
+                               "The graph image is corrupted: " + image_file_);
+  for (uint64_t i = 0; i < feature_num; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(feature_offsets[i] >= 0 && feature_lens[i] >= 0 &&
+                                   static_cast<uint64_t>(feature_offsets[i] + feature_lens[i]) <= blob_size,
+                                 "The graph image is corrupted: " + image_file_);
+  }
+
+  int64_t blob_offset = blob - memory_ptr_;
+  auto get_feature = [&](uint64_t index, std::shared_ptr<Feature> *feature) {
+    std::shared_ptr<Tensor> tensor;
+    std::vector<int64_t> offset_and_len = {blob_offset + feature_offsets[index], feature_lens[index]};
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(offset_and_len, &tensor));
+    *feature = std::make_shared<Feature>(feature_types[index], tensor, true);
+    return Status::OK();
+  };
+
+  for (uint64_t i = 0; i < node_num; ++i) {
+    auto node = std::make_shared<LocalNode>(node_ids[i], node_types[i], node_weights[i]);
+    NeighborTable table;
+    table.types = neighbor_types + type_begin[i];
+    table.offsets = neighbor_offsets + type_begin[i] + i;
+    table.type_num = type_begin[i + 1] - type_begin[i];
+    table.ids = neighbor_ids + neighbor_begin[i];
+    table.alias_prob = alias_prob + neighbor_begin[i];
+    table.alias_index = alias_index + neighbor_begin[i];
+    table.adjacent_ids = adjacent_ids + adjacent_begin[i];
+    table.adjacent_edges = adjacent_edges + adjacent_begin[i];
+    table.adjacent_num = adjacent_begin[i + 1] - adjacent_begin[i];
+    RETURN_IF_NOT_OK(node->SetNeighborTable(table));
+    for (uint32_t j = node_feature_begin[i]; j < node_feature_begin[i + 1]; ++j) {
+      std::shared_ptr<Feature> feature;
+      RETURN_IF_NOT_OK(get_feature(j, &feature));
+      RETURN_IF_NOT_OK(node->UpdateFeature(feature));
+    }
+    graph->node_id_map_[node_ids[i]] = node;
+    graph->node_type_map_[node_types[i]].push_back(node_ids[i]);
+  }
+
+  for (uint64_t i = 0; i < edge_num; ++i) {
+    std::shared_ptr<Node> src;
+    std::shared_ptr<Node> dst;
+    RETURN_IF_NOT_OK(graph->GetNodeByNodeId(edge_src[i], &src));
+    RETURN_IF_NOT_OK(graph->GetNodeByNodeId(edge_dst[i], &dst));
+    auto edge = std::make_shared<LocalEdge>(edge_ids[i], edge_types[i], edge_weights[i], src, dst);
+    for (uint32_t j = edge_feature_begin[i]; j < edge_feature_begin[i + 1]; ++j) {
+      std::shared_ptr<Feature> feature;
+      RETURN_IF_NOT_OK(get_feature(j, &feature));
+      RETURN_IF_NOT_OK(edge->UpdateFeature(feature));
+    }
+    graph->edge_id_map_[edge_ids[i]] = edge;
+    graph->edge_type_map_[edge_types[i]].push_back(edge_ids[i]);
+  }
+
+  // The default features are small, they are copied so they can be used as the ordinary ones.
+  const int64_t *dims = default_dims;
+  for (uint64_t i = 0; i < default_num; ++i) {
+    uint32_t index = default_indexes[i];
+    CHECK_FAIL_RETURN_UNEXPECTED(index < feature_num && dims + default_ranks[i] <= default_dims + dims_num,
+                                 "The graph image is corrupted: " + image_file_);
+    TensorShape shape(std::vector<dsize_t>(dims, dims + default_ranks[i]));
+    dims += default_ranks[i];
+    DataType type(static_cast<DataType::Type>(default_dtypes[i]));
+    CHECK_FAIL_RETURN_UNEXPECTED(shape.NumOfElements() * type.SizeInBytes() == feature_lens[index],
+                                 "The graph image is corrupted: " + image_file_);
+    std::shared_ptr<Tensor> tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateFromMemory(shape, type, blob + feature_offsets[index], &tensor));
+    auto feature = std::make_shared<Feature>(feature_types[index], tensor);
+    if (default_owners[i] == kNodeFeatureOwner) {
+      graph->default_node_feature_map_[feature_types[index]] = feature;
+    } else {
+      graph->default_edge_feature_map_[feature_types[index]] = feature;
+    }
+  }
+
+  for (uint64_t i = 0; i < map_num; ++i) {
+    if (map_owners[i] == kNodeFeatureOwner) {
+      graph->node_feature_map_[map_owner_types[i]].insert(map_features[i]);
+    } else {
+      graph->edge_feature_map_[map_owner_types[i]].insert(map_features[i]);
+    }
+  }
+  MS_LOG(INFO) << "Load graph image " << image_file_ << " with " << node_num << " nodes and " << edge_num
+               << " edges.";
+  return Status::OK();
+}
+
+Status GraphImage::GetFeatureData(const std::shared_ptr<Feature> &feature, const uint8_t **data, int64_t *len) const {
+  CHECK_FAIL_RETURN_UNEXPECTED(memory_ptr_ != nullptr, "The graph image is not opened: " + image_file_);
+  auto value = feature->Value();
+  CHECK_FAIL_RETURN_UNEXPECTED(value->type() == DataType(DataType::DE_INT64) && value->Size() == 2,
+                               "The feature is not in the graph image.");
+  int64_t offset = 0;
+  int64_t length = 0;
+  RETURN_IF_NOT_OK(value->GetItemAt(&offset, {0}));
+  RETURN_IF_NOT_OK(value->GetItemAt(&length, {1}));
+  CHECK_FAIL_RETURN_UNEXPECTED(offset >= 0 && length >= 0 && offset + length <= memory_size_,
+                               "The feature is beyond the graph image.");
+  *data = memory_ptr_ + offset;
+  *len = length;
+  return Status::OK();
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_IMAGE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_IMAGE_H_
+
+#include <memory>
+#include <string>
+
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+// The environment variable of the graph image file. If it is set, the first process which loads the graph writes the
+// image, and the other processes map it read-only instead of parsing the MindRecord file, so the topology and the
+// features are shared between them through the page cache.
+const char kGnnGraphImageEnv[] = "MS_GNN_GRAPH_IMAGE";
+
+class GraphDataImpl;
+
+// GraphImage is a compact binary image of a loaded graph. The neighbor tables of the nodes refer to the mapped image
+// directly, and a feature in the image is a (offset, length) tensor like the one in the shared memory.
+class GraphImage {
+ public:
+  explicit GraphImage(const std::string &image_file);
+
+  ~GraphImage();
+
+  // Write the graph into the image file, the file is replaced atomically
+  // @param GraphDataImpl *graph - the graph loaded from mr_file
+  // @param std::string mr_file - the MindRecord file which the graph is loaded from
+  // @return Status - the status code
+  Status Save(GraphDataImpl *graph, const std::string &mr_file);
+
+  // Map the image file read-only and check it is written from the current version of mr_file
+  // @param std::string mr_file - the MindRecord file of the graph
+  // @return Status - the status code, fails if there is no valid image
+  Status Open(const std::string &mr_file);
+
+  // Build the graph on the opened image
+  // @param GraphDataImpl *graph - the graph to be built, which must be empty
+  // @return Status - the status code
+  Status Load(GraphDataImpl *graph);
+
+  // Get the data of a feature in the image
+  // @param std::shared_ptr<Feature> feature - the (offset, length) feature
+  // @param const uint8_t **data - returned start address of the data
+  // @param int64_t *len - returned length of the data
+  // @return Status - the status code
+  Status GetFeatureData(const std::shared_ptr<Feature> &feature, const uint8_t **data, int64_t *len) const;
+
+ private:
+  std::string image_file_;
+  uint8_t *memory_ptr_;
+  int64_t memory_size_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_IMAGE_H_
@@ -75,6 +75,10 @@ Status GraphLoader::GetNodesAndEdges() {
     }
   }
 
+  for (auto &itr : *n_id_map) {
+    RETURN_IF_NOT_OK(itr.second->FinalizeNeighbors());
+  }
+
   for (auto &itr : graph_impl_->node_type_map_) itr.second.shrink_to_fit();
   for (auto &itr : graph_impl_->edge_type_map_) itr.second.shrink_to_fit();
 
@@ -16,21 +16,20 @@
 #include "minddata/dataset/engine/gnn/local_node.h"
 
 #include <algorithm>
+#include <numeric>
 #include <random>
 #include <string>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/alias_table.h"
 #include "minddata/dataset/engine/gnn/edge.h"
-#include "minddata/dataset/util/random.h"
 
 namespace mindspore {
 namespace dataset {
 namespace gnn {
 
 LocalNode::LocalNode(NodeIdType id, NodeType type, WeightType weight)
-    : Node(id, type, weight), rnd_(GetRandomDevice()) {
-  rnd_.seed(GetSeed());
-}
+    : Node(id, type, weight), neighbors_finalized_(false) {}
 
 Status LocalNode::GetFeatures(FeatureType feature_type, std::shared_ptr<Feature> *out_feature) {
   auto itr = features_.find(feature_type);
@@ -43,20 +42,30 @@ Status LocalNode::GetFeatures(FeatureType feature_type, std::shared_ptr<Feature>
   }
 }
 
+bool LocalNode::FindNeighbors(NodeType neighbor_type, uint32_t *begin, uint32_t *end) const {
+  // There are only a few neighbor types, a linear search is faster than a hash map.
+  auto types_end = table_.types + table_.type_num;
+  auto itr = std::find(table_.types, types_end, neighbor_type);
+  if (itr == types_end) {
+    return false;
+  }
+  auto index = itr - table_.types;
+  *begin = table_.offsets[index];
+  *end = table_.offsets[index + 1];
+  return true;
+}
+
 Status LocalNode::GetAllNeighbors(NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors, bool exclude_itself) {
+  CHECK_FAIL_RETURN_UNEXPECTED(neighbors_finalized_, "The neighbors are not finalized. node_id:" + std::to_string(id_));
   std::vector<NodeIdType> neighbors;
-  auto itr = neighbor_nodes_.find(neighbor_type);
-  if (itr != neighbor_nodes_.end()) {
-    if (exclude_itself) {
-      neighbors.resize(itr->second.first.size());
-      std::transform(itr->second.first.begin(), itr->second.first.end(), neighbors.begin(),
-                     [](const std::shared_ptr<Node> node) { return node->id(); });
-    } else {
-      neighbors.resize(itr->second.first.size() + 1);
-      neighbors[0] = id_;
-      std::transform(itr->second.first.begin(), itr->second.first.end(), neighbors.begin() + 1,
-                     [](const std::shared_ptr<Node> node) { return node->id(); });
+  uint32_t begin = 0;
+  uint32_t end = 0;
+  if (FindNeighbors(neighbor_type, &begin, &end)) {
+    neighbors.reserve(end - begin + 1);
+    if (!exclude_itself) {
+      neighbors.emplace_back(id_);
     }
+    neighbors.insert(neighbors.end(), table_.ids + begin, table_.ids + end);
   } else {
     MS_LOG(DEBUG) << "No neighbors. node_id:" << id_ << " neighbor_type:" << neighbor_type;
     if (!exclude_itself) {
@@ -67,43 +76,54 @@ Status LocalNode::GetAllNeighbors(NodeType neighbor_type, std::vector<NodeIdType
   return Status::OK();
 }
 
-Status LocalNode::GetRandomSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors, int32_t samples_num,
+Status LocalNode::GetRandomSampledNeighbors(uint32_t begin, uint32_t end, int32_t samples_num,
                                             std::vector<NodeIdType> *out) {
-  std::vector<NodeIdType> shuffled_id(neighbors.size());
-  std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
-  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-  int32_t num = std::min(samples_num, static_cast<int32_t>(neighbors.size()));
-  for (int32_t i = 0; i < num; ++i) {
-    out->emplace_back(neighbors[shuffled_id[i]]->id());
+  auto rnd = GetThreadRandomGenerator();
+  auto out_begin = out->size();
+  uint32_t num = end - begin;
+  if (static_cast<uint32_t>(samples_num) >= num) {
+    out->insert(out->end(), table_.ids + begin, table_.ids + end);
+  } else {
+    // Robert Floyd's algorithm picks samples_num distinct neighbors in O(samples_num), whatever the degree is.
+    std::vector<uint32_t> picked;
+    picked.reserve(samples_num);
+    for (uint32_t j = num - samples_num; j < num; ++j) {
+      std::uniform_int_distribution<uint32_t> dist(0, j);
+      uint32_t t = dist(*rnd);
+      picked.push_back(std::find(picked.begin(), picked.end(), t) == picked.end() ? t : j);
+    }
+    for (auto index : picked) {
+      out->emplace_back(table_.ids[begin + index]);
+    }
   }
+  std::shuffle(out->begin() + out_begin, out->end(), *rnd);
   return Status::OK();
 }
 
-Status LocalNode::GetWeightSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors,
-                                            const std::vector<WeightType> &weights, int32_t samples_num,
+Status LocalNode::GetWeightSampledNeighbors(uint32_t begin, uint32_t end, int32_t samples_num,
                                             std::vector<NodeIdType> *out) {
-  CHECK_FAIL_RETURN_UNEXPECTED(neighbors.size() == weights.size(),
-                               "The number of neighbors does not match the weight.");
-  std::discrete_distribution<NodeIdType> discrete_dist(weights.begin(), weights.end());
+  auto rnd = GetThreadRandomGenerator();
   for (int32_t i = 0; i < samples_num; ++i) {
-    NodeIdType index = discrete_dist(rnd_);
-    out->emplace_back(neighbors[index]->id());
+    uint32_t index = SampleAliasTable(table_.alias_prob + begin, table_.alias_index + begin, end - begin, rnd);
+    out->emplace_back(table_.ids[begin + index]);
   }
   return Status::OK();
 }
 
 Status LocalNode::GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
                                       std::vector<NodeIdType> *out_neighbors) {
+  CHECK_FAIL_RETURN_UNEXPECTED(neighbors_finalized_, "The neighbors are not finalized. node_id:" + std::to_string(id_));
   std::vector<NodeIdType> neighbors;
   neighbors.reserve(samples_num);
-  auto itr = neighbor_nodes_.find(neighbor_type);
-  if (itr != neighbor_nodes_.end()) {
+  uint32_t begin = 0;
+  uint32_t end = 0;
+  if (FindNeighbors(neighbor_type, &begin, &end)) {
     if (strategy == SamplingStrategy::kRandom) {
       while (neighbors.size() < samples_num) {
-        RETURN_IF_NOT_OK(GetRandomSampledNeighbors(itr->second.first, samples_num - neighbors.size(), &neighbors));
+        RETURN_IF_NOT_OK(GetRandomSampledNeighbors(begin, end, samples_num - neighbors.size(), &neighbors));
       }
     } else if (strategy == SamplingStrategy::kEdgeWeight) {
-      RETURN_IF_NOT_OK(GetWeightSampledNeighbors(itr->second.first, itr->second.second, samples_num, &neighbors));
+      RETURN_IF_NOT_OK(GetWeightSampledNeighbors(begin, end, samples_num, &neighbors));
     } else {
       RETURN_STATUS_UNEXPECTED("Invalid strategy");
     }
@@ -119,30 +139,100 @@ Status LocalNode::GetSampledNeighbors(NodeType neighbor_type, int32_t samples_nu
 }
 
 Status LocalNode::AddNeighbor(const std::shared_ptr<Node> &node, const WeightType &weight) {
-  auto itr = neighbor_nodes_.find(node->type());
-  if (itr != neighbor_nodes_.end()) {
-    itr->second.first.push_back(node);
-    itr->second.second.push_back(weight);
-  } else {
-    std::vector<std::shared_ptr<Node>> nodes = {node};
-    std::vector<WeightType> weights = {weight};
-    neighbor_nodes_[node->type()] = std::make_pair(std::move(nodes), std::move(weights));
+  CHECK_FAIL_RETURN_UNEXPECTED(!neighbors_finalized_,
+                               "The neighbors are already finalized. node_id:" + std::to_string(id_));
+  neighbor_ids_.push_back(node->id());
+  pending_neighbor_types_.push_back(node->type());
+  pending_neighbor_weights_.push_back(weight);
+  return Status::OK();
+}
+
+Status LocalNode::FinalizeNeighbors() {
+  if (neighbors_finalized_) {
+    return Status::OK();
+  }
+  // Group the neighbors by type, the neighbors of one type keep the order they are added.
+  std::vector<uint32_t> order(neighbor_ids_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](uint32_t lhs, uint32_t rhs) {
+    return pending_neighbor_types_[lhs] < pending_neighbor_types_[rhs];
+  });
+  std::vector<NodeIdType> ids(order.size());
+  std::vector<WeightType> weights(order.size());
+  neighbor_offsets_.push_back(0);
+  for (uint32_t i = 0; i < order.size(); ++i) {
+    ids[i] = neighbor_ids_[order[i]];
+    weights[i] = pending_neighbor_weights_[order[i]];
+    NodeType type = pending_neighbor_types_[order[i]];
+    if (neighbor_types_.empty() || neighbor_types_.back() != type) {
+      if (!neighbor_types_.empty()) {
+        neighbor_offsets_.push_back(i);
+      }
+      neighbor_types_.push_back(type);
+    }
+  }
+  if (!neighbor_types_.empty()) {
+    neighbor_offsets_.push_back(order.size());
+  }
+  neighbor_ids_ = std::move(ids);
+
+  alias_prob_.resize(weights.size());
+  alias_index_.resize(weights.size());
+  for (size_t i = 0; i < neighbor_types_.size(); ++i) {
+    uint32_t begin = neighbor_offsets_[i];
+    BuildAliasTable(&weights[begin], neighbor_offsets_[i + 1] - begin, &alias_prob_[begin], &alias_index_[begin]);
   }
+  std::vector<NodeType>().swap(pending_neighbor_types_);
+  std::vector<WeightType>().swap(pending_neighbor_weights_);
+  neighbor_types_.shrink_to_fit();
+  neighbor_offsets_.shrink_to_fit();
+
+  std::vector<std::pair<NodeIdType, EdgeIdType>> adjacent_nodes(pending_adjacent_nodes_.begin(),
+                                                                pending_adjacent_nodes_.end());
+  std::sort(adjacent_nodes.begin(), adjacent_nodes.end());
+  for (const auto &adjacent : adjacent_nodes) {
+    adjacent_ids_.push_back(adjacent.first);
+    adjacent_edges_.push_back(adjacent.second);
+  }
+  std::unordered_map<NodeIdType, EdgeIdType>().swap(pending_adjacent_nodes_);
+
+  table_.types = neighbor_types_.data();
+  table_.offsets = neighbor_offsets_.data();
+  table_.type_num = neighbor_types_.size();
+  table_.ids = neighbor_ids_.data();
+  table_.alias_prob = alias_prob_.data();
+  table_.alias_index = alias_index_.data();
+  table_.adjacent_ids = adjacent_ids_.data();
+  table_.adjacent_edges = adjacent_edges_.data();
+  table_.adjacent_num = adjacent_ids_.size();
+  neighbors_finalized_ = true;
+  return Status::OK();
+}
+
+Status LocalNode::SetNeighborTable(const NeighborTable &table) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!neighbors_finalized_ && neighbor_ids_.empty() && pending_adjacent_nodes_.empty(),
+                               "The neighbors are already added. node_id:" + std::to_string(id_));
+  table_ = table;
+  neighbors_finalized_ = true;
   return Status::OK();
 }
 
 Status LocalNode::AddAdjacent(const std::shared_ptr<Node> &node, const std::shared_ptr<Edge> &edge) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!neighbors_finalized_,
+                               "The neighbors are already finalized. node_id:" + std::to_string(id_));
   auto node_id = node->id();
   auto edge_id = edge->id();
-  adjacent_nodes_.insert({node_id, edge_id});
+  pending_adjacent_nodes_.insert({node_id, edge_id});
   return Status::OK();
 }
 
 Status LocalNode::GetEdgeByAdjNodeId(const NodeIdType &adj_node_id, EdgeIdType *out_edge_id) {
-  auto itr = adjacent_nodes_.find(adj_node_id);
+  CHECK_FAIL_RETURN_UNEXPECTED(neighbors_finalized_, "The neighbors are not finalized. node_id:" + std::to_string(id_));
+  auto adjacent_end = table_.adjacent_ids + table_.adjacent_num;
+  auto itr = std::lower_bound(table_.adjacent_ids, adjacent_end, adj_node_id);
 
-  if (itr != adjacent_nodes_.end()) {
-    (*out_edge_id) = itr->second;
+  if (itr != adjacent_end && *itr == adj_node_id) {
+    (*out_edge_id) = table_.adjacent_edges[itr - table_.adjacent_ids];
   } else {
     (*out_edge_id) = -1;
     MS_LOG(WARNING) << "Number " << adj_node_id << " node is not adjacent to number " << this->id() << " node.";
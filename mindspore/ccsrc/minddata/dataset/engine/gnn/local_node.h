@@ -29,6 +29,20 @@ namespace mindspore {
 namespace dataset {
 namespace gnn {
 
+// The CSR neighbor table of a LocalNode: the neighbors of types[i] are the elements in [offsets[i], offsets[i + 1]) of
+// ids and of the alias table of their edge weights, and the adjacent edges are sorted by the adjacent node id.
+struct NeighborTable {
+  const NodeType *types = nullptr;
+  const uint32_t *offsets = nullptr;
+  uint32_t type_num = 0;
+  const NodeIdType *ids = nullptr;
+  const float *alias_prob = nullptr;
+  const uint32_t *alias_index = nullptr;
+  const NodeIdType *adjacent_ids = nullptr;
+  const EdgeIdType *adjacent_edges = nullptr;
+  uint32_t adjacent_num = 0;
+};
+
 class LocalNode : public Node {
  public:
   // Constructor
@@ -65,6 +79,10 @@ class LocalNode : public Node {
   // @return Status The status code returned
   Status AddNeighbor(const std::shared_ptr<Node> &node, const WeightType &) override;
 
+  // Build the CSR neighbor table and the alias tables of the edge weights
+  // @return Status The status code returned
+  Status FinalizeNeighbors() override;
+
   // Add adjacent node and relative edge for source node
   // @param std::shared_ptr<Node> node - the node to be inserted into adjacent table
   // @param std::shared_ptr<Edge> edge - the edge related to the adjacent node of source node
@@ -82,18 +100,39 @@ class LocalNode : public Node {
   // @return Status The status code returned
   Status UpdateFeature(const std::shared_ptr<Feature> &feature) override;
 
+  // Get the neighbor table built by FinalizeNeighbors or set by SetNeighborTable
+  const NeighborTable &neighbor_table() const { return table_; }
+
+  // Use the neighbor table in an external buffer instead of building it, e.g. the one in a mapped graph image. The
+  // buffer must outlive the node.
+  // @param NeighborTable table - the neighbor table
+  // @return Status The status code returned
+  Status SetNeighborTable(const NeighborTable &table);
+
  private:
-  Status GetRandomSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors, int32_t samples_num,
-                                   std::vector<NodeIdType> *out);
+  // Find the range of the neighbors of a type in the neighbor table
+  // @return bool - false if there are no neighbors of the type
+  bool FindNeighbors(NodeType neighbor_type, uint32_t *begin, uint32_t *end) const;
+
+  Status GetRandomSampledNeighbors(uint32_t begin, uint32_t end, int32_t samples_num, std::vector<NodeIdType> *out);
 
-  Status GetWeightSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors,
-                                   const std::vector<WeightType> &weights, int32_t samples_num,
-                                   std::vector<NodeIdType> *out);
+  Status GetWeightSampledNeighbors(uint32_t begin, uint32_t end, int32_t samples_num, std::vector<NodeIdType> *out);
 
-  std::mt19937 rnd_;
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> features_;
-  std::unordered_map<NodeType, std::pair<std::vector<std::shared_ptr<Node>>, std::vector<WeightType>>> neighbor_nodes_;
-  std::unordered_map<NodeIdType, EdgeIdType> adjacent_nodes_;
+  // The table refers to the vectors below after FinalizeNeighbors.
+  NeighborTable table_;
+  std::vector<NodeType> neighbor_types_;
+  std::vector<uint32_t> neighbor_offsets_;
+  std::vector<NodeIdType> neighbor_ids_;
+  std::vector<float> alias_prob_;
+  std::vector<uint32_t> alias_index_;
+  std::vector<NodeIdType> adjacent_ids_;
+  std::vector<EdgeIdType> adjacent_edges_;
+  // The neighbors added before FinalizeNeighbors, which are released after the table is built.
+  std::vector<NodeType> pending_neighbor_types_;
+  std::vector<WeightType> pending_neighbor_weights_;
+  std::unordered_map<NodeIdType, EdgeIdType> pending_adjacent_nodes_;
+  bool neighbors_finalized_;
 };
 }  // namespace gnn
 }  // namespace dataset
@@ -30,7 +30,7 @@ Status DatasetCacheImpl::Build() {
   if (cache_client_) return Status::OK();
 
   CacheClient::Builder builder;
-  builder.SetSessionId(session_id_).SetCacheMemSz(cache_mem_sz_).SetSpill(spill_);
+  builder.SetSessionId(session_id_).SetCacheMemSz(cache_mem_sz_).SetSpill(spill_).SetCompress(compress_);
   if (hostname_) builder.SetHostname(hostname_.value());
   if (port_) builder.SetPort(port_.value());
   if (num_connections_) builder.SetNumConnections(num_connections_.value());
@@ -81,6 +81,7 @@ Status DatasetCacheImpl::to_json(nlohmann::json *out_json) {
   if (port_) args["port"] = port_.value();
   if (num_connections_) args["num_connections"] = num_connections_.value();
   if (prefetch_sz_) args["prefetch_size"] = prefetch_sz_.value();
+  args["compress"] = compress_;
   *out_json = args;
   return Status::OK();
 }
@@ -43,16 +43,18 @@ class DatasetCacheImpl : public DatasetCache {
   /// \param port optional port (default=50052).
   /// \param num_connections optional number of connections (default=12).
   /// \param prefetch_sz optional prefetch size (default=20).
+  /// \param compress Keep the rows compressed at the server (default=False).
   DatasetCacheImpl(session_id_type id, uint64_t mem_sz, bool spill, std::optional<std::vector<char>> hostname,
                    std::optional<int32_t> port, std::optional<int32_t> num_connections,
-                   std::optional<int32_t> prefetch_sz)
+                   std::optional<int32_t> prefetch_sz, bool compress = false)
       : session_id_(id),
         cache_mem_sz_(mem_sz),
         spill_(spill),
         hostname_(OptionalCharToString(hostname)),
         port_(std::move(port)),
         num_connections_(std::move(num_connections)),
-        prefetch_sz_(std::move(prefetch_sz)) {}
+        prefetch_sz_(std::move(prefetch_sz)),
+        compress_(compress) {}
 
   /// Method to initialize the DatasetCache by creating an instance of a CacheClient
   /// \return Status Error code
@@ -80,6 +82,7 @@ class DatasetCacheImpl : public DatasetCache {
   std::optional<int32_t> port_;
   std::optional<int32_t> num_connections_;
   std::optional<int32_t> prefetch_sz_;
+  bool compress_;
 };
 }  // namespace dataset
 }  // namespace mindspore
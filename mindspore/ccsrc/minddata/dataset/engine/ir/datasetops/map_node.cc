@@ -38,7 +38,8 @@ MapNode::MapNode(std::shared_ptr<DatasetNode> child, std::vector<std::shared_ptr
       output_columns_(output_columns),
       project_columns_(project_columns),
       DatasetNode(std::move(cache)),
-      callbacks_(callbacks) {
+      callbacks_(callbacks),
+      fused_batch_size_(0) {
   this->AddChild(child);
 }
 
@@ -46,6 +47,7 @@ std::shared_ptr<DatasetNode> MapNode::Copy() {
   std::vector<std::shared_ptr<TensorOperation>> operations = operations_;
   auto node = std::make_shared<MapNode>(nullptr, operations, input_columns_, output_columns_, project_columns_, cache_,
                                         callbacks_);
+  node->SetFusedBatchSize(fused_batch_size_);
   return node;
 }
 
@@ -82,6 +84,7 @@ Status MapNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
   if (!callbacks_.empty()) {
     map_op->AddCallbacks(callbacks_);
   }
+  map_op->SetFusedBatchSize(fused_batch_size_);
 
   if (!project_columns_.empty()) {
     auto project_op = std::make_shared<ProjectOp>(project_columns_);
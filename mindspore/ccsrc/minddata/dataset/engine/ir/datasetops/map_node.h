@@ -87,6 +87,11 @@ class MapNode : public DatasetNode {
   const std::vector<std::string> &OutputColumns() const { return output_columns_; }
   const std::vector<std::string> &ProjectColumns() const { return project_columns_; }
   const std::vector<std::shared_ptr<DSCallback>> &Callbacks() const { return callbacks_; }
+  int32_t FusedBatchSize() const { return fused_batch_size_; }
+
+  /// \brief Write the output rows straight into the batches of the Batch node this node feeds
+  /// \param[in] batch_size The fixed batch size of the Batch node, 0 to turn it off
+  void SetFusedBatchSize(int32_t batch_size) { fused_batch_size_ = batch_size; }
 
   /// \brief Get the arguments of node
   /// \param[out] out_json JSON string of all attributes
@@ -108,6 +113,7 @@ class MapNode : public DatasetNode {
   std::vector<std::string> output_columns_;
   std::vector<std::string> project_columns_;
   std::vector<std::shared_ptr<DSCallback>> callbacks_;
+  int32_t fused_batch_size_;
 };
 
 }  // namespace dataset
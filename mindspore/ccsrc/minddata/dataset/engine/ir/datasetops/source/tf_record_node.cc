@@ -127,13 +127,15 @@ Status TFRecordNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_o
     num_workers_, worker_connector_size_, num_samples_, sorted_dir_files, std::move(data_schema), connector_que_size_,
     columns_list_, shuffle_files, num_shards_, shard_id_, shard_equal_rows_);
 
+  // The rows are shuffled by the TFReaderOp itself if every file is indexed.
+  tf_reader_op->SetShuffleRows(shuffle_ == ShuffleMode::kGlobal);
   RETURN_IF_NOT_OK(tf_reader_op->Init());
 
   // If a global shuffle is used for TFRecord, it will inject a shuffle op over the TFRecord.
   // But, if there is a cache in the tree, we do not need the global shuffle and the shuffle op should not be built.
   // This is achieved in the cache transform pass where we call MakeSimpleProducer to reset TFRecord's shuffle
   // option to false.
-  if (shuffle_ == ShuffleMode::kGlobal) {
+  if (shuffle_ == ShuffleMode::kGlobal && !tf_reader_op->ShuffleRows()) {
     // Inject ShuffleOp
 
     std::shared_ptr<DatasetOp> shuffle_op = nullptr;
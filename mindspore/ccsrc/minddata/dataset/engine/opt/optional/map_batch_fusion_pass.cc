@@ -0,0 +1,46 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+
+#include "minddata/dataset/engine/opt/optional/map_batch_fusion_pass.h"
+
+#include "minddata/dataset/engine/ir/datasetops/batch_node.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+
+namespace mindspore {
+namespace dataset {
+
+Status MapBatchFusionPass::Visit(std::shared_ptr<BatchNode> node, bool *const modified) {
+  *modified = false;
+#ifdef ENABLE_PYTHON
+  // The size of every batch must be known ahead, and the rows must be batched as they come out of the map.
+  if (node->BatchSizeFunc() || node->BatchMapFunc() || node->Pad()) {
+    return Status::OK();
+  }
+#endif
+  if (node->BatchSize() <= 1 || node->Children().size() != 1) {
+    return Status::OK();
+  }
+  auto map_node = std::dynamic_pointer_cast<MapNode>(node->Children()[0]);
+  if (map_node == nullptr) {
+    return Status::OK();
+  }
+  map_node->SetFusedBatchSize(node->BatchSize());
+  *modified = true;
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,38 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_MAP_BATCH_FUSION_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_MAP_BATCH_FUSION_PASS_H_
+
+#include <memory>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+
+/// \class MapBatchFusionPass map_batch_fusion_pass.h
+/// \brief An optional optimization pass fusing a Map with the Batch of a fixed size right after it. The map
+///     workers write the output rows into their slots of the batches, so the Batch doesn't copy them.
+class MapBatchFusionPass : public IRNodePass {
+  /// \brief Identifies a Batch which takes its rows from a Map
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates whether the node has been visited
+  /// \return Status The status code returned
+  Status Visit(std::shared_ptr<BatchNode> node, bool *const modified) override;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_MAP_BATCH_FUSION_PASS_H_
@@ -21,12 +21,15 @@
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/resize_ir.h"
 
 namespace mindspore {
 namespace dataset {
@@ -46,7 +49,7 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
     ops.erase(itr + 1);
     node->setOperations(ops);
     *modified = true;
-    return Status::OK();
+    return PassResizeToDecode(node, modified);
   }  // end of temporary code, needs to be deleted when tensorOperation's pybind completes
 
   // logic below is for non-prebuilt TensorOperation
@@ -54,15 +57,68 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op->Name() == nm; });
 
-  // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
-  auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
-  RETURN_UNEXPECTED_IF_NULL(fused_ir);
-  // fuse the two ops
-  (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
-  node->setOperations(ops);
-  *modified = true;
+  if (itr != ops.end()) {
+    auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
+    RETURN_UNEXPECTED_IF_NULL(fused_ir);
+    // fuse the two ops
+    (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
+    ops.erase(itr + 1);
+    node->setOperations(ops);
+    *modified = true;
+  }
+  return PassResizeToDecode(node, modified);
+}
+
+Status TensorOpFusionPass::PassResizeToDecode(std::shared_ptr<MapNode> node, bool *const modified) {
+  // The ops may be shared with other pipelines, so the ones given a hint are replaced by copies.
+  std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
+  bool changed = false;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    const std::string name = ops[i]->Name();
+    if (name == kRandomCropDecodeResizeOp) {
+      auto *op = dynamic_cast<RandomCropDecodeResizeOp *>(ops[i]->Build().get());
+      RETURN_UNEXPECTED_IF_NULL(op);
+      auto scaled_op = std::make_shared<RandomCropDecodeResizeOp>(*op);
+      scaled_op->SetScaledDecode(true);
+      ops[i] = std::make_shared<transforms::PreBuiltOperation>(scaled_op);
+      changed = true;
+    } else if (name == vision::kRandomCropDecodeResizeOperation) {
+      auto *ir = dynamic_cast<vision::RandomCropDecodeResizeOperation *>(ops[i].get());
+      RETURN_UNEXPECTED_IF_NULL(ir);
+      auto scaled_ir = std::make_shared<vision::RandomCropDecodeResizeOperation>(*ir);
+      scaled_ir->SetScaledDecode(true);
+      ops[i] = scaled_ir;
+      changed = true;
+    } else if ((name == kDecodeOp || name == vision::kDecodeOperation) && i + 1 < ops.size() &&
+               (ops[i + 1]->Name() == kResizeOp || ops[i + 1]->Name() == vision::kResizeOperation)) {
+      auto resize_op = std::dynamic_pointer_cast<ResizeOp>(ops[i + 1]->Build());
+      RETURN_UNEXPECTED_IF_NULL(resize_op);
+      int32_t min_height = 0;
+      int32_t min_width = 0;
+      // The output of a single-size Resize follows the aspect ratio of the decoded image, which the scale may round.
+      if (!resize_op->FixedOutputSize(&min_height, &min_width)) {
+        continue;
+      }
+      if (name == kDecodeOp) {
+        auto *op = dynamic_cast<DecodeOp *>(ops[i]->Build().get());
+        RETURN_UNEXPECTED_IF_NULL(op);
+        auto scaled_op = std::make_shared<DecodeOp>(*op);
+        scaled_op->SetResizeHint(min_height, min_width);
+        ops[i] = std::make_shared<transforms::PreBuiltOperation>(scaled_op);
+      } else {
+        auto *ir = dynamic_cast<vision::DecodeOperation *>(ops[i].get());
+        RETURN_UNEXPECTED_IF_NULL(ir);
+        auto scaled_ir = std::make_shared<vision::DecodeOperation>(*ir);
+        scaled_ir->SetResizeHint(min_height, min_width);
+        ops[i] = scaled_ir;
+      }
+      changed = true;
+    }
+  }
+  if (changed) {
+    node->setOperations(ops);
+    *modified = true;
+  }
   return Status::OK();
 }
 }  // namespace dataset
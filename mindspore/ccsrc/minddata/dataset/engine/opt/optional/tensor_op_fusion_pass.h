@@ -31,6 +31,13 @@ class TensorOpFusionPass : public IRNodePass {
   /// \param[in, out] *modified indicates whether the node has been visited
   /// \return Status The status code returned
   Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+ private:
+  /// \brief Lets the decode ops followed by a resize to a fixed size decode jpeg images at a reduced scale
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates whether the node has been modified
+  /// \return Status The status code returned
+  Status PassResizeToDecode(std::shared_ptr<MapNode> node, bool *const modified);
 };
 }  // namespace dataset
 }  // namespace mindspore
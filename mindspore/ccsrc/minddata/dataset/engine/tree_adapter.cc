@@ -19,6 +19,7 @@
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/ir/datasetops/root_node.h"
 #ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/opt/optional/map_batch_fusion_pass.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/pre/cache_transform_pass.h"
 #include "minddata/dataset/engine/opt/post/repeat_pass.h"
@@ -78,6 +79,7 @@ Status TreeAdapter::Optimize(std::shared_ptr<DatasetNode> ir) {
   MS_LOG(INFO) << "Running optimization pass loops";
 #ifndef ENABLE_ANDROID
   optimizations.emplace_back(std::make_unique<TensorOpFusionPass>());
+  optimizations.emplace_back(std::make_unique<MapBatchFusionPass>());
 #endif
   // Apply optimization pass actions
   for (auto i = 0; i < optimizations.size(); i++) {
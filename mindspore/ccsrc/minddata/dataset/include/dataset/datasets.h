@@ -1709,7 +1709,8 @@ std::shared_ptr<DatasetCache> CreateDatasetCacheCharIF(session_id_type id, uint6
                                                        std::optional<std::vector<char>> hostname = std::nullopt,
                                                        std::optional<int32_t> port = std::nullopt,
                                                        std::optional<int32_t> num_connections = std::nullopt,
-                                                       std::optional<int32_t> prefetch_sz = std::nullopt);
+                                                       std::optional<int32_t> prefetch_sz = std::nullopt,
+                                                       bool compress = false);
 
 /// \brief Function the create a cache to be attached to a dataset.
 /// \param id A user assigned session id for the current pipeline.
@@ -1720,14 +1721,16 @@ std::shared_ptr<DatasetCache> CreateDatasetCacheCharIF(session_id_type id, uint6
 /// \param port optional port (default=50052).
 /// \param num_connections optional number of connections (default=12).
 /// \param prefetch_sz optional prefetch size (default=20).
+/// \param compress Keep the rows compressed at the server, they are decompressed after fetching (default=False).
 /// \return Shared pointer to DatasetCache. If error, nullptr is returned.
 inline std::shared_ptr<DatasetCache> CreateDatasetCache(session_id_type id, uint64_t mem_sz, bool spill,
                                                         std::optional<std::string> hostname = std::nullopt,
                                                         std::optional<int32_t> port = std::nullopt,
                                                         std::optional<int32_t> num_connections = std::nullopt,
-                                                        std::optional<int32_t> prefetch_sz = std::nullopt) {
+                                                        std::optional<int32_t> prefetch_sz = std::nullopt,
+                                                        bool compress = false) {
   return CreateDatasetCacheCharIF(id, mem_sz, spill, OptionalStringToChar(hostname), port, num_connections,
-                                  prefetch_sz);
+                                  prefetch_sz, compress);
 }
 
 /// \brief Function to create a ZipDataset.
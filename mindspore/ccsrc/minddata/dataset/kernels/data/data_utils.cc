@@ -30,6 +30,9 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/kernels/data/type_cast_op.h"
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/kernels/image/simd_image_utils.h"
+#endif
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -301,6 +304,13 @@ void CastFrom(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status TypeCast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const DataType &data_type) {
   RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), data_type, output));
 
+#ifndef ENABLE_ANDROID
+  // images are mostly cast from uint8 to float, which has a vectorized kernel
+  if (input->type() == DataType::DE_UINT8 && data_type == DataType::DE_FLOAT32 && input->HasData()) {
+    CastKernel(input->GetBuffer(), &(*(*output)->begin<float>()), input->Size());
+    return Status::OK();
+  }
+#endif
   switch (input->type().value()) {
     case DataType::DE_BOOL:
       CastFrom<bool>(input, output);
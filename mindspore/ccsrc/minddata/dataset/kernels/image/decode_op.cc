@@ -41,7 +41,11 @@ Status DecodeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     RETURN_STATUS_UNEXPECTED("Decode: invalid input shape, only support 1D input.");
   }
   if (is_rgb_format_) {  // RGB colour mode
+#ifndef ENABLE_ANDROID
+    return Decode(input, output, min_height_, min_width_);
+#else
     return Decode(input, output);
+#endif
   } else {  // BGR colour mode
     RETURN_STATUS_UNEXPECTED("Decode: only support RGB image.");
   }
@@ -42,8 +42,18 @@ class DecodeOp : public TensorOp {
 
   std::string Name() const override { return kDecodeOp; }
 
+  /// \brief Decode jpeg images at a reduced scale, as long as they are at least this size. It is set when the image
+  /// is resized to this size right after.
+  /// \param min_height, min_width: the size of the resize, 0 to decode at full size
+  void SetResizeHint(int32_t min_height, int32_t min_width) {
+    min_height_ = min_height;
+    min_width_ = min_width;
+  }
+
  private:
   bool is_rgb_format_ = true;
+  int32_t min_height_ = 0;
+  int32_t min_width_ = 0;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -26,6 +26,7 @@
 #include "minddata/dataset/include/dataset/constants.h"
 #include "minddata/dataset/kernels/image/math_utils.h"
 #include "minddata/dataset/kernels/image/resize_cubic_op.h"
+#include "minddata/dataset/kernels/image/simd_image_utils.h"
 
 const int32_t MAX_INT_PRECISION = 16777216;  // float int precision is 16777216
 const int32_t DEFAULT_NUM_HEIGHT = 1;
@@ -73,26 +74,25 @@ bool CheckTensorShape(const std::shared_ptr<Tensor> &tensor, const int &channel)
 }
 
 Status Flip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int flip_code) {
-  std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(std::move(input));
-
-  if (input_cv->Rank() == 1 || input_cv->mat().dims > 2) {
+  if (input->Rank() != MIN_IMAGE_DIMENSION && input->Rank() != DEFAULT_IMAGE_RANK) {
     RETURN_STATUS_UNEXPECTED("Flip: input tensor is not in shape of <H,W,C> or <H,W>.");
   }
-
-  std::shared_ptr<CVTensor> output_cv;
-  RETURN_IF_NOT_OK(CVTensor::CreateEmpty(input_cv->shape(), input_cv->type(), &output_cv));
-
-  if (input_cv->mat().data) {
-    try {
-      cv::flip(input_cv->mat(), output_cv->mat(), flip_code);
-      *output = std::static_pointer_cast<Tensor>(output_cv);
-      return Status::OK();
-    } catch (const cv::Exception &e) {
-      RETURN_STATUS_UNEXPECTED("Flip: " + std::string(e.what()));
-    }
-  } else {
+  if (!input->type().IsNumeric() || !input->HasData()) {
     RETURN_STATUS_UNEXPECTED("Flip: allocate memory failed.");
   }
+  std::shared_ptr<Tensor> output_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), input->type(), &output_tensor));
+  // the pixels are moved as a whole, so any type and number of channels works the same
+  size_t pixel_size = input->type().SizeInBytes();
+  if (input->Rank() == DEFAULT_IMAGE_RANK) {
+    pixel_size *= input->shape()[CHANNEL_INDEX];
+  }
+  uint8_t *buffer = reinterpret_cast<uint8_t *>(&(*output_tensor->begin<uint8_t>()));
+  // same codes as cv::flip: 0 flips around the x-axis, positive around the y-axis and negative around both axes
+  FlipKernel(input->GetBuffer(), buffer, input->shape()[0], input->shape()[1], pixel_size, flip_code != 0,
+             flip_code <= 0);
+  *output = std::move(output_tensor);
+  return Status::OK();
 }
 
 Status HorizontalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output) {
@@ -104,7 +104,7 @@ Status VerticalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *outp
 }
 
 Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int32_t output_height,
-              int32_t output_width, double fx, double fy, InterpolationMode mode) {
+              int32_t output_width, double fx, double fy, InterpolationMode mode, Tensor::BatchSlots *output_slots) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
   if (!input_cv->mat().data) {
     RETURN_STATUS_UNEXPECTED("Resize: load image failed.");
@@ -117,7 +117,7 @@ Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
     LiteMat imIn, imOut;
     std::shared_ptr<Tensor> output_tensor;
     TensorShape new_shape = TensorShape({output_height, output_width, 3});
-    RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, input_cv->type(), &output_tensor));
+    RETURN_IF_NOT_OK(Tensor::CreateEmptyInSlot(new_shape, input_cv->type(), output_slots, &output_tensor));
     uint8_t *buffer = reinterpret_cast<uint8_t *>(&(*output_tensor->begin<uint8_t>()));
     imOut.Init(output_width, output_height, input_cv->shape()[2], reinterpret_cast<void *>(buffer), LDataType::UINT8);
     imIn.Init(input_cv->shape()[1], input_cv->shape()[0], input_cv->shape()[2], input_cv->mat().data, LDataType::UINT8);
@@ -145,7 +145,13 @@ Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
     int num_channels = input_cv->shape()[CHANNEL_INDEX];
     if (input_cv->Rank() == DEFAULT_IMAGE_RANK) shape = shape.AppendDim(num_channels);
     std::shared_ptr<CVTensor> output_cv;
-    RETURN_IF_NOT_OK(CVTensor::CreateEmpty(shape, input_cv->type(), &output_cv));
+    if (output_slots == nullptr) {
+      RETURN_IF_NOT_OK(CVTensor::CreateEmpty(shape, input_cv->type(), &output_cv));
+    } else {
+      std::shared_ptr<Tensor> output_tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateEmptyInSlot(shape, input_cv->type(), output_slots, &output_tensor));
+      output_cv = CVTensor::AsCVTensor(output_tensor);
+    }
 
     auto cv_mode = GetCVInterpolationMode(mode);
     cv::resize(in_image, output_cv->mat(), cv::Size(output_width, output_height), fx, fy, cv_mode);
@@ -168,9 +174,10 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input) {
   return input->SizeInBytes() > kPngMagicLen && memcmp(input->GetBuffer(), kPngMagic, kPngMagicLen) == 0;
 }
 
-Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int32_t min_height,
+              int32_t min_width) {
   if (IsNonEmptyJPEG(input)) {
-    return JpegCropAndDecode(input, output);
+    return JpegCropAndDecode(input, output, 0, 0, 0, 0, min_height, min_width);
   } else {
     return DecodeCv(input, output);
   }
@@ -322,8 +329,21 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
   throw std::runtime_error(jpeg_last_error_msg);
 }
 
+// The largest denominator of the scales 1/2, 1/4 and 1/8 which still decodes the crop to at least min_h x min_w.
+static int JpegScaleDenom(int crop_h, int crop_w, int min_h, int min_w) {
+  constexpr int kMaxScaleDenom = 8;
+  int denom = 1;
+  if (min_h <= 0 || min_w <= 0) {
+    return denom;
+  }
+  while (denom < kMaxScaleDenom && crop_h / (denom * 2) >= min_h && crop_w / (denom * 2) >= min_w) {
+    denom *= 2;
+  }
+  return denom;
+}
+
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int min_h, int min_w) {
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -348,6 +368,23 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
              static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
     return DestroyDecompressAndReturnError("Crop: invalid crop size.");
   }
+  const int denom = JpegScaleDenom(crop_h, crop_w, min_h, min_w);
+  if (denom > 1) {
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = denom;
+    try {
+      jpeg_calc_output_dimensions(&cinfo);
+    } catch (std::runtime_error &e) {
+      return DestroyDecompressAndReturnError(e.what());
+    }
+    // Round the crop box outwards, so that it still covers the whole crop.
+    int x_end = std::min(static_cast<int>(cinfo.output_width), (crop_x + crop_w + denom - 1) / denom);
+    int y_end = std::min(static_cast<int>(cinfo.output_height), (crop_y + crop_h + denom - 1) / denom);
+    crop_x /= denom;
+    crop_y /= denom;
+    crop_w = x_end - crop_x;
+    crop_h = y_end - crop_y;
+  }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
   unsigned int crop_w_aligned = crop_w + crop_x - crop_x_aligned;
@@ -379,6 +416,18 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
 }
 
 Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift) {
+  if ((input->type() == DataType::DE_UINT8 || input->type() == DataType::DE_FLOAT32) && input->HasData()) {
+    std::shared_ptr<Tensor> output_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), DataType(DataType::DE_FLOAT32), &output_tensor));
+    float *buffer = &(*output_tensor->begin<float>());
+    if (input->type() == DataType::DE_UINT8) {
+      RescaleKernel(input->GetBuffer(), buffer, input->Size(), rescale, shift);
+    } else {
+      RescaleKernel(reinterpret_cast<const float *>(input->GetBuffer()), buffer, input->Size(), rescale, shift);
+    }
+    *output = std::move(output_tensor);
+    return Status::OK();
+  }
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
   if (!input_cv->mat().data) {
     RETURN_STATUS_UNEXPECTED("Rescale: load image failed.");
@@ -433,39 +482,31 @@ Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *outpu
 }
 
 Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output) {
-  try {
-    std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
-    if (!input_cv->mat().data) {
-      RETURN_STATUS_UNEXPECTED("HWC2CHW: load image failed.");
-    }
-    if (input_cv->Rank() == 2) {
-      // If input tensor is 2D, we assume we have hw dimensions
-      *output = input;
-      return Status::OK();
-    }
-    int num_channels = input_cv->shape()[CHANNEL_INDEX];
-    if (input_cv->shape().Size() < MIN_IMAGE_DIMENSION || input_cv->shape().Size() > DEFAULT_IMAGE_CHANNELS ||
-        (input_cv->shape().Size() == DEFAULT_IMAGE_CHANNELS && num_channels != DEFAULT_IMAGE_CHANNELS &&
-         num_channels != MIN_IMAGE_CHANNELS)) {
-      RETURN_STATUS_UNEXPECTED("HWC2CHW: image shape is not <H,W,C>.");
-    }
-    cv::Mat output_img;
-
-    int height = input_cv->shape()[0];
-    int width = input_cv->shape()[1];
-
-    std::shared_ptr<CVTensor> output_cv;
-    RETURN_IF_NOT_OK(CVTensor::CreateEmpty(TensorShape{num_channels, height, width}, input_cv->type(), &output_cv));
-    for (int i = 0; i < num_channels; ++i) {
-      cv::Mat mat;
-      RETURN_IF_NOT_OK(output_cv->MatAtIndex({i}, &mat));
-      cv::extractChannel(input_cv->mat(), mat, i);
-    }
-    *output = std::move(output_cv);
+  if (!input->type().IsNumeric() || !input->HasData()) {
+    RETURN_STATUS_UNEXPECTED("HWC2CHW: load image failed.");
+  }
+  if (input->Rank() == 2) {
+    // If input tensor is 2D, we assume we have hw dimensions
+    *output = input;
     return Status::OK();
-  } catch (const cv::Exception &e) {
-    RETURN_STATUS_UNEXPECTED("HWC2CHW: " + std::string(e.what()));
   }
+  if (input->Rank() != DEFAULT_IMAGE_RANK) {
+    RETURN_STATUS_UNEXPECTED("HWC2CHW: image shape is not <H,W,C>.");
+  }
+  int num_channels = input->shape()[CHANNEL_INDEX];
+  if (num_channels != DEFAULT_IMAGE_CHANNELS && num_channels != MIN_IMAGE_CHANNELS) {
+    RETURN_STATUS_UNEXPECTED("HWC2CHW: image shape is not <H,W,C>.");
+  }
+  int height = input->shape()[0];
+  int width = input->shape()[1];
+
+  std::shared_ptr<Tensor> output_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape{num_channels, height, width}, input->type(), &output_tensor));
+  uint8_t *buffer = reinterpret_cast<uint8_t *>(&(*output_tensor->begin<uint8_t>()));
+  HwcToChwKernel(input->GetBuffer(), buffer, static_cast<size_t>(height) * width, num_channels,
+                 input->type().SizeInBytes());
+  *output = std::move(output_tensor);
+  return Status::OK();
 }
 
 Status MaskWithTensor(const std::shared_ptr<Tensor> &sub_mat, std::shared_ptr<Tensor> *input, int x, int y,
@@ -727,7 +768,8 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
       Normalize<int8_t>(input, output, mean, std);
       break;
     case DataType::DE_UINT8:
-      Normalize<uint8_t>(input, output, mean, std);
+      NormalizeKernel(input->GetBuffer(), &(*(*output)->begin<float>()), input->Size() / mean.size(), mean.size(),
+                      mean.data(), std.data());
       break;
     case DataType::DE_INT16:
       Normalize<int16_t>(input, output, mean, std);
@@ -753,7 +795,8 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
       break;
 #endif
     case DataType::DE_FLOAT32:
-      Normalize<float>(input, output, mean, std);
+      NormalizeKernel(reinterpret_cast<const float *>(input->GetBuffer()), &(*(*output)->begin<float>()),
+                      input->Size() / mean.size(), mean.size(), mean.data(), std.data());
       break;
     case DataType::DE_FLOAT64:
       Normalize<double>(input, output, mean, std);
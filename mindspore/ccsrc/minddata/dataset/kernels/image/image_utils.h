@@ -94,9 +94,10 @@ Status VerticalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *outp
 /// \param InterpolationMode: the interpolation mode
 /// \param output: Resized image of shape <outputHeight,outputWidth,C> or <outputHeight,outputWidth>
 ///                and same type as input
+/// \param output_slots: the batch slots to create the output on, see Tensor::CreateEmptyInSlot. nullptr for none.
 Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int32_t output_height,
               int32_t output_width, double fx = 0.0, double fy = 0.0,
-              InterpolationMode mode = InterpolationMode::kLinear);
+              InterpolationMode mode = InterpolationMode::kLinear, Tensor::BatchSlots *output_slots = nullptr);
 
 /// \brief Returns Decoded image
 /// Supported images:
@@ -104,7 +105,10 @@ Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 /// supported by opencv, if user need more image analysis capabilities, please compile opencv particularlly.
 /// \param input: CVTensor containing the not decoded image 1D bytes
 /// \param output: Decoded image Tensor of shape <H,W,C> and type DE_UINT8. Pixel order is RGB
-Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+/// \param min_height, min_width: the size the image is resized to afterwards, see JpegCropAndDecode. 0 to decode
+///     at full size.
+Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int32_t min_height = 0,
+              int32_t min_width = 0);
 
 Status DecodeCv(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
 
@@ -114,8 +118,14 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Decode a jpeg image, or a crop of it
+/// \param x, y, w, h: the crop box in the full size image, all 0 to decode the whole image
+/// \param min_h, min_w: the size the decoded crop is resized to afterwards. The image is then decoded at the
+///     smallest scale of 1/2, 1/4 or 1/8 which still yields a crop at least this size. The scaling is done in the DCT
+///     domain, which saves most of the work of decoding. The crop box is scaled with the image. 0 to decode at full
+///     size.
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int min_h = 0, int min_w = 0);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
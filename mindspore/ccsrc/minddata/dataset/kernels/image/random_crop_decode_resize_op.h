@@ -46,6 +46,12 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
   std::string Name() const override { return kRandomCropDecodeResizeOp; }
+
+  /// \brief Decode jpeg images at the smallest scale which still yields a crop of at least the target size
+  void SetScaledDecode(bool scaled_decode) { scaled_decode_ = scaled_decode; }
+
+ private:
+  bool scaled_decode_ = false;
 };
 }  // namespace dataset
 }  // namespace mindspore
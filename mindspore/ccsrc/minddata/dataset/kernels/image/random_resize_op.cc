@@ -31,5 +31,10 @@ Status RandomResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared
   interpolation_ = static_cast<InterpolationMode>(distribution_(random_generator_));
   return ResizeOp::Compute(input, output);
 }
+
+Status RandomResizeOp::ComputeInSlots(const TensorRow &input, TensorRow *output, Tensor::BatchSlots *output_slots) {
+  interpolation_ = static_cast<InterpolationMode>(distribution_(random_generator_));
+  return ResizeOp::ComputeInSlots(input, output, output_slots);
+}
 }  // namespace dataset
 }  // namespace mindspore
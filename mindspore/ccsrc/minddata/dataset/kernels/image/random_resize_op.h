@@ -45,6 +45,8 @@ class RandomResizeOp : public ResizeOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  Status ComputeInSlots(const TensorRow &input, TensorRow *output, Tensor::BatchSlots *output_slots) override;
+
   std::string Name() const override { return kRandomResizeOp; }
 
  private:
@@ -28,6 +28,18 @@ const int32_t ResizeOp::kDefWidth = 0;
 const InterpolationMode ResizeOp::kDefInterpolation = InterpolationMode::kLinear;
 
 Status ResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  return ResizeInSlots(input, output, nullptr);
+}
+
+Status ResizeOp::ComputeInSlots(const TensorRow &input, TensorRow *output, Tensor::BatchSlots *output_slots) {
+  IO_CHECK_VECTOR(input, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(input.size() == 1, "The op is OneToOne, can only accept one tensor as input.");
+  output->resize(1);
+  return ResizeInSlots(input[0], &(*output)[0], output_slots);
+}
+
+Status ResizeOp::ResizeInSlots(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                               Tensor::BatchSlots *output_slots) {
   IO_CHECK(input, output);
   CHECK_FAIL_RETURN_UNEXPECTED(input->shape().Size() >= 2, "Resize: image shape is not <H,W,C> or <H,W>.");
   int32_t output_h, output_w = 0;
@@ -47,7 +59,11 @@ Status ResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     output_h = size1_;
     output_w = size2_;
   }
+#ifndef ENABLE_ANDROID
+  return Resize(input, output, output_h, output_w, 0, 0, interpolation_, output_slots);
+#else
   return Resize(input, output, output_h, output_w, 0, 0, interpolation_);
+#endif
 }
 
 Status ResizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
@@ -57,11 +57,30 @@ class ResizeOp : public TensorOp {
   void Print(std::ostream &out) const override { out << Name() << ": " << size1_ << " " << size2_; }
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+  Status ComputeInSlots(const TensorRow &input, TensorRow *output, Tensor::BatchSlots *output_slots) override;
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 
   std::string Name() const override { return kResizeOp; }
 
+  // The output has this size, whatever the size of the input. A single size keeps the aspect ratio of the input,
+  // so its output size depends on the input.
+  // @param height: the output height
+  // @param width: the output width
+  // @return true if the output size does not depend on the input
+  bool FixedOutputSize(int32_t *height, int32_t *width) const {
+    if (size2_ == 0) {
+      return false;
+    }
+    *height = size1_;
+    *width = size2_;
+    return true;
+  }
+
  protected:
+  // Resize the image, creating the output on one of the slots if it fits, see Tensor::CreateEmptyInSlot.
+  Status ResizeInSlots(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                       Tensor::BatchSlots *output_slots);
+
   int32_t size1_;
   int32_t size2_;
   InterpolationMode interpolation_;
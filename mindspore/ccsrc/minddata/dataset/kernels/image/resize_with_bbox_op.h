@@ -47,6 +47,11 @@ class ResizeWithBBoxOp : public ResizeOp {
     return TensorOp::Compute(input, output);
   }
 
+  // The image and the boxes are not one tensor as ResizeOp expects, so the row is computed like a TensorOp does.
+  Status ComputeInSlots(const TensorRow &input, TensorRow *output, Tensor::BatchSlots *output_slots) override {
+    return TensorOp::ComputeInSlots(input, output, output_slots);
+  }
+
   std::string Name() const override { return kResizeWithBBoxOp; }
 
   uint32_t NumInput() override { return 2; }
@@ -0,0 +1,595 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/simd_image_utils.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SIMD_IMAGE_X86
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr size_t kNumRgbChannels = 3;
+// The number of floats in the widest vectors
+constexpr size_t kMaxLanes = 8;
+
+#if defined(SIMD_IMAGE_X86) || defined(__aarch64__)
+// Repeat the values of the channels over num_channels * kMaxLanes floats. A block of num_channels vectors starts on
+// the first channel, and its vector v finds the values of its channels at pattern + v * lanes, for any lanes up to
+// kMaxLanes.
+std::vector<float> ExpandChannels(const float *values, size_t num_channels) {
+  std::vector<float> pattern(num_channels * kMaxLanes);
+  for (size_t k = 0; k < pattern.size(); ++k) {
+    pattern[k] = values[k % num_channels];
+  }
+  return pattern;
+}
+#endif
+
+template <typename T>
+void HwcToChwPixels(const T *src, T *dst, size_t num_pixels, size_t num_channels, size_t begin) {
+  for (size_t c = 0; c < num_channels; ++c) {
+    T *plane = dst + c * num_pixels;
+    for (size_t p = begin; p < num_pixels; ++p) {
+      plane[p] = src[p * num_channels + c];
+    }
+  }
+}
+
+// Move the pixels [begin, end) of a row of width pixels to their mirrored place.
+template <size_t N>
+void ReversePixels(const uint8_t *src, uint8_t *dst, size_t width, size_t begin, size_t end) {
+  for (size_t p = begin; p < end; ++p) {
+    (void)memcpy(dst + (width - 1 - p) * N, src + p * N, N);
+  }
+}
+
+#if defined(SIMD_IMAGE_X86)
+#define TARGET_AVX2 __attribute__((target("avx2,fma")))
+
+bool CpuHasAvx2() {
+  static const bool has_avx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  }();
+  return has_avx2;
+}
+
+TARGET_AVX2 inline __m256 LoadAvx2(const uint8_t *p) {
+  return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p))));
+}
+
+TARGET_AVX2 inline __m256 LoadAvx2(const float *p) { return _mm256_loadu_ps(p); }
+
+inline __m128 LoadSse2(const uint8_t *p) {
+  int32_t bytes;
+  (void)memcpy(&bytes, p, sizeof(bytes));
+  const __m128i zero = _mm_setzero_si128();
+  __m128i x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero);
+  return _mm_cvtepi32_ps(_mm_unpacklo_epi16(x, zero));
+}
+
+inline __m128 LoadSse2(const float *p) { return _mm_loadu_ps(p); }
+
+template <typename T>
+TARGET_AVX2 size_t NormalizeAvx2(const T *src, float *dst, size_t size, size_t num_channels, const float *mean,
+                                 const float *std) {
+  constexpr size_t kLanes = 8;
+  const size_t block = num_channels * kLanes;
+  size_t i = 0;
+  for (; i + block <= size; i += block) {
+    for (size_t v = 0; v < num_channels; ++v) {
+      __m256 x = _mm256_div_ps(LoadAvx2(src + i + v * kLanes), _mm256_loadu_ps(std + v * kLanes));
+      _mm256_storeu_ps(dst + i + v * kLanes, _mm256_sub_ps(x, _mm256_loadu_ps(mean + v * kLanes)));
+    }
+  }
+  return i;
+}
+
+template <typename T>
+size_t NormalizeSse2(const T *src, float *dst, size_t size, size_t num_channels, const float *mean,
+                     const float *std) {
+  constexpr size_t kLanes = 4;
+  const size_t block = num_channels * kLanes;
+  size_t i = 0;
+  for (; i + block <= size; i += block) {
+    for (size_t v = 0; v < num_channels; ++v) {
+      __m128 x = _mm_div_ps(LoadSse2(src + i + v * kLanes), _mm_loadu_ps(std + v * kLanes));
+      _mm_storeu_ps(dst + i + v * kLanes, _mm_sub_ps(x, _mm_loadu_ps(mean + v * kLanes)));
+    }
+  }
+  return i;
+}
+
+template <typename T>
+size_t NormalizeVector(const T *src, float *dst, size_t size, size_t num_channels, const float *mean,
+                       const float *std) {
+  std::vector<float> mean_pattern = ExpandChannels(mean, num_channels);
+  std::vector<float> std_pattern = ExpandChannels(std, num_channels);
+  if (CpuHasAvx2()) {
+    return NormalizeAvx2(src, dst, size, num_channels, mean_pattern.data(), std_pattern.data());
+  }
+  return NormalizeSse2(src, dst, size, num_channels, mean_pattern.data(), std_pattern.data());
+}
+
+template <typename T>
+TARGET_AVX2 void RescaleAvx2(const T *src, float *dst, size_t size, float scale, float shift) {
+  constexpr size_t kLanes = 8;
+  const __m256 a = _mm256_set1_ps(scale);
+  const __m256 b = _mm256_set1_ps(shift);
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(LoadAvx2(src + i), a, b));
+  }
+  for (; i < size; ++i) {
+    dst[i] = std::fma(static_cast<float>(src[i]), scale, shift);
+  }
+}
+
+template <typename T>
+void RescaleSse2(const T *src, float *dst, size_t size, float scale, float shift) {
+  constexpr size_t kLanes = 4;
+  const __m128 a = _mm_set1_ps(scale);
+  const __m128 b = _mm_set1_ps(shift);
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(LoadSse2(src + i), a), b));
+  }
+  for (; i < size; ++i) {
+    dst[i] = static_cast<float>(src[i]) * scale + shift;
+  }
+}
+
+template <typename T>
+void RescaleVector(const T *src, float *dst, size_t size, float scale, float shift) {
+  if (CpuHasAvx2()) {
+    RescaleAvx2(src, dst, size, scale, shift);
+  } else {
+    RescaleSse2(src, dst, size, scale, shift);
+  }
+}
+
+TARGET_AVX2 size_t CastAvx2(const uint8_t *src, float *dst, size_t size) {
+  constexpr size_t kLanes = 8;
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    _mm256_storeu_ps(dst + i, LoadAvx2(src + i));
+  }
+  return i;
+}
+
+size_t CastSse2(const uint8_t *src, float *dst, size_t size) {
+  constexpr size_t kLanes = 4;
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    _mm_storeu_ps(dst + i, LoadSse2(src + i));
+  }
+  return i;
+}
+
+size_t CastVector(const uint8_t *src, float *dst, size_t size) {
+  return CpuHasAvx2() ? CastAvx2(src, dst, size) : CastSse2(src, dst, size);
+}
+
+// Split 4 pixels of 3 values of 4 bytes, loaded as a0 = r0 g0 b0 r1, a1 = g1 b1 r2 g2 and a2 = b2 r3 g3 b3. Each
+// channel takes its values in pairs from two of the vectors, and then one value of each pair.
+size_t HwcToChw3Vector(const uint32_t *src, uint32_t *dst, size_t num_pixels) {
+  constexpr size_t kLanes = 4;
+  float *r = reinterpret_cast<float *>(dst);
+  float *g = r + num_pixels;
+  float *b = g + num_pixels;
+  size_t p = 0;
+  for (; p + kLanes <= num_pixels; p += kLanes) {
+    const float *s = reinterpret_cast<const float *>(src + p * kNumRgbChannels);
+    __m128 a0 = _mm_loadu_ps(s);
+    __m128 a1 = _mm_loadu_ps(s + kLanes);
+    __m128 a2 = _mm_loadu_ps(s + 2 * kLanes);
+    __m128 lo = _mm_shuffle_ps(a0, a0, _MM_SHUFFLE(3, 3, 0, 0));  // r0 r0 r1 r1
+    __m128 hi = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(1, 1, 2, 2));  // r2 r2 r3 r3
+    _mm_storeu_ps(r + p, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+    lo = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(0, 0, 1, 1));  // g0 g0 g1 g1
+    hi = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(2, 2, 3, 3));  // g2 g2 g3 g3
+    _mm_storeu_ps(g + p, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+    lo = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(1, 1, 2, 2));  // b0 b0 b1 b1
+    hi = _mm_shuffle_ps(a2, a2, _MM_SHUFFLE(3, 3, 0, 0));  // b2 b2 b3 b3
+    _mm_storeu_ps(b + p, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+  }
+  return p;
+}
+
+// The byte shuffles which gather the values of channel c from the 16 bytes k of 16 pixels of 3 bytes.
+struct RgbSplitMasks {
+  int8_t mask[kNumRgbChannels][kNumRgbChannels][16];
+};
+
+const RgbSplitMasks &GetRgbSplitMasks() {
+  static const RgbSplitMasks masks = [] {
+    constexpr int kZeroByte = -128;
+    constexpr int kVectorSize = 16;
+    RgbSplitMasks m{};
+    for (int c = 0; c < static_cast<int>(kNumRgbChannels); ++c) {
+      for (int k = 0; k < static_cast<int>(kNumRgbChannels); ++k) {
+        for (int i = 0; i < kVectorSize; ++i) {
+          int pos = static_cast<int>(kNumRgbChannels) * i + c - kVectorSize * k;
+          m.mask[c][k][i] = static_cast<int8_t>(pos >= 0 && pos < kVectorSize ? pos : kZeroByte);
+        }
+      }
+    }
+    return m;
+  }();
+  return masks;
+}
+
+TARGET_AVX2 size_t HwcToChw3Avx2(const uint8_t *src, uint8_t *dst, size_t num_pixels) {
+  constexpr size_t kLanes = 16;
+  const RgbSplitMasks &m = GetRgbSplitMasks();
+  __m128i masks[kNumRgbChannels][kNumRgbChannels];
+  for (size_t c = 0; c < kNumRgbChannels; ++c) {
+    for (size_t k = 0; k < kNumRgbChannels; ++k) {
+      masks[c][k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m.mask[c][k]));
+    }
+  }
+  size_t p = 0;
+  for (; p + kLanes <= num_pixels; p += kLanes) {
+    const uint8_t *s = src + p * kNumRgbChannels;
+    __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+    __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + kLanes));
+    __m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 2 * kLanes));
+    for (size_t c = 0; c < kNumRgbChannels; ++c) {
+      __m128i x = _mm_or_si128(_mm_shuffle_epi8(a0, masks[c][0]), _mm_shuffle_epi8(a1, masks[c][1]));
+      x = _mm_or_si128(x, _mm_shuffle_epi8(a2, masks[c][2]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + c * num_pixels + p), x);
+    }
+  }
+  return p;
+}
+
+size_t HwcToChw3Vector(const uint8_t *src, uint8_t *dst, size_t num_pixels) {
+  return CpuHasAvx2() ? HwcToChw3Avx2(src, dst, num_pixels) : 0;
+}
+
+TARGET_AVX2 void ReverseRow1Avx2(const uint8_t *src, uint8_t *dst, size_t width) {
+  constexpr size_t kLanes = 32;
+  const __m256i reverse = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11,
+                                           10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  size_t p = 0;
+  for (; p + kLanes <= width; p += kLanes) {
+    __m256i x = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + p)), reverse);
+    x = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 3, 2));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + width - kLanes - p), x);
+  }
+  ReversePixels<1>(src, dst, width, p, width);
+}
+
+// A vector of 16 bytes holds 5 pixels of 3 bytes, and its last byte spills onto the next pixel of the destination.
+// The vectors are stored from the start of the destination row, so that each spilled byte is overwritten right after.
+TARGET_AVX2 void ReverseRow3Avx2(const uint8_t *src, uint8_t *dst, size_t width) {
+  constexpr size_t kPixels = 5;
+  constexpr int kZeroByte = -128;
+  const __m128i reverse = _mm_setr_epi8(12, 13, 14, 9, 10, 11, 6, 7, 8, 3, 4, 5, 0, 1, 2, kZeroByte);
+  // The vector loads one byte past its pixels and stores one byte past them, so the first and the last pixels of
+  // the row are left to the plain loop.
+  size_t end = width > 0 ? width - 1 : 0;
+  while (end >= kPixels + 1) {
+    size_t begin = end - kPixels;
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + begin * kNumRgbChannels));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + (width - end) * kNumRgbChannels), _mm_shuffle_epi8(x, reverse));
+    end = begin;
+  }
+  ReversePixels<kNumRgbChannels>(src, dst, width, 0, end);
+  ReversePixels<kNumRgbChannels>(src, dst, width, width > 0 ? width - 1 : 0, width);
+}
+
+TARGET_AVX2 void ReverseRow4Avx2(const uint8_t *src, uint8_t *dst, size_t width) {
+  constexpr size_t kPixelSize = 4;
+  constexpr size_t kLanes = 8;
+  const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  size_t p = 0;
+  for (; p + kLanes <= width; p += kLanes) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + p * kPixelSize));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + (width - kLanes - p) * kPixelSize),
+                        _mm256_permutevar8x32_epi32(x, reverse));
+  }
+  ReversePixels<kPixelSize>(src, dst, width, p, width);
+}
+
+void ReverseRow1(const uint8_t *src, uint8_t *dst, size_t width) {
+  if (CpuHasAvx2()) {
+    ReverseRow1Avx2(src, dst, width);
+  } else {
+    ReversePixels<1>(src, dst, width, 0, width);
+  }
+}
+
+void ReverseRow3(const uint8_t *src, uint8_t *dst, size_t width) {
+  if (CpuHasAvx2()) {
+    ReverseRow3Avx2(src, dst, width);
+  } else {
+    ReversePixels<kNumRgbChannels>(src, dst, width, 0, width);
+  }
+}
+
+void ReverseRow4(const uint8_t *src, uint8_t *dst, size_t width) {
+  if (CpuHasAvx2()) {
+    ReverseRow4Avx2(src, dst, width);
+  } else {
+    ReversePixels<4>(src, dst, width, 0, width);
+  }
+}
+#elif defined(__aarch64__)
+inline float32x4_t LoadNeon(const uint8_t *p) {
+  uint32_t bytes;
+  (void)memcpy(&bytes, p, sizeof(bytes));
+  uint16x8_t x = vmovl_u8(vcreate_u8(bytes));
+  return vcvtq_f32_u32(vmovl_u16(vget_low_u16(x)));
+}
+
+inline float32x4_t LoadNeon(const float *p) { return vld1q_f32(p); }
+
+template <typename T>
+size_t NormalizeVector(const T *src, float *dst, size_t size, size_t num_channels, const float *mean,
+                       const float *std) {
+  constexpr size_t kLanes = 4;
+  std::vector<float> mean_pattern = ExpandChannels(mean, num_channels);
+  std::vector<float> std_pattern = ExpandChannels(std, num_channels);
+  const size_t block = num_channels * kLanes;
+  size_t i = 0;
+  for (; i + block <= size; i += block) {
+    for (size_t v = 0; v < num_channels; ++v) {
+      float32x4_t x = vdivq_f32(LoadNeon(src + i + v * kLanes), vld1q_f32(std_pattern.data() + v * kLanes));
+      vst1q_f32(dst + i + v * kLanes, vsubq_f32(x, vld1q_f32(mean_pattern.data() + v * kLanes)));
+    }
+  }
+  return i;
+}
+
+template <typename T>
+void RescaleVector(const T *src, float *dst, size_t size, float scale, float shift) {
+  constexpr size_t kLanes = 4;
+  const float32x4_t a = vdupq_n_f32(scale);
+  const float32x4_t b = vdupq_n_f32(shift);
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    vst1q_f32(dst + i, vfmaq_f32(b, LoadNeon(src + i), a));
+  }
+  for (; i < size; ++i) {
+    dst[i] = std::fma(static_cast<float>(src[i]), scale, shift);
+  }
+}
+
+size_t CastVector(const uint8_t *src, float *dst, size_t size) {
+  constexpr size_t kLanes = 4;
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    vst1q_f32(dst + i, LoadNeon(src + i));
+  }
+  return i;
+}
+
+size_t HwcToChw3Vector(const uint32_t *src, uint32_t *dst, size_t num_pixels) {
+  constexpr size_t kLanes = 4;
+  size_t p = 0;
+  for (; p + kLanes <= num_pixels; p += kLanes) {
+    uint32x4x3_t x = vld3q_u32(src + p * kNumRgbChannels);
+    for (size_t c = 0; c < kNumRgbChannels; ++c) {
+      vst1q_u32(dst + c * num_pixels + p, x.val[c]);
+    }
+  }
+  return p;
+}
+
+size_t HwcToChw3Vector(const uint8_t *src, uint8_t *dst, size_t num_pixels) {
+  constexpr size_t kLanes = 16;
+  size_t p = 0;
+  for (; p + kLanes <= num_pixels; p += kLanes) {
+    uint8x16x3_t x = vld3q_u8(src + p * kNumRgbChannels);
+    for (size_t c = 0; c < kNumRgbChannels; ++c) {
+      vst1q_u8(dst + c * num_pixels + p, x.val[c]);
+    }
+  }
+  return p;
+}
+
+inline uint8x16_t ReverseBytes(uint8x16_t x) {
+  constexpr int kHalf = 8;
+  x = vrev64q_u8(x);
+  return vextq_u8(x, x, kHalf);
+}
+
+void ReverseRow1(const uint8_t *src, uint8_t *dst, size_t width) {
+  constexpr size_t kLanes = 16;
+  size_t p = 0;
+  for (; p + kLanes <= width; p += kLanes) {
+    vst1q_u8(dst + width - kLanes - p, ReverseBytes(vld1q_u8(src + p)));
+  }
+  ReversePixels<1>(src, dst, width, p, width);
+}
+
+void ReverseRow3(const uint8_t *src, uint8_t *dst, size_t width) {
+  constexpr size_t kLanes = 16;
+  size_t p = 0;
+  for (; p + kLanes <= width; p += kLanes) {
+    uint8x16x3_t x = vld3q_u8(src + p * kNumRgbChannels);
+    for (size_t c = 0; c < kNumRgbChannels; ++c) {
+      x.val[c] = ReverseBytes(x.val[c]);
+    }
+    vst3q_u8(dst + (width - kLanes - p) * kNumRgbChannels, x);
+  }
+  ReversePixels<kNumRgbChannels>(src, dst, width, p, width);
+}
+
+void ReverseRow4(const uint8_t *src, uint8_t *dst, size_t width) {
+  constexpr size_t kPixelSize = 4;
+  constexpr size_t kLanes = 4;
+  constexpr int kHalf = 2;
+  size_t p = 0;
+  for (; p + kLanes <= width; p += kLanes) {
+    uint32x4_t x = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(src + p * kPixelSize)));
+    vst1q_u8(dst + (width - kLanes - p) * kPixelSize, vreinterpretq_u8_u32(vextq_u32(x, x, kHalf)));
+  }
+  ReversePixels<kPixelSize>(src, dst, width, p, width);
+}
+#else
+template <typename T>
+size_t NormalizeVector(const T *, float *, size_t, size_t, const float *, const float *) {
+  return 0;
+}
+
+template <typename T>
+void RescaleVector(const T *src, float *dst, size_t size, float scale, float shift) {
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] = static_cast<float>(src[i]) * scale + shift;
+  }
+}
+
+size_t CastVector(const uint8_t *, float *, size_t) { return 0; }
+
+template <typename T>
+size_t HwcToChw3Vector(const T *, T *, size_t) {
+  return 0;
+}
+
+void ReverseRow1(const uint8_t *src, uint8_t *dst, size_t width) { ReversePixels<1>(src, dst, width, 0, width); }
+
+void ReverseRow3(const uint8_t *src, uint8_t *dst, size_t width) {
+  ReversePixels<kNumRgbChannels>(src, dst, width, 0, width);
+}
+
+void ReverseRow4(const uint8_t *src, uint8_t *dst, size_t width) { ReversePixels<4>(src, dst, width, 0, width); }
+#endif
+
+template <typename T>
+void NormalizeImpl(const T *src, float *dst, size_t num_pixels, size_t num_channels, const float *mean,
+                   const float *std) {
+  if (num_channels == 0) {
+    return;
+  }
+  const size_t size = num_pixels * num_channels;
+  // The vectors cover whole blocks of pixels, so the rest still starts on the first channel.
+  size_t i = NormalizeVector(src, dst, size, num_channels, mean, std);
+  for (; i < size; ++i) {
+    size_t c = i % num_channels;
+    dst[i] = static_cast<float>(src[i]) / std[c] - mean[c];
+  }
+}
+
+void ReverseRow(const uint8_t *src, uint8_t *dst, size_t width, size_t pixel_size) {
+  constexpr size_t kRgbFloatSize = 12;
+  switch (pixel_size) {
+    case 1:
+      ReverseRow1(src, dst, width);
+      break;
+    case kNumRgbChannels:
+      ReverseRow3(src, dst, width);
+      break;
+    case sizeof(float):
+      ReverseRow4(src, dst, width);
+      break;
+    case kRgbFloatSize:
+      ReversePixels<kRgbFloatSize>(src, dst, width, 0, width);
+      break;
+    default:
+      for (size_t p = 0; p < width; ++p) {
+        (void)memcpy(dst + (width - 1 - p) * pixel_size, src + p * pixel_size, pixel_size);
+      }
+      break;
+  }
+}
+}  // namespace
+
+void NormalizeKernel(const uint8_t *src, float *dst, size_t num_pixels, size_t num_channels, const float *mean,
+                     const float *std) {
+  NormalizeImpl(src, dst, num_pixels, num_channels, mean, std);
+}
+
+void NormalizeKernel(const float *src, float *dst, size_t num_pixels, size_t num_channels, const float *mean,
+                     const float *std) {
+  NormalizeImpl(src, dst, num_pixels, num_channels, mean, std);
+}
+
+void RescaleKernel(const uint8_t *src, float *dst, size_t size, float scale, float shift) {
+  RescaleVector(src, dst, size, scale, shift);
+}
+
+void RescaleKernel(const float *src, float *dst, size_t size, float scale, float shift) {
+  RescaleVector(src, dst, size, scale, shift);
+}
+
+void CastKernel(const uint8_t *src, float *dst, size_t size) {
+  size_t i = CastVector(src, dst, size);
+  for (; i < size; ++i) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+void HwcToChwKernel(const uint8_t *src, uint8_t *dst, size_t num_pixels, size_t num_channels, size_t elem_size) {
+  size_t begin = 0;
+  switch (elem_size) {
+    case sizeof(uint8_t):
+      if (num_channels == kNumRgbChannels) {
+        begin = HwcToChw3Vector(src, dst, num_pixels);
+      }
+      HwcToChwPixels(src, dst, num_pixels, num_channels, begin);
+      break;
+    case sizeof(uint16_t):
+      HwcToChwPixels(reinterpret_cast<const uint16_t *>(src), reinterpret_cast<uint16_t *>(dst), num_pixels,
+                     num_channels, begin);
+      break;
+    case sizeof(uint32_t): {
+      auto *src32 = reinterpret_cast<const uint32_t *>(src);
+      auto *dst32 = reinterpret_cast<uint32_t *>(dst);
+      if (num_channels == kNumRgbChannels) {
+        begin = HwcToChw3Vector(src32, dst32, num_pixels);
+      }
+      HwcToChwPixels(src32, dst32, num_pixels, num_channels, begin);
+      break;
+    }
+    case sizeof(uint64_t):
+      HwcToChwPixels(reinterpret_cast<const uint64_t *>(src), reinterpret_cast<uint64_t *>(dst), num_pixels,
+                     num_channels, begin);
+      break;
+    default:
+      for (size_t c = 0; c < num_channels; ++c) {
+        for (size_t p = 0; p < num_pixels; ++p) {
+          (void)memcpy(dst + (c * num_pixels + p) * elem_size, src + (p * num_channels + c) * elem_size, elem_size);
+        }
+      }
+      break;
+  }
+}
+
+void FlipKernel(const uint8_t *src, uint8_t *dst, size_t height, size_t width, size_t pixel_size, bool horizontal,
+                bool vertical) {
+  const size_t row_size = width * pixel_size;
+  for (size_t r = 0; r < height; ++r) {
+    const uint8_t *src_row = src + r * row_size;
+    uint8_t *dst_row = dst + (vertical ? height - 1 - r : r) * row_size;
+    if (horizontal) {
+      ReverseRow(src_row, dst_row, width, pixel_size);
+    } else {
+      (void)memcpy(dst_row, src_row, row_size);
+    }
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_SIMD_IMAGE_UTILS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_SIMD_IMAGE_UTILS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mindspore {
+namespace dataset {
+// Kernels of the simple image ops, which work on the buffers of the tensors directly. On x86 they use AVX2 when the
+// cpu has it (checked at run time) and SSE2 otherwise, on arm they use NEON. Other targets run plain loops.
+// The source and the destination buffers must not overlap.
+
+/// \brief dst = src / std[c] - mean[c], where c is the channel of the value in an image with interleaved channels.
+/// \param[in] num_pixels The number of pixels of the image
+/// \param[in] num_channels The number of channels, and the size of mean and std
+void NormalizeKernel(const uint8_t *src, float *dst, size_t num_pixels, size_t num_channels, const float *mean,
+                     const float *std);
+void NormalizeKernel(const float *src, float *dst, size_t num_pixels, size_t num_channels, const float *mean,
+                     const float *std);
+
+/// \brief dst = src * scale + shift. Like in OpenCV, the product and the sum are fused on the cpus which have FMA.
+void RescaleKernel(const uint8_t *src, float *dst, size_t size, float scale, float shift);
+void RescaleKernel(const float *src, float *dst, size_t size, float scale, float shift);
+
+/// \brief Convert the uint8 values to float.
+void CastKernel(const uint8_t *src, float *dst, size_t size);
+
+/// \brief Transpose an image from HWC to CHW.
+/// \param[in] elem_size The size in bytes of the value of a channel
+void HwcToChwKernel(const uint8_t *src, uint8_t *dst, size_t num_pixels, size_t num_channels, size_t elem_size);
+
+/// \brief Flip an image around its vertical axis (horizontal flip), its horizontal axis (vertical flip) or both.
+/// \param[in] pixel_size The size in bytes of a pixel, with all its channels
+void FlipKernel(const uint8_t *src, uint8_t *dst, size_t height, size_t width, size_t pixel_size, bool horizontal,
+                bool vertical);
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_SIMD_IMAGE_UTILS_H_
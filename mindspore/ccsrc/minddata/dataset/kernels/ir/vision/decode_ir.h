@@ -49,8 +49,17 @@ class DecodeOperation : public TensorOperation {
 
   Status to_json(nlohmann::json *out_json) override;
 
+  /// \brief Decode jpeg images at a reduced scale, as long as they are at least this size
+  /// \param min_height, min_width: the size of the resize which follows, 0 to decode at full size
+  void SetResizeHint(int32_t min_height, int32_t min_width) {
+    min_height_ = min_height;
+    min_width_ = min_width;
+  }
+
  private:
   bool rgb_;
+  int32_t min_height_ = 0;
+  int32_t min_width_ = 0;
 };
 
 }  // namespace vision
@@ -50,6 +50,12 @@ class RandomCropDecodeResizeOperation : public RandomResizedCropOperation {
   std::string Name() const override;
 
   Status to_json(nlohmann::json *out_json) override;
+
+  /// \brief Decode jpeg images at the smallest scale which still yields a crop of at least the target size
+  void SetScaledDecode(bool scaled_decode) { scaled_decode_ = scaled_decode; }
+
+ private:
+  bool scaled_decode_ = false;
 };
 
 }  // namespace vision
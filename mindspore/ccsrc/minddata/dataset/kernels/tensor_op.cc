@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/kernels/tensor_op.h"
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace mindspore {
@@ -47,6 +48,25 @@ Status TensorOp::Compute(const TensorRow &input, TensorRow *output) {
                 "Is this TensorOp oneToOne? If no, please implement this Compute() in the derived class.");
 }
 
+// Name: BatchCompute()
+// Description: This BatchCompute() applies Compute() to each row of a block.
+Status TensorOp::BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  RETURN_UNEXPECTED_IF_NULL(output);
+  output->reserve(output->size() + input.size());
+  for (const auto &row : input) {
+    TensorRow out_row;
+    RETURN_IF_NOT_OK(Compute(row, &out_row));
+    output->push_back(std::move(out_row));
+  }
+  return Status::OK();
+}
+
+// Name: ComputeInSlots()
+// Description: The default ComputeInSlots() computes the row as usual, without the slots.
+Status TensorOp::ComputeInSlots(const TensorRow &input, TensorRow *output, Tensor::BatchSlots *output_slots) {
+  return Compute(input, output);
+}
+
 Status TensorOp::Compute(const std::shared_ptr<DeviceTensor> &input, std::shared_ptr<DeviceTensor> *output) {
   IO_CHECK(input, output);
   return Status(StatusCode::kMDUnexpectedError,
@@ -187,6 +187,27 @@ class TensorOp {
   // @return Status
   virtual Status Compute(const TensorRow &input, TensorRow *output);
 
+  // Perform an operation on a block of rows at once, and produce one row for each input row.
+  // The default calls Compute() on each row, TensorOps override it to share the per-row work across the block.
+  // @param input is a vector of rows (pass by const reference).
+  // @param output is the address to an empty vector of rows.
+  // @return Status
+  virtual Status BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output);
+
+  // Perform an operation on one row and create its outputs on the given slots of the batches of the row, see
+  // Tensor::CreateEmptyInSlot. This is for the last TensorOp of a MapOp fused with a BatchOp. The default calls
+  // Compute(), so MapOp copies the outputs into their slots.
+  // @param input is a vector of shared_ptr to Tensor (pass by const reference).
+  // @param output is the address to an empty vector of shared_ptr to Tensor.
+  // @param output_slots the slots of the row, nullptr if it has none.
+  // @return Status
+  virtual Status ComputeInSlots(const TensorRow &input, TensorRow *output, Tensor::BatchSlots *output_slots);
+
+  // Returns true if MapOp can hand the TensorOp a block of rows by BatchCompute(). Only a deterministic TensorOp
+  // without side effects should return true, because a failed block is computed again row by row.
+  // @return true/false
+  virtual bool SupportBatch() const { return false; }
+
   // Perform an operation on one DeviceTensor and produce one DeviceTensor. This is for 1-to-1 column MapOp
   // @param input shares the ownership of the Tensor (increase the ref count).
   // @param output the address to a shared_ptr where the result will be placed.
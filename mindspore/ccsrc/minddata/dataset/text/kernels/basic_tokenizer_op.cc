@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
+#include <algorithm>
 #include <memory>
 #include <queue>
 #include <string>
@@ -24,8 +25,98 @@
 #include "unicode/errorcode.h"
 #include "unicode/normalizer2.h"
 
+#include "minddata/dataset/text/kernels/data_utils.h"
+
 namespace mindspore {
 namespace dataset {
+namespace {
+constexpr uint8_t kAsciiWord = 0;
+constexpr uint8_t kAsciiSpace = 1;
+constexpr uint8_t kAsciiPunct = 2;
+constexpr size_t kAsciiBlockSize = 64;
+
+struct AsciiTables {
+  char keep_case[128];  // control characters become spaces, like replace_control_chars_ does
+  char lower_case[128];
+  uint8_t byte_class[128];  // the classes of kCommonPattern and \s after the control characters are replaced
+};
+
+const AsciiTables &GetAsciiTables() {
+  static const AsciiTables tables = []() {
+    AsciiTables t{};
+    for (int c = 0; c < 128; c++) {
+      bool is_control = c < ' ' || c == 0x7F;
+      bool is_upper = c >= 'A' && c <= 'Z';
+      t.keep_case[c] = is_control ? ' ' : static_cast<char>(c);
+      t.lower_case[c] = is_upper ? static_cast<char>(c - 'A' + 'a') : t.keep_case[c];
+      bool is_punct =
+        (c >= '!' && c <= '/') || (c >= ':' && c <= '@') || (c >= '[' && c <= '`') || (c >= '{' && c <= '~');
+      t.byte_class[c] = c == ' ' ? kAsciiSpace : (is_punct ? kAsciiPunct : kAsciiWord);
+    }
+    return t;
+  }();
+  return tables;
+}
+
+// Check the text block by block, the OR of a block has no branch so it is vectorized by the compiler.
+bool IsAsciiText(const std::string_view &text) {
+  const auto *data = reinterpret_cast<const uint8_t *>(text.data());
+  size_t size = text.size();
+  for (size_t block = 0; block < size; block += kAsciiBlockSize) {
+    size_t block_end = std::min(size, block + kAsciiBlockSize);
+    uint8_t bits = 0;
+    for (size_t i = block; i < block_end; i++) {
+      bits |= data[i];
+    }
+    if ((bits & 0x80) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Get the length of the unused token (the same as kUnusedPattern) at the start of the text, 0 if there is none.
+size_t MatchUnusedToken(const std::string_view &text) {
+  for (const auto &word : {"[CLS]", "[SEP]", "[UNK]", "[PAD]", "[MASK]"}) {
+    std::string_view unused(word);
+    if (text.substr(0, unused.size()) == unused) {
+      return unused.size();
+    }
+  }
+  std::string_view prefix("[unused");
+  if (text.substr(0, prefix.size()) != prefix) {
+    return 0;
+  }
+  size_t end = prefix.size();
+  while (end < text.size() && text[end] >= '0' && text[end] <= '9') {
+    end++;
+  }
+  return (end > prefix.size() && end < text.size() && text[end] == ']') ? end + 1 : 0;
+}
+
+// Get the start and end offsets of the unused words, which are not case folded
+void FindUnusedWords(const std::string_view &text, const std::unordered_set<std::string> &unused_words,
+                     std::queue<std::pair<int, int>> *offsets) {
+  int start = -1;
+  int len = 0;
+  for (int i = 0; i < text.length(); i++) {
+    if (text[i] == '[') {
+      start = i;
+      ++len;
+    } else if (text[i] == ']' && start >= 0) {
+      ++len;
+      std::string word(text.substr(start, len));
+      if (unused_words.find(word) != unused_words.end()) {
+        offsets->push(std::make_pair(start, start + len - 1));
+      }
+      start = -1;
+      len = 0;
+    } else if (start >= 0) {
+      ++len;
+    }
+  }
+}
+}  // namespace
 
 const bool BasicTokenizerOp::kDefLowerCase = false;
 const bool BasicTokenizerOp::kDefKeepWhitespace = false;
@@ -85,27 +176,10 @@ Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::string_view &text
 
   // 1. get start and end offsets of not case fold strs
   std::queue<std::pair<int, int>> offsets;  // offsets of not used words
-  int start = -1;
-  int len = 0;
-  for (int i = 0; i < text.length(); i++) {
-    if (text[i] == '[') {
-      start = i;
-      ++len;
-    } else if (text[i] == ']' && start >= 0) {
-      ++len;
-      std::string word(text.substr(start, len));
-      if (unused_words.find(word) != unused_words.end()) {
-        offsets.push(std::make_pair(start, start + len - 1));
-      }
-      start = -1;
-      len = 0;
-    } else if (start >= 0) {
-      ++len;
-    }
-  }
+  FindUnusedWords(text, unused_words, &offsets);
 
   // 2. Do not apply case fold on `unused_words`
-  start = 0;
+  int start = 0;
   for (int i = 0; i < text.length();) {
     std::string_view process_text;
     std::string preserve_token;
@@ -122,6 +196,7 @@ Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::string_view &text
     icu::StringByteSink<std::string> sink(&temp);
     nfkc_case_fold->normalizeUTF8(0, icu::StringPiece(process_text.data(), process_text.size()), sink, nullptr, error);
     *output += temp + preserve_token;
+    start = i;
   }
   return Status::OK();
 }
@@ -138,12 +213,97 @@ Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::shared_ptr<Tensor
   return Tensor::CreateFromVector(strs, input->shape(), output);
 }
 
+Status BasicTokenizerOp::TokenizeAscii(const std::string_view &text, TensorRow *output) const {
+  // Normalization and accent stripping don't change ASCII characters, and case folding only lowers the letters.
+  const AsciiTables &tables = GetAsciiTables();
+  std::string processed(text.size(), ' ');
+  std::queue<std::pair<int, int>> unused_offsets;
+  if (lower_case_ && preserve_unused_token_) {
+    FindUnusedWords(text, kUnusedWords, &unused_offsets);
+  }
+  const char *table = lower_case_ ? tables.lower_case : tables.keep_case;
+  size_t next = 0;
+  for (; !unused_offsets.empty(); unused_offsets.pop()) {
+    size_t first = unused_offsets.front().first;
+    size_t last = std::min(static_cast<size_t>(unused_offsets.front().second), text.size() - 1);
+    for (; next < first; next++) {
+      processed[next] = table[static_cast<uint8_t>(text[next])];
+    }
+    for (; next <= last; next++) {
+      processed[next] = tables.keep_case[static_cast<uint8_t>(text[next])];
+    }
+  }
+  for (; next < text.size(); next++) {
+    processed[next] = table[static_cast<uint8_t>(text[next])];
+  }
+
+  // Split at the delimiters the same way as regex_tokenizer_, an unused token is tried before the other delimiters.
+  std::vector<std::string> splits;
+  std::vector<uint32_t> offsets_start;
+  std::vector<uint32_t> offsets_limit;
+  auto add_split = [&processed, &splits, &offsets_start, &offsets_limit](size_t start, size_t end) {
+    (void)splits.emplace_back(processed, start, end - start);
+    offsets_start.push_back(static_cast<uint32_t>(start));
+    offsets_limit.push_back(static_cast<uint32_t>(end));
+  };
+  std::string_view processed_view(processed);
+  size_t token_start = 0;
+  for (size_t i = 0; i < processed.size();) {
+    size_t delim_len = 0;
+    bool keep_delim = true;
+    uint8_t byte_class = tables.byte_class[static_cast<uint8_t>(processed[i])];
+    if (preserve_unused_token_ && processed[i] == '[') {
+      delim_len = MatchUnusedToken(processed_view.substr(i));
+    }
+    if (delim_len == 0 && byte_class == kAsciiSpace) {
+      delim_len = processed_view.find_first_not_of(' ', i);
+      delim_len = (delim_len == std::string_view::npos ? processed.size() : delim_len) - i;
+      keep_delim = keep_whitespace_;
+    } else if (delim_len == 0 && byte_class == kAsciiPunct) {
+      delim_len = 1;
+    }
+    if (delim_len == 0) {
+      i++;
+      continue;
+    }
+    if (i > token_start) {
+      add_split(token_start, i);
+    }
+    if (keep_delim) {
+      add_split(i, i + delim_len);
+    }
+    i += delim_len;
+    token_start = i;
+  }
+  if (processed.size() > token_start) {
+    add_split(token_start, processed.size());
+  }
+
+  if (splits.empty()) {
+    (void)splits.emplace_back("");
+    offsets_start.push_back(0);
+    offsets_limit.push_back(0);
+  }
+  std::shared_ptr<Tensor> token_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(splits, &token_tensor));
+  output->push_back(token_tensor);
+  if (with_offsets_) {
+    RETURN_IF_NOT_OK(AppendOffsetsHelper(offsets_start, offsets_limit, output));
+  }
+  return Status::OK();
+}
+
 Status BasicTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
   CHECK_FAIL_RETURN_UNEXPECTED(input.size() == 1, "BasicTokenizer: input only support one column data.");
   if (input[0]->Rank() != 0 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED("BasicTokenizer: the input should be scalar with string datatype");
   }
+  std::string_view text;
+  RETURN_IF_NOT_OK(input[0]->GetItemAt(&text, {}));
+  if (IsAsciiText(text)) {
+    return TokenizeAscii(text, output);
+  }
   std::shared_ptr<Tensor> cur_input;
   std::shared_ptr<Tensor> processed_tensor;
   if (lower_case_) {
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_BASIC_TOKENIZER_OP_H_
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 
 #include "minddata/dataset/core/tensor.h"
@@ -51,6 +52,8 @@ class BasicTokenizerOp : public TokenizerOp {
   Status CaseFoldWithoutUnusedWords(const std::string_view &text, const std::unordered_set<std::string> &unused_words,
                                     std::string *output);
   Status CaseFoldWithoutUnusedWords(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+  // Tokenize the text which has only ASCII characters without ICU, the result is the same as the ICU pipeline's
+  Status TokenizeAscii(const std::string_view &text, TensorRow *output) const;
 
   std::string Name() const override { return kBasicTokenizerOp; }
 
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "minddata/dataset/kernels/data/data_utils.h"
 #include "minddata/dataset/text/kernels/lookup_op.h"
@@ -24,22 +26,23 @@ namespace dataset {
 LookupOp::LookupOp(std::shared_ptr<Vocab> vocab, WordIdType default_id, const DataType &data_type)
     : vocab_(vocab), default_id_(default_id), type_(data_type) {}
 
-Status LookupOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
-  IO_CHECK(input, output);
-  RETURN_UNEXPECTED_IF_NULL(vocab_);
+Status LookupOp::LookupIds(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) const {
   CHECK_FAIL_RETURN_UNEXPECTED(input->type() == DataType::DE_STRING, "Lookup: input is not string datatype.");
-
-  std::vector<WordIdType> word_ids;
-  word_ids.reserve(input->Size());
-  for (auto itr = input->begin<std::string_view>(); itr != input->end<std::string_view>(); ++itr) {
+  // The ids are written straight into the output tensor.
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), DataType(DataType::DE_INT32), output));
+  auto out_itr = (*output)->begin<WordIdType>();
+  for (auto itr = input->begin<std::string_view>(); itr != input->end<std::string_view>(); ++itr, ++out_itr) {
     WordIdType word_id = vocab_->Lookup(std::string(*itr));
-    word_ids.emplace_back(word_id == Vocab::kNoTokenExists ? default_id_ : word_id);
-    CHECK_FAIL_RETURN_UNEXPECTED(word_ids.back() != Vocab::kNoTokenExists,
+    word_id = word_id == Vocab::kNoTokenExists ? default_id_ : word_id;
+    CHECK_FAIL_RETURN_UNEXPECTED(word_id != Vocab::kNoTokenExists,
                                  "Lookup: invalid data, token: \"" + std::string(*itr) +
                                    "\" doesn't exist in vocab and no unknown token is specified.");
+    *out_itr = word_id;
   }
-  RETURN_IF_NOT_OK(Tensor::CreateFromVector(word_ids, input->shape(), output));
+  return Status::OK();
+}
 
+Status LookupOp::CastIds(std::shared_ptr<Tensor> *output) const {
   // type cast to user's requirements if what user wants isn't int32_t
   if ((*output)->type() != type_) {
     CHECK_FAIL_RETURN_UNEXPECTED(type_.IsNumeric(),
@@ -49,9 +52,32 @@ Status LookupOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     RETURN_IF_NOT_OK(TypeCast(*output, &cast_to, type_));
     *output = cast_to;
   }
+  return Status::OK();
+}
 
+Status LookupOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  RETURN_UNEXPECTED_IF_NULL(vocab_);
+  RETURN_IF_NOT_OK(LookupIds(input, output));
+  return CastIds(output);
+}
+
+Status LookupOp::BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  RETURN_UNEXPECTED_IF_NULL(output);
+  RETURN_UNEXPECTED_IF_NULL(vocab_);
+  output->reserve(output->size() + input.size());
+  for (const auto &row : input) {
+    CHECK_FAIL_RETURN_UNEXPECTED(row.size() == 1 && row[0] != nullptr, "Lookup: input should be one column data.");
+    std::shared_ptr<Tensor> ids;
+    RETURN_IF_NOT_OK(LookupIds(row[0], &ids));
+    RETURN_IF_NOT_OK(CastIds(&ids));
+    TensorRow out_row;
+    out_row.push_back(std::move(ids));
+    output->push_back(std::move(out_row));
+  }
   return Status::OK();
 }
+
 Status LookupOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
   CHECK_FAIL_RETURN_UNEXPECTED(inputs.size() == NumInput() && outputs.size() == NumOutput(), "size doesn't match.");
   CHECK_FAIL_RETURN_UNEXPECTED(inputs[0] == DataType::DE_STRING, "None String tensor type.");
@@ -45,6 +45,14 @@ class LookupOp : public TensorOp {
   /// \return[out] error code.
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  /// \brief perform lookup on a block of rows.
+  /// \param[in] const std::vector<TensorRow> &input
+  /// \param[in] std::vector<TensorRow> *output
+  /// \return[out] error code.
+  Status BatchCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) override;
+
+  bool SupportBatch() const override { return true; }
+
   /// \brief print method.
   /// \param[in] std::ostream out
   void Print(std::ostream &out) const override;
@@ -57,6 +65,12 @@ class LookupOp : public TensorOp {
   std::string Name() const override { return kLookupOp; }
 
  private:
+  /// \brief look up the words of a tensor into a new int32 tensor of the same shape.
+  Status LookupIds(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) const;
+
+  /// \brief cast the ids to the type of tensor after lookup.
+  Status CastIds(std::shared_ptr<Tensor> *output) const;
+
   std::shared_ptr<Vocab> vocab_;
   WordIdType default_id_;
   DataType type_;  // type of tensor after lookup
@@ -16,6 +16,7 @@
 
 #include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
 #include <algorithm>
+#include <iterator>
 #include <utility>
 #include "minddata/dataset/text/kernels/data_utils.h"
 
@@ -33,28 +34,13 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       vocab_(vocab),
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
-      unknown_token_(unknown_token) {}
-
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
-  CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "WordpieceTokenizer: LookupWord Out of range");
-  *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
-      *out_found = true;
-      break;
-    }
+      unknown_token_(unknown_token) {
+  if (vocab_ != nullptr) {
+    trie_ = std::make_unique<WordpieceTrie>(vocab_->vocab(), suffix_indicator_);
   }
-  return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::FoundNoToken(const std::string_view &input_token, const uint32_t &basic_start,
                                           std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                           std::vector<uint32_t> *offsets_limit) const {
   out_tokens->clear();
@@ -69,19 +55,7 @@ Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
-                                        std::vector<std::string> *out_tokens) const {
-  CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= static_cast<int>(input_token.size()),
-                               "Out of range");
-  std::string subword = input_token.substr(start, end - start);
-  if (start > 0) {
-    subword = suffix_indicator_ + subword;
-  }
-  (void)out_tokens->emplace_back(subword);
-  return Status::OK();
-}
-
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::GetTokens(const std::string_view &input_token, const uint32_t &basic_start,
                                        std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
   if (input_token.size() > static_cast<int>(max_bytes_per_token_)) {
@@ -95,22 +69,30 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
     }
     return Status::OK();
   }
-  RuneStrArray runes;
-  if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
+  CHECK_FAIL_RETURN_UNEXPECTED(trie_ != nullptr, "WordpieceTokenizer: vocab is not set.");
+  if (!WordpieceTrie::IsRuneString(input_token)) {
     RETURN_STATUS_UNEXPECTED("WordpieceTokenizer: Decode utf8 string failed.");
   }
-  int end = 0;
-  for (int start = 0; start < static_cast<int>(input_token.size());) {
-    bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
-    if (found) {
-      RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
-      offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
-      offsets_limit->push_back(static_cast<uint32_t>(basic_start + end));
-      start = end;
+  // The trie appends the token ends to offsets_limit, they are shifted by basic_start once the whole word is matched.
+  size_t first_token = offsets_limit->size();
+  if (!trie_->Tokenize(input_token, offsets_limit)) {
+    offsets_limit->resize(first_token);
+    return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
+  }
+  uint32_t start = 0;
+  for (size_t i = first_token; i < offsets_limit->size(); ++i) {
+    uint32_t end = (*offsets_limit)[i];
+    if (start == 0) {
+      (void)out_tokens->emplace_back(input_token.substr(0, end));
     } else {
-      return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
+      std::string subword;
+      subword.reserve(suffix_indicator_.size() + end - start);
+      (void)subword.append(suffix_indicator_).append(input_token.substr(start, end - start));
+      (void)out_tokens->emplace_back(std::move(subword));
     }
+    offsets_start->push_back(basic_start + start);
+    (*offsets_limit)[i] = basic_start + end;
+    start = end;
   }
   return Status::OK();
 }
@@ -125,14 +107,16 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
   std::vector<std::string> out_tokens;
   std::vector<uint32_t> offsets_start, offsets_limit;
   std::shared_ptr<Tensor> token_tensor;
+  std::vector<std::string> temp_tokens;
   for (auto iter = input[0]->begin<std::string_view>(); iter != input[0]->end<std::string_view>(); iter++) {
     uint32_t basic_start = 0;
-    std::vector<std::string> temp_tokens;
+    temp_tokens.clear();
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
-    out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
+    RETURN_IF_NOT_OK(GetTokens(*iter, basic_start, &temp_tokens, &offsets_start, &offsets_limit));
+    out_tokens.insert(out_tokens.end(), std::make_move_iterator(temp_tokens.begin()),
+                      std::make_move_iterator(temp_tokens.end()));
     count++;
   }
   if (out_tokens.empty()) {
@@ -20,16 +20,13 @@
 #include <string_view>
 #include <vector>
 
-#include "cppjieba/Unicode.hpp"
-
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/text/kernels/tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_trie.h"
 #include "minddata/dataset/text/vocab.h"
 #include "minddata/dataset/util/status.h"
 
-using cppjieba::DecodeRunesInString;
-using cppjieba::RuneStrArray;
 namespace mindspore {
 namespace dataset {
 
@@ -47,14 +44,12 @@ class WordpieceTokenizerOp : public TokenizerOp {
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
  protected:
-  Status AddSubword(const std::string &input_token, const int &start, const int &end,
-                    std::vector<std::string> *out_token) const;
-  Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                      std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                   std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+  Status FoundNoToken(const std::string_view &input_token, const uint32_t &basic_start,
+                      std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                      std::vector<uint32_t> *offsets_limit) const;
+  Status GetTokens(const std::string_view &input_token, const uint32_t &basic_start,
+                   std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                   std::vector<uint32_t> *offsets_limit) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
 
@@ -63,6 +58,7 @@ class WordpieceTokenizerOp : public TokenizerOp {
   const std::string suffix_indicator_;
   const int max_bytes_per_token_;
   const std::string unknown_token_;
+  std::unique_ptr<WordpieceTrie> trie_;
 };
 }  // namespace dataset
 }  // namespace mindspore
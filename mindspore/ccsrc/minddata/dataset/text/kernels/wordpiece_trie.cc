@@ -0,0 +1,172 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/kernels/wordpiece_trie.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+
+#include "cppjieba/Unicode.hpp"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+struct BuildNode {
+  std::map<uint8_t, int32_t> children;
+  uint32_t depth = 0;
+  bool is_token = false;
+};
+
+void InsertWord(std::vector<BuildNode> *nodes, int32_t root, const std::string_view &word) {
+  int32_t node = root;
+  for (char c : word) {
+    auto label = static_cast<uint8_t>(c);
+    auto itr = (*nodes)[node].children.find(label);
+    if (itr != (*nodes)[node].children.end()) {
+      node = itr->second;
+      continue;
+    }
+    auto child = static_cast<int32_t>(nodes->size());
+    (*nodes)[node].children[label] = child;
+    nodes->emplace_back();
+    nodes->back().depth = (*nodes)[node].depth + 1;
+    node = child;
+  }
+  (*nodes)[node].is_token = true;
+}
+}  // namespace
+
+WordpieceTrie::WordpieceTrie(const std::unordered_map<WordType, WordIdType> &words,
+                             const std::string &suffix_indicator) {
+  // The original lookup only tries the ends of the runes, so the words which are not made of complete runes can never
+  // be matched and are left out.
+  std::vector<BuildNode> build_nodes(kSuffixRoot + 1);
+  for (const auto &word : words) {
+    std::string_view str(word.first);
+    if (!str.empty() && IsRuneString(str)) {
+      InsertWord(&build_nodes, kPrefixRoot, str);
+    }
+    if (str.size() > suffix_indicator.size() && str.compare(0, suffix_indicator.size(), suffix_indicator) == 0) {
+      std::string_view suffix = str.substr(suffix_indicator.size());
+      if (IsRuneString(suffix)) {
+        InsertWord(&build_nodes, kSuffixRoot, suffix);
+      }
+    }
+  }
+
+  nodes_.resize(build_nodes.size());
+  for (size_t i = 0; i < build_nodes.size(); ++i) {
+    nodes_[i].children_begin = labels_.size();
+    for (const auto &child : build_nodes[i].children) {
+      labels_.push_back(child.first);
+      targets_.push_back(child.second);
+    }
+    nodes_[i].children_end = labels_.size();
+    nodes_[i].pops_begin = 0;
+    nodes_[i].pops_end = 0;
+    nodes_[i].fail = kNoNode;
+  }
+
+  // The failure link of a node always has a shorter string, so the nodes are linked in breadth-first order of both
+  // tries together.
+  std::deque<int32_t> queue = {kSuffixRoot, kPrefixRoot};
+  while (!queue.empty()) {
+    int32_t parent = queue.front();
+    queue.pop_front();
+    for (const auto &child : build_nodes[parent].children) {
+      uint8_t label = child.first;
+      int32_t node = child.second;
+      queue.push_back(node);
+      TrieNode &trie_node = nodes_[node];
+      trie_node.pops_begin = pops_.size();
+      if (build_nodes[node].is_token) {
+        // The whole string is the longest match, the rest is empty.
+        pops_.push_back(build_nodes[node].depth);
+        trie_node.pops_end = pops_.size();
+        trie_node.fail = kSuffixRoot;
+        continue;
+      }
+      // The longest match of the node is the one of its parent, pop the tokens along the failure links of the parent
+      // until a suffix node can go on with the label.
+      int32_t fail = parent;
+      do {
+        for (uint32_t i = nodes_[fail].pops_begin; i < nodes_[fail].pops_end; ++i) {
+          uint32_t len = pops_[i];
+          pops_.push_back(len);
+        }
+        fail = nodes_[fail].fail;
+      } while (fail != kNoNode && Child(fail, label) == kNoNode);
+      if (fail == kNoNode) {
+        pops_.resize(trie_node.pops_begin);
+      } else {
+        trie_node.fail = Child(fail, label);
+      }
+      trie_node.pops_end = pops_.size();
+    }
+  }
+}
+
+int32_t WordpieceTrie::Child(int32_t node, uint8_t label) const {
+  auto begin = labels_.begin() + nodes_[node].children_begin;
+  auto end = labels_.begin() + nodes_[node].children_end;
+  auto itr = std::lower_bound(begin, end, label);
+  return (itr != end && *itr == label) ? targets_[itr - labels_.begin()] : kNoNode;
+}
+
+bool WordpieceTrie::Tokenize(const std::string_view &word, std::vector<uint32_t> *token_ends) const {
+  uint32_t token_end = 0;
+  auto pop_tokens = [this, &token_end, token_ends](int32_t node) {
+    for (uint32_t i = nodes_[node].pops_begin; i < nodes_[node].pops_end; ++i) {
+      token_end += pops_[i];
+      token_ends->push_back(token_end);
+    }
+    return nodes_[node].fail;
+  };
+  int32_t node = kPrefixRoot;
+  for (char c : word) {
+    auto label = static_cast<uint8_t>(c);
+    int32_t child = Child(node, label);
+    while (child == kNoNode) {
+      node = pop_tokens(node);
+      if (node == kNoNode) {
+        return false;
+      }
+      child = Child(node, label);
+    }
+    node = child;
+  }
+  // Pop the tokens of the rest of the word.
+  while (node != kSuffixRoot && node != kPrefixRoot) {
+    node = pop_tokens(node);
+    if (node == kNoNode) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool WordpieceTrie::IsRuneString(const std::string_view &str) {
+  for (size_t i = 0; i < str.size();) {
+    auto rune = cppjieba::DecodeRuneInString(str.data() + i, str.size() - i);
+    if (rune.len == 0) {
+      return false;
+    }
+    i += rune.len;
+  }
+  return true;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_WORDPIECE_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_WORDPIECE_TRIE_H_
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/text/vocab.h"
+
+namespace mindspore {
+namespace dataset {
+
+// WordpieceTrie tokenizes a word by greedy longest-match-first in a single pass over its bytes (LinMaxMatch).
+// The vocab words and the suffix words (with the suffix indicator stripped) are two tries sharing one node array.
+// When a node can't go on with the next byte, it pops the longest-match tokens of its string and follows its failure
+// link to the suffix trie node of the rest, so no byte of the word is matched twice.
+class WordpieceTrie {
+ public:
+  // Build the tries of a vocab
+  // @param std::unordered_map<WordType, WordIdType> words - the words of the vocab
+  // @param std::string suffix_indicator - the prefix of the words which continue a token
+  WordpieceTrie(const std::unordered_map<WordType, WordIdType> &words, const std::string &suffix_indicator);
+
+  ~WordpieceTrie() = default;
+
+  // Tokenize a word by greedy longest-match-first, the same as looking up the longest prefix in the vocab repeatedly
+  // @param std::string_view word - the word to be tokenized
+  // @param std::vector<uint32_t> *token_ends - the end offset of each token in the word is appended to it
+  // @return bool - false if some part of the word has no token in the vocab, token_ends is incomplete then
+  bool Tokenize(const std::string_view &word, std::vector<uint32_t> *token_ends) const;
+
+  // Check the string is made of complete utf8 runes
+  // @param std::string_view str - the string to be checked
+  // @return bool - true if the string can be decoded
+  static bool IsRuneString(const std::string_view &str);
+
+ private:
+  static constexpr int32_t kPrefixRoot = 0;
+  static constexpr int32_t kSuffixRoot = 1;
+  static constexpr int32_t kNoNode = -1;
+
+  struct TrieNode {
+    uint32_t children_begin;  // range of the children in labels_ and targets_, sorted by label
+    uint32_t children_end;
+    uint32_t pops_begin;  // range of the lengths of the tokens popped before following the failure link in pops_
+    uint32_t pops_end;
+    int32_t fail;  // node in the suffix trie to go on with, kNoNode if the string can't be tokenized
+  };
+
+  // Get the child of a node by the next byte
+  // @return int32_t - the child node, kNoNode if there is no such child
+  int32_t Child(int32_t node, uint8_t label) const;
+
+  std::vector<TrieNode> nodes_;
+  std::vector<uint8_t> labels_;
+  std::vector<int32_t> targets_;
+  std::vector<uint32_t> pops_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_WORDPIECE_TRIE_H_
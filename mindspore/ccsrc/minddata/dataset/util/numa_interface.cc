@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/util/numa_interface.h"
 #include <dlfcn.h>
+#include <sched.h>
 
 namespace mindspore {
 namespace dataset {
@@ -92,5 +93,47 @@ Status NumaBind(void *handle, const int32_t &rank_id) {
   }
   return Status::OK();
 }
+
+int32_t NumaNodeCount(void *handle) {
+  if (handle == nullptr) {
+    return -1;
+  }
+  auto numa_max_node_func = GetNumaAdapterFunc(handle, "numa_max_node");
+  if (numa_max_node_func == nullptr) {
+    return -1;
+  }
+  auto numa_max_node = (int (*)(void))(numa_max_node_func);
+  int numa_node_max_id = numa_max_node();
+  return numa_node_max_id < 0 ? -1 : numa_node_max_id + 1;
+}
+
+int32_t NumaNodeOfCurrentCpu(void *handle) {
+  if (handle == nullptr) {
+    return -1;
+  }
+  auto numa_node_of_cpu_func = GetNumaAdapterFunc(handle, "numa_node_of_cpu");
+  if (numa_node_of_cpu_func == nullptr) {
+    return -1;
+  }
+  auto numa_node_of_cpu = (int (*)(int))(numa_node_of_cpu_func);
+  int cpu = sched_getcpu();
+  return cpu < 0 ? -1 : numa_node_of_cpu(cpu);
+}
+
+Status NumaBindMemory(void *handle, void *ptr, size_t sz, int32_t node) {
+  if (handle == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Numa package not found.");
+  }
+  auto numa_tonode_memory_func = GetNumaAdapterFunc(handle, "numa_tonode_memory");
+  if (numa_tonode_memory_func == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Numa api: numa_tonode_memory not found.");
+  }
+  if (node < 0) {
+    RETURN_STATUS_UNEXPECTED("Value error, numa node is a negative value.");
+  }
+  auto numa_tonode_memory = (void (*)(void *, size_t, int))(numa_tonode_memory_func);
+  numa_tonode_memory(ptr, sz, node);
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -35,6 +35,17 @@ void *GetNumaAdapterHandle();
 // 2. Do numa_bind
 Status NumaBind(void *handle, const int32_t &rank_id);
 
+// Return the number of numa nodes, or -1 if it can not be found.
+int32_t NumaNodeCount(void *handle);
+
+// Return the numa node of the cpu which the calling thread is running on,
+// or -1 if it can not be found.
+int32_t NumaNodeOfCurrentCpu(void *handle);
+
+// Place the pages of a memory range on a numa node. The memory must not
+// have been touched yet, the pages are allocated there at the first touch.
+Status NumaBindMemory(void *handle, void *ptr, size_t sz, int32_t node);
+
 // Release the numa handle for avoid memory leak, we should
 // not allow handle is nullptr before we use it.
 void ReleaseLibrary(void *handle);
@@ -131,6 +131,20 @@ class Queue {
     return rc;
   }
 
+  // Consumer, pop the front element only if there is one, never blocks
+  // @param p - the address to receive the element
+  // @return bool - false if the queue is empty
+  bool TryPopFront(pointer p) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    if (empty()) {
+      return false;
+    }
+    auto k = head_++ % sz_;
+    *p = std::move(*(arr_[k]));
+    full_cv_.NotifyAll();
+    return true;
+  }
+
   void ResetQue() noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, drain them. We won't call PopFront directly
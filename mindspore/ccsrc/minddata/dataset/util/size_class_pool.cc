@@ -0,0 +1,640 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/size_class_pool.h"
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "./securec.h"
+#include "minddata/dataset/util/arena.h"
+#include "minddata/dataset/util/log_adapter.h"
+#if defined(__linux__)
+#include "minddata/dataset/util/numa_interface.h"
+#endif
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int32_t kMinClassLog = 6;
+constexpr int32_t kMaxClassLog = 25;
+constexpr int32_t kClassesPerDoublingLog = 2;
+constexpr int32_t kNumClasses = ((kMaxClassLog - kMinClassLog) << kClassesPerDoublingLog) + 1;
+constexpr size_t kMinClassSz = 1ULL << kMinClassLog;
+constexpr size_t kAlign = 64;
+constexpr size_t kHdrSz = 32;
+constexpr uint32_t kBlockSig = 0x5C1A55B1;
+constexpr int16_t kLargeClass = -1;
+constexpr size_t kHugePageSz = 2ULL * 1024 * 1024;
+constexpr size_t kSegmentSz = 64ULL * 1024 * 1024;
+constexpr size_t kSpanSz = 1024ULL * 1024;
+constexpr size_t kThreadCacheSz = 512ULL * 1024;
+constexpr size_t kMaxCachedBlocks = 128;
+// The freed large blocks kept mapped per node for the next large requests, which are mostly of the same few sizes.
+constexpr size_t kLargeCacheSz = 256ULL * 1024 * 1024;
+
+// The header in front of every block. The blocks of a span are carved right after the wall of the ArenaImpl, which
+// has the same size as the header, so the first payload of a span lands on the 64 bytes boundary like the others.
+struct BlockHdr {
+  uint32_t sig;
+  int16_t cls;
+  int16_t node;
+  uint64_t sz;    // the usable size of the block
+  void *owner;    // the span of a block of a class, or the mapping of a large block
+  uint64_t map_sz;
+};
+static_assert(sizeof(BlockHdr) <= kHdrSz, "Block header does not fit");
+static_assert(ARENA_WALL_OVERHEAD_SZ == kHdrSz, "Blocks of a span would not be aligned");
+static_assert(ARENA_BLK_SZ % kAlign == 0, "Blocks of a span would not be aligned");
+
+inline BlockHdr *HdrOf(void *p) { return reinterpret_cast<BlockHdr *>(static_cast<char *>(p) - kHdrSz); }
+
+inline size_t RoundUp(size_t n, size_t align) { return (n + align - 1) / align * align; }
+
+// The usable size of a large block. Its mapping is rounded up to huge pages, so that a freed one fits the next
+// requests of about the same size.
+inline size_t LargeSize(size_t n) { return RoundUp(n + kAlign, kHugePageSz) - kAlign; }
+
+// Four classes per power of two, i.e. a request wastes at most 25% of its block.
+int32_t SizeToClass(size_t n) {
+  if (n <= kMinClassSz) {
+    return 0;
+  }
+  // 2^lg < n <= 2^(lg+1), which is split in steps of 2^(lg-2).
+  auto lg = static_cast<int32_t>(63 - __builtin_clzll(static_cast<uint64_t>(n - 1)));
+  if (lg >= kMaxClassLog) {
+    return kNumClasses;
+  }
+  int32_t step_log = lg - kClassesPerDoublingLog;
+  auto step = static_cast<int32_t>((n - (1ULL << lg) + (1ULL << step_log) - 1) >> step_log);
+  return ((lg - kMinClassLog) << kClassesPerDoublingLog) + step;
+}
+
+size_t ClassSize(int32_t cls) {
+  if (cls == 0) {
+    return kMinClassSz;
+  }
+  int32_t lg = kMinClassLog + ((cls - 1) >> kClassesPerDoublingLog);
+  size_t step = static_cast<size_t>(((cls - 1) & ((1 << kClassesPerDoublingLog) - 1)) + 1);
+  return (1ULL << lg) + (step << (lg - kClassesPerDoublingLog));
+}
+
+// The distance between two blocks of a span
+size_t ClassStride(int32_t cls) { return RoundUp(ClassSize(cls) + kHdrSz, kAlign); }
+
+// The free blocks a thread keeps. The largest classes are not worth caching, they go to the free lists directly.
+size_t ThreadCacheCap(int32_t cls) { return std::min(kMaxCachedBlocks, kThreadCacheSz / ClassStride(cls)); }
+
+// The blocks carved at once, and moved at once between a thread cache and the free lists.
+size_t BatchSize(int32_t cls) {
+  size_t cap = ThreadCacheCap(cls);
+  return cap > 1 ? cap / 2 : 1;
+}
+
+size_t SpanBlocks(int32_t cls) { return std::max<size_t>(BatchSize(cls), kSpanSz / ClassStride(cls)); }
+
+// Map sz bytes aligned on a huge page, and ask for transparent huge pages.
+// \param[out] base The mapping to pass to UnmapMemory
+// \param[out] map_sz The size of the mapping
+void *MapMemory(size_t sz, void **base, size_t *map_sz) {
+  *map_sz = sz + kHugePageSz;
+#if defined(__linux__)
+  void *q = mmap(nullptr, *map_sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (q == MAP_FAILED) {
+    return nullptr;
+  }
+#else
+  void *q = malloc(*map_sz);
+  if (q == nullptr) {
+    return nullptr;
+  }
+#endif
+  *base = q;
+  auto *p = reinterpret_cast<void *>(RoundUp(reinterpret_cast<uintptr_t>(q), kHugePageSz));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Only a hint, the memory is still good without huge pages.
+  (void)madvise(p, sz, MADV_HUGEPAGE);
+#endif
+  return p;
+}
+
+void UnmapMemory(void *base, size_t map_sz) {
+#if defined(__linux__)
+  (void)munmap(base, map_sz);
+#else
+  free(base);
+#endif
+}
+
+enum class CacheState : uint8_t { kNotCreated, kAlive, kDestroyed };
+thread_local CacheState t_cache_state = CacheState::kNotCreated;
+std::atomic<uint64_t> g_next_pool_id(0);
+}  // namespace
+
+/// \brief The free lists and the memory segments of a pool, per numa node. It is shared with the thread caches,
+/// which return their blocks to it when their thread exits.
+class SizeClassPool::Central {
+ public:
+  explicit Central(bool numa_aware);
+  ~Central();
+
+  int32_t NumNodes() const { return static_cast<int32_t>(nodes_.size()); }
+
+  /// \brief The numa node which the calling thread runs on
+  int32_t LocalNode() const;
+
+  /// \brief Move up to n free blocks of a class to the back of out. New blocks are carved if there is none.
+  Status Fetch(int32_t node, int32_t cls, size_t n, std::vector<void *> *out);
+
+  /// \brief Return blocks of a class to the free lists of their nodes. A span whose blocks are all back is given
+  /// back to its segment, as long as the list keeps at least another span's worth of blocks.
+  void Release(int32_t cls, void *const *blocks, size_t n);
+
+  /// \brief Map a block beyond the largest class on its own, or take a freed one of about the same size
+  Status AllocateLarge(int32_t node, size_t n, void **p);
+
+  /// \brief Keep a freed large block for the next large requests, or unmap it
+  void ReleaseLarge(void *p);
+
+  /// \brief Give back to the system the spans all free in the free lists, and the freed large blocks
+  void Trim();
+
+  size_t MappedSize() const { return mapped_sz_; }
+
+ private:
+  struct FreeList {
+    std::mutex mux;
+    std::vector<void *> blocks;
+  };
+  struct Segment;
+  struct Span {
+    void *addr;
+    Segment *seg;
+    size_t num_blks;
+    size_t num_free;  // the blocks of the span in the free list of its class, guarded by the lock of the list
+  };
+  struct Segment {
+    void *base;
+    size_t map_sz;
+    std::unique_ptr<ArenaImpl> arena;
+    std::vector<std::unique_ptr<Span>> spans;
+  };
+  struct LargeBlock {
+    void *base;
+    size_t map_sz;
+    char *addr;  // the start of the usable part of the mapping, the header of the block is at its end
+    size_t sz;
+  };
+  struct Node {
+    FreeList lists[kNumClasses];
+    std::mutex seg_mux;
+    std::vector<std::unique_ptr<Segment>> segments;
+    std::mutex large_mux;
+    std::vector<LargeBlock> large_blocks;
+    size_t large_sz = 0;
+  };
+  void *numa_handle_;
+  std::vector<std::unique_ptr<Node>> nodes_;
+  std::atomic<size_t> mapped_sz_;
+
+  /// \brief Map memory and place it on a numa node
+  void *MapOnNode(int32_t node, size_t sz, void **base, size_t *map_sz);
+
+  void Unmap(void *base, size_t map_sz) {
+    UnmapMemory(base, map_sz);
+    mapped_sz_ -= map_sz;
+  }
+
+  /// \brief Carve a span of blocks into a free list. The caller holds the lock of the list.
+  Status Carve(int32_t node, int32_t cls, FreeList *list);
+
+  /// \brief Take the blocks of the spans out of a free list and give the spans back to their segments. A segment
+  /// left empty is unmapped, but the last one of the node if keep_segment. The caller holds the lock of the list.
+  void FreeSpans(int32_t node, FreeList *list, const std::unordered_set<Span *> &spans, bool keep_segment);
+};
+
+/// \brief The free blocks of one pool kept by one thread
+class SizeClassPool::ThreadCache {
+ public:
+  ThreadCache(uint64_t id, const std::shared_ptr<Central> &central)
+      : id_(id), central_(central), node_(central->LocalNode()) {}
+
+  ~ThreadCache() {
+    auto central = central_.lock();
+    if (central != nullptr) {
+      for (int32_t i = 0; i < kNumClasses; ++i) {
+        central->Release(i, free_[i].data(), free_[i].size());
+      }
+    }
+  }
+
+  uint64_t id_;
+  std::weak_ptr<Central> central_;
+  int32_t node_;
+  std::vector<void *> free_[kNumClasses];
+};
+
+/// \brief The caches of all the pools that a thread uses
+struct SizeClassPool::ThreadCaches {
+  ThreadCaches() { t_cache_state = CacheState::kAlive; }
+  // The caches are released after this, a tensor freed from now on goes to the free lists directly.
+  ~ThreadCaches() { t_cache_state = CacheState::kDestroyed; }
+
+  std::vector<std::unique_ptr<ThreadCache>> caches;
+};
+
+SizeClassPool::Central::Central(bool numa_aware) : numa_handle_(nullptr), mapped_sz_(0) {
+  int32_t num_nodes = 1;
+#if defined(__linux__)
+  if (numa_aware) {
+    numa_handle_ = GetNumaAdapterHandle();
+    auto n = NumaNodeCount(numa_handle_);
+    if (n > 0) {
+      num_nodes = n;
+    } else {
+      MS_LOG(WARNING) << "Numa package (libnuma.so) not found, tensor memory is not placed by numa node.";
+      ReleaseLibrary(numa_handle_);
+      numa_handle_ = nullptr;
+    }
+  }
+#endif
+  for (int32_t i = 0; i < num_nodes; ++i) {
+    nodes_.push_back(std::make_unique<Node>());
+  }
+}
+
+SizeClassPool::Central::~Central() {
+  for (auto &node : nodes_) {
+    for (auto &seg : node->segments) {
+      seg->arena.reset();
+      UnmapMemory(seg->base, seg->map_sz);
+    }
+    for (auto &blk : node->large_blocks) {
+      UnmapMemory(blk.base, blk.map_sz);
+    }
+  }
+#if defined(__linux__)
+  ReleaseLibrary(numa_handle_);
+#endif
+}
+
+int32_t SizeClassPool::Central::LocalNode() const {
+#if defined(__linux__)
+  if (numa_handle_ != nullptr) {
+    auto node = NumaNodeOfCurrentCpu(numa_handle_);
+    return node >= 0 && node < NumNodes() ? node : 0;
+  }
+#endif
+  return 0;
+}
+
+void *SizeClassPool::Central::MapOnNode(int32_t node, size_t sz, void **base, size_t *map_sz) {
+  void *p = MapMemory(sz, base, map_sz);
+  if (p != nullptr) {
+    mapped_sz_ += *map_sz;
+  }
+#if defined(__linux__)
+  if (p != nullptr && numa_handle_ != nullptr) {
+    Status rc = NumaBindMemory(numa_handle_, p, sz, node);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to place tensor memory on numa node " << node << ". " << rc.ToString();
+    }
+  }
+#endif
+  return p;
+}
+
+Status SizeClassPool::Central::Carve(int32_t node, int32_t cls, FreeList *list) {
+  auto &n = *nodes_[node];
+  size_t stride = ClassStride(cls);
+  size_t num_blks = SpanBlocks(cls);
+  size_t span_sz = num_blks * stride;
+  void *addr = nullptr;
+  Span *span = nullptr;
+  {
+    std::unique_lock<std::mutex> lck(n.seg_mux);
+    Segment *seg = nullptr;
+    for (auto &s : n.segments) {
+      if (s->arena->Allocate(span_sz, &addr).IsOk()) {
+        seg = s.get();
+        break;
+      }
+    }
+    if (seg == nullptr) {
+      auto new_seg = std::make_unique<Segment>();
+      size_t seg_sz = std::max(kSegmentSz, RoundUp(span_sz + ARENA_WALL_OVERHEAD_SZ + ARENA_BLK_SZ, kHugePageSz));
+      void *p = MapOnNode(node, seg_sz, &new_seg->base, &new_seg->map_sz);
+      if (p == nullptr) {
+        return Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
+      }
+      new_seg->arena = std::make_unique<ArenaImpl>(p, seg_sz);
+      Status rc = new_seg->arena->Allocate(span_sz, &addr);
+      if (rc.IsError()) {
+        new_seg->arena.reset();
+        Unmap(new_seg->base, new_seg->map_sz);
+        return rc;
+      }
+      seg = new_seg.get();
+      n.segments.push_back(std::move(new_seg));
+    }
+    seg->spans.push_back(std::make_unique<Span>(Span{addr, seg, num_blks, num_blks}));
+    span = seg->spans.back().get();
+  }
+  auto *q = static_cast<char *>(addr);
+  for (size_t i = 0; i < num_blks; ++i, q += stride) {
+    auto *hdr = reinterpret_cast<BlockHdr *>(q);
+    *hdr = BlockHdr{kBlockSig, static_cast<int16_t>(cls), static_cast<int16_t>(node), ClassSize(cls), span, 0};
+    list->blocks.push_back(q + kHdrSz);
+  }
+  return Status::OK();
+}
+
+void SizeClassPool::Central::FreeSpans(int32_t node, FreeList *list, const std::unordered_set<Span *> &spans,
+                                       bool keep_segment) {
+  if (spans.empty()) {
+    return;
+  }
+  auto &blocks = list->blocks;
+  (void)blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+                                    [&spans](void *b) { return spans.count(static_cast<Span *>(HdrOf(b)->owner)); }),
+                     blocks.end());
+  auto &n = *nodes_[node];
+  std::unique_lock<std::mutex> lck(n.seg_mux);
+  for (Span *span : spans) {
+    Segment *seg = span->seg;
+    seg->arena->Deallocate(span->addr);
+    (void)seg->spans.erase(std::find_if(seg->spans.begin(), seg->spans.end(),
+                                        [span](const std::unique_ptr<Span> &s) { return s.get() == span; }));
+    if (!seg->spans.empty() || (keep_segment && n.segments.size() == 1)) {
+      continue;
+    }
+    auto it = std::find_if(n.segments.begin(), n.segments.end(),
+                           [seg](const std::unique_ptr<Segment> &s) { return s.get() == seg; });
+    (*it)->arena.reset();
+    Unmap((*it)->base, (*it)->map_sz);
+    (void)n.segments.erase(it);
+  }
+}
+
+Status SizeClassPool::Central::Fetch(int32_t node, int32_t cls, size_t n, std::vector<void *> *out) {
+  auto &list = nodes_[node]->lists[cls];
+  std::unique_lock<std::mutex> lck(list.mux);
+  if (list.blocks.empty()) {
+    RETURN_IF_NOT_OK(Carve(node, cls, &list));
+  }
+  n = std::min(n, list.blocks.size());
+  for (auto it = list.blocks.end() - n; it != list.blocks.end(); ++it) {
+    static_cast<Span *>(HdrOf(*it)->owner)->num_free--;
+  }
+  out->insert(out->end(), list.blocks.end() - n, list.blocks.end());
+  list.blocks.resize(list.blocks.size() - n);
+  return Status::OK();
+}
+
+void SizeClassPool::Central::Release(int32_t cls, void *const *blocks, size_t n) {
+  if (n == 0) {
+    return;
+  }
+  for (int32_t node = 0; node < NumNodes(); ++node) {
+    auto &list = nodes_[node]->lists[cls];
+    std::unique_lock<std::mutex> lck(list.mux);
+    std::unordered_set<Span *> idle;
+    for (size_t i = 0; i < n; ++i) {
+      auto *hdr = HdrOf(blocks[i]);
+      if (hdr->node != node) {
+        continue;
+      }
+      list.blocks.push_back(blocks[i]);
+      auto *span = static_cast<Span *>(hdr->owner);
+      if (++span->num_free == span->num_blks) {
+        (void)idle.insert(span);
+      }
+    }
+    // Keep one span all free, so that a class which is freed and allocated in turns does not carve every time.
+    size_t spare = list.blocks.size();
+    for (auto it = idle.begin(); it != idle.end();) {
+      if (spare >= 2 * (*it)->num_blks) {
+        spare -= (*it)->num_blks;
+        ++it;
+      } else {
+        it = idle.erase(it);
+      }
+    }
+    FreeSpans(node, &list, idle, true);
+  }
+}
+
+Status SizeClassPool::Central::AllocateLarge(int32_t node, size_t n, void **p) {
+  size_t sz = LargeSize(n) + kAlign;
+  auto &nd = *nodes_[node];
+  LargeBlock blk{nullptr, 0, nullptr, 0};
+  {
+    // The smallest freed block which fits and wastes at most a quarter of it
+    std::unique_lock<std::mutex> lck(nd.large_mux);
+    auto best = nd.large_blocks.end();
+    for (auto it = nd.large_blocks.begin(); it != nd.large_blocks.end(); ++it) {
+      if (it->sz >= sz && it->sz - sz <= it->sz / 4 && (best == nd.large_blocks.end() || it->sz < best->sz)) {
+        best = it;
+      }
+    }
+    if (best != nd.large_blocks.end()) {
+      blk = *best;
+      nd.large_sz -= blk.sz;
+      (void)nd.large_blocks.erase(best);
+    }
+  }
+  if (blk.addr == nullptr) {
+    blk.addr = static_cast<char *>(MapOnNode(node, sz, &blk.base, &blk.map_sz));
+    if (blk.addr == nullptr) {
+      return Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
+    }
+    blk.sz = sz;
+  }
+  *p = blk.addr + kAlign;
+  *HdrOf(*p) = BlockHdr{kBlockSig, kLargeClass, static_cast<int16_t>(node), blk.sz - kAlign, blk.base, blk.map_sz};
+  return Status::OK();
+}
+
+void SizeClassPool::Central::ReleaseLarge(void *p) {
+  auto *hdr = HdrOf(p);
+  LargeBlock blk{hdr->owner, hdr->map_sz, static_cast<char *>(p) - kAlign, hdr->sz + kAlign};
+  auto &nd = *nodes_[hdr->node];
+  {
+    std::unique_lock<std::mutex> lck(nd.large_mux);
+    if (nd.large_sz + blk.sz <= kLargeCacheSz) {
+      nd.large_blocks.push_back(blk);
+      nd.large_sz += blk.sz;
+      return;
+    }
+  }
+  Unmap(blk.base, blk.map_sz);
+}
+
+void SizeClassPool::Central::Trim() {
+  for (int32_t node = 0; node < NumNodes(); ++node) {
+    auto &nd = *nodes_[node];
+    for (auto &list : nd.lists) {
+      std::unique_lock<std::mutex> lck(list.mux);
+      std::unordered_set<Span *> idle;
+      for (void *b : list.blocks) {
+        auto *span = static_cast<Span *>(HdrOf(b)->owner);
+        if (span->num_free == span->num_blks) {
+          (void)idle.insert(span);
+        }
+      }
+      FreeSpans(node, &list, idle, false);
+    }
+    std::vector<LargeBlock> large_blocks;
+    {
+      std::unique_lock<std::mutex> lck(nd.large_mux);
+      large_blocks.swap(nd.large_blocks);
+      nd.large_sz = 0;
+    }
+    for (auto &blk : large_blocks) {
+      Unmap(blk.base, blk.map_sz);
+    }
+  }
+}
+
+SizeClassPool::SizeClassPool(bool numa_aware)
+    : id_(g_next_pool_id.fetch_add(1)), central_(std::make_shared<Central>(numa_aware)) {}
+
+// The blocks still in the thread caches are dropped with the segments they come from.
+SizeClassPool::~SizeClassPool() = default;
+
+int32_t SizeClassPool::NumNodes() const { return central_->NumNodes(); }
+
+size_t SizeClassPool::AllocationSize(size_t n) {
+  int32_t cls = SizeToClass(n);
+  return cls < kNumClasses ? ClassSize(cls) : LargeSize(n);
+}
+
+size_t SizeClassPool::MappedSize() const { return central_->MappedSize(); }
+
+void SizeClassPool::Trim() {
+  ThreadCache *tc = GetThreadCache();
+  if (tc != nullptr) {
+    for (int32_t i = 0; i < kNumClasses; ++i) {
+      central_->Release(i, tc->free_[i].data(), tc->free_[i].size());
+      tc->free_[i].clear();
+    }
+  }
+  central_->Trim();
+}
+
+SizeClassPool::ThreadCache *SizeClassPool::GetThreadCache() {
+  if (t_cache_state == CacheState::kDestroyed) {
+    return nullptr;
+  }
+  static thread_local ThreadCaches t_caches;
+  auto &caches = t_caches.caches;
+  for (auto &c : caches) {
+    if (c->id_ == id_) {
+      return c.get();
+    }
+  }
+  // Drop the caches of the pools that are gone before adding one for this pool.
+  caches.erase(std::remove_if(caches.begin(), caches.end(),
+                              [](const std::unique_ptr<ThreadCache> &c) { return c->central_.expired(); }),
+               caches.end());
+  caches.push_back(std::make_unique<ThreadCache>(id_, central_));
+  return caches.back().get();
+}
+
+Status SizeClassPool::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  ThreadCache *tc = GetThreadCache();
+  int32_t node = tc != nullptr ? tc->node_ : 0;
+  int32_t cls = SizeToClass(n);
+  if (cls >= kNumClasses) {
+    return central_->AllocateLarge(node, n, p);
+  }
+  if (tc == nullptr || ThreadCacheCap(cls) == 0) {
+    std::vector<void *> blocks;
+    RETURN_IF_NOT_OK(central_->Fetch(node, cls, 1, &blocks));
+    *p = blocks.front();
+    return Status::OK();
+  }
+  auto &blocks = tc->free_[cls];
+  if (blocks.empty()) {
+    RETURN_IF_NOT_OK(central_->Fetch(node, cls, BatchSize(cls), &blocks));
+  }
+  *p = blocks.back();
+  blocks.pop_back();
+  return Status::OK();
+}
+
+void SizeClassPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  auto *hdr = HdrOf(p);
+  if (hdr->sig != kBlockSig) {
+    MS_LOG(ERROR) << "Memory at " << p << " is not allocated by the size class pool.";
+    return;
+  }
+  int32_t cls = hdr->cls;
+  if (cls == kLargeClass) {
+    central_->ReleaseLarge(p);
+    return;
+  }
+  size_t cap = ThreadCacheCap(cls);
+  ThreadCache *tc = cap > 0 ? GetThreadCache() : nullptr;
+  if (tc == nullptr) {
+    central_->Release(cls, &p, 1);
+    return;
+  }
+  auto &blocks = tc->free_[cls];
+  blocks.push_back(p);
+  if (blocks.size() > cap) {
+    // Give back the blocks freed the longest ago, the recent ones are more likely still in the cpu cache.
+    size_t n = BatchSize(cls);
+    central_->Release(cls, blocks.data(), n);
+    (void)blocks.erase(blocks.begin(), blocks.begin() + n);
+  }
+}
+
+Status SizeClassPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  if (*p == nullptr) {
+    return Allocate(new_sz, p);
+  }
+  auto *hdr = HdrOf(*p);
+  CHECK_FAIL_RETURN_UNEXPECTED(hdr->sig == kBlockSig, "Memory is not allocated by the size class pool.");
+  if (new_sz <= hdr->sz) {
+    return Status::OK();
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  size_t n = std::min<size_t>(old_sz, hdr->sz);
+  if (n > 0) {
+    errno_t err = memcpy_s(q, new_sz, *p, n);
+    if (err) {
+      Deallocate(q);
+      RETURN_STATUS_UNEXPECTED(std::to_string(err));
+    }
+  }
+  Deallocate(*p);
+  *p = q;
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,90 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SIZE_CLASS_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SIZE_CLASS_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A memory pool for the many buffers of similar sizes that the tensors of a pipeline go through.
+///
+/// A request is rounded up to one of the size classes, four per power of two from 64 bytes to 32MB. The freed blocks
+/// of a class are kept for reuse instead of being returned to the system. Each thread has a small cache of free
+/// blocks per class, so most allocations and frees take no lock at all. A thread cache which runs empty, or grows
+/// too big, moves a batch of blocks from or to the free lists of the pool, one list per class and numa node.
+///
+/// New blocks are carved in spans from memory segments of 64MB, which are managed by an ArenaImpl. The segments are
+/// aligned on huge pages and advised to use transparent huge pages, so that the buffers don't fault page by page.
+/// If the pool is numa aware, each node has its own segments which are bound to it, and a thread allocates from the
+/// node it runs on. A block is always returned to the node it comes from.
+///
+/// A span whose blocks are all freed goes back to its segment once its free list holds another span's worth of
+/// blocks, and a segment left empty is unmapped, but the last one of a node. Trim() gives back all the free spans.
+///
+/// The blocks are 64 bytes aligned. A request beyond the largest class is mapped on its own, rounded up to huge pages.
+/// A freed one is kept for the next large requests of about the same size, up to 256MB per node, and the rest are
+/// unmapped.
+class SizeClassPool : public MemoryPool {
+ public:
+  /// \brief Constructor
+  /// \param numa_aware Place the memory on the numa node of the allocating thread. It needs libnuma, without it
+  /// the pool falls back to a single node.
+  explicit SizeClassPool(bool numa_aware = false);
+  ~SizeClassPool() override;
+
+  SizeClassPool(const SizeClassPool &) = delete;
+  SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+  Status Allocate(size_t n, void **p) override;
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override { return std::numeric_limits<uint64_t>::max(); }
+
+  // The pool grows on demand like the system memory, it is never full.
+  int PercentFree() const override { return 100; }
+
+  /// \brief The number of numa nodes that the pool places memory on
+  int32_t NumNodes() const;
+
+  /// \brief The size a request is rounded up to. The block can be used up to this size.
+  static size_t AllocationSize(size_t n);
+
+  /// \brief Give back to the system the memory of the blocks that are free, the ones in the caches of the other
+  /// threads excepted
+  void Trim();
+
+  /// \brief The memory mapped by the pool, in bytes
+  size_t MappedSize() const;
+
+ private:
+  class Central;
+  class ThreadCache;
+  struct ThreadCaches;
+
+  uint64_t id_;  // unique over the life of the process, identifies the thread caches of this pool
+  std::shared_ptr<Central> central_;
+
+  ThreadCache *GetThreadCache();
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SIZE_CLASS_POOL_H_
@@ -29,6 +29,7 @@
 #include "frontend/parallel/costmodel_context.h"
 #include "frontend/parallel/context.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/combine_like_cells.h"
 #include "pipeline/jit/parse/parse_base.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "pipeline/jit/static_analysis/auto_monad.h"
@@ -39,6 +40,7 @@
 #include "pipeline/jit/static_analysis/program_specialize.h"
 #include "pipeline/jit/resource.h"
 #include "utils/ms_context.h"
+#include "utils/ms_utils.h"
 #include "pipeline/jit/remove_value_node_dup.h"
 #include "frontend/optimizer/optimizer.h"
 #include "vm/transform.h"
@@ -817,6 +819,9 @@ static std::vector<ActionItem> CommonPipeline() {
   auto multi_graphs = parallel::CostModelContext::GetInstance()->is_multi_subgraphs();
   if (!multi_graphs) {
     actions.emplace_back(std::make_pair("combine_like_graphs", CombineLikeGraphs));
+    if (common::GetEnv(kEnvCombineLikeCells) == "1") {
+      actions.emplace_back(std::make_pair("combine_like_cells", CombineLikeCellGraphs));
+    }
   }
 
   actions.emplace_back(std::make_pair("inference_opt_prepare", InferenceOptPrepareAction));
@@ -0,0 +1,261 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/combine_like_cells.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include "frontend/parallel/context.h"
+#include "ir/func_graph_cloner.h"
+#include "ir/graph_utils.h"
+#include "pipeline/jit/parse/data_converter.h"
+#include "pipeline/jit/parse/parse.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+bool IsWeight(const AnfNodePtr &node) {
+  auto param = dyn_cast<Parameter>(node);
+  return param != nullptr && param->has_default();
+}
+
+std::string GetAbstractText(const AnfNodePtr &node) {
+  return node->abstract() == nullptr ? "" : node->abstract()->ToString();
+}
+
+std::string GetValueText(const ValuePtr &value) {
+  MS_EXCEPTION_IF_NULL(value);
+  std::ostringstream buffer;
+  buffer << value->type_name() << ":" << value->ToString();
+  auto prim = value->cast<PrimitivePtr>();
+  if (prim != nullptr) {
+    buffer << prim->GetAttrsText();
+  }
+  return buffer.str();
+}
+
+// The properties of a graph which affect how it is evaluated and transformed, the flags are kept in the attrs.
+std::string GetGraphText(const FuncGraphPtr &func_graph) {
+  std::ostringstream buffer;
+  buffer << func_graph->parameters().size() << "," << func_graph->stage();
+  std::map<std::string, std::string> attrs;
+  for (auto &attr : func_graph->attrs()) {
+    attrs[attr.first] = attr.second == nullptr ? "" : attr.second->ToString();
+  }
+  for (auto &attr : attrs) {
+    buffer << "," << attr.first << "=" << attr.second;
+  }
+  return buffer.str();
+}
+
+bool CanCombine(const FuncGraphPtr &func_graph) {
+  // The graphs with variable arguments, default values or user defined bprop are not combined.
+  return !func_graph->has_vararg() && !func_graph->has_kwarg() && func_graph->kwonlyargs_count() == 0 &&
+         func_graph->parameter_default_value().empty() && func_graph->transforms().empty();
+}
+
+void CombineLikeCells(const ResourcePtr &res, const std::vector<LikeCellInfo> &like_cells) {
+  auto &base_cell = like_cells[0];
+  FuncGraphVector func_graphs = {base_cell.func_graph};
+  ClonerPtr cloner = std::make_shared<Cloner>(func_graphs, false, false, true, std::make_shared<TraceCopy>(),
+                                              std::make_shared<TraceCombileLikeGraphs>());
+  cloner->Run();
+  auto base_graph = cloner->cloned_func_graph()[base_cell.func_graph];
+  MS_EXCEPTION_IF_NULL(base_graph);
+  // The weights of each like cell differ in the ref key, so broaden the arguments to evaluate the base graph once.
+  base_graph->set_flag(FUNC_GRAPH_FLAG_IGNORE_VALUES, true);
+  // Keep the calls of the base graph through the inline action and the optimizer 'a', so that the grad of the base
+  // graph is also built once. reset_defer_inline of the optimizer 'b' clears the flag and the layers are inlined
+  // there. The auto parallel passes need the inlined graph, so the base graph is inlined at once in those modes.
+  auto parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (parallel_mode == parallel::STAND_ALONE || parallel_mode == parallel::DATA_PARALLEL) {
+    base_graph->set_flag(FUNC_GRAPH_FLAG_DEFER_INLINE, true);
+  }
+  MS_LOG(DEBUG) << "Basegraph:" << base_graph->ToString();
+
+  auto &cloned_nodes = *cloner->cloned_node();
+  for (auto &weight : base_cell.weights) {
+    TraceGuard guard(std::make_shared<TraceCombileLikeGraphs>(weight->debug_info()));
+    auto param = base_graph->add_parameter();
+    auto &node_users = res->manager()->node_users()[weight];
+    for (auto &user : node_users) {
+      // The uses of the weight outside the base cell, or by the other cells, are kept.
+      auto iter = cloned_nodes.find(user.first);
+      if (iter == cloned_nodes.end() || iter->second == nullptr) {
+        continue;
+      }
+      auto cloned_user = iter->second->cast<CNodePtr>();
+      MS_EXCEPTION_IF_NULL(cloned_user);
+      cloned_user->set_input(IntToSize(user.second), param);
+    }
+  }
+
+  for (auto &cell : like_cells) {
+    auto &fg = cell.func_graph;
+    std::vector<AnfNodePtr> new_node_inputs;
+    new_node_inputs.push_back(NewValueNode(base_graph));
+    for (auto &p : fg->parameters()) {
+      AnfNodePtr para_after_cast = parse::GetMixedPrecisionCastHelp(fg, p);
+      new_node_inputs.push_back(para_after_cast);
+    }
+    (void)new_node_inputs.insert(new_node_inputs.end(), cell.weights.begin(), cell.weights.end());
+    AnfNodePtr out = fg->NewCNodeBefore(fg->get_return(), new_node_inputs);
+    fg->set_output(out);
+    const int recursive_level = 2;
+    MS_LOG(DEBUG) << "Combine like cell newout:" << out->DebugString(recursive_level);
+  }
+}
+}  // namespace
+
+bool GetLikeCellSignature(const FuncGraphPtr &func_graph, LikeCellInfo *info, std::string *signature) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  MS_EXCEPTION_IF_NULL(info);
+  MS_EXCEPTION_IF_NULL(signature);
+  auto nodes = TopoSort(func_graph->get_return(), SuccDeeperSimple, AlwaysInclude);
+  info->func_graph = func_graph;
+  info->node_num = nodes.size();
+  info->closure.add(func_graph);
+  for (auto &node : nodes) {
+    if (IsValueNode<FuncGraph>(node)) {
+      info->closure.add(GetValueNode<FuncGraphPtr>(node));
+    }
+  }
+  if (!std::all_of(info->closure.begin(), info->closure.end(), CanCombine)) {
+    return false;
+  }
+
+  std::unordered_map<AnfNodePtr, size_t> node_index;
+  std::unordered_map<FuncGraphPtr, size_t> graph_index;
+  std::vector<FuncGraphPtr> graphs;
+  auto get_graph_index = [&graph_index, &graphs](const FuncGraphPtr &fg) {
+    auto iter = graph_index.find(fg);
+    if (iter != graph_index.end()) {
+      return iter->second;
+    }
+    auto index = graphs.size();
+    graph_index[fg] = index;
+    graphs.push_back(fg);
+    return index;
+  };
+  auto get_node_index = [&node_index](const AnfNodePtr &node) {
+    auto iter = node_index.find(node);
+    return iter == node_index.end() ? std::string("?") : std::to_string(iter->second);
+  };
+
+  std::ostringstream buffer;
+  for (auto &node : nodes) {
+    auto index = node_index.size();
+    if (IsWeight(node)) {
+      buffer << "W" << info->weights.size() << ":" << GetAbstractText(node) << ";";
+      info->weights.push_back(node);
+    } else if (node->isa<ValueNode>()) {
+      auto value = GetValueNode(node);
+      if (value->isa<FuncGraph>()) {
+        buffer << "G" << get_graph_index(value->cast<FuncGraphPtr>()) << ";";
+      } else {
+        buffer << "V" << GetValueText(value) << ";";
+      }
+    } else {
+      auto fg = node->func_graph();
+      if (fg == nullptr || !info->closure.contains(fg)) {
+        MS_LOG(DEBUG) << func_graph->ToString() << " uses the free variable " << node->DebugString()
+                      << ", which can not be combined.";
+        return false;
+      }
+      if (node->isa<Parameter>()) {
+        auto &params = fg->parameters();
+        auto pos = std::find(params.begin(), params.end(), node) - params.begin();
+        buffer << "P" << get_graph_index(fg) << "." << pos << ";";
+      } else {
+        auto cnode = node->cast<CNodePtr>();
+        MS_EXCEPTION_IF_NULL(cnode);
+        buffer << "C" << get_graph_index(fg) << "(";
+        for (auto &input : cnode->inputs()) {
+          buffer << get_node_index(input) << ",";
+        }
+        buffer << ");";
+      }
+    }
+    node_index[node] = index;
+  }
+  for (size_t i = 0; i < graphs.size(); ++i) {
+    buffer << "F" << i << "[" << GetGraphText(graphs[i]) << "]->" << get_node_index(graphs[i]->get_return()) << "{";
+    for (auto &order_node : graphs[i]->order_list()) {
+      buffer << get_node_index(order_node) << ",";
+    }
+    buffer << "};";
+  }
+  *signature = buffer.str();
+  return true;
+}
+
+bool CombineLikeCellGraphs(const ResourcePtr &res) {
+  MS_EXCEPTION_IF_NULL(res);
+  auto manager = res->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::map<std::string, std::vector<LikeCellInfo>> like_cells_map;
+  for (auto &fg : parse::data_converter::GetObjCellGraphs()) {
+    if (fg == nullptr || fg->dropped() || fg->has_flag(FUNC_GRAPH_OUTPUT_NO_RECOMPUTE) ||
+        !manager->func_graphs().contains(fg)) {
+      continue;
+    }
+    LikeCellInfo info;
+    std::string signature;
+    if (GetLikeCellSignature(fg, &info, &signature)) {
+      like_cells_map[signature].push_back(std::move(info));
+    }
+  }
+
+  std::vector<std::vector<LikeCellInfo> *> groups;
+  for (auto &item : like_cells_map) {
+    if (item.second.size() > 1) {
+      groups.push_back(&item.second);
+    }
+  }
+  // The outer cells are combined first, then the inner cells in them are dropped with the outer cells.
+  std::stable_sort(groups.begin(), groups.end(),
+                   [](const std::vector<LikeCellInfo> *a, const std::vector<LikeCellInfo> *b) {
+                     return a->front().node_num > b->front().node_num;
+                   });
+  FuncGraphSet combined;
+  for (auto group : groups) {
+    std::vector<LikeCellInfo> like_cells;
+    (void)std::copy_if(group->begin(), group->end(), std::back_inserter(like_cells),
+                       [&combined](const LikeCellInfo &info) { return !combined.contains(info.func_graph); });
+    if (like_cells.size() <= 1) {
+      continue;
+    }
+    MS_LOG(INFO) << "Combine " << like_cells.size() << " like cells of " << like_cells[0].func_graph->ToString()
+                 << ", which has " << like_cells[0].node_num << " nodes.";
+    CombineLikeCells(res, like_cells);
+    for (auto &cell : like_cells) {
+      for (auto &fg : cell.closure) {
+        combined.add(fg);
+      }
+    }
+  }
+  return true;
+}
+}  // namespace pipeline
+}  // namespace mindspore
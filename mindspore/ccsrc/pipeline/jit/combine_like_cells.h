@@ -0,0 +1,56 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMBINE_LIKE_CELLS_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMBINE_LIKE_CELLS_H_
+
+#include <string>
+#include <vector>
+#include "ir/func_graph.h"
+#include "pipeline/jit/resource.h"
+
+namespace mindspore {
+namespace pipeline {
+// Set ENV_COMBINE_LIKE_CELLS=1 to combine the structurally identical cell graphs.
+constexpr auto kEnvCombineLikeCells = "ENV_COMBINE_LIKE_CELLS";
+
+struct LikeCellInfo {
+  FuncGraphPtr func_graph;
+  // The weights used by the graph and the graphs it calls, in the order of the first use
+  std::vector<AnfNodePtr> weights;
+  // The graph and all the graphs it calls
+  FuncGraphSet closure;
+  size_t node_num = 0;
+};
+
+// Build the structural signature of 'func_graph' and the graphs it calls, in which the weights are numbered by the
+// order of their first use. Two graphs with the same signature compute the same function of their parameters and
+// weights. Return false if the graph can not be combined, e.g. it has free variables other than the weights.
+bool GetLikeCellSignature(const FuncGraphPtr &func_graph, LikeCellInfo *info, std::string *signature);
+
+// The cell graphs with the same structural signature, e.g. the layers of a transformer, are combined to one base
+// graph which takes the weights as extra parameters:
+// layer1(x){xx(w1)}, layer2(x){xx(w2)} -> layer1(x){base(x, w1)}, layer2(x){base(x, w2)}, base(x, w){xx(w)}
+// so that the abstract interpretation and the specialization of the base graph are done once and shared by all the
+// layers. The outermost like cells are combined first.
+// In the stand alone and data parallel modes the calls of the base graph are deferred to the optimizer 'b', so the
+// optimizer 'a' and the grad also run on the base graph once. The later passes and the backend kernel build still run
+// once per layer.
+bool CombineLikeCellGraphs(const ResourcePtr &res);
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMBINE_LIKE_CELLS_H_
@@ -213,6 +213,10 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set the parameter cost_model_communi_bias of the DP algorithm.")
     .def("get_costmodel_communi_bias", &CostModelContext::costmodel_communi_bias,
          "Get the parameter cost_model_communi_bias of the DP algorithm.")
+    .def("set_costmodel_calibration_file", &CostModelContext::set_costmodel_calibration_file,
+         "Set the cost table measured on the local host, which is used in place of the analytic cost model.")
+    .def("get_costmodel_calibration_file", &CostModelContext::costmodel_calibration_file,
+         "Get the cost table measured on the local host.")
     .def("set_multi_subgraphs", &CostModelContext::set_multi_subgraphs, "Set the parameter is_multi_subgraphs.")
     .def("get_multi_subgraphs", &CostModelContext::is_multi_subgraphs, "Get the parameter is_multi_subgraphs.")
     .def("set_run_phase", &CostModelContext::set_run_phase, "Set the flag run_phase.")
@@ -17,13 +17,16 @@
  */
 
 #include "pipeline/jit/parse/data_converter.h"
+#include <algorithm>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <string>
 #include <memory>
 #include <vector>
 #include "pipeline/jit/parse/resolve.h"
 #include "pipeline/jit/parse/python_adapter.h"
+#include "pipeline/jit/combine_like_cells.h"
 #include "frontend/operator/ops.h"
 #include "frontend/operator/composite/composite.h"
 #include "ir/func_graph_cloner.h"
@@ -338,6 +341,11 @@ ValuePtr ConvertCellObjToFuncGraph(const py::object &obj) {
     }
     func_graph->set_stage(stage);
   }
+  // The cells without 'cell_init_args' are not combined by the object key, record them as the candidates of
+  // combining the structurally like graphs.
+  if (common::GetEnv(pipeline::kEnvCombineLikeCells) == "1" && data_converter::GetObjKey(obj)[1].empty()) {
+    data_converter::SetObjCellGraph(func_graph);
+  }
   return func_graph;
 }
 
@@ -553,6 +561,10 @@ static std::unordered_map<std::string, ValuePtr> object_map_;
 
 static std::unordered_map<std::string, std::vector<FuncGraphPtr>> object_graphs_map_;
 
+static std::vector<FuncGraphPtr> object_cell_graphs_;
+
+static std::unordered_set<FuncGraphPtr> object_cell_graph_set_;
+
 void SetObjGraphValue(const std::string &obj_key, const FuncGraphPtr &data) {
   object_graphs_map_[obj_key].push_back(data);
   MS_LOG(DEBUG) << "Set func graph size:" << object_graphs_map_.size();
@@ -563,6 +575,17 @@ const std::unordered_map<std::string, std::vector<FuncGraphPtr>> &GetObjGraphs()
   return object_graphs_map_;
 }
 
+void SetObjCellGraph(const FuncGraphPtr &data) {
+  if (object_cell_graph_set_.insert(data).second) {
+    object_cell_graphs_.push_back(data);
+  }
+}
+
+const std::vector<FuncGraphPtr> &GetObjCellGraphs() {
+  MS_LOG(DEBUG) << "Cell graph size:" << object_cell_graphs_.size();
+  return object_cell_graphs_;
+}
+
 void CacheObjectValue(const std::string &obj_key, const ValuePtr &data) { object_map_[obj_key] = data; }
 bool GetObjectValue(const std::string &obj_key, ValuePtr *const data) {
   if (object_map_.count(obj_key)) {
@@ -640,6 +663,8 @@ ValuePtr PyDataToValue(const py::object &obj) {
 void ClearObjectCache() {
   object_map_.clear();
   object_graphs_map_.clear();
+  object_cell_graphs_.clear();
+  object_cell_graph_set_.clear();
 }
 }  // namespace data_converter
 
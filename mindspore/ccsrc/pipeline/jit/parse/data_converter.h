@@ -39,6 +39,10 @@ void SetObjGraphValue(const std::string &obj_key, const FuncGraphPtr &data);
 
 const std::unordered_map<std::string, std::vector<FuncGraphPtr>> &GetObjGraphs();
 
+void SetObjCellGraph(const FuncGraphPtr &data);
+
+const std::vector<FuncGraphPtr> &GetObjCellGraphs();
+
 std::vector<std::string> GetObjKey(const py::object &obj);
 ResolveTypeDef GetObjType(const py::object &obj);
 ClassInstanceTypeDef GetClassInstanceType(const py::object &obj);
@@ -350,15 +350,19 @@ OptPassGroupMap GetA1A2(const opt::irpass::OptimizeIRPassLib &irpass) {
 }
 
 OptPassGroupMap GetOptPassesAfterCconv(const opt::irpass::OptimizeIRPassLib &irpass) {
-  opt::OptPassConfig c_1 = opt::OptPassConfig({
-    // Safe inlining,
-    irpass.inline_,
-    irpass.updatestate_eliminater_,
-    irpass.load_eliminater_,
-    irpass.switch_call_monad_eliminater_,
-    irpass.stopgrad_eliminater_,
-    irpass.partial_eliminate_,
-  });
+  // Each of these substitutions only reads the graph, so after its first run the list only visits the nodes
+  // changed since.
+  opt::OptPassConfig c_1 = opt::OptPassConfig(
+    {
+      // Safe inlining,
+      irpass.inline_,
+      irpass.updatestate_eliminater_,
+      irpass.load_eliminater_,
+      irpass.switch_call_monad_eliminater_,
+      irpass.stopgrad_eliminater_,
+      irpass.partial_eliminate_,
+    },
+    false, false, true);
 
   OptPassGroupMap map_a({{"c_1", c_1},
                          {"cse", opt::OptPassConfig(opt::CSEPass(false))},
@@ -18,6 +18,14 @@
 
 namespace mindspore {
 namespace ps {
+namespace {
+template <typename T>
+T FindOrDefault(const std::unordered_map<Key, T> &map, const Key &key) {
+  auto iter = map.find(key);
+  return iter == map.end() ? T() : iter->second;
+}
+}  // namespace
+
 void ParameterServer::Run(const FuncGraphPtr &func_graph) {
   MS_EXCEPTION_IF_NULL(func_graph);
   MS_LOG(INFO) << "PServer starts connecting to scheduler and workers...";
@@ -145,6 +153,8 @@ void ParameterServer::InitWeight(const Key &key, const WeightPtr &weight) {
   if ((weights_.count(key) == 0) || (is_embedding_[key] && weights_.count(key) != 0)) {
     MS_LOG(INFO) << "Initializing weight for key " << key << ", server rank " << server_node_->rank_id();
     weights_[key] = weight;
+    (void)weight_versions_[key];
+    (void)optim_infos_.emplace(key, nullptr);
     tokens_[key] = 0;
     is_embedding_[key] = false;
   }
@@ -191,7 +201,9 @@ void ParameterServer::InitEmbeddingTable(
       }
     }
     weights_[key] = embedding;
+    (void)weight_versions_[key];
     MS_LOG(DEBUG) << "The key:" << key << " the embedding:" << *embedding;
+    (void)optim_infos_.emplace(key, nullptr);
     tokens_[key] = 0;
     is_embedding_[key] = true;
 
@@ -202,30 +214,38 @@ void ParameterServer::InitEmbeddingTable(
 bool ParameterServer::HasWeight(const Key &key) { return (weights_.count(key) > 0 && !is_embedding_.count(key)); }
 
 void ParameterServer::Finalize() {
+  std::lock_guard<std::mutex> lock(apply_grads_mutex_);
   running_ = false;
   apply_grads_cv_.notify_one();
 }
 
 void ParameterServer::UpdateWeights() {
   while (true) {
-    MS_LOG(INFO) << "The running is:" << running_ << " the ready is:" << this->ReadyForUpdateWeights();
-    std::unique_lock<std::mutex> lock(mutex_);
-    apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
-    if (!running_) {
-      break;
+    {
+      std::unique_lock<std::mutex> lock(apply_grads_mutex_);
+      MS_LOG(INFO) << "The running is:" << running_ << " the ready is:" << update_ready_;
+      apply_grads_cv_.wait(lock, [this] { return update_ready_ || !running_; });
+      if (!running_) {
+        break;
+      }
+      update_ready_ = false;
     }
 
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
       Key key = iter->first;
       WeightPtr weight_ptr = iter->second;
+      // The lookups and the updates of the embeddings of this key wait, the other keys are served meanwhile.
+      std::lock_guard<std::mutex> key_lock(key_mutex(key));
 
       std::shared_ptr<PServerKernel> optimizer = nullptr;
       if (weight_key_to_optims_.count(key) > 0) {
-        optimizer = optimizers_[key];
+        optimizer = FindOrDefault(optimizers_, key);
       }
       MS_EXCEPTION_IF_NULL(optimizer);
 
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
+      std::shared_ptr<OptimizerInfo> optim_info = FindOrDefault(optim_infos_, key);
+      bool is_embedding = FindOrDefault(is_embedding_, key);
       if (optim_info != nullptr) {
         const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
         const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
@@ -236,19 +256,23 @@ void ParameterServer::UpdateWeights() {
         indices_shape.emplace_back(optim_info->indice_size());
         shapes.push_back(indices_shape);
 
-        if (original_optim_inputs_shape_.count(key) != 0) {
+        auto original_shapes = FindOrDefault(original_optim_inputs_shape_, key);
+        if (original_shapes != nullptr) {
           std::transform(
-            (*(original_optim_inputs_shape_[key])).begin(), (*(original_optim_inputs_shape_[key])).end(),
-            std::back_inserter(shapes),
+            original_shapes->begin(), original_shapes->end(), std::back_inserter(shapes),
             [](std::shared_ptr<std::vector<size_t>> input_shapes) -> std::vector<size_t> { return *input_shapes; });
         }
         optimizer->ReInit(shapes);
         optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
         optimizer->Execute(inputs, workspaces, outputs);
+        // The pulls of the dense weight copy it again.
+        if (!is_embedding) {
+          weight_versions_.at(key).Advance();
+        }
         optim_info->Reset();
       }
-      if (!is_embedding_[key]) {
-        tokens_[key] = worker_num_;
+      if (!is_embedding) {
+        tokens_.at(key) = SizeToLong(worker_num_);
       }
     }
     ResetGradAccumCount();
@@ -256,55 +280,79 @@ void ParameterServer::UpdateWeights() {
 }
 
 void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
   const Key &key = keys[0];
-  bool no_sparse_grad = values.size() == 1 && values[0] == -100;
-  if (!no_sparse_grad) {
-    std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-
-    // Create or update the optimizer info
-    if (optim_info == nullptr) {
-      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-      if (pserver_kernel == nullptr) {
-        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+  auto counter_iter = grads_accum_counter_.find(key);
+  auto optim_info_iter = optim_infos_.find(key);
+  if (counter_iter == grads_accum_counter_.end() || optim_info_iter == optim_infos_.end()) {
+    MS_LOG(EXCEPTION) << "Invalid gradient key " << key;
+  }
+  bool ready = false;
+  {
+    std::lock_guard<std::mutex> key_lock(key_mutex(key));
+    bool no_sparse_grad = values.size() == 1 && values[0] == -100;
+    if (!no_sparse_grad) {
+      std::shared_ptr<OptimizerInfo> &optim_info = optim_info_iter->second;
+
+      // Create or update the optimizer info
+      if (optim_info == nullptr) {
+        const std::string optim_name = FindOrDefault(weight_key_to_optims_, key);
+        auto builder_iter = optim_info_builders_.find(optim_name);
+        std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = FindOrDefault(optimizers_, key);
+        if (builder_iter == optim_info_builders_.end() || pserver_kernel == nullptr) {
+          MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << optim_name;
+        }
+        MS_EXCEPTION_IF_NULL(pserver_kernel);
+        OptimizerInfo *optim =
+          builder_iter->second->Build(pserver_kernel, FindOrDefault(weights_, key), keys, values, lengths,
+                                      FindOrDefault(optim_inputs_shape_, key), worker_num_,
+                                      FindOrDefault(is_embedding_, key));
+        optim_info.reset(optim);
+      } else {
+        optim_info->Update(values, lengths);
+        optim_info->Accumulate(values, lengths);
       }
-      MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim = builder->Build(pserver_kernel, weights_[key], keys, values, lengths,
-                                            optim_inputs_shape_[key], worker_num_, is_embedding_[key]);
-      optim_info.reset(optim);
-      optim_infos_[key] = optim_info;
-    } else {
-      optim_info->Update(values, lengths);
-      optim_info->Accumulate(values, lengths);
     }
-  }
 
-  grads_accum_counter_[key] += 1;
-  if (grads_accum_counter_[key] == worker_num_) {
-    grad_accum_count_++;
+    counter_iter->second += 1;
+    // Only the last push of the round sees all the keys accumulated, so the update is triggered once.
+    if (counter_iter->second == worker_num_) {
+      ready = ++grad_accum_count_ == grads_accum_counter_.size();
+    }
   }
-  if (ReadyForUpdateWeights()) {
+  if (ready) {
+    std::lock_guard<std::mutex> apply_lock(apply_grads_mutex_);
+    update_ready_ = true;
     apply_grads_cv_.notify_one();
   }
 }
 
-WeightPtr ParameterServer::weight(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
+void ParameterServer::DoPull(const Key &key, KVMessage *res) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  MS_EXCEPTION_IF_NULL(res);
+  auto iter = weights_.find(key);
+  auto version_iter = weight_versions_.find(key);
+  auto token_iter = tokens_.find(key);
+  if (iter == weights_.end() || version_iter == weight_versions_.end() || token_iter == tokens_.end()) {
     MS_LOG(EXCEPTION) << "Invalid weight key " << key;
   }
-  WeightPtr weight_ptr = weights_[key];
+  token_iter->second -= 1;
+  const WeightPtr &weight_ptr = iter->second;
   MS_EXCEPTION_IF_NULL(weight_ptr);
-  WeightPtr copy_weight_ptr = std::make_shared<std::vector<float>>(weight_ptr->size(), 0);
-  MS_EXCEPTION_IF_NULL(copy_weight_ptr);
-  copy_weight_ptr = weight_ptr;
-  tokens_[key] -= 1;
-  return copy_weight_ptr;
+  WeightSnapshotPtr snapshot = version_iter->second.Get();
+  if (snapshot == nullptr) {
+    // The first pull after an update copies the weight, which the update thread writes under the same lock.
+    std::lock_guard<std::mutex> key_lock(key_mutex(key));
+    snapshot = version_iter->second.Get();
+    if (snapshot == nullptr) {
+      snapshot = version_iter->second.Set(*weight_ptr);
+    }
+  }
+  *res->mutable_values() = {snapshot->values.begin(), snapshot->values.end()};
 }
 
 void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res) {
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
   MS_EXCEPTION_IF_NULL(res);
   if (weights_.count(key) == 0) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
@@ -314,10 +362,13 @@ void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KV
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
+  WeightPtr table_ptr = weights_.at(key);
   MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_.at(key);
   MS_EXCEPTION_IF_NULL(table_lookup_op);
+  // The lookup op keeps the shapes of the request, the lookups of the same table are serialized, and the rows of one
+  // lookup are gathered in parallel by the op.
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
 
   // Update shapes of lookup operator
   std::vector<std::vector<size_t>> shapes = {};
@@ -362,6 +413,7 @@ void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KV
 }
 
 void ParameterServer::UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
   if (weights_.count(key) == 0) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
@@ -370,42 +422,44 @@ void ParameterServer::UpdateEmbeddings(const Key &key, const LookupIds &lookup_i
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
+  WeightPtr table_ptr = weights_.at(key);
   MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_.at(key);
   MS_EXCEPTION_IF_NULL(table_lookup_op);
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
   table_lookup_op->UpdateEmbeddings(table_ptr->data(), lookup_ids.data(), vals.data(), lookup_ids.size());
 }
 
-inline bool ParameterServer::ReadyForUpdateWeights() {
-  return grads_accum_counter_.size() > 0 && grad_accum_count_ == grads_accum_counter_.size();
-}
-
 inline bool ParameterServer::ReadyForPush(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
   if (weights_.empty()) {
     MS_LOG(EXCEPTION) << "The weights in server is empty. Many reasons could cause this: 1.The Worker didn't send "
                          "kInitWeightsCmd command. 2.The Server failed to initialize weights.";
   }
+  auto iter = tokens_.find(key);
+  bool no_token = iter == tokens_.end() || iter->second <= 0;
   MS_LOG(INFO) << "The grad_accum_count_:" << grad_accum_count_ << " the weights_:" << weights_.size()
-               << " the token:" << (tokens_[key] <= 0);
-  return grad_accum_count_ < weights_.size() && tokens_[key] <= 0;
+               << " the token:" << no_token;
+  return grad_accum_count_ < weights_.size() && no_token;
 }
 
 inline bool ParameterServer::ReadyForPull(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (tokens_.count(key) == 0 || weights_[key] == 0) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto iter = tokens_.find(key);
+  if (iter == tokens_.end() || FindOrDefault(weights_, key) == nullptr) {
     MS_LOG(EXCEPTION) << "Invalid weight key " << key;
   }
-  MS_LOG(INFO) << "ReadyForPull: " << (tokens_[key] > 0);
-  return tokens_[key] > 0;
+  MS_LOG(INFO) << "ReadyForPull: " << (iter->second > 0);
+  return iter->second > 0;
 }
 
 inline void ParameterServer::ResetGradAccumCount() {
-  grad_accum_count_ = 0;
   for (auto iter = grads_accum_counter_.begin(); iter != grads_accum_counter_.end(); iter++) {
-    grads_accum_counter_[iter->first] = 0;
+    std::lock_guard<std::mutex> key_lock(key_mutex(iter->first));
+    iter->second = 0;
   }
+  // The pushes of the next round wait for this.
+  grad_accum_count_ = 0;
 }
 
 const CNodePtr ParameterServer::GetCNode(const std::string &name) const {
@@ -420,7 +474,9 @@ const CNodePtr ParameterServer::GetCNode(const std::string &name) const {
   return nullptr;
 }
 
-inline std::mutex &ParameterServer::mutex() { return mutex_; }
+inline std::shared_mutex &ParameterServer::mutex() { return mutex_; }
+
+inline std::mutex &ParameterServer::key_mutex(const Key &key) { return key_mutexes_[key % kKeyLockStripeNum]; }
 
 void ParameterServer::GetEmbeddingTableParamPtr() {
   MS_EXCEPTION_IF_NULL(func_graph_);
@@ -548,8 +604,7 @@ void ParameterServer::ServerHandler::HandlePullReq(DataPtr data, size_t size, Ve
   KVMessage res_data;
   *res_data.mutable_keys() = input.keys();
   Key key = input.keys()[0];
-  auto weight = ps_->weight(key);
-  *res_data.mutable_values() = {weight->begin(), weight->end()};
+  ps_->DoPull(key, &res_data);
   res->resize(res_data.ByteSizeLong());
   size_t dest_size = res_data.ByteSizeLong();
   size_t src_size = res_data.ByteSizeLong();
@@ -560,7 +615,7 @@ void ParameterServer::ServerHandler::HandlePullReq(DataPtr data, size_t size, Ve
 }
 
 void ParameterServer::ServerHandler::HandleInitWeights(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   if (!input.ParseFromArray(data.get(), SizeToInt(size))) {
@@ -587,7 +642,7 @@ void ParameterServer::ServerHandler::HandleInitWeights(DataPtr data, size_t size
 }
 
 void ParameterServer::ServerHandler::HandleInitWeightToOptimId(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   if (!input.ParseFromArray(data.get(), SizeToInt(size))) {
@@ -607,7 +662,7 @@ void ParameterServer::ServerHandler::HandleInitWeightToOptimId(DataPtr data, siz
 }
 
 void ParameterServer::ServerHandler::HandleInitInputsShape(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
@@ -624,7 +679,7 @@ void ParameterServer::ServerHandler::HandleInitInputsShape(DataPtr data, size_t
 }
 
 void ParameterServer::ServerHandler::HandleInitEmbeddings(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   EmbeddingTableMeta embedding_table_meta;
   embedding_table_meta.ParseFromArray(data.get(), size);
   const Key &key = embedding_table_meta.key();
@@ -718,7 +773,6 @@ void ParameterServer::ServerHandler::HandleEmbeddingLookup(DataPtr data, size_t
 }
 
 void ParameterServer::ServerHandler::HandleUpdateEmbeddings(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
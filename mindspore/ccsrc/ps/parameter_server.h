@@ -24,7 +24,10 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
+#include <atomic>
+#include <array>
 #include <thread>
 #include <cmath>
 #include <random>
@@ -55,6 +58,7 @@
 #include "ps/constants.h"
 #include "ps/util.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/weight_version.h"
 #include "utils/log_adapter.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
@@ -63,6 +67,9 @@
 
 namespace mindspore {
 namespace ps {
+// The number of the mutexes which the keys are striped to.
+constexpr size_t kKeyLockStripeNum = 64;
+
 class ParameterServer {
  public:
   static ParameterServer &GetInstance() {
@@ -81,6 +88,7 @@ class ParameterServer {
         func_graph_(nullptr),
         sess_(nullptr),
         running_(true),
+        update_ready_(false),
         thread_(nullptr),
         server_node_(nullptr) {}
   ~ParameterServer() = default;
@@ -129,21 +137,21 @@ class ParameterServer {
   void Finalize();
   void UpdateWeights();
   void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
-  WeightPtr weight(const Key &key);
+  void DoPull(const Key &key, KVMessage *res);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res);
   void UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals);
-  bool ReadyForUpdateWeights();
   bool ReadyForPush(const Key &key);
   bool ReadyForPull(const Key &key);
   void ResetGradAccumCount();
   const CNodePtr GetCNode(const std::string &name) const;
-  std::mutex &mutex();
+  std::shared_mutex &mutex();
+  std::mutex &key_mutex(const Key &key);
   void GetEmbeddingTableParamPtr();
   void SyncEmbeddingTables();
 
   size_t pserver_num_;
   size_t worker_num_;
-  size_t grad_accum_count_;
+  std::atomic<size_t> grad_accum_count_;
   std::unique_ptr<ServerHandler> handler_;
   FuncGraphPtr func_graph_;
   std::shared_ptr<session::SessionBasic> sess_;
@@ -161,10 +169,18 @@ class ParameterServer {
   std::unordered_map<Key, WeightPtr> grads_;
   std::unordered_map<Key, size_t> grads_accum_counter_;
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
-  std::unordered_map<Key, uint64_t> tokens_;
+  std::unordered_map<Key, std::atomic<int64_t>> tokens_;
+  // The versions of the dense weights, advanced by the update thread after each update, with the copies the pulls
+  // are served from.
+  std::unordered_map<Key, WeightVersion> weight_versions_;
 
-  std::mutex mutex_;
+  // The maps above are only changed by the init handlers which hold 'mutex_' exclusively. The pushes, pulls and
+  // lookups hold it shared and lock the stripe of their key, so the requests of different keys run in parallel.
+  std::shared_mutex mutex_;
+  std::array<std::mutex, kKeyLockStripeNum> key_mutexes_;
+  std::mutex apply_grads_mutex_;
   std::condition_variable apply_grads_cv_;
+  bool update_ready_;
 
   std::unique_ptr<std::thread> thread_;
   std::shared_ptr<core::ServerNode> server_node_;
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_WEIGHT_VERSION_H_
+#define MINDSPORE_CCSRC_PS_WEIGHT_VERSION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// A copy of a dense weight, made at the version 'version' of the weight.
+struct WeightSnapshot {
+  uint64_t version;
+  std::vector<float> values;
+};
+using WeightSnapshotPtr = std::shared_ptr<const WeightSnapshot>;
+
+// The version of a dense weight and the copy of it which the pulls are served from. The weight is only written under
+// the lock of its key, and Advance is called after each write. The first pull after a write copies the weight under
+// the same lock, the later pulls share that copy without locking, so the weight is copied at most once per write and
+// only if it is pulled, and the pulls never read the weight while it is written.
+class WeightVersion {
+ public:
+  WeightVersion() : version_(0) {}
+  ~WeightVersion() = default;
+
+  // Called under the lock of the key after the weight is written.
+  void Advance() { (void)version_.fetch_add(1, std::memory_order_release); }
+
+  // The copy of the weight made since the last write, or nullptr if there is none yet. Does not lock.
+  WeightSnapshotPtr Get() const {
+    WeightSnapshotPtr snapshot = std::atomic_load(&snapshot_);
+    if (snapshot != nullptr && snapshot->version == version_.load(std::memory_order_acquire)) {
+      return snapshot;
+    }
+    return nullptr;
+  }
+
+  // Copy 'weight' for the pulls until the next write. Called under the lock of the key, so 'weight' is not written
+  // meanwhile.
+  WeightSnapshotPtr Set(const std::vector<float> &weight) {
+    auto snapshot = std::make_shared<const WeightSnapshot>(
+      WeightSnapshot{version_.load(std::memory_order_relaxed), std::vector<float>(weight.begin(), weight.end())});
+    std::atomic_store(&snapshot_, snapshot);
+    return snapshot;
+  }
+
+ private:
+  std::atomic<uint64_t> version_;
+  WeightSnapshotPtr snapshot_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_WEIGHT_VERSION_H_
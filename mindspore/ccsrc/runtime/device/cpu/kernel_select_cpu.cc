@@ -18,12 +18,15 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <set>
+#include <unordered_set>
 #include "backend/kernel_compiler/common_utils.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 #include "backend/kernel_compiler/kernel_build_info.h"
 #include "backend/kernel_compiler/oplib/opinfo.h"
 #include "backend/kernel_compiler/oplib/oplib.h"
 #include "utils/trace_base.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace device {
@@ -200,7 +203,100 @@ void KernelNotSupportException(const AnfNodePtr &kernel_node, const std::vector<
   operator_info << "is not support.";
   MS_EXCEPTION(TypeError) << operator_info.str() << " Trace: " << trace::DumpSourceLines(kernel_node);
 }
+
+// The oneDNN kernels which read the first input and write the first output in any layout.
+const std::set<std::string> kMKLBlockedFormatOps = {
+  kConv2DOpName, kConv3DOpName, "MaxPool", "MaxPool3D", "AvgPool", "AvgPool3D", "BatchNorm", "ReLU", "ReLU6",
+  "Elu",         "Abs",         "Exp",     "Log",       "Sigmoid", "Sqrt",      "Square",    "Tanh"};
+// The convolutions choose the blocked layout of the output, the others keep the layout of the first input.
+const std::set<std::string> kMKLBlockedFormatCreatorOps = {kConv2DOpName, kConv3DOpName};
+
+bool AcceptMKLBlockedFormat(const CNodePtr &kernel_node) {
+  if (kMKLBlockedFormatOps.find(AnfAlgo::GetCNodeName(kernel_node)) == kMKLBlockedFormatOps.end()) {
+    return false;
+  }
+  const size_t dim_4d = 4;
+  const size_t dim_5d = 5;
+  auto shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  return (shape.size() == dim_4d || shape.size() == dim_5d) &&
+         AnfAlgo::GetInputDeviceDataType(kernel_node, 0) == kNumberTypeFloat32 &&
+         AnfAlgo::GetOutputDeviceDataType(kernel_node, 0) == kNumberTypeFloat32;
+}
+
+// Whether the first output of the node is only read by the oneDNN kernels as their first input, the graph outputs and
+// the other kernels need the default layout.
+bool AllUsersAcceptMKLBlockedFormat(const FuncGraphManagerPtr &manager, const AnfNodePtr &node) {
+  auto &node_users = manager->node_users();
+  auto iter = node_users.find(node);
+  if (iter == node_users.end() || iter->second.empty()) {
+    return false;
+  }
+  for (auto &user : iter->second) {
+    auto user_node = user.first->cast<CNodePtr>();
+    if (user_node == nullptr) {
+      return false;
+    }
+    if (AnfAlgo::CheckPrimitiveType(user_node, prim::kPrimTupleGetItem)) {
+      if (AnfAlgo::GetTupleGetItemOutIndex(user_node) != 0) {
+        continue;
+      }
+      if (!AllUsersAcceptMKLBlockedFormat(manager, user_node)) {
+        return false;
+      }
+      continue;
+    }
+    if (user.second != 1 || !AnfAlgo::IsRealKernel(user_node) || !AcceptMKLBlockedFormat(user_node)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SetFirstFormat(const CNodePtr &kernel_node, bool is_input) {
+  auto build_info = AnfAlgo::GetSelectKernelBuildInfo(kernel_node);
+  MS_EXCEPTION_IF_NULL(build_info);
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>(build_info);
+  if (is_input) {
+    builder->SetInputFormat(kOpFormat_MKL_BLOCKED, 0);
+  } else {
+    builder->SetOutputFormat(kOpFormat_MKL_BLOCKED, 0);
+  }
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), kernel_node.get());
+}
 }  // namespace
+
+void SetMKLBlockedFormat(const std::vector<CNodePtr> &kernel_nodes) {
+  if (kernel_nodes.empty() || common::GetEnv(kEnvMKLBlockedFormat) != "1") {
+    return;
+  }
+  auto func_graph = kernel_nodes[0]->func_graph();
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto manager = func_graph->manager();
+  if (manager == nullptr) {
+    return;
+  }
+  std::unordered_set<AnfNodePtr> blocked_nodes;
+  for (auto &kernel_node : kernel_nodes) {
+    MS_EXCEPTION_IF_NULL(kernel_node);
+    if (!AnfAlgo::IsRealKernel(kernel_node) || !AcceptMKLBlockedFormat(kernel_node)) {
+      continue;
+    }
+    // The producers are visited first, so the layout of the input has been selected.
+    auto input = AnfAlgo::GetPrevNodeOutput(kernel_node, 0);
+    bool input_blocked = input.second == 0 && blocked_nodes.find(input.first) != blocked_nodes.end();
+    if (input_blocked) {
+      SetFirstFormat(kernel_node, true);
+    }
+    bool is_creator = kMKLBlockedFormatCreatorOps.find(AnfAlgo::GetCNodeName(kernel_node)) !=
+                      kMKLBlockedFormatCreatorOps.end();
+    if ((is_creator || input_blocked) && AllUsersAcceptMKLBlockedFormat(manager, kernel_node)) {
+      SetFirstFormat(kernel_node, false);
+      (void)blocked_nodes.insert(kernel_node);
+    }
+  }
+  MS_LOG(INFO) << "Select the blocked format for " << blocked_nodes.size() << " oneDNN kernels.";
+}
+
 bool SelectKernel(const CNodePtr &kernel_node, KernelAttr *selected_kernel_attr,
                   const std::vector<KernelAttr> &kernel_attrs, const std::vector<TypeId> &input_types,
                   const std::vector<size_t> &input_not_cnode_indexes, const std::vector<TypeId> &output_types,
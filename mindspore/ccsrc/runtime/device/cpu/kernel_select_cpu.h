@@ -29,6 +29,10 @@ namespace mindspore {
 namespace device {
 namespace cpu {
 void SetKernelInfo(const CNodePtr &apply_kernel_ptr);
+// Set ENV_MKL_BLOCKED_FORMAT=1 to pass the tensors between the oneDNN kernels in their blocked layouts.
+constexpr auto kEnvMKLBlockedFormat = "ENV_MKL_BLOCKED_FORMAT";
+// Select kOpFormat_MKL_BLOCKED for the edges between the oneDNN kernels, the kernels are in the execution order.
+void SetMKLBlockedFormat(const std::vector<CNodePtr> &kernel_nodes);
 
 class KernelAttr {
  public:
@@ -158,6 +158,7 @@ void CPUDeviceContext::SetOperatorInfo(const std::vector<CNodePtr> &nodes) const
 }
 
 void CPUDeviceContext::CreateKernel(const std::vector<CNodePtr> &nodes) const {
+  SetMKLBlockedFormat(nodes);
   for (const auto &node : nodes) {
     MS_EXCEPTION_IF_NULL(node);
     if (AnfAlgo::IsControlOpExecInBackend(node)) {
@@ -542,6 +542,8 @@ constexpr auto kOpFormat_DHWCN = "DHWCN";
 constexpr auto kOpFormat_NDC1HWC0 = "NDC1HWC0";
 constexpr auto kOpFormat_FRACTAL_Z_3D = "FRACTAL_Z_3D";
 constexpr auto kOpFormat_FRACTAL_ZN_LSTM = "FRACTAL_ZN_LSTM";
+// The opaque blocked layout chosen by the oneDNN primitive on CPU, the device shape is the same as the host shape.
+constexpr auto kOpFormat_MKL_BLOCKED = "MKLBlocked";
 
 const std::set<std::string> kOpFormatList = {kOpFormat_DEFAULT,      kOpFormat_NC1KHKWHWC0,
                                              kOpFormat_ND,           kOpFormat_NCHW,
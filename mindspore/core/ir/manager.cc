@@ -376,6 +376,9 @@ void FuncGraphManager::AcquireNodes(const std::vector<AnfNodePtr> &nodes) {
     all_nodes_.update(new_nodes);
     acq.update(new_nodes);
   }
+  if (change_log_depth_ > 0) {
+    (void)change_log_.insert(change_log_.end(), acq.begin(), acq.end());
+  }
 
   for (auto &node : acq) {
     MS_EXCEPTION_IF_NULL(node);
@@ -514,7 +517,7 @@ void FuncGraphManager::AddEdge(AnfNodePtr node, int index, AnfNodePtr input) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->AddFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->AddFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        InvalidateComputer();
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ)) {
@@ -522,7 +525,7 @@ void FuncGraphManager::AddEdge(AnfNodePtr node, int index, AnfNodePtr input) {
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->AddFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      InvalidateComputer();
     }
   }
 }
@@ -535,7 +538,7 @@ void FuncGraphManager::DropEdge(AnfNodePtr node, int index, AnfNodePtr input) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->DropFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->DropFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        InvalidateComputer();
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ)) {
@@ -543,7 +546,7 @@ void FuncGraphManager::DropEdge(AnfNodePtr node, int index, AnfNodePtr input) {
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->DropFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      InvalidateComputer();
     }
   }
 }
@@ -556,7 +559,7 @@ void FuncGraphManager::MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target) {
   target->CopyFuncGraphsUsed(source);
   target->CopyJValueNodes(source);
   source->ClearAllManagerInfo();
-  signals_->InvalidateComputer();
+  InvalidateComputer();
 }
 
 FuncGraphTransaction FuncGraphManager::Transact() {
@@ -578,6 +581,12 @@ void FuncGraphManager::ParseChanges(const std::vector<Change> &changes, EdgeTupl
         (*rms)[old_node] += 1;
         (*adds)[edge.new_node] += 1;
         edge.root_node->set_input(edge.index, edge.new_node);
+        if (change_log_depth_ > 0) {
+          // The users of old_node and new_node change too.
+          change_log_.push_back(edge.root_node);
+          change_log_.push_back(old_node);
+          change_log_.push_back(edge.new_node);
+        }
       } break;
       case Change::kTxAddEdge: {
         auto edge = args.cast<ArgsOfAddEdge>();
@@ -585,6 +594,10 @@ void FuncGraphManager::ParseChanges(const std::vector<Change> &changes, EdgeTupl
         (*add_edges)[std::make_pair(edge.root_node, std::make_pair(index, edge.new_node))] += 1;
         (*adds)[edge.new_node] += 1;
         edge.root_node->add_input(edge.new_node);
+        if (change_log_depth_ > 0) {
+          change_log_.push_back(edge.root_node);
+          change_log_.push_back(edge.new_node);
+        }
       } break;
       case Change::kTxSetParams: {
         auto param = args.cast<ArgsOfSetParams>();
@@ -618,7 +631,41 @@ void FuncGraphManager::ParseChanges(const std::vector<Change> &changes, EdgeTupl
   }
 }
 
+void FuncGraphManager::StopChangeLog() {
+  if (change_log_depth_ == 0) {
+    MS_LOG(WARNING) << "The change log is not started.";
+    return;
+  }
+  if (--change_log_depth_ == 0) {
+    change_log_.clear();
+  }
+}
+
+void FuncGraphManager::InvalidateComputer() {
+  if (commit_depth_ > 0) {
+    invalidate_pending_ = true;
+    return;
+  }
+  signals_->InvalidateComputer();
+}
+
 void FuncGraphManager::CommitChanges(const std::vector<Change> &changes) {
+  // The graph level analyses are invalidated once after all the changes are applied, instead of once for each edge
+  // which changes the used graphs or the free variables.
+  class CommitGuard {
+   public:
+    explicit CommitGuard(FuncGraphManager *manager) : manager_(manager) { ++manager_->commit_depth_; }
+    ~CommitGuard() {
+      if (--manager_->commit_depth_ == 0 && manager_->invalidate_pending_) {
+        manager_->invalidate_pending_ = false;
+        manager_->signals_->InvalidateComputer();
+      }
+    }
+
+   private:
+    FuncGraphManager *manager_;
+  };
+  CommitGuard guard(this);
   EdgeTupleCounter add_edges;
   EdgeTupleCounter rm_edges;
   Counter<AnfNodePtr> adds;
@@ -690,11 +737,15 @@ bool FuncGraphTransaction::Replace(const AnfNodePtr &old_node, const AnfNodePtr
     MS_LOG(WARNING) << "Cannot replace the return node of a func graph " << old_func_graph->ToString();
     return false;
   }
-  auto users = manager_->node_users()[old_node];
-  for (auto &node : users) {
+  // The changes are applied on commit, so the users can be read without a copy.
+  auto &node_users = manager_->node_users();
+  auto iter = node_users.find(old_node);
+  if (iter == node_users.end()) {
+    return true;
+  }
+  for (auto &node : iter->second) {
     SetEdge(node.first, node.second, new_node);
   }
-
   return true;
 }
 
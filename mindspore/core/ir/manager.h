@@ -351,6 +351,12 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
 
   std::shared_ptr<Signals> signals() const { return signals_; }
 
+  // The nodes whose inputs are changed and the nodes acquired, in the order of the changes. They are logged while
+  // some optimizer runs its passes by worklist, see Optimizer::step. The log is cleared when the last one stops.
+  void StartChangeLog() { ++change_log_depth_; }
+  void StopChangeLog();
+  const std::vector<AnfNodePtr> &change_log() const { return change_log_; }
+
   IncludeType Limit(const AnfNodePtr &node);
 
   // Static Analysis
@@ -373,6 +379,8 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
   void AddEdge(AnfNodePtr node, int index, AnfNodePtr input);
   void DropEdge(AnfNodePtr node, int index, AnfNodePtr input);
   void MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target);
+  // Invalidate the graph level analyses, which is deferred to the end of the commit in progress.
+  void InvalidateComputer();
 
   FuncGraphSet roots_;        // Managed roots.
   FuncGraphSet func_graphs_;  // Managed func graphs.
@@ -390,6 +398,10 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
 
   bool is_manage_;
   std::function<IncludeType(AnfNodePtr)> limit_;
+  size_t commit_depth_{0};
+  bool invalidate_pending_{false};
+  size_t change_log_depth_{0};
+  std::vector<AnfNodePtr> change_log_;
 };
 
 class FuncGraphTransaction {
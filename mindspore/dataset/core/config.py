@@ -27,7 +27,7 @@ __all__ = ['set_seed', 'get_seed', 'set_prefetch_size', 'get_prefetch_size', 'se
            'get_num_parallel_workers', 'set_numa_enable', 'get_numa_enable', 'set_monitor_sampling_interval',
            'get_monitor_sampling_interval', 'set_callback_timeout', 'get_callback_timeout',
            'set_auto_num_workers', 'get_auto_num_workers', 'set_enable_shared_mem', 'get_enable_shared_mem',
-           'set_sending_batches', 'load', '_init_device_info']
+           'set_enable_tensor_pool', 'get_enable_tensor_pool', 'set_sending_batches', 'load', '_init_device_info']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -416,6 +416,39 @@ def set_enable_shared_mem(enable):
         raise TypeError("enable must be of type bool.")
     _config.set_enable_shared_mem(enable)
 
+
+def get_enable_tensor_pool():
+    """
+    Get the default state of tensor pool enabled variable.
+
+
+    Returns:
+        bool, the state of tensor pool enabled variable (default=False).
+    """
+    return _config.get_enable_tensor_pool()
+
+
+def set_enable_tensor_pool(enable):
+    """
+    Set the default state of tensor pool flag. If enable is True, the data of the tensors created from then on
+    is allocated from a pool of reusable buffers, kept per size and per thread, instead of by the system allocator.
+    This saves the cost of allocating and faulting in the many buffers of similar sizes that the decoding and
+    augmentations produce. When numa is enabled, the buffers are placed on the numa node of the thread that
+    allocates them. The memory of the pool is kept until the process exits.
+
+    Args:
+        enable (bool): Whether to allocate the data of the tensors from the pool.
+
+    Raises:
+        TypeError: If enable is not a boolean data type.
+
+    Examples:
+        >>> ds.config.set_enable_tensor_pool(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_tensor_pool(enable)
+
 def set_sending_batches(batch_num):
     """
     Set the default sending batches when training with sink_mode=True in Ascend device.
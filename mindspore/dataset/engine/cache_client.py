@@ -19,7 +19,7 @@ import copy
 from mindspore._c_dataengine import CacheClient
 
 from ..core.validator_helpers import type_check, check_pos_int32, check_pos_uint32, check_uint64, check_positive, \
-    check_value
+    check_value, check_valid_str
 
 
 class DatasetCache:
@@ -39,6 +39,18 @@ class DatasetCache:
         num_connections (int, optional): Number of tcp/ip connections (default=None, use default value 12).
         prefetch_size (int, optional): The size of the cache queue between operations
             (default=None, use default value 20).
+        compress (bool, optional): Whether or not the server keeps the rows compressed in memory and on disk, they
+            are decompressed by the pipeline after fetching (default=False). It is worth it for rows like decoded
+            images, which take several times less memory once compressed.
+        eviction (str, optional): The policy to evict the cold rows from the server memory once it is full, 'lru' or
+            'clock' (default=None, the new rows are not cached once the memory is full). The evicted rows are moved to
+            the spill path if spilling is on. The spill path itself has no eviction: its rows stay until the session
+            is destroyed, and once it is full the evicted rows are dropped. The caches with an eviction policy share
+            the memory of the server, and it only applies to mappable datasets, which fetch the rows missing from the
+            cache again.
+        frequency_admission (bool, optional): Whether or not a new row is only cached in a full memory if it is
+            accessed more often than the row it would evict, so that a scan of a dataset larger than the memory
+            doesn't flush the cache (default=False). It requires an eviction policy.
 
     Examples:
             >>> import mindspore.dataset as ds
@@ -51,13 +63,17 @@ class DatasetCache:
     """
 
     def __init__(self, session_id, size=0, spilling=False, hostname=None, port=None, num_connections=None,
-                 prefetch_size=None):
+                 prefetch_size=None, compress=False, eviction=None, frequency_admission=False):
         check_pos_uint32(session_id, "session_id")
         type_check(size, (int,), "size")
         if size != 0:
             check_positive(size, "size")
             check_uint64(size, "size")
         type_check(spilling, (bool,), "spilling")
+        type_check(compress, (bool,), "compress")
+        if eviction is not None:
+            check_valid_str(eviction, ["lru", "clock"], "eviction")
+        type_check(frequency_admission, (bool,), "frequency_admission")
         if hostname is not None:
             type_check(hostname, (str,), "hostname")
         if port is not None:
@@ -75,7 +91,11 @@ class DatasetCache:
         self.port = port
         self.prefetch_size = prefetch_size
         self.num_connections = num_connections
-        self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size)
+        self.compress = compress
+        self.eviction = eviction
+        self.frequency_admission = frequency_admission
+        self.cache_client = CacheClient(session_id, size, spilling, hostname, port, num_connections, prefetch_size,
+                                        compress, eviction, frequency_admission)
 
     def get_stat(self):
         """Get the statistics from a cache."""
@@ -94,5 +114,8 @@ class DatasetCache:
         new_cache.port = copy.deepcopy(self.port, memodict)
         new_cache.prefetch_size = copy.deepcopy(self.prefetch_size, memodict)
         new_cache.num_connections = copy.deepcopy(self.num_connections, memodict)
+        new_cache.compress = copy.deepcopy(self.compress, memodict)
+        new_cache.eviction = copy.deepcopy(self.eviction, memodict)
+        new_cache.frequency_admission = copy.deepcopy(self.frequency_admission, memodict)
         new_cache.cache_client = self.cache_client
         return new_cache
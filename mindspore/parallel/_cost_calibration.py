@@ -0,0 +1,232 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""
+Calibration of the auto-parallel cost model.
+
+The strategy searching records the operators which are not in the cost table set by `costmodel_calibration_file`
+to `costmodel_calibration_file + ".missing"`. This tool runs microbenchmarks of those operators on the local host, and
+merges the measured timings into the cost table, which is used in place of the analytic cost model by the next
+compilation. The collectives are measured by a group of local processes exchanging the same number of bytes through
+shared memory, standing in for the devices of a stage.
+"""
+import argparse
+import json
+import os
+import time
+from multiprocessing import Barrier, Process, shared_memory
+
+import numpy as np
+
+from mindspore import context, nn, Tensor
+from mindspore import log as logger
+from mindspore.ops import operations as P
+from mindspore.ops import composite as C
+
+_COST_TABLE_VERSION = 1
+_MISSING_SUFFIX = ".missing"
+_ITEM_KEYS = ("op_type", "inputs_shape", "inputs_slice_shape", "outputs_slice_shape", "stage_device_num")
+
+
+class _GradAll(nn.Cell):
+    """Calculate the gradients of all the inputs of the operator."""
+
+    def __init__(self, network):
+        super(_GradAll, self).__init__()
+        self.network = network
+        self.grad = C.GradOperation(get_all=True)
+
+    def construct(self, *inputs):
+        return self.grad(self.network)(*inputs)
+
+
+class _SingleOp(nn.Cell):
+    """Wrap a primitive as a cell."""
+
+    def __init__(self, primitive):
+        super(_SingleOp, self).__init__()
+        self.primitive = primitive
+
+    def construct(self, *inputs):
+        return self.primitive(*inputs)
+
+
+def _median_time_us(func, repeat, warmup):
+    """Return the median time (us) of calling func."""
+    for _ in range(warmup):
+        func()
+    costs = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        costs.append((time.perf_counter() - start) * 1e6)
+    return float(np.median(costs))
+
+
+def _measure_bytes_per_us(repeat, warmup):
+    """Measure the memory bandwidth, which converts the timings into the bytes unit of the analytic cost model."""
+    size = 64 * 1024 * 1024
+    src = np.ones(size, dtype=np.uint8)
+    dst = np.empty_like(src)
+    cost = _median_time_us(lambda: np.copyto(dst, src), repeat, warmup)
+    return size / max(cost, 1e-3)
+
+
+def _measure_computation(item, repeat, warmup):
+    """Measure the forward and backward time of an operator with the sliced inputs, None if it can not be run."""
+    op_type = item["op_type"]
+    if not hasattr(P, op_type):
+        logger.info("Operator %s is not in mindspore.ops.operations, skip it.", op_type)
+        return None, None
+    try:
+        network = _SingleOp(getattr(P, op_type)())
+        inputs = [Tensor(np.random.uniform(-1.0, 1.0, size=shape).astype(np.float32))
+                  for shape in item["inputs_slice_shape"]]
+        forward = _median_time_us(lambda: network(*inputs), repeat, warmup)
+    except (TypeError, ValueError, RuntimeError) as e:
+        logger.info("Operator %s can not be profiled with default attributes: %s", op_type, str(e))
+        return None, None
+    try:
+        grad_network = _GradAll(network)
+        backward = _median_time_us(lambda: grad_network(*inputs), repeat, warmup)
+    except (TypeError, ValueError, RuntimeError) as e:
+        logger.info("The gradient of operator %s can not be profiled: %s", op_type, str(e))
+        backward = None
+    return forward, backward
+
+
+def _ring_all_reduce(rank, group_size, name, num, barrier, repeat, result_name):
+    """Ring all-reduce through shared memory, run by each stand-in process."""
+    buffers = shared_memory.SharedMemory(name=name)
+    data = np.ndarray((group_size, num), dtype=np.float32, buffer=buffers.buf)
+    chunks = np.array_split(np.arange(num), group_size)
+    barrier.wait()
+    start = time.perf_counter()
+    for _ in range(repeat):
+        # reduce-scatter, followed by all-gather, in 2 * (group_size - 1) steps
+        for step in range(group_size - 1):
+            chunk = chunks[(rank - step - 1) % group_size]
+            data[rank, chunk] += data[(rank - 1) % group_size, chunk]
+            barrier.wait()
+        for step in range(group_size - 1):
+            chunk = chunks[(rank - step) % group_size]
+            data[rank, chunk] = data[(rank - 1) % group_size, chunk]
+            barrier.wait()
+    cost = (time.perf_counter() - start) * 1e6 / repeat
+    if rank == 0:
+        result = shared_memory.SharedMemory(name=result_name)
+        np.ndarray((1,), dtype=np.float64, buffer=result.buf)[0] = cost
+        result.close()
+    buffers.close()
+
+
+def _measure_communication(num_bytes, group_size, repeat):
+    """Measure the time (us) of exchanging num_bytes among group_size local processes."""
+    if num_bytes <= 0:
+        return 0.0
+    if group_size <= 1:
+        return _median_time_us(lambda: np.empty(int(num_bytes), dtype=np.uint8).fill(0), repeat, 1)
+    num = max(int(num_bytes) // 4, group_size)
+    buffers = shared_memory.SharedMemory(create=True, size=group_size * num * 4)
+    result = shared_memory.SharedMemory(create=True, size=8)
+    try:
+        np.ndarray((group_size, num), dtype=np.float32, buffer=buffers.buf).fill(1.0)
+        barrier = Barrier(group_size)
+        processes = [Process(target=_ring_all_reduce,
+                             args=(rank, group_size, buffers.name, num, barrier, repeat, result.name))
+                     for rank in range(group_size)]
+        for process in processes:
+            process.start()
+        for process in processes:
+            process.join()
+        return float(np.ndarray((1,), dtype=np.float64, buffer=result.buf)[0])
+    finally:
+        buffers.close()
+        buffers.unlink()
+        result.close()
+        result.unlink()
+
+
+def _item_key(item):
+    return json.dumps([item[key] for key in _ITEM_KEYS])
+
+
+def calibrate(calibration_file, repeat=20, warmup=3, max_stand_in_processes=8):
+    """
+    Profile the operators recorded in `calibration_file + ".missing"`, and merge them into the cost table.
+
+    Args:
+        calibration_file (str): The cost table set by `costmodel_calibration_file` in the cost model context.
+        repeat (int): The number of measured runs of each benchmark. Default: 20.
+        warmup (int): The number of warm-up runs of each benchmark. Default: 3.
+        max_stand_in_processes (int): The maximum number of local processes standing in for the devices of a stage
+            when measuring the collectives. Default: 8.
+
+    Returns:
+        int, the number of the operators added into the cost table.
+    """
+    missing_file = calibration_file + _MISSING_SUFFIX
+    if not os.path.exists(missing_file):
+        logger.warning("There is no uncalibrated operator recorded in %s.", missing_file)
+        return 0
+    with open(missing_file, "r") as f:
+        missing = json.load(f)
+
+    table = {"version": _COST_TABLE_VERSION, "items": []}
+    if os.path.exists(calibration_file):
+        with open(calibration_file, "r") as f:
+            table = json.load(f)
+        if table.get("version") != _COST_TABLE_VERSION:
+            raise ValueError("The version of cost table {} is not {}.".format(calibration_file, _COST_TABLE_VERSION))
+    context.set_context(mode=context.PYNATIVE_MODE)
+    table["bytes_per_us"] = _measure_bytes_per_us(repeat, warmup)
+
+    items = {_item_key(item): item for item in table["items"]}
+    communication_costs = {}
+    for item in missing["items"]:
+        key = _item_key(item)
+        if key in items:
+            continue
+        forward, backward = _measure_computation(item, repeat, warmup)
+        group_size = min(int(item["stage_device_num"]), max_stand_in_processes)
+        measured = {name: item[name] for name in _ITEM_KEYS}
+        measured["forward_computation"] = -1.0 if forward is None else forward
+        measured["backward_computation"] = -1.0 if backward is None else backward
+        # The analytic communication costs recorded by the strategy searching are the numbers of bytes to exchange.
+        for name in ("forward_communication", "backward_communication"):
+            comm_key = (item[name], group_size)
+            if comm_key not in communication_costs:
+                communication_costs[comm_key] = _measure_communication(item[name], group_size, repeat)
+            measured[name] = communication_costs[comm_key]
+        items[key] = measured
+        logger.info("Calibrated %s: %s", item["op_type"], str(measured))
+
+    added = len(items) - len(table["items"])
+    table["items"] = list(items.values())
+    with open(calibration_file, "w") as f:
+        json.dump(table, f, indent=2)
+    os.remove(missing_file)
+    return added
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Calibrate the auto-parallel cost model on the local host.")
+    parser.add_argument("calibration_file", type=str, help="the cost table set by costmodel_calibration_file")
+    parser.add_argument("--repeat", type=int, default=20, help="the number of measured runs of each benchmark")
+    parser.add_argument("--warmup", type=int, default=3, help="the number of warm-up runs of each benchmark")
+    parser.add_argument("--max_stand_in_processes", type=int, default=8,
+                        help="the maximum number of local processes standing in for the devices of a stage")
+    args = parser.parse_args()
+    print("Added {} operators into {}.".format(
+        calibrate(args.calibration_file, args.repeat, args.warmup, args.max_stand_in_processes), args.calibration_file))
@@ -0,0 +1,89 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import os
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import composite as C
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class ConvMatMul(nn.Cell):
+    def __init__(self):
+        super(ConvMatMul, self).__init__()
+        self.conv = P.Conv2D(16, 3, pad_mode="same")
+        self.reshape = P.Reshape()
+        self.matmul = P.MatMul(transpose_b=True)
+
+    def construct(self, x, w, fc):
+        y = self.conv(x, w)
+        return self.matmul(self.reshape(y, (y.shape[0], -1)), fc)
+
+
+class Grad(nn.Cell):
+    def __init__(self, network):
+        super(Grad, self).__init__()
+        self.grad = C.GradOperation(get_all=True, sens_param=True)
+        self.network = network
+
+    def construct(self, x, w, fc, sens):
+        return self.grad(self.network)(x, w, fc, sens)
+
+
+def cpu_supports_bf16():
+    # oneDNN runs bfloat16 on AVX-512 and later, the other cpus fall back to float32.
+    if not os.path.exists('/proc/cpuinfo'):
+        return False
+    with open('/proc/cpuinfo') as cpuinfo:
+        flags = cpuinfo.read()
+    return all(flag in flags for flag in ('avx512f', 'avx512bw', 'avx512vl', 'avx512dq'))
+
+
+def run_net(inputs, bf16):
+    os.environ['ENV_CPU_BF16_COMPUTE'] = '1' if bf16 else '0'
+    try:
+        net = ConvMatMul()
+        forward = net(*inputs[:-1]).asnumpy()
+        grads = [grad.asnumpy() for grad in Grad(net)(*inputs)]
+        return [forward] + grads
+    finally:
+        os.environ.pop('ENV_CPU_BF16_COMPUTE')
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_bf16_compute():
+    np.random.seed(1)
+    x = np.random.randn(4, 8, 8, 8).astype(np.float32)
+    w = np.random.randn(16, 8, 3, 3).astype(np.float32)
+    fc = np.random.randn(10, 16 * 8 * 8).astype(np.float32)
+    sens = np.random.randn(4, 10).astype(np.float32)
+    inputs = [Tensor(x), Tensor(w), Tensor(fc), Tensor(sens)]
+    expects = run_net(inputs, False)
+    outputs = run_net(inputs, True)
+    # The forward output and the grads of x, w and fc. The bfloat16 inputs keep 8 bits of mantissa and the products
+    # are accumulated in float32, the float32 fallback only differs in the order of the sums.
+    tolerance = 2e-2 if cpu_supports_bf16() else 1e-5
+    assert len(outputs) == len(expects)
+    for output, expect in zip(outputs, expects):
+        assert output.shape == expect.shape
+        assert np.max(np.abs(output - expect)) <= tolerance * np.max(np.abs(expect))
@@ -0,0 +1,75 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import os
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.common.parameter import Parameter
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class ConvBnReluPool(nn.Cell):
+    def __init__(self, weight1, weight2):
+        super(ConvBnReluPool, self).__init__()
+        out_channel = 16
+        self.conv1 = P.Conv2D(out_channel, 3, pad_mode="same")
+        self.conv2 = P.Conv2D(out_channel, 3, pad_mode="same")
+        self.w1 = Parameter(Tensor(weight1), name='w1')
+        self.w2 = Parameter(Tensor(weight2), name='w2')
+        self.bn1 = nn.BatchNorm2d(out_channel)
+        self.bn2 = nn.BatchNorm2d(out_channel)
+        self.relu = P.ReLU()
+        self.pool = P.MaxPool(kernel_size=2, strides=2)
+        self.reduce_mean = P.ReduceMean()
+
+    def construct(self, x):
+        # Only the end of this chain is read outside of it, so all its inner edges are blocked.
+        out1 = self.pool(self.relu(self.bn1(self.conv1(x, self.w1))))
+        # The conv output is also read by ReduceMean, which is not a oneDNN kernel, and the relu output is a graph
+        # output, so both edges stay in the default layout.
+        y = self.conv2(x, self.w2)
+        z = self.relu(self.bn2(y))
+        return out1, z, self.reduce_mean(y, (2, 3)), self.pool(z)
+
+
+def run_net(x, weight1, weight2, blocked):
+    os.environ['ENV_MKL_BLOCKED_FORMAT'] = '1' if blocked else '0'
+    try:
+        net = ConvBnReluPool(weight1, weight2)
+        return [output.asnumpy() for output in net(Tensor(x))]
+    finally:
+        os.environ.pop('ENV_MKL_BLOCKED_FORMAT')
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_blocked_format_chain():
+    np.random.seed(1)
+    x = np.random.randn(2, 8, 16, 16).astype(np.float32)
+    weight1 = np.random.randn(16, 8, 3, 3).astype(np.float32)
+    weight2 = np.random.randn(16, 8, 3, 3).astype(np.float32)
+    expects = run_net(x, weight1, weight2, False)
+    outputs = run_net(x, weight1, weight2, True)
+    assert len(outputs) == len(expects)
+    for output, expect in zip(outputs, expects):
+        assert output.shape == expect.shape
+        assert np.allclose(output, expect, rtol=1e-4, atol=1e-4)
@@ -380,3 +380,56 @@ TEST_F(MindDataTestBatchOp, TestSimpleBatchPadding) {
     EXPECT_TRUE(rc.IsOk());
   }
 }
+
+TEST_F(MindDataTestBatchOp, TestBatchOfSlots) {
+  std::shared_ptr<Tensor> batch;
+  ASSERT_OK(Tensor::CreateEmpty(TensorShape({3, 2}), DataType(DataType::DE_INT32), &batch));
+  TensorQTable rows;
+  for (int32_t i = 0; i < 3; i++) {
+    std::shared_ptr<Tensor> row;
+    ASSERT_OK(Tensor::CreateFromVector(std::vector<int32_t>{i, i * 10}, &row));
+    ASSERT_OK(batch->InsertTensor({i}, row));
+    std::shared_ptr<Tensor> slot;
+    ASSERT_OK(Tensor::CreateFromBatchSlot(batch, i, &slot));
+    ASSERT_EQ(slot->shape(), TensorShape({2}));
+    ASSERT_EQ(slot->BatchOfSlot(), batch);
+    int32_t v;
+    ASSERT_OK(slot->GetItemAt<int32_t>(&v, {1}));
+    ASSERT_EQ(v, i * 10);
+    rows.push_back(TensorRow(0, {slot}));
+  }
+  // The slots hold the batch, which the batching takes as it is
+  std::shared_ptr<Tensor> batched;
+  ASSERT_TRUE(BatchOp::IsBatchOfSlots(rows, 0, &batched));
+  ASSERT_EQ(batched, batch);
+  std::swap(rows[0], rows[1]);
+  ASSERT_FALSE(BatchOp::IsBatchOfSlots(rows, 0, &batched));
+  rows.pop_back();
+  std::swap(rows[0], rows[1]);
+  ASSERT_FALSE(BatchOp::IsBatchOfSlots(rows, 0, &batched));
+}
+
+TEST_F(MindDataTestBatchOp, TestCreateEmptyInSlot) {
+  std::shared_ptr<Tensor> int_batch;
+  std::shared_ptr<Tensor> float_batch;
+  ASSERT_OK(Tensor::CreateEmpty(TensorShape({2, 2}), DataType(DataType::DE_INT32), &int_batch));
+  ASSERT_OK(Tensor::CreateEmpty(TensorShape({2, 3}), DataType(DataType::DE_FLOAT32), &float_batch));
+  Tensor::BatchSlots slots = {{int_batch, 1}, {float_batch, 0}};
+  // The tensor takes the slot of its shape and type, each slot is taken once
+  std::shared_ptr<Tensor> t;
+  ASSERT_OK(Tensor::CreateEmptyInSlot(TensorShape({3}), DataType(DataType::DE_FLOAT32), &slots, &t));
+  ASSERT_EQ(t->BatchOfSlot(), float_batch);
+  ASSERT_EQ(t->GetBuffer(), float_batch->GetBuffer());
+  ASSERT_EQ(slots[1].first, nullptr);
+  ASSERT_OK(Tensor::CreateEmptyInSlot(TensorShape({3}), DataType(DataType::DE_FLOAT32), &slots, &t));
+  ASSERT_EQ(t->BatchOfSlot(), nullptr);
+  ASSERT_EQ(t->shape(), TensorShape({3}));
+  ASSERT_OK(Tensor::CreateEmptyInSlot(TensorShape({3}), DataType(DataType::DE_INT32), &slots, &t));
+  ASSERT_EQ(t->BatchOfSlot(), nullptr);
+  ASSERT_OK(Tensor::CreateEmptyInSlot(TensorShape({2}), DataType(DataType::DE_INT32), nullptr, &t));
+  ASSERT_EQ(t->BatchOfSlot(), nullptr);
+  ASSERT_OK(Tensor::CreateEmptyInSlot(TensorShape({2}), DataType(DataType::DE_INT32), &slots, &t));
+  ASSERT_EQ(t->BatchOfSlot(), int_batch);
+  ASSERT_EQ(t->GetBuffer(), int_batch->GetBuffer() + 2 * sizeof(int32_t));
+  ASSERT_EQ(slots[0].first, nullptr);
+}
@@ -13,15 +13,26 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
 #include <string>
+#include <thread>
+#include <vector>
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
+#include "minddata/dataset/engine/cache/cache_compress.h"
+#include "minddata/dataset/engine/cache/cache_policy.h"
+#include "minddata/dataset/engine/cache/cache_pool.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/cache_op.h"
 #include "minddata/dataset/engine/datasetops/cache_lookup_op.h"
 #include "minddata/dataset/engine/datasetops/cache_merge_op.h"
 #include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
+#include "minddata/dataset/engine/ir/cache/pre_built_dataset_cache.h"
+#include "minddata/dataset/include/dataset/datasets.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
@@ -537,3 +548,324 @@ TEST_F(MindDataTestCacheOp, DISABLED_TestImageFolderCacheMerge) {
   rc = myClient->DestroyCache();
   ASSERT_TRUE(rc.IsOk());
 }
+
+TEST_F(MindDataTestCacheOp, TestCacheRowCompression) {
+  // A row in two pieces, the header and a decoded image with large flat areas.
+  std::string header(64, 'h');
+  std::vector<uint8_t> image(64 * 64 * 3);
+  for (size_t i = 0; i < image.size(); ++i) {
+    image[i] = static_cast<uint8_t>((i / 192) * 4);
+  }
+  std::vector<ReadableSlice> buf = {ReadableSlice(header.data(), header.size()),
+                                    ReadableSlice(image.data(), image.size())};
+  std::string compressed;
+  ASSERT_TRUE(CompressRow(buf, &compressed));
+  EXPECT_LT(compressed.size(), image.size() / 4);
+  // The fetched rows are padded.
+  compressed.append(100, '\0');
+  ReadableSlice row(compressed.data(), compressed.size());
+  ASSERT_TRUE(IsCompressedRow(row));
+  std::vector<char> restored;
+  Status rc = DecompressRow(row, &restored);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(restored.size(), header.size() + image.size());
+  EXPECT_EQ(std::string(restored.data(), header.size()), header);
+  EXPECT_EQ(memcmp(restored.data() + header.size(), image.data(), image.size()), 0);
+
+  // A corrupted row is an error rather than a crash.
+  compressed[sizeof(CompressedRowHeader) + 1] ^= 0x7f;
+  compressed.resize(compressed.size() - 150);
+  rc = DecompressRow(ReadableSlice(compressed.data(), compressed.size()), &restored);
+  EXPECT_TRUE(rc.IsError());
+
+  // Random bytes don't compress and are cached as they are.
+  std::mt19937 gen(1);
+  std::vector<uint8_t> noise(4096);
+  for (auto &b : noise) {
+    b = static_cast<uint8_t>(gen());
+  }
+  EXPECT_FALSE(CompressRow({ReadableSlice(noise.data(), noise.size())}, &compressed));
+  EXPECT_FALSE(IsCompressedRow(ReadableSlice(header.data(), header.size())));
+
+  // A row larger than the buffer kept by the thread, followed by a small one again.
+  std::vector<uint8_t> large(8 * 1024 * 1024, 7);
+  buf = {ReadableSlice(header.data(), header.size()), ReadableSlice(large.data(), large.size())};
+  ASSERT_TRUE(CompressRow(buf, &compressed));
+  rc = DecompressRow(ReadableSlice(compressed.data(), compressed.size()), &restored);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(restored.size(), header.size() + large.size());
+  EXPECT_EQ(memcmp(restored.data() + header.size(), large.data(), large.size()), 0);
+  buf = {ReadableSlice(header.data(), header.size()), ReadableSlice(image.data(), image.size())};
+  ASSERT_TRUE(CompressRow(buf, &compressed));
+  rc = DecompressRow(ReadableSlice(compressed.data(), compressed.size()), &restored);
+  ASSERT_TRUE(rc.IsOk());
+  EXPECT_EQ(memcmp(restored.data() + header.size(), image.data(), image.size()), 0);
+}
+
+TEST_F(MindDataTestCacheOp, TestCacheCompressSetting) {
+  // The setting is carried by the cache of the C++ API and by the one built from a python CacheClient.
+  std::shared_ptr<DatasetCache> cache = CreateDatasetCache(1, 0, false, std::nullopt, std::nullopt, std::nullopt,
+                                                           std::nullopt, true);
+  ASSERT_NE(cache, nullptr);
+  nlohmann::json args;
+  ASSERT_OK(cache->to_json(&args));
+  EXPECT_EQ(args["compress"], true);
+
+  std::shared_ptr<CacheClient> client;
+  ASSERT_OK(CacheClient::Builder().SetSessionId(1).SetCompress(true).Build(&client));
+  auto pre_built = std::make_shared<PreBuiltDatasetCache>(client);
+  ASSERT_OK(pre_built->to_json(&args));
+  EXPECT_EQ(args["compress"], true);
+}
+
+TEST_F(MindDataTestCacheOp, TestCacheEvictionPolicy) {
+  int64_t victim = -1;
+  // LRU evicts the row fetched the longest time ago.
+  auto lru = CacheEvictionPolicy::Create(CacheEvictionType::kLru);
+  ASSERT_NE(lru, nullptr);
+  EXPECT_FALSE(lru->Victim(&victim));
+  for (int64_t key = 0; key < 4; ++key) {
+    lru->Add(key);
+  }
+  lru->Touch(0);
+  ASSERT_TRUE(lru->Victim(&victim));
+  EXPECT_EQ(victim, 1);
+  lru->Remove(1);
+  ASSERT_TRUE(lru->Victim(&victim));
+  EXPECT_EQ(victim, 2);
+
+  // CLOCK gives the fetched rows a second chance.
+  auto clock = CacheEvictionPolicy::Create(CacheEvictionType::kClock);
+  ASSERT_NE(clock, nullptr);
+  for (int64_t key = 0; key < 4; ++key) {
+    clock->Add(key);
+  }
+  clock->Touch(0);
+  clock->Touch(1);
+  ASSERT_TRUE(clock->Victim(&victim));
+  EXPECT_EQ(victim, 2);
+  clock->Remove(2);
+  ASSERT_TRUE(clock->Victim(&victim));
+  EXPECT_EQ(victim, 3);
+  clock->Remove(3);
+  ASSERT_TRUE(clock->Victim(&victim));
+  EXPECT_EQ(victim, 0);
+  EXPECT_EQ(CacheEvictionPolicy::Create(CacheEvictionType::kNone), nullptr);
+
+  // The sketch tells the hot rows from the cold ones.
+  FrequencySketch sketch;
+  for (int i = 0; i < 5; ++i) {
+    sketch.Increment(7);
+  }
+  sketch.Increment(8);
+  EXPECT_GE(sketch.Estimate(7), 5);
+  EXPECT_GT(sketch.Estimate(7), sketch.Estimate(8));
+  EXPECT_EQ(sketch.Estimate(9), 0);
+}
+
+namespace {
+constexpr size_t kPoolRowSize = 1024;
+
+// A pool with LRU eviction. Without a spill path the evicted rows are dropped. The NUMA placement of the rows needs a
+// running cache server, the pool tests only run without it.
+Status CreateEvictingPool(uint64_t quota, std::shared_ptr<CachePool> *out, const std::string &spill_root = "") {
+  constexpr float kMemoryCapRatio = 0.8;
+  auto mp = std::make_shared<NumaMemoryPool>(std::make_shared<CacheServerHW>(), kMemoryCapRatio);
+  auto pool = std::make_shared<CachePool>(mp, spill_root, false, CacheEvictionType::kLru, false);
+  RETURN_IF_NOT_OK(pool->ServiceStart());
+  pool->SetMemoryQuota(quota);
+  *out = std::move(pool);
+  return Status::OK();
+}
+
+Status InsertPoolRow(CachePool *pool, CachePool::key_type key) {
+  std::vector<char> row(kPoolRowSize, static_cast<char>(key));
+  return pool->Insert(key, {ReadableSlice(row.data(), row.size())});
+}
+
+// Wait for the prefetchers of the pool to read 'num_rows' rows ahead.
+bool WaitPrefetched(const CachePool &pool, int64_t num_rows) {
+  constexpr int kMaxWaitMs = 5000;
+  for (int ms = 0; ms < kMaxWaitMs; ms += 10) {
+    if (pool.GetStat().num_prefetched >= num_rows) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+void ExpectPoolRow(CachePool *pool, CachePool::key_type key) {
+  std::vector<char> row(kPoolRowSize);
+  WritableSlice dest(row.data(), row.size());
+  size_t bytes_read = 0;
+  ASSERT_OK(pool->Read(key, &dest, &bytes_read));
+  ASSERT_EQ(bytes_read, kPoolRowSize);
+  EXPECT_EQ(row[0], static_cast<char>(key));
+  EXPECT_EQ(row[kPoolRowSize - 1], static_cast<char>(key));
+}
+}  // namespace
+
+TEST_F(MindDataTestCacheOp, TestCachePoolEviction) {
+  if (CacheServerHW::numa_enabled()) {
+    return;
+  }
+  std::shared_ptr<CachePool> pool;
+  ASSERT_OK(CreateEvictingPool(4 * kPoolRowSize, &pool));
+  for (CachePool::key_type key = 0; key < 6; ++key) {
+    ASSERT_OK(InsertPoolRow(pool.get(), key));
+    EXPECT_LE(pool->GetMemoryInUse(), 4 * kPoolRowSize);
+  }
+  // The two oldest rows are dropped and read as nothing, the others are intact.
+  std::vector<char> row(kPoolRowSize);
+  WritableSlice dest(row.data(), row.size());
+  size_t bytes_read = 1;
+  ASSERT_OK(pool->Read(0, &dest, &bytes_read));
+  EXPECT_EQ(bytes_read, 0);
+  ASSERT_OK(pool->Read(5, &dest, &bytes_read));
+  EXPECT_EQ(bytes_read, kPoolRowSize);
+  EXPECT_EQ(row[kPoolRowSize - 1], 5);
+  auto stat = pool->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, 4);
+  EXPECT_EQ(stat.num_evicted, 2);
+
+  // A dropped row can be cached again, a cached row is still a duplicate.
+  ASSERT_OK(InsertPoolRow(pool.get(), 0));
+  ASSERT_OK(pool->Read(0, &dest, &bytes_read));
+  EXPECT_EQ(bytes_read, kPoolRowSize);
+  EXPECT_EQ(row[0], 0);
+  EXPECT_EQ(InsertPoolRow(pool.get(), 5), StatusCode::kMDDuplicateKey);
+  EXPECT_LE(pool->GetMemoryInUse(), 4 * kPoolRowSize);
+
+  // A lower quota is only applied by the next eviction.
+  pool->SetMemoryQuota(2 * kPoolRowSize);
+  EXPECT_EQ(pool->GetMemoryInUse(), 4 * kPoolRowSize);
+  ASSERT_OK(pool->EvictOverQuota());
+  EXPECT_EQ(pool->GetMemoryInUse(), 2 * kPoolRowSize);
+  ASSERT_OK(pool->ServiceStop());
+}
+
+TEST_F(MindDataTestCacheOp, TestCachePoolFetchEvictedRow) {
+  if (CacheServerHW::numa_enabled()) {
+    return;
+  }
+  std::shared_ptr<CachePool> pool;
+  ASSERT_OK(CreateEvictingPool(kPoolRowSize, &pool));
+  ASSERT_OK(InsertPoolRow(pool.get(), 1));
+  std::vector<char> reply(kPoolRowSize);
+  WritableSlice dest(reply.data(), reply.size());
+  ASSERT_OK(pool->FetchRow(1, &dest));
+  EXPECT_FALSE(IsEvictedRow(reply.data(), reply.size()));
+  EXPECT_EQ(reply[0], 1);
+
+  // The row is evicted between the plan of a fetch and its copy, the reply tells the client it is a miss.
+  ASSERT_OK(InsertPoolRow(pool.get(), 2));
+  ASSERT_OK(pool->FetchRow(1, &dest));
+  EXPECT_TRUE(IsEvictedRow(reply.data(), reply.size()));
+  ASSERT_OK(pool->ServiceStop());
+}
+
+TEST_F(MindDataTestCacheOp, TestCachePoolConcurrentInsert) {
+  if (CacheServerHW::numa_enabled()) {
+    return;
+  }
+  constexpr size_t kQuotaRows = 16;
+  constexpr int kNumThreads = 8;
+  constexpr int kRowsPerThread = 200;
+  std::shared_ptr<CachePool> pool;
+  ASSERT_OK(CreateEvictingPool(kQuotaRows * kPoolRowSize, &pool));
+  std::vector<Status> rcs(kNumThreads);
+  std::vector<uint64_t> max_in_use(kNumThreads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kRowsPerThread && rcs[t].IsOk(); ++i) {
+        rcs[t] = InsertPoolRow(pool.get(), t * kRowsPerThread + i);
+        max_in_use[t] = std::max<uint64_t>(max_in_use[t], pool->GetMemoryInUse());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  // The room of a row is reserved before it is allocated, the inserts together never go beyond the quota.
+  for (int t = 0; t < kNumThreads; ++t) {
+    EXPECT_OK(rcs[t]);
+    EXPECT_LE(max_in_use[t], kQuotaRows * kPoolRowSize);
+  }
+  auto stat = pool->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, kQuotaRows);
+  EXPECT_EQ(stat.num_evicted, kNumThreads * kRowsPerThread - kQuotaRows);
+  ASSERT_OK(pool->ServiceStop());
+}
+
+// With no memory quota every row is spilled to disk, and the rows which are hinted are read ahead.
+TEST_F(MindDataTestCacheOp, TestCachePoolPrefetchHit) {
+  if (CacheServerHW::numa_enabled()) {
+    return;
+  }
+  constexpr int kNumRows = 10;
+  std::shared_ptr<CachePool> pool;
+  ASSERT_OK(CreateEvictingPool(0, &pool, "/tmp"));
+  std::vector<CachePool::key_type> keys;
+  for (CachePool::key_type key = 0; key < kNumRows; ++key) {
+    ASSERT_OK(InsertPoolRow(pool.get(), key));
+    keys.push_back(key);
+  }
+  EXPECT_EQ(pool->GetStat().num_disk_cached, kNumRows);
+  ASSERT_OK(pool->Prefetch(keys));
+  ASSERT_TRUE(WaitPrefetched(*pool, kNumRows));
+  for (auto key : keys) {
+    ExpectPoolRow(pool.get(), key);
+  }
+  EXPECT_EQ(pool->GetStat().num_prefetch_hit, kNumRows);
+  // A staged row is taken by its read, the next read goes to disk.
+  ExpectPoolRow(pool.get(), 0);
+  EXPECT_EQ(pool->GetStat().num_prefetch_hit, kNumRows);
+  ASSERT_OK(pool->ServiceStop());
+}
+
+// A staged row which is not read within 1024 hints is dropped, the rows of the recent hints are kept.
+TEST_F(MindDataTestCacheOp, TestCachePoolPrefetchStaleRow) {
+  if (CacheServerHW::numa_enabled()) {
+    return;
+  }
+  constexpr int kMaxHintAge = 1024;
+  std::shared_ptr<CachePool> pool;
+  ASSERT_OK(CreateEvictingPool(0, &pool, "/tmp"));
+  ASSERT_OK(InsertPoolRow(pool.get(), 1));
+  ASSERT_OK(InsertPoolRow(pool.get(), 2));
+  ASSERT_OK(pool->Prefetch({1}));
+  ASSERT_OK(pool->Prefetch({2}));
+  ASSERT_TRUE(WaitPrefetched(*pool, 2));
+  // Row 2 is staged already, the hints only age row 1 out.
+  for (int i = 0; i < kMaxHintAge - 1; ++i) {
+    ASSERT_OK(pool->Prefetch({2}));
+  }
+  ExpectPoolRow(pool.get(), 1);
+  EXPECT_EQ(pool->GetStat().num_prefetch_hit, 0);
+  ExpectPoolRow(pool.get(), 2);
+  EXPECT_EQ(pool->GetStat().num_prefetch_hit, 1);
+  ASSERT_OK(pool->ServiceStop());
+}
+
+// The rows which are not hinted, and the rows in memory, are read as before.
+TEST_F(MindDataTestCacheOp, TestCachePoolPrefetchMiss) {
+  if (CacheServerHW::numa_enabled()) {
+    return;
+  }
+  std::shared_ptr<CachePool> pool;
+  ASSERT_OK(CreateEvictingPool(kPoolRowSize, &pool, "/tmp"));
+  // Row 1 is spilled to disk when row 2 takes its room.
+  ASSERT_OK(InsertPoolRow(pool.get(), 1));
+  ASSERT_OK(InsertPoolRow(pool.get(), 2));
+  ExpectPoolRow(pool.get(), 1);
+  ASSERT_OK(pool->Prefetch({2}));
+  ExpectPoolRow(pool.get(), 2);
+  auto stat = pool->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, 1);
+  EXPECT_EQ(stat.num_disk_cached, 1);
+  EXPECT_EQ(stat.num_prefetched, 0);
+  EXPECT_EQ(stat.num_prefetch_hit, 0);
+  ASSERT_OK(pool->ServiceStop());
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <iostream>
+#include <sstream>
 #include <memory>
 #include <vector>
 
@@ -23,6 +24,7 @@
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 #include "minddata/dataset/engine/datasetops/source/csv_op.h"
+#include "minddata/dataset/engine/datasetops/source/csv_scanner.h"
 #include "minddata/dataset/util/status.h"
 
 
@@ -58,3 +60,23 @@ TEST_F(MindDataTestCSVOp, TestTotalRows) {
   ASSERT_EQ(total_rows, 8);
   files.clear();
 }
+
+TEST_F(MindDataTestCSVOp, TestCsvRowCounter) {
+  // The quoted line ends are not row ends, the blank lines are not rows, and the last row has no line end.
+  std::string text = "a,b\r\n\n\"x\ny\",\"\"\"\"\n" + std::string(100, 'c') + ",d\n\n,\"e\r\nf\"\nlast";
+  std::istringstream stream(text);
+  CsvRowCounter counter(2);
+  CsvBlockReader reader(&stream, ',');
+  const char *block = nullptr;
+  size_t size = 0;
+  CsvBlockMasks masks;
+  while (reader.Next(&block, &size, &masks)) {
+    counter.Feed(masks, size);
+  }
+  counter.Finish();
+  ASSERT_EQ(counter.rows(), 5);
+
+  // the rows 0, 2 and 4 begin right after the line ends of the rows before them
+  std::vector<int64_t> expected = {0, static_cast<int64_t>(text.find('c')), static_cast<int64_t>(text.find("last"))};
+  EXPECT_EQ(counter.checkpoints(), expected);
+}
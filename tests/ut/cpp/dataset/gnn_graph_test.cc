@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <string>
 #include <map>
 #include <memory>
@@ -21,10 +23,12 @@
 
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
+#include "minddata/dataset/engine/gnn/local_node.h"
 
 using namespace mindspore::dataset;
 using namespace mindspore::dataset::gnn;
@@ -408,3 +412,121 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+// With a fixed seed, two graphs walk the same paths, while the successive walks of one graph differ.
+TEST_F(MindDataTestGNNGraph, TestRandomWalkSeed) {
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(135);
+  std::string path = "data/mindrecord/testGraphData/sns";
+  std::vector<std::vector<NodeIdType>> walks;
+  for (int i = 0; i < 2; ++i) {
+    GraphDataImpl graph(path, 1);
+    Status s = graph.Init();
+    EXPECT_TRUE(s.IsOk());
+    MetaInfo meta_info;
+    s = graph.GetMetaInfo(&meta_info);
+    EXPECT_TRUE(s.IsOk());
+    std::shared_ptr<Tensor> nodes;
+    s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+    EXPECT_TRUE(s.IsOk());
+    std::vector<NodeIdType> node_list(nodes->begin<NodeIdType>(), nodes->end<NodeIdType>());
+    std::vector<NodeType> meta_path(59, 1);
+    for (int j = 0; j < 2; ++j) {
+      std::shared_ptr<Tensor> walk_path;
+      s = graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &walk_path);
+      EXPECT_TRUE(s.IsOk());
+      walks.emplace_back(walk_path->begin<NodeIdType>(), walk_path->end<NodeIdType>());
+    }
+  }
+  GlobalContext::config_manager()->set_seed(original_seed);
+  EXPECT_EQ(walks[0], walks[2]);
+  EXPECT_EQ(walks[1], walks[3]);
+  EXPECT_NE(walks[0], walks[1]);
+}
+
+TEST_F(MindDataTestGNNGraph, TestLocalNodeNeighborTable) {
+  LocalNode node(1, 0, 1);
+  // The neighbors of two types are added alternately.
+  for (NodeIdType i = 0; i < 5; ++i) {
+    EXPECT_TRUE(node.AddNeighbor(std::make_shared<LocalNode>(100 + i, 1, 1), i + 1).IsOk());
+    EXPECT_TRUE(node.AddNeighbor(std::make_shared<LocalNode>(200 + i, 2, 1), 1).IsOk());
+  }
+  std::vector<NodeIdType> neighbors;
+  EXPECT_FALSE(node.GetAllNeighbors(1, &neighbors).IsOk());
+  EXPECT_TRUE(node.FinalizeNeighbors().IsOk());
+  EXPECT_FALSE(node.AddNeighbor(std::make_shared<LocalNode>(300, 3, 1), 1).IsOk());
+
+  EXPECT_TRUE(node.GetAllNeighbors(1, &neighbors).IsOk());
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({1, 100, 101, 102, 103, 104}));
+  EXPECT_TRUE(node.GetAllNeighbors(2, &neighbors, true).IsOk());
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({200, 201, 202, 203, 204}));
+  EXPECT_TRUE(node.GetAllNeighbors(3, &neighbors, true).IsOk());
+  EXPECT_TRUE(neighbors.empty());
+
+  // Random sampling takes distinct neighbors until all of them are taken.
+  EXPECT_TRUE(node.GetSampledNeighbors(2, 3, SamplingStrategy::kRandom, &neighbors).IsOk());
+  EXPECT_EQ(std::unordered_set<NodeIdType>(neighbors.begin(), neighbors.end()).size(), 3);
+  EXPECT_TRUE(node.GetSampledNeighbors(2, 7, SamplingStrategy::kRandom, &neighbors).IsOk());
+  EXPECT_EQ(std::unordered_set<NodeIdType>(neighbors.begin(), neighbors.end()).size(), 5);
+  EXPECT_TRUE(node.GetSampledNeighbors(3, 2, SamplingStrategy::kRandom, &neighbors).IsOk());
+  EXPECT_EQ(neighbors, std::vector<NodeIdType>({kDefaultNodeId, kDefaultNodeId}));
+
+  NumNeighborsMap number_neighbors;
+  EXPECT_TRUE(node.GetSampledNeighbors(1, 15000, SamplingStrategy::kEdgeWeight, &neighbors).IsOk());
+  for (auto neighbor : neighbors) {
+    number_neighbors[neighbor] += 1;
+  }
+  CheckNeighborsRatio(number_neighbors, {1, 2, 3, 4, 5});
+}
+
+TEST_F(MindDataTestGNNGraph, TestGraphImage) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  std::string image_file = "gnn_graph_test.img";
+  (void)remove(image_file.c_str());
+  setenv(kGnnGraphImageEnv, image_file.c_str(), 1);
+  // The first graph writes the image, and the second one maps it.
+  GraphDataImpl writer(path, 1);
+  EXPECT_TRUE(writer.Init().IsOk());
+  GraphDataImpl reader(path, 1);
+  EXPECT_TRUE(reader.Init().IsOk());
+  unsetenv(kGnnGraphImageEnv);
+
+  MetaInfo writer_info;
+  MetaInfo reader_info;
+  EXPECT_TRUE(writer.GetMetaInfo(&writer_info).IsOk());
+  EXPECT_TRUE(reader.GetMetaInfo(&reader_info).IsOk());
+  EXPECT_EQ(writer_info.node_type, reader_info.node_type);
+  EXPECT_EQ(writer_info.edge_num, reader_info.edge_num);
+  EXPECT_EQ(writer_info.node_feature_type, reader_info.node_feature_type);
+  EXPECT_EQ(writer_info.edge_feature_type, reader_info.edge_feature_type);
+
+  std::shared_ptr<Tensor> writer_nodes;
+  std::shared_ptr<Tensor> reader_nodes;
+  EXPECT_TRUE(writer.GetAllNodes(writer_info.node_type[0], &writer_nodes).IsOk());
+  EXPECT_TRUE(reader.GetAllNodes(reader_info.node_type[0], &reader_nodes).IsOk());
+  EXPECT_EQ(writer_nodes->ToString(), reader_nodes->ToString());
+  std::vector<NodeIdType> node_list(reader_nodes->begin<NodeIdType>(), reader_nodes->end<NodeIdType>());
+
+  std::shared_ptr<Tensor> writer_neighbors;
+  std::shared_ptr<Tensor> reader_neighbors;
+  EXPECT_TRUE(writer.GetAllNeighbors(node_list, writer_info.node_type[1], OutputFormat::kNormal, &writer_neighbors)
+                .IsOk());
+  EXPECT_TRUE(reader.GetAllNeighbors(node_list, reader_info.node_type[1], OutputFormat::kNormal, &reader_neighbors)
+                .IsOk());
+  EXPECT_EQ(writer_neighbors->ToString(), reader_neighbors->ToString());
+
+  TensorRow writer_features;
+  TensorRow reader_features;
+  EXPECT_TRUE(writer.GetNodeFeature(writer_nodes, writer_info.node_feature_type, &writer_features).IsOk());
+  EXPECT_TRUE(reader.GetNodeFeature(reader_nodes, reader_info.node_feature_type, &reader_features).IsOk());
+  ASSERT_EQ(writer_features.size(), reader_features.size());
+  for (size_t i = 0; i < writer_features.size(); ++i) {
+    EXPECT_EQ(writer_features[i]->ToString(), reader_features[i]->ToString());
+  }
+
+  std::shared_ptr<Tensor> edges;
+  EXPECT_TRUE(reader.GetEdgesFromNodes({{101, 201}, {103, 207}, {108, 208}}, &edges).IsOk());
+  EXPECT_EQ(edges->ToString(), "Tensor (shape: <3>, Type: int32)\n[1,9,17]");
+  (void)remove(image_file.c_str());
+  (void)remove((image_file + ".lock").c_str());
+}
@@ -16,9 +16,13 @@
 
 #include "minddata/dataset/engine/tree_adapter.h"
 #include "common/common.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/engine/datasetops/map_op/map_op.h"
 #include "minddata/dataset/include/dataset/datasets.h"
 #include "minddata/dataset/include/dataset/transforms.h"
+#include "minddata/dataset/include/dataset/vision.h"
 
 // IR non-leaf nodes
 #include "minddata/dataset/engine/ir/datasetops/batch_node.h"
@@ -143,3 +147,59 @@ TEST_F(MindDataTestTreeAdapter, TestProjectMapTreeAdapter) {
   const std::string err_msg = rc.ToString();
   EXPECT_TRUE(err_msg.find("EOF buffer encountered.") != err_msg.npos);
 }
+
+namespace {
+// Run a tree and collect its batches. The number of the tensors the map wrote into their batches is also returned.
+Status RunMapBatch(const std::shared_ptr<Dataset> &ds, bool optimize, std::vector<TensorRow> *batches,
+                   int64_t *num_written_in_slot) {
+  TreeAdapter tree_adapter;
+  tree_adapter.SetOptimize(optimize);
+  RETURN_IF_NOT_OK(tree_adapter.Compile(ds->IRNode(), 1));
+  std::shared_ptr<MapOp> map_op;
+  for (auto op = tree_adapter.GetRoot().lock(); op != nullptr && map_op == nullptr; op = op->child(0)) {
+    map_op = std::dynamic_pointer_cast<MapOp>(op);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(map_op != nullptr, "No MapOp in the tree.");
+  TensorRow row;
+  RETURN_IF_NOT_OK(tree_adapter.GetNext(&row));
+  while (!row.empty()) {
+    batches->push_back(row);
+    RETURN_IF_NOT_OK(tree_adapter.GetNext(&row));
+  }
+  *num_written_in_slot = map_op->NumWrittenInSlot();
+  return Status::OK();
+}
+}  // namespace
+
+TEST_F(MindDataTestTreeAdapter, TestMapBatchFusion) {
+  MS_LOG(INFO) << "Doing MindDataTestTreeAdapter-TestMapBatchFusion.";
+  // One worker places the rows in order, so the rows written into their batches are known.
+  auto config = GlobalContext::config_manager();
+  int32_t num_workers = config->num_parallel_workers();
+  ASSERT_OK(config->set_num_parallel_workers(1));
+  std::string folder_path = datasets_root_path_ + "/testMnistData/";
+  std::shared_ptr<Dataset> ds = Mnist(folder_path, "all", std::make_shared<SequentialSampler>(0, 5));
+  ds = ds->Map({std::make_shared<vision::Resize>(std::vector<int32_t>{16, 16})}, {"image"});
+  ds = ds->Batch(2);
+  ASSERT_OK(config->set_num_parallel_workers(num_workers));
+  ASSERT_NE(ds, nullptr);
+
+  std::vector<TensorRow> expected;
+  int64_t num_written_in_slot = 0;
+  ASSERT_OK(RunMapBatch(ds, false, &expected, &num_written_in_slot));
+  EXPECT_EQ(num_written_in_slot, 0);
+  std::vector<TensorRow> batches;
+  ASSERT_OK(RunMapBatch(ds, true, &batches, &num_written_in_slot));
+  // The first row is copied into its batch, as the layout of the rows is not known before. The other images are
+  // written into their batches by Resize. The last batch has one row, BatchOp copies it from its full size batch.
+  EXPECT_EQ(num_written_in_slot, 4);
+  ASSERT_EQ(batches.size(), 3);
+  ASSERT_EQ(batches.size(), expected.size());
+  for (size_t i = 0; i < batches.size(); i++) {
+    ASSERT_EQ(batches[i].size(), expected[i].size());
+    for (size_t j = 0; j < batches[i].size(); j++) {
+      EXPECT_EQ(*batches[i][j], *expected[i][j]);
+    }
+  }
+  EXPECT_EQ(batches[2][0]->shape()[0], 1);
+}
@@ -154,3 +154,31 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "RandomCropDecodeResizeOp test 2 finished";
 }
+
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestScaledDecode) {
+  MS_LOG(INFO) << "starting RandomCropDecodeResizeOp scaled decode test";
+  constexpr int h = 884;
+  constexpr int w = 718;
+  constexpr int min_h = h / 4;
+  constexpr int min_w = w / 4;
+
+  // A crop which is resized to a quarter of its size is decoded at the 1/4 scale, and still covers the target.
+  std::shared_ptr<Tensor> scaled;
+  Status rc = JpegCropAndDecode(raw_input_tensor_, &scaled, 0, 0, w, h, min_h, min_w);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_GE(scaled->shape()[0], min_h);
+  EXPECT_GE(scaled->shape()[1], min_w);
+  EXPECT_LT(scaled->shape()[0], h / 2);
+  EXPECT_LT(scaled->shape()[1], w / 2);
+
+  // The op decodes at the reduced scale only when it is asked to, and the output has the target size either way.
+  constexpr int target = 100;
+  auto op = RandomCropDecodeResizeOp(target, target, 0.08, 1.0, 0.75, 1.333333, InterpolationMode::kLinear, 10);
+  op.SetScaledDecode(true);
+  std::shared_ptr<Tensor> output;
+  rc = op.Compute(raw_input_tensor_, &output);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_EQ(output->shape()[0], target);
+  EXPECT_EQ(output->shape()[1], target);
+  MS_LOG(INFO) << "RandomCropDecodeResizeOp scaled decode test finished";
+}
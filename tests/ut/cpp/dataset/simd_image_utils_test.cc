@@ -0,0 +1,110 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <random>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/kernels/image/simd_image_utils.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestSimdImageUtils : public UT::Common {
+ public:
+  MindDataTestSimdImageUtils() {}
+};
+
+// The sizes are not multiples of the vectors, so that the rest of each row or image goes through the plain loops.
+TEST_F(MindDataTestSimdImageUtils, TestNormalize) {
+  std::mt19937 rd(1);
+  for (size_t num_channels = 1; num_channels <= 4; ++num_channels) {
+    const size_t num_pixels = 37 * 29;
+    const size_t size = num_pixels * num_channels;
+    std::vector<uint8_t> image(size);
+    std::vector<float> image_float(size);
+    for (size_t i = 0; i < size; ++i) {
+      image[i] = static_cast<uint8_t>(rd());
+      image_float[i] = static_cast<float>(rd() % 10000) / 7.0f;
+    }
+    std::vector<float> mean = {123.675, 116.28, 103.53, 50.0};
+    std::vector<float> std = {58.395, 57.12, 57.375, 10.0};
+    std::vector<float> output(size);
+    NormalizeKernel(image.data(), output.data(), num_pixels, num_channels, mean.data(), std.data());
+    for (size_t i = 0; i < size; ++i) {
+      size_t c = i % num_channels;
+      ASSERT_EQ(output[i], static_cast<float>(image[i]) / std[c] - mean[c]);
+    }
+    NormalizeKernel(image_float.data(), output.data(), num_pixels, num_channels, mean.data(), std.data());
+    for (size_t i = 0; i < size; ++i) {
+      size_t c = i % num_channels;
+      ASSERT_EQ(output[i], image_float[i] / std[c] - mean[c]);
+    }
+  }
+}
+
+TEST_F(MindDataTestSimdImageUtils, TestRescaleAndCast) {
+  const size_t size = 1001;
+  std::vector<uint8_t> image(size);
+  for (size_t i = 0; i < size; ++i) {
+    image[i] = static_cast<uint8_t>(i * 7);
+  }
+  std::vector<float> output(size);
+  RescaleKernel(image.data(), output.data(), size, 1.0 / 255, -1.0);
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_NEAR(output[i], image[i] / 255.0 - 1.0, 1e-6);
+  }
+  CastKernel(image.data(), output.data(), size);
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(output[i], static_cast<float>(image[i]));
+  }
+}
+
+TEST_F(MindDataTestSimdImageUtils, TestHwcToChwAndFlip) {
+  std::mt19937 rd(2);
+  const size_t height = 13;
+  const size_t width = 71;
+  for (size_t elem_size : {1, 2, 4, 8}) {
+    for (size_t num_channels : {1, 3, 4}) {
+      const size_t pixel_size = elem_size * num_channels;
+      const size_t size = height * width * pixel_size;
+      std::vector<uint8_t> image(size);
+      for (auto &b : image) {
+        b = static_cast<uint8_t>(rd());
+      }
+      std::vector<uint8_t> output(size);
+      std::vector<uint8_t> expected(size);
+      HwcToChwKernel(image.data(), output.data(), height * width, num_channels, elem_size);
+      for (size_t p = 0; p < height * width; ++p) {
+        for (size_t c = 0; c < num_channels; ++c) {
+          (void)memcpy(&expected[(c * height * width + p) * elem_size], &image[(p * num_channels + c) * elem_size],
+                       elem_size);
+        }
+      }
+      ASSERT_EQ(output, expected);
+      for (bool vertical : {false, true}) {
+        FlipKernel(image.data(), output.data(), height, width, pixel_size, true, vertical);
+        for (size_t r = 0; r < height; ++r) {
+          for (size_t p = 0; p < width; ++p) {
+            size_t r_dst = vertical ? height - 1 - r : r;
+            (void)memcpy(&expected[(r_dst * width + width - 1 - p) * pixel_size], &image[(r * width + p) * pixel_size],
+                         pixel_size);
+          }
+        }
+        ASSERT_EQ(output, expected);
+      }
+    }
+  }
+}
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/size_class_pool.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestSizeClassPool : public UT::Common {
+ public:
+  MindDataTestSizeClassPool() {}
+};
+
+TEST_F(MindDataTestSizeClassPool, TestSizeClasses) {
+  EXPECT_EQ(SizeClassPool::AllocationSize(1), 64);
+  EXPECT_EQ(SizeClassPool::AllocationSize(64), 64);
+  EXPECT_EQ(SizeClassPool::AllocationSize(65), 80);
+  EXPECT_EQ(SizeClassPool::AllocationSize(129), 160);
+  EXPECT_EQ(SizeClassPool::AllocationSize(150528), 163840);
+  // Beyond the largest class a request is rounded up to huge pages, less the room of the header.
+  EXPECT_EQ(SizeClassPool::AllocationSize(40000001), 20 * 2097152 - 64);
+}
+
+TEST_F(MindDataTestSizeClassPool, TestReuse) {
+  auto pool = std::make_shared<SizeClassPool>();
+  void *p = nullptr;
+  ASSERT_OK(pool->Allocate(1000, &p));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0);
+  pool->Deallocate(p);
+  // The block just freed comes back from the cache of the thread.
+  void *q = nullptr;
+  ASSERT_OK(pool->Allocate(900, &q));
+  EXPECT_EQ(p, q);
+  // It grows in place as long as the class allows.
+  ASSERT_OK(pool->Reallocate(&q, 900, 1024));
+  EXPECT_EQ(p, q);
+  (void)memset(q, 'a', 1024);
+  ASSERT_OK(pool->Reallocate(&q, 1024, 4096));
+  EXPECT_NE(p, q);
+  EXPECT_EQ(static_cast<char *>(q)[1023], 'a');
+  pool->Deallocate(q);
+  // A large block is mapped on its own, and kept for a request of about the same size once freed.
+  ASSERT_OK(pool->Allocate(40000001, &p));
+  static_cast<char *>(p)[40000000] = 'b';
+  pool->Deallocate(p);
+  ASSERT_OK(pool->Allocate(39000000, &q));
+  EXPECT_EQ(p, q);
+  pool->Deallocate(q);
+  // A larger one gets its own mapping.
+  ASSERT_OK(pool->Allocate(60000000, &q));
+  EXPECT_NE(p, q);
+  pool->Deallocate(q);
+}
+
+TEST_F(MindDataTestSizeClassPool, TestTrim) {
+  auto pool = std::make_shared<SizeClassPool>();
+  // Small blocks, which go through the cache of the thread, and blocks of 1MB, one per span, over a few segments.
+  std::vector<void *> blocks;
+  for (size_t sz : {1000, 1000000}) {
+    for (int i = 0; i < 200; ++i) {
+      void *p = nullptr;
+      ASSERT_OK(pool->Allocate(sz, &p));
+      blocks.push_back(p);
+    }
+  }
+  void *large = nullptr;
+  ASSERT_OK(pool->Allocate(40000001, &large));
+  size_t mapped = pool->MappedSize();
+  EXPECT_GT(mapped, 3 * 64 * 1048576);
+  for (void *p : blocks) {
+    pool->Deallocate(p);
+  }
+  // The spans of 1MB go back to their segments as they are freed, the empty segments are unmapped.
+  EXPECT_LT(pool->MappedSize(), mapped - 2 * 64 * 1048576);
+  // The large block stays mapped after it is freed, for the next large request.
+  pool->Deallocate(large);
+  EXPECT_GT(pool->MappedSize(), 40000001);
+  pool->Trim();
+  EXPECT_EQ(pool->MappedSize(), 0);
+  // The pool is still good after a trim.
+  void *p = nullptr;
+  ASSERT_OK(pool->Allocate(1000, &p));
+  pool->Deallocate(p);
+}
+
+TEST_F(MindDataTestSizeClassPool, TestThreads) {
+  auto pool = std::make_shared<SizeClassPool>(true);
+  ASSERT_GE(pool->NumNodes(), 1);
+  // Blocks allocated by one thread and freed by another one, like the rows passed between the operators.
+  constexpr int kNumRows = 10000;
+  std::vector<void *> rows(kNumRows, nullptr);
+  // The gtest assertions are checked by the main thread, the threads only keep the results.
+  Status rc;
+  std::thread producer([&pool, &rows, &rc]() {
+    for (int i = 0; i < kNumRows && rc.IsOk(); ++i) {
+      size_t sz = 100 + (i % 7) * 10000;
+      rc = pool->Allocate(sz, &rows[i]);
+      if (rc.IsOk()) {
+        (void)memset(rows[i], i % 128, sz);
+      }
+    }
+  });
+  producer.join();
+  ASSERT_OK(rc);
+  int num_wrong = 0;
+  std::thread consumer([&pool, &rows, &num_wrong]() {
+    for (int i = 0; i < kNumRows; ++i) {
+      if (static_cast<char *>(rows[i])[99] != i % 128) {
+        ++num_wrong;
+      }
+      pool->Deallocate(rows[i]);
+    }
+  });
+  consumer.join();
+  EXPECT_EQ(num_wrong, 0);
+}
+
+TEST_F(MindDataTestSizeClassPool, TestTensorPool) {
+  auto cfg = GlobalContext::config_manager();
+  cfg->set_enable_tensor_pool(true);
+  std::shared_ptr<Tensor> t;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<int32_t>{1, 2, 3, 4}, &t));
+  EXPECT_NE(std::dynamic_pointer_cast<SizeClassPool>(GlobalContext::Instance()->tensor_mem_pool()), nullptr);
+  cfg->set_enable_tensor_pool(false);
+  EXPECT_EQ(std::dynamic_pointer_cast<SizeClassPool>(GlobalContext::Instance()->tensor_mem_pool()), nullptr);
+  int32_t v = 0;
+  ASSERT_OK(t->GetItemAt(&v, {3}));
+  EXPECT_EQ(v, 4);
+}
@@ -13,12 +13,19 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_decoder.h"
+#include "minddata/dataset/engine/datasetops/source/tf_record_index.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
@@ -731,3 +738,178 @@ TEST_F(MindDataTestTFReaderOp, TestTotalRowsBasic) {
   TFReaderOp::CountTotalRows(&total_rows, filenames, 729, true);
   ASSERT_EQ(total_rows, 60);
 }
+
+TEST_F(MindDataTestTFReaderOp, TestTFExampleDecoder) {
+  dataengine::Example example;
+  auto *feature_map = example.mutable_features()->mutable_feature();
+  (*feature_map)["image"].mutable_bytes_list()->add_value("abc");
+  (*feature_map)["image"].mutable_bytes_list()->add_value("d");
+  (*feature_map)["label"].mutable_int64_list()->add_value(-3);
+  (*feature_map)["label"].mutable_int64_list()->add_value(70000);
+  (*feature_map)["score"].mutable_float_list()->add_value(0.5);
+  (*feature_map)["text"].mutable_bytes_list()->add_value("hello");
+  (*feature_map)["unused"].mutable_float_list()->add_value(1.0);
+  std::string serialized_example;
+  ASSERT_TRUE(example.SerializeToString(&serialized_example));
+
+  // Only the columns of the schema are decoded, in the order of the schema.
+  DataSchema schema;
+  ASSERT_OK(schema.AddColumn(ColDescriptor("text", DataType(DataType::DE_STRING), TensorImpl::kFlexible, 1)));
+  ASSERT_OK(schema.AddColumn(ColDescriptor("label", DataType(DataType::DE_INT32), TensorImpl::kFlexible, 1)));
+  ASSERT_OK(schema.AddColumn(ColDescriptor("image", DataType(DataType::DE_UINT8), TensorImpl::kFlexible, 1)));
+  ASSERT_OK(schema.AddColumn(ColDescriptor("score", DataType(DataType::DE_FLOAT32), TensorImpl::kFlexible, 1)));
+  TFExampleDecoder decoder(&schema);
+  TensorRow row(schema.NumColumns(), nullptr);
+  ASSERT_OK(decoder.Decode(serialized_example, &row));
+
+  std::string_view text;
+  ASSERT_OK(row[0]->GetItemAt(&text, {0}));
+  EXPECT_EQ(text, "hello");
+  int32_t label = 0;
+  ASSERT_OK(row[1]->GetItemAt(&label, {0}));
+  EXPECT_EQ(label, -3);
+  ASSERT_OK(row[1]->GetItemAt(&label, {1}));
+  EXPECT_EQ(label, 70000);
+  // the bytes are padded with ' ' to the longest value
+  std::shared_ptr<Tensor> expected_image;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<uint8_t>{'a', 'b', 'c', 'd', ' ', ' '}, &expected_image));
+  EXPECT_EQ(*row[2], *expected_image);
+  float score = 0;
+  ASSERT_OK(row[3]->GetItemAt(&score, {0}));
+  EXPECT_EQ(score, 0.5);
+
+  // A truncated record and a missing column are errors.
+  EXPECT_ERROR(decoder.Decode(serialized_example.substr(0, serialized_example.size() - 1), &row));
+  feature_map->erase("score");
+  ASSERT_TRUE(example.SerializeToString(&serialized_example));
+  EXPECT_ERROR(decoder.Decode(serialized_example, &row));
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFRecordIndex) {
+  // Work on a copy, so the index file is not written into the test data.
+  std::string filename = "tf_record_index_test.data";
+  {
+    std::ifstream in(datasets_root_path_ + "/testTFTestAllTypes/test.data", std::ios::binary);
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+  }
+  std::string index_file = TFRecordIndex::IndexFileName(filename);
+  (void)remove(index_file.c_str());
+
+  int64_t num_rows = 0;
+  EXPECT_ERROR(TFRecordIndex::CountRows(filename, &num_rows));
+
+  TFRecordIndex index;
+  ASSERT_OK(index.Build(filename));
+  EXPECT_EQ(index.num_rows(), 12);
+  EXPECT_EQ(index.offset(0), 0);
+  ASSERT_OK(index.Save(filename));
+  ASSERT_OK(TFRecordIndex::CountRows(filename, &num_rows));
+  EXPECT_EQ(num_rows, 12);
+  num_rows = 0;
+  ASSERT_OK(TFReaderOp::CountTotalRows(&num_rows, {filename}));
+  EXPECT_EQ(num_rows, 12);
+
+  TFRecordIndex loaded;
+  ASSERT_OK(loaded.Load(filename));
+  ASSERT_EQ(loaded.num_rows(), index.num_rows());
+  for (int64_t i = 0; i < index.num_rows(); ++i) {
+    EXPECT_EQ(loaded.offset(i), index.offset(i));
+  }
+
+  // A rewrite of the same size within the same second makes the index out of date as well.
+  struct stat st;
+  ASSERT_EQ(stat(filename.c_str(), &st), 0);
+  struct timespec times[2] = {st.st_atim, st.st_mtim};
+  times[1].tv_nsec = (times[1].tv_nsec + 1) % 1000000000;
+  ASSERT_EQ(utimensat(AT_FDCWD, filename.c_str(), times, 0), 0);
+  EXPECT_ERROR(TFRecordIndex::CountRows(filename, &num_rows));
+  EXPECT_ERROR(loaded.Load(filename));
+
+  // The index is out of date once the file changes.
+  {
+    std::ofstream out(filename, std::ios::binary | std::ios::app);
+    out << "x";
+  }
+  EXPECT_ERROR(TFRecordIndex::CountRows(filename, &num_rows));
+  EXPECT_ERROR(loaded.Load(filename));
+
+  (void)remove(index_file.c_str());
+  (void)remove(filename.c_str());
+}
+
+// Read 'num_repeats' epochs of an indexed file with the rows shuffled, and return the col_sint64 of the rows.
+static std::vector<int64_t> ReadShuffledRows(const std::string &filename, const std::string &schema_file,
+                                             uint32_t num_repeats) {
+  std::vector<int64_t> values;
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+  EXPECT_OK(schema->LoadSchemaFile(schema_file, {"col_sint64"}));
+  int32_t op_connector_size = GlobalContext::config_manager()->op_connector_size();
+  std::shared_ptr<TFReaderOp> my_tfreader_op = std::make_shared<TFReaderOp>(
+    1, 16, 0, std::vector<std::string>{filename}, std::move(schema), op_connector_size,
+    std::vector<std::string>{"col_sint64"}, false, 1, 0, false);
+  my_tfreader_op->SetShuffleRows(true);
+  EXPECT_OK(my_tfreader_op->Init());
+  EXPECT_TRUE(my_tfreader_op->ShuffleRows());
+  std::shared_ptr<RepeatOp> my_repeat_op = std::make_shared<RepeatOp>(num_repeats);
+  EXPECT_OK(my_tree->AssociateNode(my_tfreader_op));
+  EXPECT_OK(my_tree->AssociateNode(my_repeat_op));
+  my_tfreader_op->set_total_repeats(num_repeats);
+  my_tfreader_op->set_num_repeats_per_epoch(num_repeats);
+  EXPECT_OK(my_repeat_op->AddChild(my_tfreader_op));
+  EXPECT_OK(my_tree->AssignRoot(my_repeat_op));
+  EXPECT_OK(my_tree->Prepare());
+  EXPECT_OK(my_tree->Launch());
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  EXPECT_OK(di.FetchNextTensorRow(&tensor_list));
+  while (!tensor_list.empty()) {
+    int64_t value = 0;
+    EXPECT_OK(tensor_list[0]->GetItemAt(&value, {0}));
+    values.push_back(value);
+    EXPECT_OK(di.FetchNextTensorRow(&tensor_list));
+  }
+  return values;
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFReaderShuffleRows) {
+  std::string filename = "tf_record_shuffle_test.data";
+  {
+    std::ifstream in(datasets_root_path_ + "/testTFTestAllTypes/test.data", std::ios::binary);
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+  }
+  TFRecordIndex index;
+  ASSERT_OK(index.Build(filename));
+  ASSERT_OK(index.Save(filename));
+  std::string schema_file = datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json";
+
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(135);
+  constexpr uint32_t kNumRepeats = 3;
+  constexpr size_t kNumRows = 12;
+  std::vector<int64_t> first = ReadShuffledRows(filename, schema_file, kNumRepeats);
+  std::vector<int64_t> second = ReadShuffledRows(filename, schema_file, kNumRepeats);
+  GlobalContext::config_manager()->set_seed(original_seed);
+
+  // Every epoch holds all the rows in a new order, and the same seed gives the same orders.
+  ASSERT_EQ(first.size(), kNumRows * kNumRepeats);
+  EXPECT_EQ(first, second);
+  std::vector<std::vector<int64_t>> epochs;
+  for (uint32_t i = 0; i < kNumRepeats; ++i) {
+    epochs.emplace_back(first.begin() + i * kNumRows, first.begin() + (i + 1) * kNumRows);
+  }
+  for (uint32_t i = 1; i < kNumRepeats; ++i) {
+    EXPECT_NE(epochs[i], epochs[0]);
+    std::vector<int64_t> sorted_epoch = epochs[i];
+    std::vector<int64_t> sorted_first = epochs[0];
+    std::sort(sorted_epoch.begin(), sorted_epoch.end());
+    std::sort(sorted_first.begin(), sorted_first.end());
+    EXPECT_EQ(sorted_epoch, sorted_first);
+  }
+
+  (void)remove(TFRecordIndex::IndexFileName(filename).c_str());
+  (void)remove(filename.c_str());
+}
@@ -26,6 +26,7 @@
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -358,4 +359,74 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTokenizerOp, TestBasicTokenizerAscii) {
+  MS_LOG(INFO) << "Doing TestBasicTokenizerAscii.";
+  // ASCII text is tokenized without ICU, the unused words keep their case.
+  std::unique_ptr<BasicTokenizerOp> basic_tokenizer(
+    new BasicTokenizerOp(true, false, NormalizeForm::kNone, true, true));
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateScalar<std::string>("Hello, [CLS] World!\tBye", &input);
+  TensorRow output;
+  Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(output[0]->Size(), 6);
+  CheckEqual(output[0], {0}, "hello");
+  CheckEqual(output[0], {1}, ",");
+  CheckEqual(output[0], {2}, "[CLS]");
+  CheckEqual(output[0], {3}, "world");
+  CheckEqual(output[0], {4}, "!");
+  CheckEqual(output[0], {5}, "bye");
+
+  std::vector<uint32_t> expected_start = {0, 5, 7, 13, 18, 20};
+  std::vector<uint32_t> expected_limit = {5, 6, 12, 18, 19, 23};
+  ASSERT_EQ(output.size(), 3);
+  for (size_t i = 0; i < expected_start.size(); i++) {
+    uint32_t start = 0;
+    uint32_t limit = 0;
+    EXPECT_TRUE(output[1]->GetItemAt<uint32_t>(&start, {static_cast<dsize_t>(i)}).IsOk());
+    EXPECT_TRUE(output[2]->GetItemAt<uint32_t>(&limit, {static_cast<dsize_t>(i)}).IsOk());
+    EXPECT_EQ(start, expected_start[i]);
+    EXPECT_EQ(limit, expected_limit[i]);
+  }
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizer.";
+  // "abcd" is a prefix of "abcdx" and "##cd" is a prefix of "##cdy", so the matching of "abcdz" has to fall back
+  // twice before it finds the longest-match tokens.
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector({"a", "abcdx", "##b", "##c", "##cdy", "##dz", "中", "##国"}, {}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::unique_ptr<WordpieceTokenizerOp> op(new WordpieceTokenizerOp(vocab, "##", 100, "[UNK]", true));
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateFromVector(std::vector<std::string>{"abcdz", "abcdq", "中国", "abcdx"}, &input);
+  TensorRow output;
+  s = op->Compute(TensorRow(0, {input}), &output);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(output[0]->Size(), 8);
+  CheckEqual(output[0], {0}, "a");
+  CheckEqual(output[0], {1}, "##b");
+  CheckEqual(output[0], {2}, "##c");
+  CheckEqual(output[0], {3}, "##dz");
+  CheckEqual(output[0], {4}, "[UNK]");
+  CheckEqual(output[0], {5}, "中");
+  CheckEqual(output[0], {6}, "##国");
+  CheckEqual(output[0], {7}, "abcdx");
+
+  // The offsets of a word which can't be tokenized only cover the unknown token.
+  std::vector<uint32_t> expected_start = {0, 1, 2, 3, 0, 0, 3, 0};
+  std::vector<uint32_t> expected_limit = {1, 2, 3, 5, 5, 3, 6, 5};
+  ASSERT_EQ(output.size(), 3);
+  EXPECT_EQ(output[1]->Size(), expected_start.size());
+  EXPECT_EQ(output[2]->Size(), expected_limit.size());
+  for (size_t i = 0; i < expected_start.size(); i++) {
+    uint32_t start = 0;
+    uint32_t limit = 0;
+    EXPECT_TRUE(output[1]->GetItemAt<uint32_t>(&start, {static_cast<dsize_t>(i)}).IsOk());
+    EXPECT_TRUE(output[2]->GetItemAt<uint32_t>(&limit, {static_cast<dsize_t>(i)}).IsOk());
+    EXPECT_EQ(start, expected_start[i]);
+    EXPECT_EQ(limit, expected_limit[i]);
+  }
+}
@@ -130,3 +130,24 @@ TEST_F(MindDataTestTypeCast, CastFromFLOAT16) {
   testCast<float16, double>(input, input_format, DataType("float64"));
   testCast<float16, bool>(input, input_format, DataType("bool"));
 }
+
+TEST_F(MindDataTestTypeCast, TestBatchCompute) {
+  std::unique_ptr<TypeCastOp> op(new TypeCastOp(DataType("float32")));
+  EXPECT_TRUE(op->SupportBatch());
+  std::vector<TensorRow> input;
+  for (int32_t i = 0; i < 4; i++) {
+    std::shared_ptr<Tensor> t;
+    Tensor::CreateFromVector(std::vector<int32_t>{i, i + 1}, &t);
+    input.push_back(TensorRow(0, {t}));
+  }
+  std::vector<TensorRow> output;
+  EXPECT_TRUE(op->BatchCompute(input, &output));
+  ASSERT_EQ(output.size(), input.size());
+  for (int32_t i = 0; i < 4; i++) {
+    ASSERT_EQ(output[i].size(), 1);
+    ASSERT_TRUE(output[i][0]->type() == DataType(DataType::DE_FLOAT32));
+    float value = 0;
+    EXPECT_TRUE(output[i][0]->GetItemAt<float>(&value, {1}));
+    EXPECT_EQ(value, static_cast<float>(i + 1));
+  }
+}
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "fl/server/kernel/striped_accumulator.h"
+#include "fl/server/kernel/dense_grad_accum_kernel.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+namespace kernel {
+class TestStripedAccumulator : public UT::Common {
+ public:
+  TestStripedAccumulator() {}
+};
+
+// Simulate the clients which upload their weights to the server at the same time.
+TEST_F(TestStripedAccumulator, test_concurrent_clients) {
+  const size_t client_num = 16;
+  const size_t weight_num = 5 * kAccumulateChunkSize + 7;
+  std::vector<float> weight(weight_num, 100.0);
+  std::vector<std::vector<float>> new_weights;
+  for (size_t i = 0; i < client_num; i++) {
+    new_weights.emplace_back(weight_num, static_cast<float>(i + 1));
+  }
+
+  StripedAccumulator accumulator;
+  std::atomic<size_t> clear_count(0);
+  std::vector<std::thread> clients;
+  for (size_t i = 0; i < client_num; i++) {
+    clients.emplace_back([&, i]() {
+      accumulator.StartRound([&]() {
+        std::fill(weight.begin(), weight.end(), 0.0);
+        ++clear_count;
+      });
+      accumulator.Accumulate(weight.data(), new_weights[i].data(), weight_num);
+    });
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  ASSERT_EQ(clear_count, 1);
+  const float expected = static_cast<float>(client_num * (client_num + 1) / 2);
+  for (size_t i = 0; i < weight_num; i++) {
+    ASSERT_EQ(weight[i], expected);
+  }
+
+  // The next round clears the buffer again.
+  accumulator.EndRound();
+  std::vector<int> grad(10, 5);
+  std::vector<int> new_grad(10, 1);
+  accumulator.StartRound([&grad]() { std::fill(grad.begin(), grad.end(), 0); });
+  accumulator.Accumulate(grad.data(), new_grad.data(), grad.size());
+  ASSERT_EQ(grad, new_grad);
+}
+
+// The rejected launches are not counted, so they don't take the places of the clients of the round.
+TEST_F(TestStripedAccumulator, test_dense_grad_accum_rejected_launch) {
+  std::vector<float> grad(8, 100.0);
+  std::vector<float> new_grad(8, 3.0);
+  std::vector<float> big_grad(16, 1.0);
+  auto grad_addr = std::make_shared<Address>(grad.data(), grad.size() * sizeof(float));
+  auto new_grad_addr = std::make_shared<Address>(new_grad.data(), new_grad.size() * sizeof(float));
+  auto big_grad_addr = std::make_shared<Address>(big_grad.data(), big_grad.size() * sizeof(float));
+
+  DenseGradAccumKernel<float> kernel;
+  kernel.set_done_count(2);
+  ASSERT_FALSE(kernel.Launch({grad_addr, big_grad_addr}, {}, {}));
+  ASSERT_TRUE(kernel.Launch({grad_addr, new_grad_addr}, {}, {}));
+  ASSERT_FALSE(kernel.IsAggregationDone());
+  ASSERT_TRUE(kernel.Launch({grad_addr, new_grad_addr}, {}, {}));
+  ASSERT_TRUE(kernel.IsAggregationDone());
+  ASSERT_FALSE(kernel.Launch({grad_addr, new_grad_addr}, {}, {}));
+  for (float value : grad) {
+    ASSERT_EQ(value, 3.0);
+  }
+
+  kernel.Reset();
+  ASSERT_TRUE(kernel.Launch({grad_addr, new_grad_addr}, {}, {}));
+  ASSERT_FALSE(kernel.IsAggregationDone());
+}
+}  // namespace kernel
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
@@ -375,6 +375,38 @@ TEST_F(TestManager, test_scalar_replace) {
   mng->Replace(cnode_add, x);
 }
 
+TEST_F(TestManager, test_batch_transaction) {
+  // Many edits are committed in one transaction.
+  FuncGraphPtr func_graph = std::make_shared<FuncGraph>();
+  ParameterPtr x = func_graph->add_parameter();
+  ParameterPtr y = func_graph->add_parameter();
+  const size_t num = 20;
+  std::vector<AnfNodePtr> adds;
+  AnfNodePtr last = x;
+  for (size_t i = 0; i < num; i++) {
+    last = func_graph->NewCNode({NewValueNode(prim::kPrimScalarAdd), last, x});
+    adds.push_back(last);
+  }
+  func_graph->set_output(last);
+  auto mng = Manage(func_graph);
+  ASSERT_EQ(mng->node_users()[x].size(), num + 1);
+
+  auto tr = mng->Transact();
+  for (auto &add : adds) {
+    tr.SetEdge(add, 2, y);
+  }
+  tr.Commit();
+  ASSERT_EQ(mng->node_users()[x].size(), 1);
+  ASSERT_EQ(mng->node_users()[y].size(), num);
+  ASSERT_EQ(mng->node_users()[y].front().first, adds.front());
+  ASSERT_EQ(mng->node_users()[y].back().first, adds.back());
+
+  ASSERT_TRUE(mng->Replace(x, y));
+  ASSERT_EQ(mng->node_users()[y].size(), num + 1);
+  ASSERT_TRUE(mng->node_users()[x].empty());
+  ASSERT_EQ(mng->free_variables_total().size(), mng->func_graphs().size());
+}
+
 TEST_F(TestManager, test_nested_manual) {
   auto graphs = MakeNestedGraph();
   auto f = graphs[0];
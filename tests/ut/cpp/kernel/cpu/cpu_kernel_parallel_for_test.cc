@@ -0,0 +1,93 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "common/thread_pool.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+class CPUKernelParallelForTest : public UT::Common {
+ public:
+  CPUKernelParallelForTest() {}
+};
+
+TEST_F(CPUKernelParallelForTest, test_cover_all_elements) {
+  const size_t count = 10007;
+  std::vector<int> visited(count, 0);
+  auto task = [&visited](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      visited[i] += 1;
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, count);
+  CPUKernelUtils::ParallelFor(task, count, kParallelForMinBlockCost);
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(visited[i], 2);
+  }
+}
+
+TEST_F(CPUKernelParallelForTest, test_grain_size) {
+  // The blocks run on the workers, so their sizes are collected and checked on this thread.
+  std::mutex mutex;
+  std::vector<size_t> block_sizes;
+  auto task = [&mutex, &block_sizes](size_t start, size_t end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    block_sizes.push_back(end - start);
+  };
+  common::ThreadPool::GetInstance().ParallelFor(task, 1000, 100);
+  ASSERT_LE(block_sizes.size(), 10);
+  ASSERT_LE(block_sizes.size(), common::ThreadPool::GetInstance().GetSyncRunThreadNum());
+  for (auto block_size : block_sizes) {
+    ASSERT_GE(block_size, 100);
+  }
+  ASSERT_EQ(std::accumulate(block_sizes.begin(), block_sizes.end(), size_t(0)), 1000);
+}
+
+TEST_F(CPUKernelParallelForTest, test_nested_call) {
+  const size_t outer_count = 64;
+  const size_t inner_count = 256;
+  std::atomic<size_t> sum(0);
+  auto inner_task = [&sum](size_t start, size_t end) { sum += end - start; };
+  auto outer_task = [&inner_task](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      common::ThreadPool::GetInstance().ParallelFor(inner_task, inner_count);
+    }
+  };
+  common::ThreadPool::GetInstance().ParallelFor(outer_task, outer_count);
+  ASSERT_EQ(sum, outer_count * inner_count);
+}
+
+TEST_F(CPUKernelParallelForTest, test_exception) {
+  const size_t count = 1024;
+  auto task = [count](size_t, size_t end) {
+    if (end == count) {
+      throw std::runtime_error("The last block failed.");
+    }
+  };
+  ASSERT_THROW(common::ThreadPool::GetInstance().ParallelFor(task, count), std::runtime_error);
+  // The workers are still usable after the exception.
+  std::atomic<size_t> sum(0);
+  common::ThreadPool::GetInstance().ParallelFor([&sum](size_t start, size_t end) { sum += end - start; }, count);
+  ASSERT_EQ(sum, count);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -23,6 +23,7 @@
 #include "ir/visitor.h"
 #include "ir/func_graph_cloner.h"
 #include "frontend/optimizer/opt.h"
+#include "frontend/optimizer/optimizer.h"
 #include "frontend/optimizer/anf_visitor.h"
 #include "frontend/optimizer/irpass.h"
 #include "frontend/optimizer/irpass/arithmetic_simplify.h"
@@ -177,6 +178,80 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+TEST_F(TestOptOpt, SubstitutionIndex) {
+  // The substitutions are indexed by primitive, the ones of other primitives and the generic ones are kept in order.
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_constant_variable", "before_1");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_constant_variable", "after");
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({elim_Z, elim_R, idempotent_P, Qct_to_P})));
+
+  FuncGraphPtr before_idempotent = getPyFun.CallAndParseRet("test_idempotent", "before_2");
+  FuncGraphPtr after_idempotent = getPyFun.CallAndParseRet("test_idempotent", "after");
+  ASSERT_TRUE(nullptr != before_idempotent);
+  ASSERT_TRUE(nullptr != after_idempotent);
+  auto idempotent_any = MakeSubstitution(std::make_shared<IdempotentEliminater>(), "idempotent_any",
+                                         [](const AnfNodePtr &node) { return IsPrimitiveCNode(node, P); });
+  ASSERT_TRUE(
+    CheckOpt(before_idempotent, after_idempotent, std::vector<SubstitutionPtr>({Qct_to_P, elim_R, idempotent_any})));
+}
+
+TEST_F(TestOptOpt, GraphOnlyWorklist) {
+  // A graph only list runs on the whole graph first, then only on the nodes changed since its last run. The result is
+  // the same as running it on the whole graph each round.
+  auto S = std::make_shared<Primitive>("S");
+  constexpr size_t kChainSize = 50;
+  auto make_graph = [&S]() {
+    auto fg = std::make_shared<FuncGraph>();
+    AnfNodePtr node = fg->add_parameter();
+    for (size_t i = 0; i < kChainSize; ++i) {
+      node = fg->NewCNode({NewValueNode(S), node});
+    }
+    for (size_t i = 0; i < 5; ++i) {
+      node = fg->NewCNode({NewValueNode(P), node});
+    }
+    fg->set_output(node);
+    return fg;
+  };
+
+  // Returns the number of nodes visited by the list in each round, and checks the graph ends with a single P.
+  auto run = [&make_graph, this](bool graph_only) {
+    size_t visits = 0;
+    std::vector<size_t> round_visits;
+    auto count_visits = MakeSubstitution(std::make_shared<IdempotentEliminater>(), "count_visits",
+                                         [&visits](const AnfNodePtr &) {
+                                           ++visits;
+                                           return false;
+                                         });
+    auto end_round = [&visits, &round_visits](const FuncGraphPtr &, const OptimizerPtr &) {
+      round_visits.push_back(visits);
+      visits = 0;
+      return false;
+    };
+    OptPassGroupMap passes({{"idempotent", OptPassConfig({count_visits, idempotent_P}, false, false, graph_only)},
+                            {"end_round", OptPassConfig(end_round)}});
+    auto resource = std::make_shared<pipeline::Resource>();
+    auto fg = make_graph();
+    resource->manager()->AddFuncGraph(fg);
+    auto optimizer = Optimizer::MakeOptimizer("ut_test", resource, passes);
+    fg = optimizer->step(fg, false);
+
+    auto output = fg->output()->cast<CNodePtr>();
+    EXPECT_TRUE(IsPrimitiveCNode(output, P));
+    EXPECT_TRUE(IsPrimitiveCNode(output->input(1), S));
+    EXPECT_TRUE(resource->manager()->change_log().empty());
+    return round_visits;
+  };
+
+  auto full_visits = run(false);
+  auto worklist_visits = run(true);
+  ASSERT_EQ(full_visits.size(), 2);
+  ASSERT_EQ(worklist_visits.size(), 2);
+  EXPECT_EQ(worklist_visits[0], full_visits[0]);
+  EXPECT_GT(full_visits[1], kChainSize);
+  EXPECT_LT(worklist_visits[1], 10);
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
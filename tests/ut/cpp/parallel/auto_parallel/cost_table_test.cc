@@ -0,0 +1,111 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include "common/common_test.h"
+#include "frontend/parallel/auto_parallel/cost_table.h"
+#include "frontend/parallel/auto_parallel/operator_costmodel.h"
+#include "frontend/parallel/device_manager.h"
+
+namespace mindspore {
+namespace parallel {
+class TestCostTable : public UT::Common {
+ public:
+  TestCostTable() {}
+  void SetUp();
+  void TearDown();
+  std::string table_file_ = "./cost_table_test.json";
+};
+
+void TestCostTable::SetUp() {
+  RankList dev_list;
+  for (int32_t i = 0; i < 8; i++) {
+    dev_list.push_back(i);
+  }
+  RankList stage_map;
+  stage_map.push_back(8);
+  g_device_manager = std::make_shared<DeviceManager>();
+  g_device_manager->Init(dev_list, 0, stage_map, "hccl");
+
+  std::ofstream table(table_file_);
+  table << R"({"version": 1, "bytes_per_us": 2.0, "items": [{"op_type": "MatMul",
+    "inputs_shape": [[64, 32], [32, 16]], "inputs_slice_shape": [[8, 32], [32, 16]],
+    "outputs_slice_shape": [[8, 16]], "stage_device_num": 8, "forward_computation": 10.0,
+    "backward_computation": 20.0, "forward_communication": 0.0, "backward_communication": -1.0}]})";
+  table.close();
+}
+
+void TestCostTable::TearDown() {
+  CostTable::GetInstance()->Clear();
+  (void)std::remove(table_file_.c_str());
+  (void)std::remove((table_file_ + COST_TABLE_MISSING_SUFFIX).c_str());
+}
+
+TEST_F(TestCostTable, test_Load) {
+  auto cost_table = CostTable::GetInstance();
+  ASSERT_TRUE(cost_table->Load(table_file_));
+  ASSERT_TRUE(cost_table->enabled());
+  ASSERT_EQ(cost_table->size(), 1);
+
+  CostTableKey key;
+  key.op_type = "MatMul";
+  key.inputs_shape = {{64, 32}, {32, 16}};
+  key.inputs_slice_shape = {{8, 32}, {32, 16}};
+  key.outputs_slice_shape = {{8, 16}};
+  key.stage_device_num = 8;
+  CostTableItem item;
+  ASSERT_TRUE(cost_table->Lookup(key, &item));
+  ASSERT_DOUBLE_EQ(item.forward_computation, 20.0);
+  ASSERT_DOUBLE_EQ(item.backward_computation, 40.0);
+  ASSERT_DOUBLE_EQ(item.forward_communication, 0.0);
+  ASSERT_DOUBLE_EQ(item.backward_communication, COST_TABLE_UNMEASURED);
+
+  key.stage_device_num = 4;
+  ASSERT_FALSE(cost_table->Lookup(key, &item));
+}
+
+TEST_F(TestCostTable, test_CalibratedCost) {
+  ASSERT_TRUE(CostTable::GetInstance()->Load(table_file_));
+  MatMulCost mmcost;
+  mmcost.set_op_type("MatMul");
+  mmcost.set_is_parameter({false, true});
+
+  Shape input0_shape = {64, 32}, input0_slice_shape = {8, 32}, input1_shape = {32, 16}, input1_slice_shape = {32, 16},
+        output_shape = {64, 16}, output_slice_shape = {8, 16};
+  TensorLayout input0_layout, input1_layout, output_layout;
+  std::vector<TensorInfo> inputs = {TensorInfo(input0_layout, input0_shape, input0_slice_shape),
+                                    TensorInfo(input1_layout, input1_shape, input1_slice_shape)};
+  std::vector<TensorInfo> outputs = {TensorInfo(output_layout, output_shape, output_slice_shape)};
+
+  ASSERT_DOUBLE_EQ(mmcost.GetCalibratedForwardComputationCost(inputs, outputs, 0), 20.0);
+  ASSERT_DOUBLE_EQ(mmcost.GetCalibratedForwardCommCost(inputs, outputs, 0), 0.0);
+  // The backward communication is not measured, so the analytic estimate is used.
+  ASSERT_DOUBLE_EQ(mmcost.GetCalibratedCommCost(inputs, outputs, 0), mmcost.GetBackwardCommCost(inputs, outputs, 0));
+  ASSERT_EQ(CostTable::GetInstance()->missing_size(), 0);
+
+  std::vector<TensorInfo> dp_inputs = {TensorInfo(input0_layout, input0_shape, input0_shape),
+                                       TensorInfo(input1_layout, input1_shape, input1_slice_shape)};
+  std::vector<TensorInfo> dp_outputs = {TensorInfo(output_layout, output_shape, output_shape)};
+  ASSERT_DOUBLE_EQ(mmcost.GetCalibratedForwardComputationCost(dp_inputs, dp_outputs, 0),
+                   mmcost.GetForwardComputationCost(dp_inputs, dp_outputs, 0));
+  ASSERT_EQ(CostTable::GetInstance()->missing_size(), 1);
+  ASSERT_TRUE(CostTable::GetInstance()->DumpMissing());
+  std::ifstream missing(table_file_ + COST_TABLE_MISSING_SUFFIX);
+  ASSERT_TRUE(missing.good());
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Benchmarks of the fetches of a cache which holds twice as many rows as its memory quota, so half of the rows are read
+// from disk. The spilled rows are likely still in the page cache after they are written. For the numbers of a cold
+// disk, drop the page cache before each test, e.g. with the --gtest_filter of one test and
+// 'echo 3 > /proc/sys/vm/drop_caches'.
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dataset/common/common.h"
+#include "gtest/gtest.h"
+#include "perf/perf_common.h"
+#include "minddata/dataset/engine/cache/cache_hw.h"
+#include "minddata/dataset/engine/cache/cache_pool.h"
+#include "minddata/dataset/engine/cache/cache_policy.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCachePrefetchPerf : public UT::Common {
+ protected:
+  static constexpr size_t kRowSize = 64 * 1024;
+  static constexpr uint64_t kMemoryQuota = 64 * 1048576;
+  static constexpr int64_t kNumRows = 2 * kMemoryQuota / kRowSize;
+  // The rows of a window and the number of windows hinted ahead, like CacheBase::FetchSamplesToWorkers
+  static constexpr size_t kWindowRows = 64;
+  static constexpr size_t kLookahead = 2;
+
+  void SetUp() override {
+    constexpr float kMemoryCapRatio = 0.8;
+    auto mp = std::make_shared<NumaMemoryPool>(std::make_shared<CacheServerHW>(), kMemoryCapRatio);
+    pool_ = std::make_shared<CachePool>(mp, "/tmp", false, CacheEvictionType::kLru, false, 4);
+    ASSERT_OK(pool_->ServiceStart());
+    pool_->SetMemoryQuota(kMemoryQuota);
+    std::vector<char> row(kRowSize);
+    for (CachePool::key_type key = 0; key < kNumRows; ++key) {
+      std::fill(row.begin(), row.end(), static_cast<char>(key));
+      ASSERT_OK(pool_->Insert(key, {ReadableSlice(row.data(), row.size())}));
+    }
+    auto stat = pool_->GetStat();
+    UT::PerfLog("rows in memory") << stat.num_mem_cached << ", rows on disk: " << stat.num_disk_cached;
+    // The rows are fetched in a random order, in windows of kWindowRows rows.
+    std::vector<CachePool::key_type> keys(kNumRows);
+    for (CachePool::key_type key = 0; key < kNumRows; ++key) {
+      keys[key] = key;
+    }
+    std::mt19937 gen(1234);
+    std::shuffle(keys.begin(), keys.end(), gen);
+    for (size_t begin = 0; begin < keys.size(); begin += kWindowRows) {
+      size_t end = std::min(begin + kWindowRows, keys.size());
+      windows_.emplace_back(keys.begin() + begin, keys.begin() + end);
+    }
+  }
+
+  void TearDown() override { ASSERT_OK(pool_->ServiceStop()); }
+
+  // Read all the windows and report the rows per second. The window 'lookahead' windows later is hinted before a
+  // window is read.
+  void Report(const std::string &name, size_t lookahead) {
+    std::vector<char> row(kRowSize);
+    double ms = UT::TimeMs([&]() {
+      for (size_t i = 0; i < lookahead && i < windows_.size(); ++i) {
+        ASSERT_OK(pool_->Prefetch(windows_[i]));
+      }
+      for (size_t i = 0; i < windows_.size(); ++i) {
+        if (lookahead > 0 && i + lookahead < windows_.size()) {
+          ASSERT_OK(pool_->Prefetch(windows_[i + lookahead]));
+        }
+        for (auto key : windows_[i]) {
+          WritableSlice dest(row.data(), row.size());
+          ASSERT_OK(pool_->Read(key, &dest));
+        }
+      }
+    });
+    auto stat = pool_->GetStat();
+    UT::PerfLog(name) << kNumRows * 1000 / ms << " rows/s, rows read ahead " << stat.num_prefetched
+                      << ", taken by a read " << stat.num_prefetch_hit;
+  }
+
+  std::shared_ptr<CachePool> pool_;
+  std::vector<std::vector<CachePool::key_type>> windows_;
+};
+
+TEST_F(MindDataTestCachePrefetchPerf, TestNoHint) { Report("no hint", 0); }
+
+TEST_F(MindDataTestCachePrefetchPerf, TestHint) { Report("hint 2 windows ahead", kLookahead); }
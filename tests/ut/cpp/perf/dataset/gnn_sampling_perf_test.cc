@@ -0,0 +1,74 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Benchmarks of the neighbor sampling and the random walks of the GNN graph.
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dataset/common/common.h"
+#include "gtest/gtest.h"
+#include "perf/perf_common.h"
+#include "minddata/dataset/engine/gnn/graph_data_impl.h"
+
+using namespace mindspore::dataset;
+using namespace mindspore::dataset::gnn;
+
+class MindDataTestGNNSamplingPerf : public UT::Common {
+ protected:
+  static constexpr int kRepeats = 1000;
+
+  void SetUp() override {
+    graph_ = std::make_unique<GraphDataImpl>("data/mindrecord/testGraphData/sns", 1);
+    ASSERT_OK(graph_->Init());
+    ASSERT_OK(graph_->GetMetaInfo(&meta_info_));
+    std::shared_ptr<Tensor> nodes;
+    ASSERT_OK(graph_->GetAllNodes(meta_info_.node_type[0], &nodes));
+    node_list_.assign(nodes->begin<NodeIdType>(), nodes->end<NodeIdType>());
+  }
+
+  // Run 'run' kRepeats times and report the time of one run.
+  static void Report(const std::string &name, const std::function<Status()> &run) {
+    double ms = UT::TimeMs([&run]() {
+      for (int i = 0; i < kRepeats; ++i) {
+        ASSERT_OK(run());
+      }
+    });
+    UT::PerfLog(name) << ms * 1000 / kRepeats << " us";
+  }
+
+  std::unique_ptr<GraphDataImpl> graph_;
+  MetaInfo meta_info_;
+  std::vector<NodeIdType> node_list_;
+};
+
+TEST_F(MindDataTestGNNSamplingPerf, TestSampledNeighbors) {
+  std::vector<NodeType> neighbor_types(2, meta_info_.node_type[0]);
+  std::shared_ptr<Tensor> neighbors;
+  Report("random sampling, 2 hops of 10", [&]() {
+    return graph_->GetSampledNeighbors(node_list_, {10, 10}, neighbor_types, SamplingStrategy::kRandom, &neighbors);
+  });
+  Report("weighted sampling, 2 hops of 10", [&]() {
+    return graph_->GetSampledNeighbors(node_list_, {10, 10}, neighbor_types, SamplingStrategy::kEdgeWeight, &neighbors);
+  });
+}
+
+TEST_F(MindDataTestGNNSamplingPerf, TestRandomWalk) {
+  std::vector<NodeType> meta_path(59, meta_info_.node_type[0]);
+  std::shared_ptr<Tensor> walk_path;
+  Report("node2vec walk of 60 nodes from each node",
+         [&]() { return graph_->RandomWalk(node_list_, meta_path, 2.0, 0.5, -1, &walk_path); });
+}
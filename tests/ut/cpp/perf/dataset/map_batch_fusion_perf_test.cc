@@ -0,0 +1,62 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Benchmarks of a Map feeding a fixed-size Batch, with and without the fusion of the two, in which the map workers
+// write the rows into their batches.
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dataset/common/common.h"
+#include "gtest/gtest.h"
+#include "perf/perf_common.h"
+#include "minddata/dataset/engine/tree_adapter.h"
+#include "minddata/dataset/include/dataset/datasets.h"
+#include "minddata/dataset/include/dataset/vision.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestMapBatchFusionPerf : public UT::DatasetOpTesting {
+ protected:
+  static constexpr int32_t kBatchSize = 32;
+  static constexpr int32_t kRepeats = 40;
+
+  // Decode and resize the images of testPK, and report the rows per second of the batches.
+  void Report(const std::string &name, bool fuse) {
+    std::shared_ptr<Dataset> ds = ImageFolder(datasets_root_path_ + "/testPK/data/", true);
+    ds = ds->Repeat(kRepeats);
+    ds = ds->Map({std::make_shared<vision::Decode>(), std::make_shared<vision::Resize>(std::vector<int32_t>{224, 224})},
+                 {"image"});
+    ds = ds->Batch(kBatchSize, true);
+    TreeAdapter tree_adapter;
+    tree_adapter.SetOptimize(fuse);
+    ASSERT_OK(tree_adapter.Compile(ds->IRNode(), 1));
+    int64_t num_rows = 0;
+    double ms = UT::TimeMs([&]() {
+      TensorRow row;
+      ASSERT_OK(tree_adapter.GetNext(&row));
+      while (!row.empty()) {
+        num_rows += row[0]->shape()[0];
+        ASSERT_OK(tree_adapter.GetNext(&row));
+      }
+    });
+    UT::PerfLog(name) << num_rows * 1000 / ms << " rows/s";
+  }
+};
+
+TEST_F(MindDataTestMapBatchFusionPerf, TestDecodeResizeBatch) {
+  Report("map and batch", false);
+  Report("map fused with batch", true);
+}
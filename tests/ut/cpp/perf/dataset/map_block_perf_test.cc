@@ -0,0 +1,80 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Benchmarks of the map jobs run on single rows and on the blocks of rows which the MapOp workers take from their
+// queues.
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dataset/common/common.h"
+#include "gtest/gtest.h"
+#include "perf/perf_common.h"
+#include "minddata/dataset/engine/datasetops/map_op/cpu_map_job.h"
+#include "minddata/dataset/text/kernels/lookup_op.h"
+#include "minddata/dataset/text/vocab.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestMapBlockPerf : public UT::Common {
+ protected:
+  static constexpr int kNumRows = 20000;
+  static constexpr int kNumWords = 32;
+  static constexpr int kVocabSize = 10000;
+  // The most rows a MapOp worker takes from its queue at once
+  static constexpr size_t kMaxBlockRows = 32;
+
+  void SetUp() override {
+    std::vector<std::string> words;
+    for (int i = 0; i < kVocabSize; ++i) {
+      words.push_back("w" + std::to_string(i));
+    }
+    std::shared_ptr<Vocab> vocab;
+    ASSERT_OK(Vocab::BuildFromVector(words, {"<unk>"}, true, &vocab));
+    auto lookup = std::make_shared<LookupOp>(vocab, vocab->Lookup("<unk>"), DataType(DataType::DE_INT32));
+    job_ = std::make_unique<CpuMapJob>(std::vector<std::shared_ptr<TensorOp>>{lookup});
+    for (int i = 0; i < kNumRows; ++i) {
+      std::vector<std::string> sentence;
+      for (int j = 0; j < kNumWords; ++j) {
+        sentence.push_back(words[(i * kNumWords + j) % kVocabSize]);
+      }
+      std::shared_ptr<Tensor> t;
+      ASSERT_OK(Tensor::CreateFromVector(sentence, &t));
+      rows_.push_back(TensorRow(i, {t}));
+    }
+  }
+
+  // Run the job on blocks of 'block_rows' rows and report the rows per second.
+  void Report(const std::string &name, size_t block_rows) {
+    double ms = UT::TimeMs([&]() {
+      for (size_t begin = 0; begin < rows_.size(); begin += block_rows) {
+        size_t end = std::min(begin + block_rows, rows_.size());
+        std::vector<TensorRow> out;
+        ASSERT_OK(job_->Run(std::vector<TensorRow>(rows_.begin() + begin, rows_.begin() + end), &out));
+        ASSERT_EQ(out.size(), end - begin);
+      }
+    });
+    UT::PerfLog(name) << rows_.size() * 1000 / ms << " rows/s";
+  }
+
+  std::unique_ptr<CpuMapJob> job_;
+  std::vector<TensorRow> rows_;
+};
+
+TEST_F(MindDataTestMapBlockPerf, TestLookup) {
+  Report("lookup, one row per job", 1);
+  Report("lookup, blocks of 32 rows", kMaxBlockRows);
+}
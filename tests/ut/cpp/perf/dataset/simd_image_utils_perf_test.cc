@@ -0,0 +1,196 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Benchmarks of the image ops which run on the vectorized kernels of simd_image_utils, against the code the kernels
+// replaced: the OpenCV calls through CVTensor, and the loops over the tensor iterators.
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dataset/common/common.h"
+#include "gtest/gtest.h"
+#include "perf/perf_common.h"
+#include "minddata/dataset/core/cv_tensor.h"
+#include "minddata/dataset/kernels/data/data_utils.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+// The ops as they were before the kernels
+
+Status FlipWithOpenCV(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int flip_code) {
+  std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(std::move(input));
+  std::shared_ptr<CVTensor> output_cv;
+  RETURN_IF_NOT_OK(CVTensor::CreateEmpty(input_cv->shape(), input_cv->type(), &output_cv));
+  cv::flip(input_cv->mat(), output_cv->mat(), flip_code);
+  *output = std::static_pointer_cast<Tensor>(output_cv);
+  return Status::OK();
+}
+
+Status RescaleWithOpenCV(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale,
+                         float shift) {
+  std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
+  std::shared_ptr<CVTensor> output_cv;
+  RETURN_IF_NOT_OK(CVTensor::CreateEmpty(input_cv->shape(), DataType(DataType::DE_FLOAT32), &output_cv));
+  input_cv->mat().convertTo(output_cv->mat(), CV_32F, rescale, shift);
+  *output = std::static_pointer_cast<Tensor>(output_cv);
+  return Status::OK();
+}
+
+Status HwcToChwWithOpenCV(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
+  int num_channels = input_cv->shape()[CHANNEL_INDEX];
+  int height = input_cv->shape()[0];
+  int width = input_cv->shape()[1];
+  std::shared_ptr<CVTensor> output_cv;
+  RETURN_IF_NOT_OK(CVTensor::CreateEmpty(TensorShape{num_channels, height, width}, input_cv->type(), &output_cv));
+  for (int i = 0; i < num_channels; ++i) {
+    cv::Mat mat;
+    RETURN_IF_NOT_OK(output_cv->MatAtIndex({i}, &mat));
+    cv::extractChannel(input_cv->mat(), mat, i);
+  }
+  *output = std::move(output_cv);
+  return Status::OK();
+}
+
+template <typename T>
+Status NormalizeWithIterators(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                              std::vector<float> mean, std::vector<float> std) {
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), DataType(DataType::DE_FLOAT32), output));
+  auto itr_out = (*output)->begin<float>();
+  auto itr = input->begin<T>();
+  auto end = input->end<T>();
+  int64_t num_channels = (*output)->shape()[CHANNEL_INDEX];
+  while (itr != end) {
+    for (int64_t i = 0; i < num_channels; i++) {
+      *itr_out = static_cast<float>(*itr) / std[i] - mean[i];
+      ++itr_out;
+      ++itr;
+    }
+  }
+  return Status::OK();
+}
+
+Status CastWithIterators(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), DataType(DataType::DE_FLOAT32), output));
+  auto in_itr = input->begin<uint8_t>();
+  auto out_itr = (*output)->begin<float>();
+  auto out_end = (*output)->end<float>();
+  for (; out_itr != out_end; ++in_itr, ++out_itr) *out_itr = static_cast<float>(*in_itr);
+  return Status::OK();
+}
+}  // namespace
+
+class MindDataTestSimdImageUtilsPerf : public UT::Common {
+ protected:
+  static constexpr int kRepeats = 1000;
+  // A typical image of the pipelines, after a resize
+  static constexpr int64_t kHeight = 224;
+  static constexpr int64_t kWidth = 224;
+  static constexpr int64_t kChannels = 3;
+
+  void SetUp() override {
+    ASSERT_OK(Tensor::CreateEmpty(TensorShape({kHeight, kWidth, kChannels}), DataType(DataType::DE_UINT8), &image_));
+    std::mt19937 rd(1);
+    for (auto itr = image_->begin<uint8_t>(); itr != image_->end<uint8_t>(); ++itr) {
+      *itr = static_cast<uint8_t>(rd());
+    }
+    ASSERT_OK(TypeCast(image_, &image_float_, DataType(DataType::DE_FLOAT32)));
+  }
+
+  // Run the replaced code and the op kRepeats times each, check that they give the same image (up to the rounding of
+  // a fused multiply-add) and report the time of one run of each.
+  static void Report(const std::string &name, const std::function<Status(std::shared_ptr<Tensor> *)> &replaced,
+                     const std::function<Status(std::shared_ptr<Tensor> *)> &op) {
+    std::shared_ptr<Tensor> expected;
+    std::shared_ptr<Tensor> output;
+    double replaced_us = 0;
+    double op_us = 0;
+    TimeRuns(replaced, &expected, &replaced_us);
+    TimeRuns(op, &output, &op_us);
+    ASSERT_EQ(output->shape(), expected->shape());
+    ASSERT_EQ(output->type(), expected->type());
+    if (output->type() == DataType::DE_FLOAT32) {
+      float max_diff = 0;
+      auto itr = expected->begin<float>();
+      for (auto out_itr = output->begin<float>(); out_itr != output->end<float>(); ++out_itr, ++itr) {
+        max_diff = std::max(max_diff, std::fabs(*out_itr - *itr));
+      }
+      EXPECT_LE(max_diff, 1e-5);
+    } else {
+      EXPECT_EQ(memcmp(output->GetBuffer(), expected->GetBuffer(), output->SizeInBytes()), 0);
+    }
+    UT::PerfLog(name) << "replaced code: " << replaced_us << " us, kernel: " << op_us << " us";
+  }
+
+  static void TimeRuns(const std::function<Status(std::shared_ptr<Tensor> *)> &run, std::shared_ptr<Tensor> *output,
+                       double *us) {
+    double ms = UT::TimeMs([&]() {
+      for (int i = 0; i < kRepeats; ++i) {
+        ASSERT_OK(run(output));
+      }
+    });
+    *us = ms * 1000 / kRepeats;
+  }
+
+  std::shared_ptr<Tensor> image_;
+  std::shared_ptr<Tensor> image_float_;
+};
+
+TEST_F(MindDataTestSimdImageUtilsPerf, TestNormalize) {
+  std::vector<float> mean = {123.675, 116.28, 103.53};
+  std::vector<float> std = {58.395, 57.12, 57.375};
+  Report(
+    "normalize uint8",
+    [&](std::shared_ptr<Tensor> *out) { return NormalizeWithIterators<uint8_t>(image_, out, mean, std); },
+    [&](std::shared_ptr<Tensor> *out) { return Normalize(image_, out, mean, std); });
+  Report(
+    "normalize float32",
+    [&](std::shared_ptr<Tensor> *out) { return NormalizeWithIterators<float>(image_float_, out, mean, std); },
+    [&](std::shared_ptr<Tensor> *out) { return Normalize(image_float_, out, mean, std); });
+}
+
+TEST_F(MindDataTestSimdImageUtilsPerf, TestHwcToChw) {
+  Report(
+    "HWC2CHW uint8", [&](std::shared_ptr<Tensor> *out) { return HwcToChwWithOpenCV(image_, out); },
+    [&](std::shared_ptr<Tensor> *out) { return HwcToChw(image_, out); });
+  Report(
+    "HWC2CHW float32", [&](std::shared_ptr<Tensor> *out) { return HwcToChwWithOpenCV(image_float_, out); },
+    [&](std::shared_ptr<Tensor> *out) { return HwcToChw(image_float_, out); });
+}
+
+TEST_F(MindDataTestSimdImageUtilsPerf, TestRescale) {
+  Report(
+    "rescale uint8", [&](std::shared_ptr<Tensor> *out) { return RescaleWithOpenCV(image_, out, 1.0 / 255, -1.0); },
+    [&](std::shared_ptr<Tensor> *out) { return Rescale(image_, out, 1.0 / 255, -1.0); });
+}
+
+TEST_F(MindDataTestSimdImageUtilsPerf, TestHorizontalFlip) {
+  Report(
+    "horizontal flip uint8", [&](std::shared_ptr<Tensor> *out) { return FlipWithOpenCV(image_, out, 1); },
+    [&](std::shared_ptr<Tensor> *out) { return HorizontalFlip(image_, out); });
+}
+
+TEST_F(MindDataTestSimdImageUtilsPerf, TestTypeCast) {
+  Report(
+    "type cast uint8 to float32", [&](std::shared_ptr<Tensor> *out) { return CastWithIterators(image_, out); },
+    [&](std::shared_ptr<Tensor> *out) { return TypeCast(image_, out, DataType(DataType::DE_FLOAT32)); });
+}
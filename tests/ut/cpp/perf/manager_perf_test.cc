@@ -0,0 +1,106 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Benchmarks of the FuncGraphManager on a graph of 100k nodes.
+#include <functional>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "perf/perf_common.h"
+#include "base/core_ops.h"
+#include "ir/anf.h"
+#include "ir/func_graph.h"
+#include "ir/manager.h"
+
+namespace mindspore {
+class TestManagerPerf : public UT::Common {
+ public:
+  static constexpr size_t kNumNodes = 100000;
+
+  // kNumNodes adds in chains of kChainLength, each add also using the parameter x. The end of each chain is used as a
+  // free variable by a closure, and the calls of the closures are gathered in the output. The graph is kept shallow
+  // because the traversals of the manager recurse along the inputs.
+  void SetUp() override {
+    func_graph_ = std::make_shared<FuncGraph>();
+    x_ = func_graph_->add_parameter();
+    y_ = func_graph_->add_parameter();
+    std::vector<AnfNodePtr> outputs = {NewValueNode(prim::kPrimMakeTuple)};
+    for (size_t chain = 0; chain < kNumNodes / kChainLength; ++chain) {
+      AnfNodePtr last = NewValueNode(static_cast<int64_t>(chain));
+      for (size_t i = 0; i < kChainLength; ++i) {
+        last = func_graph_->NewCNode({NewValueNode(prim::kPrimScalarAdd), last, x_});
+        nodes_.push_back(last->cast<CNodePtr>());
+      }
+      auto closure = std::make_shared<FuncGraph>();
+      closure->set_output(closure->NewCNode({NewValueNode(prim::kPrimScalarAdd), last, closure->add_parameter()}));
+      outputs.push_back(func_graph_->NewCNode({NewValueNode(closure), x_}));
+    }
+    func_graph_->set_output(func_graph_->NewCNode(outputs));
+  }
+
+  static void Report(const std::string &name, const std::function<void()> &run) {
+    double ms = UT::TimeMs(run);
+    UT::PerfLog(name) << ms << " ms";
+  }
+
+ protected:
+  static constexpr size_t kChainLength = 100;
+  FuncGraphPtr func_graph_;
+  AnfNodePtr x_;
+  AnfNodePtr y_;
+  std::vector<CNodePtr> nodes_;
+};
+
+TEST_F(TestManagerPerf, TestManage100k) {
+  FuncGraphManagerPtr manager;
+  Report("Manage", [this, &manager]() { manager = Manage(func_graph_); });
+  ASSERT_EQ(manager->node_users()[x_].size(), kNumNodes + kNumNodes / kChainLength);
+
+  // One transaction per edit, with the free variables queried in between like the passes do.
+  Report("SetEdge, one commit each", [this, &manager]() {
+    for (size_t i = 0; i < kNumNodes; ++i) {
+      manager->SetEdge(nodes_[i], 2, y_);
+      if (i % kChainLength == 0) {
+        (void)manager->free_variables_total();
+      }
+    }
+  });
+  ASSERT_EQ(manager->node_users()[y_].size(), kNumNodes);
+
+  // All the edits in one transaction.
+  Report("SetEdge, one commit", [this, &manager]() {
+    auto tr = manager->Transact();
+    for (auto &node : nodes_) {
+      tr.SetEdge(node, 2, x_);
+    }
+    tr.Commit();
+    (void)manager->free_variables_total();
+  });
+  ASSERT_TRUE(manager->node_users()[y_].empty());
+
+  // Replace each add by a new one, which moves its single user.
+  Report("Replace", [this, &manager]() {
+    for (auto &node : nodes_) {
+      auto new_node = func_graph_->NewCNode(node->inputs());
+      (void)manager->Replace(node, new_node);
+    }
+  });
+  ASSERT_EQ(manager->node_users()[x_].size(), kNumNodes + kNumNodes / kChainLength);
+
+  // Only the parameters, the return and its primitive are left.
+  Report("Drop", [this, &manager]() { manager->Replace(func_graph_->output(), x_); });
+  ASSERT_EQ(manager->all_nodes().size(), 4);
+}
+}  // namespace mindspore
@@ -0,0 +1,48 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// The benchmarks of the perf directory are built into ut_perf_tests, not into ut_tests, and are run by hand, e.g.:
+//   ./ut_perf_tests --gtest_filter='TestManagerPerf.*'
+#ifndef TESTS_UT_CPP_PERF_PERF_COMMON_H_
+#define TESTS_UT_CPP_PERF_PERF_COMMON_H_
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace UT {
+// Run 'run' once and return its time in milliseconds.
+inline double TimeMs(const std::function<void()> &run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// One line of the results of a benchmark, "[perf] <name>: <measures>", e.g. PerfLog("Drop") << ms << " ms".
+class PerfLog {
+ public:
+  explicit PerfLog(const std::string &name) { std::cout << "[perf] " << name << ": "; }
+  ~PerfLog() { std::cout << std::endl; }
+
+  template <typename T>
+  PerfLog &operator<<(const T &value) {
+    std::cout << value;
+    return *this;
+  }
+};
+}  // namespace UT
+#endif  // TESTS_UT_CPP_PERF_PERF_COMMON_H_
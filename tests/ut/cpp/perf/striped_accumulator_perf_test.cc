@@ -0,0 +1,74 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Benchmarks of the aggregation of the weights uploaded by the concurrent clients of a federated learning round.
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "perf/perf_common.h"
+#include "fl/server/kernel/striped_accumulator.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+namespace kernel {
+class TestStripedAccumulatorPerf : public UT::Common {
+ public:
+  static constexpr size_t kClientNum = 16;
+  static constexpr size_t kWeightNum = 1 << 22;
+
+  // Run 'accumulate' for each client in its own thread, like the concurrent launches of FedAvgKernel.
+  static void Run(const std::string &name, const std::function<void(float *, const float *)> &accumulate) {
+    std::vector<float> weight(kWeightNum, 0);
+    std::vector<std::vector<float>> new_weights(kClientNum, std::vector<float>(kWeightNum, 1.0));
+    double ms = UT::TimeMs([&]() {
+      std::vector<std::thread> clients;
+      for (size_t i = 0; i < kClientNum; i++) {
+        clients.emplace_back([&, i]() { accumulate(weight.data(), new_weights[i].data()); });
+      }
+      for (auto &client : clients) {
+        client.join();
+      }
+    });
+    ASSERT_EQ(weight[kWeightNum - 1], static_cast<float>(kClientNum));
+    UT::PerfLog(name) << ms << " ms";
+  }
+};
+
+// Each client holds one lock for the whole weight, like the aggregation before the striped accumulator.
+TEST_F(TestStripedAccumulatorPerf, TestGlobalLock) {
+  std::mutex mutex;
+  Run("global lock", [&mutex](float *weight, const float *new_weight) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < kWeightNum; i++) {
+      weight[i] += new_weight[i];
+    }
+  });
+}
+
+TEST_F(TestStripedAccumulatorPerf, TestStriped) {
+  StripedAccumulator accumulator;
+  accumulator.StartRound([]() {});
+  Run("striped", [&accumulator](float *weight, const float *new_weight) {
+    accumulator.Accumulate(weight, new_weight, kWeightNum);
+  });
+}
+}  // namespace kernel
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Benchmarks of the pulls of the dense weights of the parameter server by several clients while the weights are
+// updated.
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "perf/perf_common.h"
+#include "ps/weight_version.h"
+
+namespace mindspore {
+namespace ps {
+class TestWeightPullPerf : public UT::Common {
+ public:
+  static constexpr size_t kKeyNum = 16;
+  static constexpr size_t kWeightSize = 1 << 16;
+  static constexpr size_t kStripeNum = 64;
+  static constexpr size_t kClientNum = 8;
+  static constexpr size_t kRoundNum = 200;
+
+  void SetUp() override {
+    weights_.assign(kKeyNum, std::vector<float>(kWeightSize, 1.0));
+    versions_ = std::vector<WeightVersion>(kKeyNum);
+  }
+
+  // The update thread of the server: each update writes all the keys, each under the lock of its key.
+  void Update(float grad, bool advance) {
+    for (size_t key = 0; key < kKeyNum; ++key) {
+      std::lock_guard<std::mutex> lock(key_mutexes_[key % kStripeNum]);
+      for (auto &value : weights_[key]) {
+        value -= grad * 0.01f;
+      }
+      if (advance) {
+        versions_[key].Advance();
+      }
+    }
+  }
+
+  // The pull before the weight versions: the weight is copied under the lock of the key.
+  void PullLocked(size_t key, std::vector<float> *res) {
+    std::lock_guard<std::mutex> lock(key_mutexes_[key % kStripeNum]);
+    res->assign(weights_[key].begin(), weights_[key].end());
+  }
+
+  // Like ParameterServer::DoPull.
+  void PullVersioned(size_t key, std::vector<float> *res) {
+    WeightSnapshotPtr snapshot = versions_[key].Get();
+    if (snapshot == nullptr) {
+      std::lock_guard<std::mutex> lock(key_mutexes_[key % kStripeNum]);
+      snapshot = versions_[key].Get();
+      if (snapshot == nullptr) {
+        snapshot = versions_[key].Set(weights_[key]);
+      }
+    }
+    res->assign(snapshot->values.begin(), snapshot->values.end());
+  }
+
+  // The update thread runs kRoundNum updates back to back while kClientNum clients pull all the keys, and report the
+  // time of an update and the number of the pulls served.
+  void RunContended(const std::string &name, bool versioned) {
+    std::atomic<bool> done(false);
+    std::atomic<size_t> pulls(0);
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < kClientNum; ++c) {
+      clients.emplace_back([&]() {
+        std::vector<float> res;
+        while (!done.load()) {
+          for (size_t key = 0; key < kKeyNum; ++key) {
+            versioned ? PullVersioned(key, &res) : PullLocked(key, &res);
+          }
+          (void)pulls.fetch_add(kKeyNum);
+        }
+      });
+    }
+    double ms = UT::TimeMs([&]() {
+      for (size_t i = 0; i < kRoundNum; ++i) {
+        Update(static_cast<float>(i), versioned);
+      }
+    });
+    done = true;
+    for (auto &client : clients) {
+      client.join();
+    }
+    UT::PerfLog(name + ", contended") << ms / kRoundNum << " ms per update, " << pulls.load() * 1000 / ms << " pulls/s";
+  }
+
+  // The rounds of the training: the server updates all the keys, then each client pulls all of them.
+  void RunRounds(const std::string &name, bool versioned) {
+    std::vector<std::vector<float>> res(kClientNum);
+    double pull_ms = 0;
+    for (size_t i = 0; i < kRoundNum; ++i) {
+      Update(static_cast<float>(i), versioned);
+      pull_ms += UT::TimeMs([&]() {
+        std::vector<std::thread> clients;
+        for (size_t c = 0; c < kClientNum; ++c) {
+          clients.emplace_back([&, c]() {
+            for (size_t key = 0; key < kKeyNum; ++key) {
+              versioned ? PullVersioned(key, &res[c]) : PullLocked(key, &res[c]);
+            }
+          });
+        }
+        for (auto &client : clients) {
+          client.join();
+        }
+      });
+    }
+    UT::PerfLog(name + ", rounds") << pull_ms / kRoundNum << " ms for the pulls of a round";
+  }
+
+ protected:
+  std::vector<std::vector<float>> weights_;
+  std::vector<WeightVersion> versions_;
+  std::array<std::mutex, kStripeNum> key_mutexes_;
+};
+
+TEST_F(TestWeightPullPerf, TestLockedPull) {
+  RunContended("locked pull", false);
+  RunRounds("locked pull", false);
+}
+
+TEST_F(TestWeightPullPerf, TestVersionedPull) {
+  RunContended("versioned pull", true);
+  RunRounds("versioned pull", true);
+}
+}  // namespace ps
+}  // namespace mindspore
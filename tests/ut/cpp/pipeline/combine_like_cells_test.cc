@@ -0,0 +1,83 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "pipeline/jit/combine_like_cells.h"
+#include "ir/tensor.h"
+#include "frontend/operator/ops.h"
+
+namespace mindspore {
+namespace pipeline {
+class TestCombineLikeCells : public UT::Common {
+ public:
+  TestCombineLikeCells() {}
+  void SetUp() { top_graph_ = std::make_shared<FuncGraph>(); }
+  void TearDown() {}
+
+  AnfNodePtr NewWeight(const std::vector<int64_t> &shape) {
+    auto weight = top_graph_->add_parameter();
+    weight->set_default_param(std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape));
+    weight->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    return weight;
+  }
+
+  // cell(x) = prim(x, weight)
+  FuncGraphPtr NewCell(const PrimitivePtr &prim, const AnfNodePtr &weight) {
+    auto cell = std::make_shared<FuncGraph>();
+    auto x = cell->add_parameter();
+    cell->set_output(cell->NewCNode({NewValueNode(prim), x, weight}));
+    return cell;
+  }
+
+  FuncGraphPtr top_graph_;
+};
+
+TEST_F(TestCombineLikeCells, test_like_cells) {
+  auto cell1 = NewCell(prim::kPrimAdd, NewWeight({2, 3}));
+  auto cell2 = NewCell(prim::kPrimAdd, NewWeight({2, 3}));
+  LikeCellInfo info1, info2;
+  std::string signature1, signature2;
+  ASSERT_TRUE(GetLikeCellSignature(cell1, &info1, &signature1));
+  ASSERT_TRUE(GetLikeCellSignature(cell2, &info2, &signature2));
+  ASSERT_EQ(signature1, signature2);
+  ASSERT_EQ(info1.weights.size(), 1);
+  ASSERT_EQ(info1.closure.size(), 1);
+}
+
+TEST_F(TestCombineLikeCells, test_unlike_cells) {
+  LikeCellInfo info1, info2, info3;
+  std::string signature1, signature2, signature3;
+  ASSERT_TRUE(GetLikeCellSignature(NewCell(prim::kPrimAdd, NewWeight({2, 3})), &info1, &signature1));
+  ASSERT_TRUE(GetLikeCellSignature(NewCell(prim::kPrimMul, NewWeight({2, 3})), &info2, &signature2));
+  ASSERT_TRUE(GetLikeCellSignature(NewCell(prim::kPrimAdd, NewWeight({3, 3})), &info3, &signature3));
+  ASSERT_NE(signature1, signature2);
+  ASSERT_NE(signature1, signature3);
+}
+
+TEST_F(TestCombineLikeCells, test_free_variable) {
+  // The cell uses a node of another graph, which is not a weight, so it can not be combined.
+  auto outer = std::make_shared<FuncGraph>();
+  auto y = outer->add_parameter();
+  auto cell = NewCell(prim::kPrimAdd, y);
+  LikeCellInfo info;
+  std::string signature;
+  ASSERT_FALSE(GetLikeCellSignature(cell, &info, &signature));
+}
+}  // namespace pipeline
+}  // namespace mindspore
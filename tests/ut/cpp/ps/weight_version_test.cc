@@ -0,0 +1,120 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/weight_version.h"
+
+namespace mindspore {
+namespace ps {
+class TestWeightVersion : public UT::Common {
+ public:
+  TestWeightVersion() = default;
+  virtual ~TestWeightVersion() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+  // Like ParameterServer::DoPull.
+  static WeightSnapshotPtr Pull(WeightVersion *version, std::mutex *key_mutex, const std::vector<float> &weight) {
+    WeightSnapshotPtr snapshot = version->Get();
+    if (snapshot == nullptr) {
+      std::lock_guard<std::mutex> lock(*key_mutex);
+      snapshot = version->Get();
+      if (snapshot == nullptr) {
+        snapshot = version->Set(weight);
+      }
+    }
+    return snapshot;
+  }
+};
+
+// The weight is copied by the first pull after a write, and the copy is shared until the next write.
+TEST_F(TestWeightVersion, CopyOncePerWrite) {
+  WeightVersion version;
+  std::mutex key_mutex;
+  std::vector<float> weight(16, 1.0);
+  EXPECT_EQ(version.Get(), nullptr);
+  auto first = Pull(&version, &key_mutex, weight);
+  EXPECT_EQ(first->values, weight);
+  EXPECT_EQ(Pull(&version, &key_mutex, weight), first);
+
+  weight.assign(16, 2.0);
+  version.Advance();
+  EXPECT_EQ(version.Get(), nullptr);
+  auto second = Pull(&version, &key_mutex, weight);
+  EXPECT_NE(second, first);
+  EXPECT_EQ(second->values, weight);
+  EXPECT_EQ(first->values, std::vector<float>(16, 1.0));
+}
+
+// Each update sets all the values of the weight to the number of the update, so a copy made during an update has
+// different values.
+TEST_F(TestWeightVersion, PullsNeverSeeTornWeights) {
+  constexpr size_t kWeightSize = 4096;
+  constexpr size_t kUpdateNum = 2000;
+  constexpr size_t kReaderNum = 4;
+  WeightVersion version;
+  std::mutex key_mutex;
+  std::vector<float> weight(kWeightSize, 0);
+  std::atomic<bool> done(false);
+  std::vector<size_t> torn(kReaderNum, 0);
+  std::vector<size_t> stale(kReaderNum, 0);
+  std::vector<size_t> reads(kReaderNum, 0);
+  std::vector<std::thread> readers;
+  for (size_t r = 0; r < kReaderNum; ++r) {
+    readers.emplace_back([&, r]() {
+      float last = 0;
+      while (!done.load()) {
+        auto snapshot = Pull(&version, &key_mutex, weight);
+        auto &values = snapshot->values;
+        for (float value : values) {
+          if (value != values[0]) {
+            ++torn[r];
+            break;
+          }
+        }
+        // The pulls of one client never go back to an older update.
+        if (values[0] < last) {
+          ++stale[r];
+        }
+        last = values[0];
+        ++reads[r];
+      }
+    });
+  }
+  for (size_t i = 1; i <= kUpdateNum; ++i) {
+    std::lock_guard<std::mutex> lock(key_mutex);
+    for (auto &value : weight) {
+      value = static_cast<float>(i);
+    }
+    version.Advance();
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  for (size_t r = 0; r < kReaderNum; ++r) {
+    EXPECT_EQ(torn[r], 0);
+    EXPECT_EQ(stale[r], 0);
+    EXPECT_GT(reads[r], 0);
+  }
+}
+}  // namespace ps
+}  // namespace mindspore